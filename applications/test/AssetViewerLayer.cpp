@@ -1,10 +1,16 @@
 #include "AssetViewerLayer.h"
 #include "assets/AssetComponentTypes.h"
+#include "assets/MeshFile.h"
+#include "core/Log.h"
+#include "core/PackArchive.h"
+#include "core/Paths.h"
 #include "material/MaterialDescription.h"
 #include "ral/EnumUtils.h"
 
 
 #include <imgui.h>
+#include <algorithm>
+#include <filesystem>
 
 namespace RDE {
     void AssetViewerLayer::on_render_gui() {
@@ -12,6 +18,17 @@ namespace RDE {
         auto all_assets = asset_registry.view<entt::entity>();
         // Show a tree of all assets
         ImGui::Begin("Asset Viewer");
+        // Packs the whole asset directory, mounted on the next start.
+        if (ImGui::Button("Build asset pack")) {
+            if (auto asset_path = get_asset_path()) {
+                auto pack_path = *asset_path;
+                pack_path += PackArchive::EXTENSION;
+                PackBuilder::Build(*asset_path, pack_path);
+            }
+        }
+        if (ImGui::CollapsingHeader("Load telemetry")) {
+            render_load_telemetry();
+        }
         for (const auto &asset: all_assets) {
             // make a new node in the tree
             ImGui::PushID(entt::to_integral(asset));
@@ -84,6 +101,11 @@ namespace RDE {
                     ImGui::Text("GPU Texture: %u", entt::to_integral(gpu_texture.texture.index));
                     ImGui::Text("Width: %d, Height: %d, Channels: %d", gpu_texture.width, gpu_texture.height,
                                 gpu_texture.channels);
+                    ImGui::Text("Mip levels: %zu, %s", gpu_texture.mips.size() + 1,
+                                gpu_texture.srgb ? "sRGB" : "linear");
+                    ImGui::Text("Format: %s", gpu_texture.format == RAL::Format::UNKNOWN
+                                                  ? "uncompressed"
+                                                  : ral_format_to_string(gpu_texture.format).c_str());
                 }
 
                 if (asset_registry.all_of<AssetShaderDef>(asset)) {
@@ -121,6 +143,16 @@ namespace RDE {
                         ImGui::Text(" - Subview: %s, Index Offset: %u, Index Count: %u", subview.name.c_str(),
                                     subview.index_offset, subview.index_count);
                     }
+                    // Bake imported meshes next to their source, the .rdemesh loader picks the file up on the next load.
+                    if (asset_registry.all_of<AssetFilepath>(asset)) {
+                        std::filesystem::path source = asset_registry.get<AssetFilepath>(asset).path;
+                        if (source.extension() != MeshFile::EXTENSION && ImGui::Button("Bake .rdemesh")) {
+                            auto baked = source.replace_extension(MeshFile::EXTENSION);
+                            if (MeshFile::Write(baked, cpu_geometry)) {
+                                RDE_INFO("Baked mesh to '{}'", baked.string());
+                            }
+                        }
+                    }
                 }
                 ImGui::TreePop();
             }
@@ -128,4 +160,79 @@ namespace RDE {
         }
         ImGui::End();
     }
-}
\ No newline at end of file
+
+    void AssetViewerLayer::render_load_telemetry() {
+        AssetTelemetry &telemetry = m_asset_manager->get_telemetry();
+        const auto &counters = telemetry.get_counters();
+        const DerivedDataCache &derived_data_cache = m_asset_manager->get_derived_data_cache();
+        ImGui::Text("Asset cache: %zu hits, %zu misses, %zu reloads", counters.cache_hits, counters.cache_misses,
+                    counters.num_reloads);
+        ImGui::Text("Derived data cache: %zu hits, %zu misses", derived_data_cache.get_hit_count(),
+                    derived_data_cache.get_miss_count());
+        ImGui::Text("Max queue depth: %zu reads, %zu ready, %zu decodes", counters.max_read_queue_depth,
+                    counters.max_ready_queue_depth, counters.max_decode_queue_depth);
+
+        // Written to the working directory, CI runs can write them on exit through RDE_ASSET_TELEMETRY instead.
+        if (ImGui::Button("Write JSON") && telemetry.write_json("asset_telemetry.json")) {
+            RDE_INFO("Wrote asset_telemetry.json");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Write CSV") && telemetry.write_csv("asset_telemetry.csv")) {
+            RDE_INFO("Wrote asset_telemetry.csv");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) {
+            telemetry.clear();
+        }
+
+        constexpr size_t NUM_PHASES = AssetTelemetry::NUM_PHASES;
+        if (ImGui::BeginTable("loaders", int(NUM_PHASES) + 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Loader");
+            ImGui::TableSetupColumn("Assets");
+            for (size_t p = 0; p < NUM_PHASES; ++p) {
+                ImGui::TableSetupColumn(AssetTelemetry::GetPhaseName(static_cast<AssetTelemetry::Phase>(p)));
+            }
+            ImGui::TableSetupColumn("Total ms");
+            ImGui::TableSetupColumn("MiB read");
+            ImGui::TableSetupColumn("DDC hit/miss");
+            ImGui::TableHeadersRow();
+            for (const auto &[loader, statistics]: telemetry.get_loader_statistics()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(loader.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu (%zu failed)", statistics.num_assets, statistics.num_failed);
+                double total = 0.0;
+                for (const double seconds: statistics.seconds) {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", seconds * 1000.0);
+                    total += seconds;
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", total * 1000.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", double(statistics.bytes_read) / (1024.0 * 1024.0));
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu/%zu", statistics.derived_data_hits, statistics.derived_data_misses);
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::TreeNode("Slowest assets")) {
+            std::vector<const AssetTelemetry::AssetRecord *> slowest;
+            for (const auto &record: telemetry.get_records()) {
+                slowest.push_back(&record);
+            }
+            const size_t count = std::min<size_t>(slowest.size(), 20);
+            std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(), [](auto *a, auto *b) {
+                return a->get_total_seconds() > b->get_total_seconds();
+            });
+            for (size_t i = 0; i < count; ++i) {
+                const auto &record = *slowest[i];
+                ImGui::Text("%8.2f ms %s%s", record.get_total_seconds() * 1000.0, record.uri.c_str(),
+                            record.failed ? " (failed)" : "");
+            }
+            ImGui::TreePop();
+        }
+    }
+}
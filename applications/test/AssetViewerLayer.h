@@ -2,11 +2,13 @@
 
 #include "core/ILayer.h"
 #include "assets/AssetDatabase.h"
+#include "assets/AssetManager.h"
 
 namespace RDE {
     class AssetViewerLayer : public ILayer {
     public:
-        explicit AssetViewerLayer(AssetDatabase *asset_database) : m_asset_database(asset_database) {
+        AssetViewerLayer(AssetDatabase *asset_database, AssetManager *asset_manager)
+            : m_asset_database(asset_database), m_asset_manager(asset_manager) {
         }
 
         void on_attach() override {
@@ -31,7 +33,11 @@ namespace RDE {
         }
 
     private:
+        // Load time per loader and phase, the slowest assets and the AssetManager's counters.
+        void render_load_telemetry();
+
         std::string m_name = "AssetViewerLayer"; // Name of the layer
         AssetDatabase *m_asset_database = nullptr; // Pointer to the asset database
+        AssetManager *m_asset_manager = nullptr;
     };
 }
@@ -8,21 +8,31 @@
 #include "core/Log.h"
 
 #include "core/Paths.h"
+#include "core/VirtualFileSystem.h"
 #include "core/Ticker.h"
 #include "systems/TransformSystem.h"
 #include "systems/CameraSystem.h"
 #include "systems/HierarchySystem.h"
 #include "systems/BoundingVolumeSystem.h"
+#include "systems/TextureStreamingSystem.h"
+#include "systems/WorldStreamingSystem.h"
+#include "components/PrefabComponent.h"
+#include "scene/SceneFile.h"
+#include "scene/WorldPartition.h"
 
 
 #include "assets/StbImageLoader.h"
 #include "assets/MeshMtlLoader.h"
 #include "assets/MeshObjLoader.h"
+#include "assets/MeshBinaryLoader.h"
 #include "assets/MaterialManifestLoader.h"
 #include "assets/ShaderDefLoader.h"
+#include "assets/PrefabLoader.h"
 #include "assets/GenerateDefaultTextures.h"
 
 #include <imgui.h>
+#include <cstdlib>
+#include <filesystem>
 
 namespace RDE {
     SandboxApp::SandboxApp(std::unique_ptr<IWindow> window) : m_window(
@@ -60,17 +70,27 @@ namespace RDE {
         {
             m_asset_database = std::make_shared<AssetDatabase>();
             m_asset_manager = std::make_unique<AssetManager>(*m_asset_database);
+            m_hot_reloader = std::make_unique<HotReloader>(*m_asset_manager);
             m_file_watcher = std::make_unique<FileWatcher>();
             m_file_watcher_event_queue = std::make_unique<ThreadSafeQueue<std::string> >();
             auto path = get_asset_path();
 
+            // A pack built next to the asset directory (see the Asset Viewer) serves the assets it contains.
+            auto pack_path = *path;
+            pack_path += PackArchive::EXTENSION;
+            if (std::filesystem::exists(pack_path)) {
+                VFS::Mount(pack_path, *path);
+            }
+
             m_file_watcher->start(path->string(), m_file_watcher_event_queue.get());
             //TODO: register loaders for different asset types
             m_asset_manager->register_loader(std::make_shared<StbImageLoader>());
             m_asset_manager->register_loader(std::make_shared<MeshObjLoader>());
+            m_asset_manager->register_loader(std::make_shared<MeshBinaryLoader>());
             m_asset_manager->register_loader(std::make_shared<MeshMtlLoader>());
             m_asset_manager->register_loader(std::make_shared<MaterialManifestLoader>());
             m_asset_manager->register_loader(std::make_shared<ShaderDefLoader>());
+            m_asset_manager->register_loader(std::make_shared<PrefabLoader>());
         }
         {
             auto &scene_registry = m_scene->get_registry();
@@ -79,12 +99,26 @@ namespace RDE {
             system_scheduler.register_system<TransformSystem>(scene_registry);
             system_scheduler.register_system<BoundingVolumeSystem>(scene_registry);
             system_scheduler.register_system<CameraSystem>(scene_registry);
+            int width, height;
+            m_window->get_framebuffer_size(width, height);
+            system_scheduler.register_system<TextureStreamingSystem>(scene_registry, *m_asset_database,
+                                                                     static_cast<float>(height));
             //system_scheduler.register_system<GpuGeometryUploadSystem>(scene_registry, m_renderer->get_device());
             //system_scheduler.register_system<RenderPacketSystem>(scene_registry, *m_asset_database, m_main_view);
-            RDE_INFO("Registered systems: HierarchySystem, TransformSystem, BoundingVolumeSystem, CameraSystem");
+            RDE_INFO("Registered systems: HierarchySystem, TransformSystem, BoundingVolumeSystem, CameraSystem, "
+                     "TextureStreamingSystem");
+            // Streams a partitioned world around the camera, see RDE_WORLD_PARTITION below.
+            if (const char *world_path = std::getenv("RDE_WORLD")) {
+                system_scheduler.register_system<WorldStreamingSystem>(scene_registry, *m_asset_manager,
+                                                                       std::filesystem::path(world_path));
+                RDE_INFO("Registered WorldStreamingSystem for '{}'", world_path);
+            }
         }
 
         m_renderer->init();
+        m_upload_manager = std::make_unique<RAL::BufferUploadManager>(m_renderer->get_device());
+        m_texture_streamer = std::make_unique<TextureStreamer>(m_renderer->get_device(), *m_upload_manager,
+                                                               *m_asset_database);
 
         auto imgui_layer = std::make_shared<ImGuiLayer>(m_window.get(),
                                                         m_renderer->get_device());
@@ -94,21 +128,42 @@ namespace RDE {
         auto test_scene_layer = std::make_shared<TestSceneLayer>(m_asset_manager.get(), m_scene->get_registry(), m_renderer->get_device());
         m_layer_stack.push_layer(test_scene_layer);
 
-        auto asset_viewer_layer = std::make_shared<AssetViewerLayer>(m_asset_database.get());
+        auto asset_viewer_layer = std::make_shared<AssetViewerLayer>(m_asset_database.get(), m_asset_manager.get());
         m_layer_stack.push_layer(asset_viewer_layer);
         return true;
     }
 
     void SandboxApp::shutdown() {
         m_layer_stack.clear();
+        m_texture_streamer.reset();
+        m_upload_manager.reset();
         {
+            VFS::UnmountAll();
             m_file_watcher->stop();
             m_file_watcher.reset();
             m_file_watcher_event_queue.reset();
+            m_hot_reloader.reset();
+            // CI tracks load times with this dump, the extension picks the format.
+            if (const char *telemetry_path = std::getenv("RDE_ASSET_TELEMETRY")) {
+                const std::filesystem::path path(telemetry_path);
+                const AssetTelemetry &telemetry = m_asset_manager->get_telemetry();
+                if (path.extension() == ".csv" ? telemetry.write_csv(path) : telemetry.write_json(path)) {
+                    RDE_INFO("Wrote asset load telemetry to '{}'", path.string());
+                }
+            }
             m_asset_manager.reset();
             m_asset_database.reset();
         }
         {
+            // Saves the scene on exit, drop the file on the window to load it again.
+            if (const char *snapshot_path = std::getenv("RDE_SCENE_SNAPSHOT")) {
+                if (SceneFile::Write(snapshot_path, m_scene->get_registry())) {
+                    RDE_INFO("Wrote scene snapshot to '{}'", snapshot_path);
+                }
+            }
+            if (const char *world_path = std::getenv("RDE_WORLD_PARTITION")) {
+                WorldPartition::Write(world_path, m_scene->get_registry(), 64.0f);
+            }
             m_scene->shutdown();
             m_scene.reset();
         }
@@ -154,11 +209,14 @@ namespace RDE {
         while (!m_file_watcher_event_queue->empty()) {
             auto file_path_opt = m_file_watcher_event_queue->try_pop();
             if (file_path_opt) {
-                const std::string &file_path = *file_path_opt;
-                // Handle file change event, e.g., reload assets
-                m_asset_manager->force_load(file_path);
+                // Coalesced and reloaded together with everything depending on the file.
+                m_hot_reloader->on_file_changed(*file_path_opt);
             }
         }
+        m_hot_reloader->update();
+
+        // Drop unreferenced assets while over the memory budget, they reload on their next request.
+        m_asset_manager->update_residency();
 
         // Update layers
         for (auto &layer: m_layer_stack) {
@@ -176,6 +234,11 @@ namespace RDE {
             return; // Skip this frame, we'll start fresh on the next one
         }
 
+        // New textures become usable with their mip tail, finer levels stream in within the frame's upload budget.
+        m_upload_manager->begin_frame();
+        m_texture_streamer->update();
+        m_upload_manager->flush();
+
         if (RAL::CommandBuffer *cmd = m_renderer->begin_frame()) {
             const auto& frameCtx = m_renderer->get_current_frame_context();
             cmd->begin();
@@ -252,12 +315,20 @@ namespace RDE {
             dispatcher.dispatch<WindowFileDropEvent>([this](WindowFileDropEvent &e) {
                 // Handle file drop event
                 for (const auto &file_path: e.get_files()) {
+                    if (std::filesystem::path(file_path).extension() == SceneFile::EXTENSION) {
+                        SceneFile::Read(file_path, m_scene->get_registry(), *m_asset_manager);
+                        continue;
+                    }
                     auto f_asset = m_asset_manager->load_async(file_path);
 
                     f_asset.wait();
                     auto asset_id = f_asset.get();
                     if(asset_id && asset_id->is_valid()){
-                        //TODO instanciate the asset in the scene with default parameters where missing
+                        //TODO instanciate the other asset types in the scene with default parameters where missing
+                        auto &asset_registry = m_asset_database->get_registry();
+                        if (const auto *prefab = asset_registry.try_get<Prefab>(asset_id->entity_id)) {
+                            PrefabUtils::Instantiate(m_scene->get_registry(), asset_id, *prefab);
+                        }
                     }
                 }
                 return false; // Allow layers to handle the event
@@ -3,7 +3,9 @@
 #include "core/Application.h"
 #include "core/IWindow.h"
 #include "core/InputManager.h"
+#include "assets/HotReloader.h"
 #include "renderer/Renderer.h"
+#include "renderer/TextureStreamer.h"
 #include "scene/Scene.h"
 #include "material/MaterialDatabase.h"
 
@@ -35,6 +37,9 @@ namespace RDE {
         std::unique_ptr<RDE::AssetManager> m_asset_manager;
         std::unique_ptr<RDE::FileWatcher> m_file_watcher;
         std::unique_ptr<RDE::ThreadSafeQueue<std::string>> m_file_watcher_event_queue;
+        std::unique_ptr<RDE::HotReloader> m_hot_reloader;
+        std::unique_ptr<RAL::BufferUploadManager> m_upload_manager;
+        std::unique_ptr<RDE::TextureStreamer> m_texture_streamer;
 
         // --- Data Ownership ---
         std::shared_ptr<RDE::AssetDatabase> m_asset_database;
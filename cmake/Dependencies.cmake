@@ -21,7 +21,6 @@ FetchContent_Declare(glad GIT_REPOSITORY https://github.com/Dav1dde/glad.git GIT
 FetchContent_Declare(glm GIT_REPOSITORY https://github.com/g-truc/glm.git GIT_TAG 1.0.1)
 FetchContent_Declare(stb_image GIT_REPOSITORY https://github.com/nothings/stb.git GIT_TAG master)
 FetchContent_Declare(EnTT GIT_REPOSITORY https://github.com/skypjack/entt.git GIT_TAG v3.15.0)
-FetchContent_Declare(tinyobjloader GIT_REPOSITORY https://github.com/tinyobjloader/tinyobjloader.git GIT_TAG v2.0.0rc13)
 FetchContent_Declare(yaml-cpp GIT_REPOSITORY https://github.com/jbeder/yaml-cpp.git GIT_TAG master)
 FetchContent_Declare(efsw GIT_REPOSITORY https://github.com/SpartanJ/efsw.git GIT_TAG 1.4.1)
 
@@ -67,7 +66,7 @@ FetchContent_MakeAvailable(imgui)
 # Most of these are header-only or have simple builds.
 FetchContent_MakeAvailable(VulkanMemoryAllocator)
 #FetchContent_MakeAvailable(daxa)
-FetchContent_MakeAvailable(spdlog ImGuiFileDialog tinyobjloader yaml-cpp efsw glm)
+FetchContent_MakeAvailable(spdlog ImGuiFileDialog yaml-cpp efsw glm)
 
 FetchContent_MakeAvailable(stb_image)
 add_library(rde_stb_image INTERFACE)
@@ -0,0 +1,96 @@
+//assets/AssetCache.h
+#pragma once
+
+#include "AssetHandle.h"
+#include "core/PathId.h"
+
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RDE {
+    // Loaded assets by PathId, split into shards with their own reader-writer lock. Lookups from loader threads and the
+    // main thread only take the shared lock of one shard, so they neither wait for each other nor for writes to other
+    // shards. Thread-safe.
+    class AssetCache {
+    public:
+        static constexpr size_t NUM_SHARDS = 64;
+
+        [[nodiscard]] AssetID find(PathId id) const {
+            const Shard &shard = get_shard(id);
+            std::shared_lock lock(shard.mutex);
+            auto it = shard.assets.find(id);
+            return it == shard.assets.end() ? nullptr : it->second;
+        }
+
+        [[nodiscard]] bool contains(PathId id) const {
+            const Shard &shard = get_shard(id);
+            std::shared_lock lock(shard.mutex);
+            return shard.assets.count(id) != 0;
+        }
+
+        void insert_or_assign(PathId id, AssetID asset) {
+            Shard &shard = get_shard(id);
+            std::unique_lock lock(shard.mutex);
+            shard.assets.insert_or_assign(id, std::move(asset));
+        }
+
+        // Returns false and leaves the entry alone if id is already cached.
+        bool insert(PathId id, AssetID asset) {
+            Shard &shard = get_shard(id);
+            std::unique_lock lock(shard.mutex);
+            return shard.assets.try_emplace(id, std::move(asset)).second;
+        }
+
+        // Returns the removed asset, nullptr if id was not cached.
+        AssetID erase(PathId id) {
+            Shard &shard = get_shard(id);
+            std::unique_lock lock(shard.mutex);
+            auto it = shard.assets.find(id);
+            if (it == shard.assets.end()) {
+                return nullptr;
+            }
+            AssetID asset = std::move(it->second);
+            shard.assets.erase(it);
+            return asset;
+        }
+
+        // Copy of all entries, consistent per shard. For iteration that modifies the cache.
+        [[nodiscard]] std::vector<std::pair<PathId, AssetID> > snapshot() const {
+            std::vector<std::pair<PathId, AssetID> > entries;
+            for (const Shard &shard: m_shards) {
+                std::shared_lock lock(shard.mutex);
+                entries.insert(entries.end(), shard.assets.begin(), shard.assets.end());
+            }
+            return entries;
+        }
+
+        [[nodiscard]] size_t size() const {
+            size_t size = 0;
+            for (const Shard &shard: m_shards) {
+                std::shared_lock lock(shard.mutex);
+                size += shard.assets.size();
+            }
+            return size;
+        }
+
+    private:
+        // Own cache line each, so locking one shard does not contend with its neighbours.
+        struct alignas(64) Shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<PathId, AssetID, PathIdHash> assets;
+        };
+
+        // The low bits pick the bucket inside a shard, so the shard comes from the high bits.
+        Shard &get_shard(PathId id) { return m_shards[id >> 58]; }
+
+        const Shard &get_shard(PathId id) const { return m_shards[id >> 58]; }
+
+        static_assert(NUM_SHARDS == 64, "get_shard takes the top 6 bits of the id");
+
+        std::array<Shard, NUM_SHARDS> m_shards;
+    };
+}
@@ -1,11 +1,14 @@
 //assets/AssetComponentTypes.h
 #pragma once
 
+#include "core/ByteBuffer.h"
 #include "core/Properties.h"
 #include "AssetHandle.h"
 #include "ral/Resources.h"
 #include "components/DirtyTagComponent.h"
 
+#include <glm/gtc/quaternion.hpp>
+#include <limits>
 #include <optional>
 #include <string>
 #include <vector>
@@ -64,8 +67,12 @@ namespace RDE {
         PropertyContainer edges;
         PropertyContainer faces;
         PropertyContainer tets;
+        PropertyContainer meshlets; // Filled by MeshletBuilder::Build
 
         std::vector<AssetGeometrySubView> subviews;
+        std::vector<uint32_t> meshlet_vertices; // Global vertex index per meshlet-local vertex
+        // Files defining the subviews' materials, relative to the mesh file. Baked meshes report them as dependencies.
+        std::vector<std::string> material_libraries;
 
         size_t getVertexCount() const { return vertices.size(); }
     };
@@ -85,14 +92,38 @@ namespace RDE {
         std::vector<AssetGeometrySubView> subviews;
     };
 
+    struct AssetTextureMip {
+        int width{0};
+        int height{0};
+        ByteBuffer data;
+    };
+
     struct AssetGpuTexture {
         RAL::TextureHandle texture; // GPU texture handle
         RAL::SamplerHandle sampler; // Sampler for texture filtering and wrapping
+        // Filtering and wrapping of the sampler. Its minLod is set by the TextureStreamer to the finest resident level.
+        RAL::SamplerDescription sampler_description;
 
         int width{0}; // Texture width
         int height{0}; // Texture height
         int channels{0}; // Texture channels (e.g., RGB, RGBA)
-        std::vector<char> data; // Pointer to the raw texture data, if needed
+        bool srgb{true}; // Color channels are sRGB encoded, false for data such as normal maps
+        RAL::Format format{RAL::Format::UNKNOWN}; // Block-compressed format of data and mips, UNKNOWN for 8 bit pixels
+        ByteBuffer data; // Decoded pixels of level 0, rows bottom to top
+        std::vector<AssetTextureMip> mips; // Levels 1 and below, each half the size of the previous one
+    };
+
+    // Mip levels of a texture on the GPU. Levels stream in coarsest first, so the resident ones are always
+    // finest_resident_level and everything coarser, and the texture's sampler is clamped to finest_resident_level.
+    struct AssetTextureResidency {
+        uint32_t resident_levels{0}; // Bit per level uploaded to the GPU
+        int finest_resident_level{-1}; // -1 while no level is resident
+        // Finest level worth streaming, from the scene's screen-size feedback. Until the scene requests a level nothing
+        // streams past the levels uploaded with the texture.
+        int requested_level{std::numeric_limits<int>::max()};
+        float priority{0.0f}; // Largest on-screen size in pixels of the meshes using the texture, higher streams first
+
+        bool is_resident(int level) const { return (resident_levels >> level) & 1u; }
     };
 
     struct ConditionalVertexAttribute : RAL::VertexInputAttribute {
@@ -126,19 +157,19 @@ namespace RDE {
         std::vector<RAL::PushConstantRange> pushConstantRanges; // Push constants are usually not conditional
     };
 
+    // A node tree loaded from a .prefab file, instantiated into a scene by PrefabUtils::Instantiate. Nodes are stored
+    // depth first from the root at index 0, so every parent comes before its children.
     struct Prefab {
         struct Node {
-            AssetID mesh_asset;   // Direct handle, not an index
-            AssetID material_asset; // Direct handle
             std::string name;
-            glm::mat4 transform; // Store the transform directly
-            AssetID parent;      // Direct handle to parent node's asset
-            std::vector<AssetID> children;
+            AssetID mesh_asset; // nullptr for nodes that only group others
+            AssetID material_asset;
+            glm::vec3 translation = {0.0f, 0.0f, 0.0f};
+            glm::quat orientation = {1.0f, 0.0f, 0.0f, 0.0f};
+            glm::vec3 scale = {1.0f, 1.0f, 1.0f};
+            int32_t parent = -1; // Index of the parent node, -1 for the root
         };
 
-        // No more separate vectors for meshes/materials/transforms.
-        // Each node is self-contained.
         std::vector<Node> nodes;
-        std::vector<AssetID> root_nodes;
     };
 }
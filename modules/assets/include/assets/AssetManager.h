@@ -2,25 +2,47 @@
 #pragma once
 
 #include "AssetHandle.h"
+#include "AssetCache.h"
 #include "AssetDatabase.h"
+#include "AssetResidency.h"
+#include "AssetTelemetry.h"
+#include "DependencyCache.h"
+#include "DerivedDataCache.h"
 #include "ILoader.h"
 #include "core/DependencyGraph.h"
+#include "core/FileIOUtils.h"
 #include "core/Log.h"
+#include "core/ParallelFor.h"
+#include "core/PathId.h"
 #include "core/Paths.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <filesystem>
+#include <optional>
 #include <queue>
 #include <utility>
 #include <algorithm>
 
 namespace RDE {
+    // Assets are cached under the PathId of their normalized URI, so "a/./b.png" and "a/b.png" are the same asset.
+    // get_loaded_asset and find may be called from any thread (loaders, workers) without a global lock, everything
+    // else, loading included, happens on the main thread.
     class AssetManager {
     public:
-        explicit AssetManager(AssetDatabase &asset_database) : m_database(asset_database) {}
+        explicit AssetManager(AssetDatabase &asset_database) : m_database(asset_database),
+                                                               m_data_path(get_asset_path()) {
+            if (auto derived_data_path = get_derived_data_path()) {
+                m_derived_data_cache.open(*derived_data_path);
+            }
+        }
 
         ~AssetManager() = default;
 
@@ -32,75 +54,388 @@ namespace RDE {
 
         // --- PRIMARY NEW FUNCTION: Asynchronous Loading ---
         std::future<AssetID> load_async(const std::string& uri) {
+            const PathId key = m_paths.intern(uri);
+
             // 1. Check cache for already loaded asset.
-            if (auto it = m_cache.find(uri); it != m_cache.end()) {
+            if (AssetID cached = m_cache.find(key)) {
+                m_residency.touch(cached->uri);
+                ++m_telemetry.get_counters().cache_hits;
                 std::promise<AssetID> promise;
-                promise.set_value(it->second);
+                promise.set_value(std::move(cached));
                 RDE_CORE_TRACE("Asset Cache HIT for '{}'.", uri);
                 return promise.get_future();
             }
 
             // 2. Check if this asset is already in the process of being loaded.
-            if (auto it = m_loading_operations.find(uri); it != m_loading_operations.end()) {
+            if (auto it = m_loading_operations.find(key); it != m_loading_operations.end()) {
                 RDE_CORE_TRACE("Asset '{}' is already being loaded. Returning existing future.", uri);
                 return it->second.get_future();
             }
 
             // 3. Begin a new loading operation.
             RDE_CORE_INFO("Asset Cache MISS for '{}'. Starting new load operation.", uri);
-            m_loading_operations.emplace(uri, std::promise<AssetID>());
+            ++m_telemetry.get_counters().cache_misses;
+            m_loading_operations.emplace(key, std::promise<AssetID>());
 
             // For simplicity, we do this on the calling thread.
             // In a real engine, you'd dispatch this entire block to a background thread pool.
             try {
                 // This is the core logic.
-                AssetID result_id = begin_load_operation(uri);
-                m_loading_operations.at(uri).set_value(result_id);
+                AssetID result_id = begin_load_operation(uri, key);
+                m_loading_operations.at(key).set_value(result_id);
             } catch (const std::exception& e) {
                 RDE_CORE_ERROR("Failed to load asset '{}': {}", uri, e.what());
-                m_loading_operations.at(uri).set_exception(std::current_exception());
+                m_loading_operations.at(key).set_exception(std::current_exception());
             }
 
-            auto future = m_loading_operations.at(uri).get_future();
+            auto future = m_loading_operations.at(key).get_future();
             // Once the operation is complete, we can remove it from the map.
             // The future remains valid.
-            m_loading_operations.erase(uri);
+            m_loading_operations.erase(key);
             return future;
         }
 
         std::future<AssetID> force_load(const std::string &uri) {
             RDE_CORE_INFO("Force loading asset from '{}'.", uri);
             // Clear the cache for this URI to force reload.
-            m_cache.erase(uri);
+            if (AssetID cached = m_cache.erase(m_paths.intern(uri))) {
+                m_residency.remove(cached->uri);
+            }
 
             // Call the regular load function to reload the asset.
             return load_async(uri);
         }
 
+        // Normalizes and hashes uri on every call. Callers looking an asset up repeatedly keep its PathId instead.
         AssetID get_loaded_asset(const std::string &uri) const {
-            auto it = m_cache.find(uri);
-            if (it != m_cache.end()) {
-                return it->second;
-            }
-            return nullptr; // Asset not found
+            return m_cache.find(PathTable::MakeId(uri));
+        }
+
+        AssetID get_loaded_asset(PathId key) const {
+            return m_cache.find(key);
+        }
+
+        PathId intern(std::string_view uri) {
+            return m_paths.intern(uri);
+        }
+
+        const PathTable &get_paths() const {
+            return m_paths;
         }
 
         void add_to_cache(const std::string& uri, AssetID id) {
-            if (!m_cache.count(uri)) {
-                m_cache[uri] = std::move(id);
+            const PathId key = m_paths.intern(uri);
+            if (!m_cache.contains(key)) {
+                cache_asset(key, std::move(id));
             }
         }
 
         AssetDatabase &get_database() {
             return m_database;
         }
+
+        DependencyCache &get_dependency_cache() {
+            return m_dependency_cache;
+        }
+
+        DerivedDataCache &get_derived_data_cache() {
+            return m_derived_data_cache;
+        }
+
+        AssetTelemetry &get_telemetry() {
+            return m_telemetry;
+        }
+
+        // --- Residency ---
+        // Cached assets are accounted in the AssetResidency. AssetID is a shared_ptr, so an asset is referenced while
+        // anything besides the cache (a scene component, another asset, a pending future) holds a copy. Once a budget
+        // is exceeded, unreferenced assets are destroyed, least recently used first, and load again through the
+        // normal path on their next request.
+        void set_residency_budget(uint64_t cpu_bytes, uint64_t gpu_bytes) {
+            m_residency.set_budget(cpu_bytes, gpu_bytes);
+        }
+
+        // Reported by whoever uploads the asset, so GPU memory counts against its budget.
+        void set_gpu_bytes(const AssetID &asset_id, uint64_t bytes) {
+            m_residency.set_gpu_bytes(asset_id->uri, bytes);
+        }
+
+        // Called before the manager destroys an asset's entity, when it is evicted or replaced by a reload. Owners of
+        // GPU resources free them here.
+        void set_eviction_callback(std::function<void(const AssetID &, AssetDatabase &)> callback) {
+            m_eviction_callback = std::move(callback);
+        }
+
+        AssetResidency &get_residency() {
+            return m_residency;
+        }
+
+        // Call once per frame: refreshes the last use of referenced assets and evicts while over budget.
+        // Returns the number of evicted assets.
+        size_t update_residency() {
+            // The cache's own references per asset, anything beyond them is held elsewhere.
+            // The snapshot holds one more reference per entry.
+            const auto entries = m_cache.snapshot();
+            std::unordered_map<const AssetID_Data *, long> cache_references;
+            for (const auto &[key, id]: entries) {
+                cache_references[id.get()] += 2;
+            }
+            auto is_referenced = [&cache_references](const AssetID &id, long extra_references) {
+                return id.use_count() - extra_references > cache_references[id.get()];
+            };
+            for (const auto &[key, id]: entries) {
+                if (is_referenced(id, 0)) {
+                    m_residency.touch(id->uri);
+                }
+            }
+            if (!m_residency.is_over_budget()) {
+                return 0;
+            }
+
+            // Sub-assets ("file#name") only load through their file, so they are evicted together with it.
+            std::unordered_map<std::string, std::vector<PathId>> keys_by_file;
+            for (const auto &[key, id]: entries) {
+                keys_by_file[std::string(strip_fragment(id->uri))].push_back(key);
+            }
+
+            size_t evicted = 0;
+            for (const std::string &asset_uri: m_residency.get_eviction_order()) {
+                if (!m_residency.is_over_budget()) {
+                    break;
+                }
+                auto group = keys_by_file.find(std::string(strip_fragment(asset_uri)));
+                if (group == keys_by_file.end() || group->second.empty()) {
+                    continue;
+                }
+                // Evicting an asset drops its references to others, so this is checked with the live counts.
+                const bool referenced = std::any_of(group->second.begin(), group->second.end(),
+                                                    [&](PathId key) {
+                                                        AssetID id = m_cache.find(key);
+                                                        return id && is_referenced(id, 1);
+                                                    });
+                if (!referenced) {
+                    evicted += evict(group->second);
+                    group->second.clear();
+                }
+            }
+            const auto &statistics = m_residency.get_statistics();
+            RDE_CORE_TRACE("Evicted {} assets, {:.1f} MiB CPU and {:.1f} MiB GPU resident.", evicted,
+                           double(statistics.cpu_bytes) / (1024.0 * 1024.0),
+                           double(statistics.gpu_bytes) / (1024.0 * 1024.0));
+            return evicted;
+        }
+        // --- Hot reload ---
+        // Cache URIs of the assets loaded from the changed files and of everything depending on them, transitively,
+        // ordered dependencies first. Uses the dependency graphs of previous loads, paths are compared normalized.
+        std::vector<std::string> collect_reload_set(const std::vector<std::string> &changed_paths) const {
+            std::unordered_set<PathId, PathIdHash> dirty;
+            std::queue<PathId> to_visit;
+            for (const auto &path: changed_paths) {
+                const PathId key = PathTable::MakeId(path);
+                if (m_dependencies.count(key) && dirty.insert(key).second) {
+                    to_visit.push(key);
+                }
+            }
+            while (!to_visit.empty()) {
+                auto it = m_dependents.find(to_visit.front());
+                to_visit.pop();
+                if (it == m_dependents.end()) {
+                    continue;
+                }
+                for (const auto &dependent: it->second) {
+                    if (dirty.insert(dependent).second) {
+                        to_visit.push(dependent);
+                    }
+                }
+            }
+
+            // Dependencies first: repeatedly take the assets whose dirty dependencies are all taken.
+            std::vector<PathId> order;
+            std::unordered_set<PathId, PathIdHash> placed;
+            while (order.size() < dirty.size()) {
+                const size_t before = order.size();
+                for (const PathId key: dirty) {
+                    if (placed.count(key)) {
+                        continue;
+                    }
+                    bool ready = true;
+                    if (auto deps = m_dependencies.find(key); deps != m_dependencies.end()) {
+                        for (const PathId dep: deps->second) {
+                            if (dep != key && dirty.count(dep) && !placed.count(dep)) {
+                                ready = false;
+                                break;
+                            }
+                        }
+                    }
+                    if (ready) {
+                        order.push_back(key);
+                        placed.insert(key);
+                    }
+                }
+                if (order.size() == before) {
+                    RDE_CORE_WARN("Dependency cycle among reloaded assets, reloading the rest unordered.");
+                    for (const PathId key: dirty) {
+                        if (placed.insert(key).second) {
+                            order.push_back(key);
+                        }
+                    }
+                }
+            }
+
+            std::vector<std::string> uris;
+            uris.reserve(order.size());
+            for (const PathId key: order) {
+                uris.emplace_back(m_paths.get_path(key));
+            }
+            return uris;
+        }
+
+        std::shared_ptr<ILoader> find_loader(const std::string &uri) const {
+            auto it = m_loaders.find(std::string(FileIO::GetExtension(strip_fragment(uri))));
+            return it == m_loaders.end() ? nullptr : it->second;
+        }
+
+        // Loads uri again, from derived data prepared off the main thread if given, and swaps the result in: the cached
+        // AssetID is kept and pointed at the new entity, so everything holding it sees the new asset, and the old
+        // entity is destroyed. Sub-assets the loader registers as "uri#name" are swapped the same way. On failure the
+        // old asset stays.
+        bool reload_asset(const std::string &uri, const std::vector<char> *derived_data = nullptr) {
+            auto loader = find_loader(uri);
+            if (!loader) {
+                return false;
+            }
+            const PathId key = m_paths.intern(uri);
+            // Dependencies the file gained since its last load are loaded first.
+            std::vector<PathId> dependencies;
+            for (const auto &dep: m_dependency_cache.get(uri, *loader)) {
+                const std::string dep_uri = resolve(dep);
+                const PathId dep_key = m_paths.intern(dep_uri);
+                if (!m_cache.contains(dep_key)) {
+                    load_async(dep_uri).wait();
+                }
+                dependencies.push_back(dep_key);
+            }
+            set_dependencies(key, std::move(dependencies));
+
+            // Loaders only create missing sub-assets, so the current ones are taken out of the cache.
+            std::vector<std::pair<PathId, AssetID>> previous;
+            const std::string prefix = std::string(m_paths.get_path(key)) + '#';
+            for (const auto &[entry_key, id]: m_cache.snapshot()) {
+                const std::string_view path = m_paths.get_path(entry_key);
+                if (entry_key == key || path.compare(0, prefix.size(), prefix) == 0) {
+                    previous.emplace_back(entry_key, m_cache.erase(entry_key));
+                }
+            }
+
+            AssetID id;
+            AssetTelemetry::AssetRecord record{uri, std::string(FileIO::GetExtension(uri))};
+            ++m_telemetry.get_counters().num_reloads;
+            try {
+                AssetTelemetry::Scope scope(record, AssetTelemetry::Phase::Parse);
+                if (derived_data) {
+                    id = loader->read_derived_data(uri, derived_data->data(), derived_data->size(), m_database, *this);
+                    record.derived_data = id ? AssetTelemetry::DerivedData::Hit : AssetTelemetry::DerivedData::Miss;
+                }
+                if (!id) {
+                    id = loader->load_asset(uri, m_database, *this);
+                }
+            } catch (const std::exception &e) {
+                RDE_CORE_ERROR("Failed to reload asset '{}': {}", uri, e.what());
+                id = nullptr;
+            }
+            if (!id) {
+                for (auto &[entry_key, old]: previous) {
+                    m_cache.insert_or_assign(entry_key, std::move(old));
+                }
+                record.failed = true;
+                m_telemetry.submit(std::move(record));
+                return false;
+            }
+            {
+                AssetTelemetry::Scope commit(record, AssetTelemetry::Phase::Commit);
+                m_cache.insert_or_assign(key, id);
+
+                std::unordered_set<const AssetID_Data *> released;
+                for (auto &[entry_key, old]: previous) {
+                    const AssetID fresh = m_cache.find(entry_key);
+                    if (!fresh) {
+                        // No longer produced by the file, keep the old version.
+                        m_cache.insert_or_assign(entry_key, std::move(old));
+                        continue;
+                    }
+                    if (released.insert(old.get()).second && old->entity_id != fresh->entity_id) {
+                        if (m_eviction_callback) {
+                            m_eviction_callback(old, m_database);
+                        }
+                        if (m_database.get_registry().valid(old->entity_id)) {
+                            m_database.destroy_asset(old);
+                        }
+                    }
+                    old->entity_id = fresh->entity_id;
+                    m_residency.add(old->uri, AssetResidency::MeasureCpuBytes(m_database, old));
+                    m_cache.insert_or_assign(entry_key, std::move(old));
+                }
+            }
+            RDE_CORE_INFO("Reloaded asset '{}'.", uri);
+            m_telemetry.submit(std::move(record));
+            return true;
+        }
     private:
-        AssetID begin_load_operation(const std::string& root_uri) {
+        static std::string_view strip_fragment(std::string_view uri) {
+            return uri.substr(0, uri.find('#'));
+        }
+
+        // Asset URIs from the dependency discovery are relative to the asset directory.
+        std::string resolve(const std::string &uri) const {
+            return m_data_path ? (*m_data_path / uri).string() : uri;
+        }
+
+        // Records the edges of the reverse dependency index used by collect_reload_set.
+        void set_dependencies(PathId key, std::vector<PathId> dependencies) {
+            auto &current = m_dependencies[key];
+            for (const PathId dep: current) {
+                if (auto it = m_dependents.find(dep); it != m_dependents.end()) {
+                    it->second.erase(key);
+                }
+            }
+            for (const PathId dep: dependencies) {
+                m_dependents[dep].insert(key);
+            }
+            current = std::move(dependencies);
+        }
+
+        void cache_asset(PathId key, AssetID id) {
+            m_residency.add(id->uri, AssetResidency::MeasureCpuBytes(m_database, id));
+            m_cache.insert_or_assign(key, std::move(id));
+        }
+
+        size_t evict(const std::vector<PathId> &keys) {
+            std::vector<AssetID> assets;
+            for (const PathId key: keys) {
+                AssetID asset = m_cache.erase(key);
+                if (asset && std::find(assets.begin(), assets.end(), asset) == assets.end()) {
+                    assets.push_back(std::move(asset));
+                }
+            }
+            for (const auto &asset: assets) {
+                RDE_CORE_TRACE("Evicting asset '{}'.", asset->uri);
+                if (m_eviction_callback) {
+                    m_eviction_callback(asset, m_database);
+                }
+                m_residency.evicted(asset->uri);
+                if (m_database.get_registry().valid(asset->entity_id)) {
+                    m_database.destroy_asset(asset);
+                }
+                asset->entity_id = entt::null;
+            }
+            return assets.size();
+        }
+
+        AssetID begin_load_operation(const std::string& root_uri, PathId root_key) {
             // -- I. DISCOVERY PHASE --
             DependencyGraph<std::string, std::string> graph;
-            build_dependency_graph(root_uri, graph);
-
-            const auto data_path = get_asset_path();
+            std::unordered_map<PathId, double, PathIdHash> discovery_seconds;
+            build_dependency_graph(root_uri, graph, discovery_seconds);
 
             // -- II. SCHEDULING PHASE --
             auto stages = graph.bake();
@@ -110,36 +445,215 @@ namespace RDE {
 
             // -- III. EXECUTION PHASE --
             for (const auto& stage : stages) {
-                // All assets in this stage can be loaded in parallel.
-                // For now, we'll do it serially to keep it simple.
-                // TODO: Replace with parallel_for or dispatch to a thread pool.
+                // All assets in this stage are independent of each other. The files of loaders that only need the
+                // bytes are read in one asynchronous batch, the other loaders run while it is in flight.
+                std::vector<PendingLoad> direct;
+                std::vector<PendingLoad> batched;
                 for (const std::string* uri_ptr : stage) {
                     //make sure the path is the correct absolute path containing the parent path
-                    const std::string& current_uri = data_path.value() / *uri_ptr;
+                    const PathId key = m_paths.intern(resolve(*uri_ptr));
 
                     // Skip if it was loaded as a dependency of another parallel asset.
-                    if (m_cache.count(current_uri)) continue;
+                    if (m_cache.contains(key)) continue;
 
-                    std::filesystem::path path(current_uri);
-                    std::string ext = path.extension().string();
+                    // Loaders see the normalized path, so their sub-asset URIs match the cache keys.
+                    const std::string current_uri(m_paths.get_path(key));
+                    std::string ext(FileIO::GetExtension(current_uri));
                     auto it_loader = m_loaders.find(ext);
                     if (it_loader == m_loaders.end()) {
                         throw std::runtime_error("No loader for extension: " + ext);
                     }
 
-                    // The loader does the actual work.
-                    AssetID primary_id = it_loader->second->load_asset(current_uri, m_database, *this);
+                    // Results still in the derived data cache need no read of the source.
+                    PendingLoad load{current_uri, key, it_loader->second.get(), {}, {current_uri, ext}};
+                    load.record.seconds[size_t(AssetTelemetry::Phase::Discovery)] = discovery_seconds[key];
+                    if (AssetID cached_id = load_derived_data(load)) {
+                        {
+                            AssetTelemetry::Scope commit(load.record, AssetTelemetry::Phase::Commit);
+                            cache_asset(key, std::move(cached_id));
+                        }
+                        m_telemetry.submit(std::move(load.record));
+                        continue;
+                    }
+                    (load.loader->loads_from_memory() ? batched : direct).push_back(std::move(load));
+                }
+                execute_stage(direct, batched);
+            }
+            AssetID root_id = m_cache.find(root_key);
+            if (!root_id) {
+                throw std::runtime_error("Asset was not produced by its loader: " + root_uri);
+            }
+            return root_id;
+        }
+
+        struct PendingLoad {
+            std::string uri;
+            PathId key;
+            const ILoader *loader;
+            std::string derived_data_key; // Where the result goes in the derived data cache, empty if it doesn't
+            AssetTelemetry::AssetRecord record;
+        };
+
+        void execute_stage(std::vector<PendingLoad> &direct, std::vector<PendingLoad> &batched) {
+            // Reads are timed from submission to arrival, overlapping reads each count their full latency.
+            struct Arrival {
+                FileIO::ReadResult result;
+                double seconds;
+            };
+            std::mutex mutex;
+            std::condition_variable arrived;
+            std::deque<Arrival> ready;
+            std::unordered_map<std::string, PendingLoad *> by_path;
+            std::future<void> reads;
+            AssetTelemetry::Counters &counters = m_telemetry.get_counters();
+            if (!batched.empty()) {
+                std::vector<std::string> paths;
+                for (auto &load: batched) {
+                    paths.push_back(load.uri);
+                    by_path[load.uri] = &load;
+                }
+                counters.max_read_queue_depth = std::max(counters.max_read_queue_depth, batched.size());
+                const auto submitted = std::chrono::steady_clock::now();
+                reads = FileIO::ReadAsync(std::move(paths), [&, submitted](FileIO::ReadResult &result) {
+                    const std::chrono::duration<double> latency = std::chrono::steady_clock::now() - submitted;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready.push_back({std::move(result), latency.count()});
+                    arrived.notify_one();
+                });
+            }
+
+            // Files of loaders that decode concurrently are decoded on worker threads as they arrive, at most one per
+            // worker at a time so decoded images don't pile up, and added to the database in arrival order.
+            struct Decoding {
+                PendingLoad *load;
+                std::future<std::unique_ptr<DecodedAsset>> decoded;
+            };
+            std::deque<Decoding> decoding;
+            auto finish_decode = [&]() {
+                Decoding front = std::move(decoding.front());
+                decoding.pop_front();
+                PendingLoad &load = *front.load;
+                std::unique_ptr<DecodedAsset> decoded = front.decoded.get();
+                AssetID id;
+                {
+                    AssetTelemetry::Scope commit(load.record, AssetTelemetry::Phase::Commit);
+                    id = load.loader->create_asset(load.uri, std::move(decoded), m_database, *this);
+                }
+                finish_load(load, id);
+            };
+
+            // The read callbacks reference the locals above, so outstanding reads are waited for before leaving.
+            std::exception_ptr error;
+            try {
+                for (auto &load: direct) {
+                    AssetID id;
+                    {
+                        AssetTelemetry::Scope scope(load.record, AssetTelemetry::Phase::Parse);
+                        id = load.loader->load_asset(load.uri, m_database, *this);
+                    }
+                    finish_load(load, id);
+                }
+                for (size_t i = 0; i < batched.size(); ++i) {
+                    Arrival arrival;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        arrived.wait(lock, [&]() { return !ready.empty(); });
+                        counters.max_ready_queue_depth = std::max(counters.max_ready_queue_depth, ready.size());
+                        arrival = std::move(ready.front());
+                        ready.pop_front();
+                    }
+                    FileIO::ReadResult &result = arrival.result;
+                    PendingLoad &load = *by_path.at(result.path);
+                    load.record.seconds[size_t(AssetTelemetry::Phase::IO)] += arrival.seconds;
+                    load.record.bytes_read += result.data.size();
+                    if (!result.success) {
+                        RDE_CORE_ERROR("Failed to read '{}'.", load.uri);
+                        finish_load(load, nullptr);
+                        continue;
+                    }
+                    if (load.loader->decodes_concurrently()) {
+                        if (decoding.size() >= Parallel::GetWorkerCount()) {
+                            finish_decode();
+                        }
+                        auto decode = [&load, data = std::move(result.data)]() {
+                            AssetTelemetry::Scope scope(load.record, AssetTelemetry::Phase::Parse);
+                            return load.loader->decode(load.uri, data.data(), data.size());
+                        };
+                        decoding.push_back({&load, std::async(std::launch::async, std::move(decode))});
+                        counters.max_decode_queue_depth = std::max(counters.max_decode_queue_depth, decoding.size());
+                        continue;
+                    }
+                    AssetID id;
+                    {
+                        AssetTelemetry::Scope scope(load.record, AssetTelemetry::Phase::Parse);
+                        id = load.loader->load_asset_from_memory(load.uri, result.data.data(), result.data.size(),
+                                                                 m_database, *this);
+                    }
+                    finish_load(load, id);
+                }
+                while (!decoding.empty()) {
+                    finish_decode();
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+            for (auto &pending: decoding) {
+                pending.decoded.wait();
+            }
+            if (reads.valid()) {
+                reads.wait();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Returns the cached result of a previous import, or nullptr with load.derived_data_key set to where the
+        // result of this import should be stored.
+        AssetID load_derived_data(PendingLoad &load) {
+            const ILoader &loader = *load.loader;
+            if (!loader.supports_derived_data() || !m_derived_data_cache.is_open()) {
+                return nullptr;
+            }
 
-                    if(primary_id){
-                        // Cache the result immediately.
-                        m_cache[current_uri] = primary_id;
+            // Hashing the source on its first sight and mapping the entry count as I/O.
+            AssetTelemetry::Scope scope(load.record, AssetTelemetry::Phase::IO);
+            load.record.derived_data = AssetTelemetry::DerivedData::Miss;
+            load.derived_data_key = m_derived_data_cache.make_key(load.uri, loader);
+            if (!load.derived_data_key.empty()) {
+                MappedFile cached;
+                if (m_derived_data_cache.load(load.derived_data_key, cached)) {
+                    load.record.bytes_read += cached.size();
+                    AssetTelemetry::ScopedPhase parse(AssetTelemetry::Phase::Parse);
+                    if (AssetID id = loader.read_derived_data(load.uri, cached.data(), cached.size(), m_database,
+                                                              *this)) {
+                        RDE_CORE_TRACE("Derived data HIT for '{}'.", load.uri);
+                        load.record.derived_data = AssetTelemetry::DerivedData::Hit;
+                        return id;
                     }
+                    RDE_CORE_WARN("Derived data for '{}' is invalid, importing again.", load.uri);
+                }
+            }
+            return nullptr;
+        }
+
+        void finish_load(PendingLoad &load, const AssetID &id) {
+            if (id) {
+                AssetTelemetry::Scope scope(load.record, AssetTelemetry::Phase::Commit);
+                // Cache the result immediately.
+                cache_asset(load.key, id);
+                std::vector<char> data;
+                if (!load.derived_data_key.empty() && load.loader->write_derived_data(id, m_database, data)) {
+                    m_derived_data_cache.store(load.derived_data_key, data);
                 }
             }
-            return m_cache.at(root_uri);
+            load.record.failed = !id;
+            m_telemetry.submit(std::move(load.record));
         }
 
-        void build_dependency_graph(const std::string& root_uri, DependencyGraph<std::string, std::string>& graph) {
+        // Records the time of each file's dependency scan in discovery_seconds.
+        void build_dependency_graph(const std::string& root_uri, DependencyGraph<std::string, std::string>& graph,
+                                    std::unordered_map<PathId, double, PathIdHash> &discovery_seconds) {
             std::queue<std::string> to_process;
             std::unordered_set<std::string> discovered;
 
@@ -156,21 +670,34 @@ namespace RDE {
                     file_uri = file_uri.substr(0, fragment_pos);
                 }
 
-                std::filesystem::path path(file_uri);
-                std::string ext = path.extension().string();
+                std::string ext(FileIO::GetExtension(file_uri));
                 auto it_loader = m_loaders.find(ext);
                 if (it_loader == m_loaders.end()) {
                     RDE_CORE_WARN("No loader found for dependency '{}', skipping.", current_uri);
                     continue;
                 }
 
-                // Use the new fast discovery method.
-                std::vector<std::string> dependencies = it_loader->second->get_dependencies(file_uri);
+                // Use the new fast discovery method, unchanged files are answered from the cache.
+                AssetTelemetry::AssetRecord discovery;
+                std::vector<std::string> dependencies;
+                {
+                    AssetTelemetry::Scope scope(discovery, AssetTelemetry::Phase::Discovery);
+                    dependencies = m_dependency_cache.get(file_uri, *it_loader->second);
+                }
 
                 // An asset "reads" from its dependencies and "writes" to itself.
                 // The payload and resource handle are both the URI string.
                 graph.add_node(file_uri, dependencies, {file_uri});
 
+                // Remembered under the cache keys for hot reloading.
+                std::vector<PathId> dependency_keys;
+                for (const auto &dep_uri: dependencies) {
+                    dependency_keys.push_back(m_paths.intern(resolve(dep_uri)));
+                }
+                const PathId file_key = m_paths.intern(resolve(file_uri));
+                discovery_seconds[file_key] += discovery.seconds[size_t(AssetTelemetry::Phase::Discovery)];
+                set_dependencies(file_key, std::move(dependency_keys));
+
                 for (const auto& dep_uri : dependencies) {
                     if (discovered.find(dep_uri) == discovered.end()) {
                         discovered.insert(dep_uri);
@@ -181,10 +708,20 @@ namespace RDE {
         }
 
         AssetDatabase &m_database;
+        std::optional<std::filesystem::path> m_data_path; // Looked up once, it touches the file system
 
         // Your runtime-pluggable system.
-        std::unordered_map<std::string, AssetID> m_cache;
+        PathTable m_paths;
+        AssetCache m_cache;
         std::unordered_map<std::string, std::shared_ptr<ILoader>> m_loaders;
-        std::unordered_map<std::string, std::promise<AssetID>> m_loading_operations;
+        std::unordered_map<PathId, std::promise<AssetID>, PathIdHash> m_loading_operations;
+        DependencyCache m_dependency_cache;
+        DerivedDataCache m_derived_data_cache;
+        AssetResidency m_residency;
+        AssetTelemetry m_telemetry;
+        // Reverse dependency index.
+        std::unordered_map<PathId, std::vector<PathId>, PathIdHash> m_dependencies;
+        std::unordered_map<PathId, std::unordered_set<PathId, PathIdHash>, PathIdHash> m_dependents;
+        std::function<void(const AssetID &, AssetDatabase &)> m_eviction_callback;
     };
 }
@@ -0,0 +1,75 @@
+//assets/AssetResidency.h
+#pragma once
+
+#include "AssetDatabase.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RDE {
+    // Per asset memory accounting for the AssetManager: the CPU bytes of the asset's components, measured when it is
+    // cached, the GPU bytes reported by whoever uploaded it, and when it was last used. Keyed by the cache URI.
+    class AssetResidency {
+    public:
+        static constexpr uint64_t DEFAULT_CPU_BUDGET = 2ull * 1024 * 1024 * 1024;
+        static constexpr uint64_t DEFAULT_GPU_BUDGET = 1ull * 1024 * 1024 * 1024;
+
+        struct Statistics {
+            size_t num_assets = 0;
+            uint64_t cpu_bytes = 0;
+            uint64_t gpu_bytes = 0;
+            size_t num_evicted = 0;
+            uint64_t evicted_bytes = 0;
+        };
+
+        void set_budget(uint64_t cpu_bytes, uint64_t gpu_bytes) {
+            m_cpu_budget = cpu_bytes;
+            m_gpu_budget = gpu_bytes;
+        }
+
+        [[nodiscard]] uint64_t get_cpu_budget() const { return m_cpu_budget; }
+
+        [[nodiscard]] uint64_t get_gpu_budget() const { return m_gpu_budget; }
+
+        // Starts tracking uri, or replaces its CPU size. Counts as a use.
+        void add(const std::string &uri, uint64_t cpu_bytes);
+
+        void remove(const std::string &uri);
+
+        // Like remove, but counted in the statistics.
+        void evicted(const std::string &uri);
+
+        void touch(const std::string &uri);
+
+        [[nodiscard]] bool contains(const std::string &uri) const { return m_entries.count(uri) != 0; }
+
+        void set_gpu_bytes(const std::string &uri, uint64_t bytes);
+
+        [[nodiscard]] bool is_over_budget() const {
+            return m_statistics.cpu_bytes > m_cpu_budget || m_statistics.gpu_bytes > m_gpu_budget;
+        }
+
+        // Tracked URIs, least recently used first.
+        [[nodiscard]] std::vector<std::string> get_eviction_order() const;
+
+        [[nodiscard]] const Statistics &get_statistics() const { return m_statistics; }
+
+        // Bytes held by the CPU side components of an asset (geometry, decoded pixels, text).
+        static uint64_t MeasureCpuBytes(const AssetDatabase &db, const AssetID &asset_id);
+
+    private:
+        struct Entry {
+            uint64_t cpu_bytes = 0;
+            uint64_t gpu_bytes = 0;
+            uint64_t last_use = 0;
+        };
+
+        std::unordered_map<std::string, Entry> m_entries;
+        uint64_t m_use_counter = 0;
+        uint64_t m_cpu_budget = DEFAULT_CPU_BUDGET;
+        uint64_t m_gpu_budget = DEFAULT_GPU_BUDGET;
+        Statistics m_statistics;
+    };
+}
@@ -0,0 +1,144 @@
+//assets/AssetTelemetry.h
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace RDE {
+    // Where asset load time goes. The AssetManager keeps one record per loaded asset with the time spent in each load
+    // phase, the bytes read and whether the derived data cache had it, sums them per loader and counts its cache hits
+    // and queue depths. Lives on the main thread, only the Scope and ScopedPhase helpers are used from workers.
+    class AssetTelemetry {
+    public:
+        enum class Phase : uint8_t {
+            Discovery, // Dependency scan
+            IO, // Opening and reading the source, or mapping its derived data
+            Parse, // Decoding the source into components, the default inside a loader
+            PostProcess, // Processing after the decode, e.g. mip generation, compression or mesh optimization
+            Commit, // Creating the asset in the database, caching it and storing its derived data
+            Count
+        };
+
+        static constexpr size_t NUM_PHASES = static_cast<size_t>(Phase::Count);
+
+        enum class DerivedData : uint8_t {
+            None, // The loader has none or the cache is closed
+            Hit,
+            Miss
+        };
+
+        struct AssetRecord {
+            std::string uri;
+            std::string loader; // Extension the loader was picked by
+            double seconds[NUM_PHASES] = {};
+            uint64_t bytes_read = 0;
+            DerivedData derived_data = DerivedData::None;
+            bool failed = false;
+
+            [[nodiscard]] double get_total_seconds() const;
+        };
+
+        struct LoaderStatistics {
+            size_t num_assets = 0;
+            size_t num_failed = 0;
+            double seconds[NUM_PHASES] = {};
+            uint64_t bytes_read = 0;
+            size_t derived_data_hits = 0;
+            size_t derived_data_misses = 0;
+        };
+
+        struct Counters {
+            size_t cache_hits = 0; // load_async answered from the asset cache
+            size_t cache_misses = 0; // load_async that started a load operation
+            size_t num_reloads = 0;
+            size_t max_read_queue_depth = 0; // Files in flight in one batched read
+            size_t max_ready_queue_depth = 0; // Files read but not yet handed to their loader
+            size_t max_decode_queue_depth = 0; // Decodes running on workers at once
+        };
+
+    private:
+        struct Context {
+            AssetRecord *record;
+            Phase phase;
+            std::chrono::steady_clock::time_point start;
+
+            // Adds the time since start to the current phase and restarts the clock.
+            void flush(std::chrono::steady_clock::time_point now);
+        };
+
+        // Innermost Scope of the calling thread, nullptr outside of one.
+        static Context *&GetCurrent();
+
+    public:
+        // Attributes the time until its destruction on this thread to record, starting in phase. The enclosing scope on
+        // this thread, e.g. of the asset whose loader started this load, is paused meanwhile, so phases never count
+        // the same time twice.
+        class Scope {
+        public:
+            Scope(AssetRecord &record, Phase phase);
+
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            Context m_context;
+            Context *m_previous;
+        };
+
+        // Switches the record of the innermost Scope on this thread to phase until its destruction. Loaders mark their
+        // I/O and post-processing with it, outside of a Scope it does nothing.
+        class ScopedPhase {
+        public:
+            explicit ScopedPhase(Phase phase);
+
+            ~ScopedPhase();
+
+            ScopedPhase(const ScopedPhase &) = delete;
+
+            ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+        private:
+            Context *m_context;
+            Phase m_previous = Phase::Parse;
+        };
+
+        // Counts bytes read from storage for the record of the innermost Scope on this thread.
+        static void AddBytesRead(uint64_t bytes);
+
+        static const char *GetPhaseName(Phase phase);
+
+        void submit(AssetRecord record);
+
+        void clear();
+
+        [[nodiscard]] const std::vector<AssetRecord> &get_records() const { return m_records; }
+
+        // Keyed by loader extension.
+        [[nodiscard]] const std::map<std::string, LoaderStatistics> &get_loader_statistics() const {
+            return m_loaders;
+        }
+
+        [[nodiscard]] Counters &get_counters() { return m_counters; }
+
+        [[nodiscard]] const Counters &get_counters() const { return m_counters; }
+
+        // Counters, per loader sums and every record, times in milliseconds.
+        bool write_json(const std::filesystem::path &path) const;
+
+        // One row per record, times in milliseconds.
+        bool write_csv(const std::filesystem::path &path) const;
+
+    private:
+        std::vector<AssetRecord> m_records;
+        std::map<std::string, LoaderStatistics> m_loaders;
+        Counters m_counters;
+    };
+}
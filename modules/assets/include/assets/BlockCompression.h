@@ -0,0 +1,40 @@
+//assets/BlockCompression.h
+#pragma once
+
+#include "AssetComponentTypes.h"
+#include "ral/Common.h"
+
+#include <cstddef>
+#include <string_view>
+
+// CPU encoder for the block-compressed texture formats (BC1, BC3, BC4, BC5 and BC7), so textures reach the GPU in the
+// format it samples from. Blocks are independent and encoded in parallel, the palette searches use SSE2 where
+// available. BC7 blocks are written in mode 6 (one subset, RGBA endpoints with p-bits, 16 weights), which suits both
+// opaque and alpha textures.
+namespace RDE::BlockCompression {
+    enum class Quality {
+        Fast, // Bounding box endpoints, BC1/BC3 instead of BC7
+        Normal, // Principal axis endpoints, one least squares refinement
+        High // More refinements and an exhaustive p-bit search for translucent BC7 blocks
+    };
+
+    // Bytes of one level of width x height pixels, 0 if format is not block-compressed.
+    size_t GetCompressedSize(RAL::Format format, int width, int height);
+
+    // BC5 for normal maps, BC4 for single channel data, BC7 for everything else (BC1 or BC3 at Quality::Fast).
+    RAL::Format ChooseFormat(int channels, bool srgb, bool normal_map, bool has_alpha, Quality quality);
+
+    // Compresses 8 bit pixels with 1 to 4 channels into GetCompressedSize bytes. Edge blocks of sizes that are not a
+    // multiple of 4 repeat the last row and column. Returns false if format is not supported.
+    bool Compress(const unsigned char *pixels, int width, int height, int channels, RAL::Format format,
+                  Quality quality, unsigned char *out);
+
+    // Decodes to RGBA8, for validation and tools. Of BC7 only mode 6 blocks are decoded, others come out magenta.
+    bool Decompress(const unsigned char *blocks, int width, int height, RAL::Format format, unsigned char *rgba);
+
+    // Replaces the pixels of texture.data and texture.mips with their compressed form and sets texture.format.
+    bool Compress(AssetGpuTexture &texture, RAL::Format format, Quality quality);
+
+    // Guess from the file name whether a texture is a tangent space normal map.
+    bool IsNormalMap(std::string_view path);
+}
@@ -0,0 +1,51 @@
+//assets/DependencyCache.h
+#pragma once
+
+#include "ILoader.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace RDE {
+    // Remembers the result of ILoader::get_dependencies per file, keyed by file size and modification time, so repeat
+    // loads and hot reloads of unchanged files skip the scan.
+    class DependencyCache {
+    public:
+        std::vector<std::string> get(const std::string &uri, const ILoader &loader);
+
+        void invalidate(const std::string &uri);
+
+        void clear();
+
+        [[nodiscard]] size_t get_hit_count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+        [[nodiscard]] size_t get_miss_count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_misses;
+        }
+
+    private:
+        struct Entry {
+            std::uintmax_t size = 0;
+            std::filesystem::file_time_type mtime;
+            std::vector<std::string> dependencies;
+        };
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+        size_t m_hits = 0;
+        size_t m_misses = 0;
+    };
+
+    // Returns the lines of the top level YAML block `key:` (up to the next top level key), or an empty string.
+    // Lets manifest loaders parse only their dependency section instead of the whole document.
+    std::string ExtractYamlBlock(std::string_view text, std::string_view key);
+}
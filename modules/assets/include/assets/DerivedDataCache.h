@@ -0,0 +1,97 @@
+//assets/DerivedDataCache.h
+#pragma once
+
+#include "ILoader.h"
+#include "core/MappedFile.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RDE {
+    // On-disk cache of processed assets. Entries are keyed by a hash of the source file's content, the extension,
+    // ILoader::get_expected_version(), ILoader::get_import_settings() and ILoader::get_path_settings(), so any change
+    // to one of them simply misses and the stale entry ages out. Entries are evicted least recently used first once the
+    // size budget is exceeded.
+    // A default constructed cache is closed and misses every lookup.
+    class DerivedDataCache {
+    public:
+        static constexpr uint64_t DEFAULT_BUDGET_BYTES = uint64_t(2) << 30;
+
+        DerivedDataCache() = default;
+
+        // Creates root if needed and indexes the existing entries.
+        bool open(const std::filesystem::path &root, uint64_t budget_bytes = DEFAULT_BUDGET_BYTES);
+
+        void close();
+
+        [[nodiscard]] bool is_open() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return !m_root.empty();
+        }
+
+        // Returns an empty key if the source cannot be read. The content hash is remembered per file size and
+        // modification time, so repeated loads of an unchanged file do not read it again.
+        std::string make_key(const std::string &uri, const ILoader &loader);
+
+        // Key for a source whose content hash the caller already has, e.g. because it holds the bytes.
+        static std::string make_key(uint64_t content_hash, const std::string &uri, const ILoader &loader);
+
+        // Maps the entry, the caller deserializes straight out of the mapping.
+        bool load(const std::string &key, MappedFile &out);
+
+        bool store(const std::string &key, const std::vector<char> &data);
+
+        void set_budget(uint64_t budget_bytes);
+
+        [[nodiscard]] uint64_t get_budget() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_budget;
+        }
+
+        [[nodiscard]] uint64_t get_size_bytes() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_size;
+        }
+
+        [[nodiscard]] size_t get_hit_count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+        [[nodiscard]] size_t get_miss_count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_misses;
+        }
+
+    private:
+        struct Entry {
+            uint64_t size = 0;
+            uint64_t last_use = 0; // Ordering only, initialized from the file time on open
+        };
+
+        struct SourceHash {
+            std::uintmax_t size = 0;
+            std::filesystem::file_time_type mtime;
+            uint64_t hash = 0;
+        };
+
+        [[nodiscard]] std::filesystem::path entry_path(const std::string &key) const;
+
+        // Removes least recently used entries until the cache is below 90% of the budget. Expects m_mutex held.
+        void evict();
+
+        mutable std::mutex m_mutex;
+        std::filesystem::path m_root;
+        uint64_t m_budget = DEFAULT_BUDGET_BYTES;
+        uint64_t m_size = 0;
+        uint64_t m_use_counter = 0;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::unordered_map<std::string, SourceHash> m_source_hashes;
+        size_t m_hits = 0;
+        size_t m_misses = 0;
+    };
+}
@@ -0,0 +1,59 @@
+//assets/HotReloader.h
+#pragma once
+
+#include "AssetManager.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RDE {
+    // Turns file change notifications into asset reloads. Notifications for the same file are coalesced until it was
+    // quiet for the debounce window (editors and the watcher report a save several times). The changed assets and
+    // everything depending on them are then imported on a background thread and swapped in together, in a single
+    // update(), so a frame never sees half a reload. Main thread only, except for the background import.
+    class HotReloader {
+    public:
+        explicit HotReloader(AssetManager &asset_manager,
+                             std::chrono::milliseconds debounce = std::chrono::milliseconds(200));
+
+        // Waits for a running import.
+        ~HotReloader();
+
+        HotReloader(const HotReloader &) = delete;
+
+        HotReloader &operator=(const HotReloader &) = delete;
+
+        void on_file_changed(const std::string &path);
+
+        // Call once per frame: swaps in a finished import and starts the next one for changes that settled.
+        void update();
+
+        [[nodiscard]] bool is_reloading() const { return m_job.valid(); }
+
+    private:
+        struct PreparedAsset {
+            std::string uri;
+            std::shared_ptr<ILoader> loader;
+            std::vector<char> derived_data; // Serialized import, empty if the loader runs at commit time
+        };
+
+        struct Job {
+            std::vector<PreparedAsset> assets; // Dependencies first
+        };
+
+        // Background thread: imports into a private database and serializes the result.
+        static void Prepare(Job &job, AssetManager &asset_manager);
+
+        void commit(Job &job);
+
+        AssetManager &m_asset_manager;
+        std::chrono::milliseconds m_debounce;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_pending; // Last notification per path
+        std::vector<std::string> m_settled; // Quiet long enough, waiting for the running import to finish
+        std::future<std::unique_ptr<Job> > m_job;
+    };
+}
@@ -7,6 +7,11 @@
 #include <vector>
 
 namespace RDE{
+    // Result of ILoader::decode, defined by each loader.
+    struct DecodedAsset {
+        virtual ~DecodedAsset() = default;
+    };
+
     class ILoader {
     public:
         virtual ~ILoader() = default;
@@ -24,6 +29,42 @@ namespace RDE{
                                    AssetDatabase& asset_database,
                                    AssetManager& asset_manager) const = 0;
 
+        // --- Batched reads ---
+        // Loaders that only need the bytes of the file let the AssetManager read it, which reads all files of a
+        // dependency stage in one asynchronous batch and hands each to its loader as soon as it arrived.
+        virtual bool loads_from_memory() const {
+            return false;
+        }
+
+        virtual AssetID load_asset_from_memory(const std::string& uri,
+                                               [[maybe_unused]] const char *data, [[maybe_unused]] size_t size,
+                                               AssetDatabase& asset_database,
+                                               AssetManager& asset_manager) const {
+            return load_asset(uri, asset_database, asset_manager);
+        }
+
+        // --- Concurrent decoding ---
+        // Loaders from memory whose expensive part is reentrant split it off: decode runs on worker threads, for many
+        // files at once, and must touch neither the database nor the AssetManager. create_asset then adds the result
+        // on the loading thread.
+        virtual bool decodes_concurrently() const {
+            return false;
+        }
+
+        // Returns nullptr on failure.
+        virtual std::unique_ptr<DecodedAsset> decode([[maybe_unused]] const std::string &uri,
+                                                     [[maybe_unused]] const char *data,
+                                                     [[maybe_unused]] size_t size) const {
+            return nullptr;
+        }
+
+        virtual AssetID create_asset([[maybe_unused]] const std::string &uri,
+                                     [[maybe_unused]] std::unique_ptr<DecodedAsset> decoded,
+                                     [[maybe_unused]] AssetDatabase &asset_database,
+                                     [[maybe_unused]] AssetManager &asset_manager) const {
+            return nullptr;
+        }
+
         // Optionally, you can provide a method to get the supported file extensions.
         virtual std::vector<std::string> get_supported_extensions() const = 0;
 
@@ -35,5 +76,42 @@ namespace RDE{
         virtual std::string get_expected_version() const {
             return "1.0"; // Default expected version
         }
+
+        // --- Derived data cache ---
+        // Loaders whose processing is expensive serialize their result, the AssetManager stores it in the
+        // DerivedDataCache and calls read_derived_data instead of load_asset while the source is unchanged.
+        // The HotReloader runs load_asset of these loaders on a background thread against a private database, so
+        // they must not use the AssetManager there.
+        virtual bool supports_derived_data() const {
+            return false;
+        }
+
+        // Everything besides the source content and version that changes the result, part of the cache key.
+        virtual std::string get_import_settings() const {
+            return {};
+        }
+
+        // Settings the loader derives from the source's path rather than its content, such as a texture classified
+        // as normal map by its file name. Part of the cache key as well, so copies of one file under different names
+        // don't share an entry.
+        virtual std::string get_path_settings([[maybe_unused]] const std::string &uri) const {
+            return {};
+        }
+
+        // Serializes the components load_asset created for asset_id.
+        virtual bool write_derived_data([[maybe_unused]] const AssetID &asset_id,
+                                        [[maybe_unused]] AssetDatabase &asset_database,
+                                        [[maybe_unused]] std::vector<char> &out) const {
+            return false;
+        }
+
+        // Recreates the asset from write_derived_data's bytes. Returns nullptr on invalid data, the AssetManager then
+        // falls back to load_asset.
+        virtual AssetID read_derived_data([[maybe_unused]] const std::string &uri,
+                                          [[maybe_unused]] const char *data, [[maybe_unused]] size_t size,
+                                          [[maybe_unused]] AssetDatabase &asset_database,
+                                          [[maybe_unused]] AssetManager &asset_manager) const {
+            return nullptr;
+        }
     };
 }
\ No newline at end of file
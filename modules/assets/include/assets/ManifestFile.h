@@ -0,0 +1,83 @@
+//assets/ManifestFile.h
+#pragma once
+
+#include "assets/AssetComponentTypes.h"
+#include "assets/DerivedDataCache.h"
+#include "core/Hash.h"
+#include "core/Log.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compiled form of the YAML manifests (.mat and .shaderdef). The YAML stays the authoring format, loaders compile it
+// once and keep the result in the derived data cache, later loads read it straight out of the mapped entry instead of
+// building a YAML node tree. Layout: header | records in declaration order, strings as a 32 bit length and the bytes.
+// The header carries the format version and the hash of the source it was compiled from, a compiled manifest is only
+// accepted for exactly that source. Files are written in native (little endian) byte order.
+namespace RDE::ManifestFile {
+    inline constexpr uint32_t VERSION = 1;
+
+    // A .mat manifest with its references as written in the file, relative to the asset path. The loader resolves
+    // them against the loaded assets.
+    struct Material {
+        struct Parameter {
+            std::string name;
+            uint32_t components = 1; // float, vec2, vec3 or vec4
+            float value[4] = {};
+        };
+
+        struct Texture {
+            std::string name;
+            std::string path;
+        };
+
+        std::string name;
+        std::string shader;
+        AssetPipelineDescription pipeline;
+        std::vector<Parameter> parameters;
+        std::vector<Texture> textures;
+    };
+
+    void Serialize(const Material &material, uint64_t source_hash, std::vector<char> &out);
+
+    void Serialize(const AssetShaderDef &shader_def, uint64_t source_hash, std::vector<char> &out);
+
+    // Validates the header against source_hash and every record against size. Returns false, fills error and leaves
+    // the output untouched on bad or stale data.
+    bool Deserialize(const char *data, size_t size, uint64_t source_hash, Material &material,
+                     std::string *error = nullptr);
+
+    bool Deserialize(const char *data, size_t size, uint64_t source_hash, AssetShaderDef &shader_def,
+                     std::string *error = nullptr);
+
+    // Reads the compiled form of the manifest source (data, size) from the cache, or calls compile(out) on a miss and
+    // stores its result. Returns false only if compile does.
+    template<typename T, typename Compile>
+    bool LoadOrCompile(DerivedDataCache &cache, const std::string &uri, const char *data, size_t size,
+                       const ILoader &loader, T &out, Compile &&compile) {
+        const uint64_t source_hash = Hash::Compute(data, size);
+        std::string key;
+        if (cache.is_open()) {
+            key = cache.make_key(source_hash, uri, loader);
+            MappedFile compiled;
+            if (cache.load(key, compiled)) {
+                std::string error;
+                if (Deserialize(compiled.data(), compiled.size(), source_hash, out, &error)) {
+                    return true;
+                }
+                RDE_CORE_WARN("Compiled manifest for '{}' rejected: {}", uri, error);
+            }
+        }
+
+        if (!compile(out)) {
+            return false;
+        }
+        if (!key.empty()) {
+            std::vector<char> compiled;
+            Serialize(out, source_hash, compiled);
+            cache.store(key, compiled);
+        }
+        return true;
+    }
+}
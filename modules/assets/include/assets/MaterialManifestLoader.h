@@ -3,6 +3,8 @@
 #include "assets/ILoader.h"
 
 namespace RDE{
+    // Loads .mat manifests. The YAML is compiled to a ManifestFile::Material once per source content and kept in the
+    // derived data cache, the references are resolved against the loaded assets on every load.
     class MaterialManifestLoader : public ILoader {
     public:
         MaterialManifestLoader() = default;
@@ -11,6 +13,14 @@ namespace RDE{
 
         AssetID load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const override;
 
+        bool loads_from_memory() const override { return true; }
+
+        AssetID load_asset_from_memory(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                       AssetManager &manager) const override;
+
         std::vector<std::string> get_supported_extensions() const override;
+
+        // The compiled manifest format version, part of the derived data key.
+        std::string get_import_settings() const override;
     };
 }
\ No newline at end of file
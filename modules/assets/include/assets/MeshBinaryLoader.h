@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ILoader.h"
+#include "AssetDatabase.h"
+#include "AssetManager.h"
+
+namespace RDE {
+    // Loads meshes baked with MeshFile::Write. The file already holds the optimized, meshletized geometry with
+    // normals and tangents, so no post-processing runs here. The material libraries of the source are its dependencies.
+    class MeshBinaryLoader : public ILoader {
+    public:
+        MeshBinaryLoader() = default;
+
+        std::vector<std::string> get_dependencies(const std::string &uri) const override;
+
+        AssetID load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const override;
+
+        std::vector<std::string> get_supported_extensions() const override;
+    };
+}
@@ -0,0 +1,33 @@
+//assets/MeshFile.h
+#pragma once
+
+#include "assets/AssetComponentTypes.h"
+
+#include <filesystem>
+
+// Engine native baked mesh format (.rdemesh). Stores every property array of an AssetCpuGeometry as
+// (container, name, type tag, element count, raw bytes) plus the subviews, material libraries and meshlet vertex list.
+// Layout: header | array table | subview table | library table | string blob | 64 byte aligned array payloads.
+// Reading maps the file and fills each array with a single bulk copy out of the mapping, so loading is bound by the
+// page cache and memcpy instead of text parsing. Files are written in native (little endian) byte order.
+// The in-memory variants are what the derived data cache stores for imported meshes.
+namespace RDE::MeshFile {
+    inline constexpr uint32_t VERSION = 2;
+    inline constexpr const char *EXTENSION = ".rdemesh";
+
+    // Arrays of types without a type tag (e.g. strings or custom structs) are skipped with a warning.
+    void Serialize(const AssetCpuGeometry &geometry, std::vector<char> &out);
+
+    // Validates every offset against size. Returns false, fills error and leaves geometry untouched on bad data.
+    bool Deserialize(const char *data, size_t size, AssetCpuGeometry &geometry, std::string *error = nullptr);
+
+    // Reads only AssetCpuGeometry::material_libraries, for dependency discovery. Touches the header and tables alone.
+    bool DeserializeMaterialLibraries(const char *data, size_t size, std::vector<std::string> &libraries,
+                                      std::string *error = nullptr);
+
+    // The file is written to a temporary next to path and renamed, so readers never see a partial file.
+    bool Write(const std::filesystem::path &path, const AssetCpuGeometry &geometry);
+
+    // Returns false and leaves geometry untouched on a missing, truncated or incompatible file.
+    bool Read(const std::filesystem::path &path, AssetCpuGeometry &geometry);
+}
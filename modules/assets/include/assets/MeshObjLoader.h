@@ -14,5 +14,15 @@ namespace RDE {
         AssetID load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const override;
 
         std::vector<std::string> get_supported_extensions() const override;
+
+        // The processed geometry is cached as an in-memory .rdemesh.
+        bool supports_derived_data() const override { return true; }
+
+        std::string get_import_settings() const override;
+
+        bool write_derived_data(const AssetID &asset_id, AssetDatabase &db, std::vector<char> &out) const override;
+
+        AssetID read_derived_data(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                  AssetManager &manager) const override;
     };
 }
\ No newline at end of file
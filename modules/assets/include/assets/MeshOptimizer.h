@@ -0,0 +1,54 @@
+//assets/MeshOptimizer.h
+#pragma once
+
+#include "assets/AssetComponentTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RDE::MeshOptimizer {
+    struct Settings {
+        bool optimize_vertex_cache = true; // Tipsify triangle order per subview
+        bool optimize_overdraw = true; // Sort the Tipsify clusters front-to-back-ish (needs v:point)
+        bool optimize_vertex_fetch = true; // Renumber vertices in first-use order
+        uint32_t cache_size = 16; // Post-transform cache size the triangle order targets
+    };
+
+    struct CacheStatistics {
+        float acmr = 0.0f; // Average cache miss ratio: vertex shader invocations per triangle (0.5 is ideal on large grids)
+        float atvr = 0.0f; // Average transformed vertex ratio: invocations per referenced vertex (1.0 is ideal)
+        size_t vertex_shader_invocations = 0;
+    };
+
+    struct Result {
+        CacheStatistics before;
+        CacheStatistics after;
+    };
+
+    struct FaceRange {
+        size_t first_face = 0;
+        size_t num_faces = 0;
+        int subview = -1; // Index into AssetCpuGeometry::subviews, -1 for a geometry without subviews
+    };
+
+    // Collects the face ranges of all valid subviews sorted by first_face, or the whole geometry if it has none.
+    // Returns false (and no ranges) if subviews overlap, since they can't be reordered independently then.
+    bool GetSubviewFaceRanges(const AssetCpuGeometry &geometry, std::vector<FaceRange> &ranges);
+
+    // Simulates a FIFO post-transform cache of cache_size entries over the f:tris index buffer.
+    CacheStatistics AnalyzeVertexCache(const AssetCpuGeometry &geometry, uint32_t cache_size = 16);
+
+    CacheStatistics AnalyzeVertexCache(const std::vector<uint32_t> &indices, size_t vertex_count,
+                                       uint32_t cache_size = 16);
+
+    // Reorders the triangles of [first_index, first_index + index_count) for vertex cache reuse (Tipsify).
+    // Writes the start of every cluster that begins after a cache flush into cluster_starts, relative to the range,
+    // in triangles. Returns the new order of the range's triangles as offsets relative to the range.
+    std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t> &indices, size_t first_index,
+                                              size_t index_count, uint32_t cache_size,
+                                              std::vector<uint32_t> *cluster_starts = nullptr);
+
+    // Reorders triangles (per subview, ranges stay intact) and then vertices of an imported mesh in place.
+    // Every face and vertex property is permuted along with f:tris.
+    Result Optimize(AssetCpuGeometry &geometry, const Settings &settings = {});
+}
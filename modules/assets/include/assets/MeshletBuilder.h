@@ -0,0 +1,45 @@
+//assets/MeshletBuilder.h
+#pragma once
+
+#include "assets/AssetComponentTypes.h"
+#include "geometry/Plane.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Splits the triangles of an imported mesh into small clusters (meshlets) that can be culled individually.
+// The result lives next to the other topology of AssetCpuGeometry:
+//   meshlets        "m:triangle_offset", "m:triangle_count" (uint32_t, range in faces)
+//                   "m:vertex_offset", "m:vertex_count" (uint32_t, range in meshlet_vertices)
+//                   "m:subview" (int), "m:bounding_sphere" (vec4: center, radius)
+//                   "m:cone_apex", "m:cone_axis" (vec3), "m:cone_cutoff" (float)
+//   faces           "f:meshlet" (uint32_t), "f:meshlet_tris" (uint32_t, three 8 bit meshlet-local vertex indices)
+//   meshlet_vertices  global vertex index of every meshlet-local vertex
+// Faces are reordered so every meshlet is a contiguous face range inside its subview.
+namespace RDE::MeshletBuilder {
+    struct Settings {
+        uint32_t max_vertices = 64; // At most 256, local indices are 8 bit
+        uint32_t max_triangles = 124; // 124 keeps the packed u8 index buffer of a meshlet below 512 bytes
+    };
+
+    struct Statistics {
+        size_t num_meshlets = 0;
+        float average_vertices = 0.0f;
+        float average_triangles = 0.0f;
+    };
+
+    // Builds the meshlets of every subview. Replaces meshlets that were built before.
+    Statistics Build(AssetCpuGeometry &geometry, const Settings &settings = {});
+
+    // Frustum and normal cone test of every meshlet. planes are in world space and use the convention of
+    // CalculateFrustumPlanes (inside if dot(normal, p) + distance >= 0), pass num_planes = 0 to skip the frustum test.
+    // The cone test is exact for rigid transforms with uniform scale.
+    void CullMeshlets(const AssetCpuGeometry &geometry, const glm::mat4 &model, const glm::vec3 &camera_position,
+                      const Plane *planes, size_t num_planes, std::vector<uint32_t> &visible_meshlets);
+
+    // Merges the face ranges of sorted visible meshlets into (index_offset, index_count) draw ranges.
+    std::vector<std::pair<uint32_t, uint32_t> > GetIndexRanges(const AssetCpuGeometry &geometry,
+                                                              const std::vector<uint32_t> &visible_meshlets);
+}
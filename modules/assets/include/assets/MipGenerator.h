@@ -0,0 +1,32 @@
+//assets/MipGenerator.h
+#pragma once
+
+#include "AssetComponentTypes.h"
+
+#include <string_view>
+
+// Mip chains for 8 bit textures. Every level is downsampled 2:1 from the previous one with a separable filter: rows are
+// converted to linear space (through a table for sRGB channels), filtered horizontally, combined vertically and
+// converted back. The weighted sums use SSE2 where available. Output rows of a level are split across threads, and the
+// calls for different textures are independent, so images can be processed in parallel as well.
+namespace RDE::MipGenerator {
+    enum class Filter {
+        Box, // 2x2 average, cheapest
+        Kaiser // Kaiser windowed sinc over 6x6 texels, keeps more detail and aliases less
+    };
+
+    // Levels of a full chain down to 1x1, level 0 included.
+    int GetLevelCount(int width, int height);
+
+    // Downsamples one level of width x height pixels into max(width / 2, 1) x max(height / 2, 1). If srgb is set, the
+    // color channels are filtered in linear space. Alpha (the last channel of 2 and 4 channel images) is always linear.
+    void Downsample(const unsigned char *src, int width, int height, int channels, bool srgb, Filter filter,
+                    unsigned char *dst);
+
+    // Replaces texture.mips with the full chain below texture.data.
+    void Generate(AssetGpuTexture &texture, Filter filter = Filter::Kaiser);
+
+    // Guess from the file name whether a texture holds data rather than color (normal, roughness, ... maps), which
+    // must not be filtered as sRGB.
+    bool IsLinearData(std::string_view path);
+}
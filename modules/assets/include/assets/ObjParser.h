@@ -0,0 +1,52 @@
+//assets/ObjParser.h
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Wavefront OBJ parser for large files. The file is memory mapped and split at line boundaries into one chunk per
+// worker, every chunk is parsed independently (numbers via std::from_chars) and the results are concatenated.
+// Supports v, vt, vn, f (v, v/vt, v//vn, v/vt/vn, negative indices), o, g, usemtl and mtllib. Everything else
+// (l, p, s, vertex colors, free-form geometry) is ignored. Polygons are fan triangulated.
+namespace RDE::ObjParser {
+    struct Corner {
+        int32_t position = -1; // 0-based, -1 if absent
+        int32_t texcoord = -1;
+        int32_t normal = -1;
+
+        bool operator==(const Corner &other) const = default;
+    };
+
+    // A run of triangles with the same object/group name and material. Groups are contiguous and in file order.
+    struct Group {
+        uint32_t first_triangle = 0;
+        uint32_t triangle_count = 0;
+        std::string name;
+        std::string material; // Empty if no usemtl preceded the group
+    };
+
+    struct ObjData {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> texcoords; // As stored in the file, V is not flipped
+        std::vector<glm::vec3> normals;
+        std::vector<Corner> corners; // Three per triangle, all indices validated
+        std::vector<Group> groups; // Only non-empty groups
+        std::vector<std::string> material_libraries; // mtllib entries as written in the file
+    };
+
+    // Returns false and fills error (with the line number) on malformed faces or out of range indices.
+    bool Parse(const char *data, size_t size, ObjData &out, std::string *error = nullptr);
+
+    bool ParseFile(const std::filesystem::path &path, ObjData &out, std::string *error = nullptr);
+
+    // Dependency pre-scan: collects the mtllib entries of the file header and stops at the first face, so only the
+    // first few pages of a mapped file are touched. mtllib statements after the first face are not found.
+    std::vector<std::string> ScanMaterialLibraries(const char *data, size_t size);
+
+    // Welds identical (position, texcoord, normal) corners with sharded open addressing tables. Writes one vertex
+    // index per corner into indices and returns the unique corners. The vertex order depends only on the input.
+    std::vector<Corner> WeldCorners(const std::vector<Corner> &corners, std::vector<uint32_t> &indices);
+}
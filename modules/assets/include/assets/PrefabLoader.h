@@ -0,0 +1,23 @@
+#pragma once
+
+#include "assets/ILoader.h"
+
+namespace RDE {
+    // Loads .prefab files into a Prefab component. The node tree is flattened depth first from the scene root, meshes
+    // and materials are resolved against the loaded assets, instances are created by PrefabUtils::Instantiate.
+    class PrefabLoader : public ILoader {
+    public:
+        PrefabLoader() = default;
+
+        std::vector<std::string> get_dependencies(const std::string &uri) const override;
+
+        AssetID load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const override;
+
+        bool loads_from_memory() const override { return true; }
+
+        AssetID load_asset_from_memory(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                       AssetManager &manager) const override;
+
+        std::vector<std::string> get_supported_extensions() const override;
+    };
+}
@@ -4,12 +4,22 @@
 #include "assets/ILoader.h"
 
 namespace RDE {
+    // Loads .shaderdef manifests. The YAML is compiled to its binary form once per source content and kept in the
+    // derived data cache, see ManifestFile.
     class ShaderDefLoader : public ILoader {
     public:
         std::vector<std::string> get_supported_extensions() const override;
 
+        // The compiled manifest format version, part of the derived data key.
+        std::string get_import_settings() const override;
+
         AssetID load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const override;
 
+        bool loads_from_memory() const override { return true; }
+
+        AssetID load_asset_from_memory(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                       AssetManager &manager) const override;
+
         std::vector<std::string> get_dependencies(const std::string &uri) const override;
     };
 }
\ No newline at end of file
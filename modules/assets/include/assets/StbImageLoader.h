@@ -4,16 +4,52 @@
 #include "assets/ILoader.h"
 #include "assets/AssetDatabase.h"
 #include "assets/AssetManager.h"
+#include "assets/BlockCompression.h"
 
 namespace RDE {
+    struct TextureImportSettings {
+        bool compress = true; // Encode data and mips to the format BlockCompression::ChooseFormat picks
+        BlockCompression::Quality quality = BlockCompression::Quality::Normal;
+    };
+
     class StbImageLoader final : public ILoader {
     public:
         StbImageLoader() = default;
 
+        explicit StbImageLoader(const TextureImportSettings &settings) : m_settings(settings) {}
+
         std::vector<std::string> get_dependencies(const std::string &uri) const override;
 
         AssetID load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const override;
 
+        bool loads_from_memory() const override { return true; }
+
+        AssetID load_asset_from_memory(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                       AssetManager &manager) const override;
+
+        // stb_image decodes are independent of each other once the flip is done by the loader.
+        bool decodes_concurrently() const override { return true; }
+
+        std::unique_ptr<DecodedAsset> decode(const std::string &uri, const char *data, size_t size) const override;
+
+        AssetID create_asset(const std::string &uri, std::unique_ptr<DecodedAsset> decoded, AssetDatabase &db,
+                             AssetManager &manager) const override;
+
         std::vector<std::string> get_supported_extensions() const override;
+
+        // Decoded pixels are cached, so compressed images are only decoded once.
+        bool supports_derived_data() const override { return true; }
+
+        std::string get_import_settings() const override;
+
+        std::string get_path_settings(const std::string &uri) const override;
+
+        bool write_derived_data(const AssetID &asset_id, AssetDatabase &db, std::vector<char> &out) const override;
+
+        AssetID read_derived_data(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                  AssetManager &manager) const override;
+
+    private:
+        TextureImportSettings m_settings;
     };
 } // namespace RDE```
@@ -0,0 +1,34 @@
+//assets/TangentSpace.h
+#pragma once
+
+#include "core/Properties.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// Vertex normals and tangents for indexed triangle meshes (v:point, v:texcoord, f:tris).
+// Faces are processed in parallel into per-face data, then every vertex gathers its incident corners through a
+// vertex -> corner table, so no two threads ever write the same vertex and no atomics are needed.
+namespace RDE::TangentSpace {
+    enum class NormalWeighting {
+        Area, // Sum of the unnormalized face normals
+        Angle // Face normals weighted by the corner angle, independent of the triangulation
+    };
+
+    void ComputeVertexNormals(const std::vector<glm::vec3> &positions, const std::vector<glm::ivec3> &triangles,
+                              std::vector<glm::vec3> &normals, NormalWeighting weighting = NormalWeighting::Angle);
+
+    // MikkTSpace style tangents: per face UV derivatives projected into the vertex normal's tangent plane, angle
+    // weighted and orthonormalized against the normal. w is the handedness, bitangent = w * cross(normal, tangent).
+    // Expects vertices that are already split at UV seams (as the OBJ importer does).
+    void ComputeVertexTangents(const std::vector<glm::vec3> &positions, const std::vector<glm::vec2> &texcoords,
+                               const std::vector<glm::vec3> &normals, const std::vector<glm::ivec3> &triangles,
+                               std::vector<glm::vec4> &tangents);
+
+    // Writes v:normal from v:point and f:tris. Returns false if one of them is missing.
+    bool ComputeNormals(PropertyContainer &vertices, const PropertyContainer &faces,
+                        NormalWeighting weighting = NormalWeighting::Angle);
+
+    // Writes v:tangent (vec4) from v:point, v:normal, v:texcoord and f:tris. Returns false if one of them is missing.
+    bool ComputeTangents(PropertyContainer &vertices, const PropertyContainer &faces);
+}
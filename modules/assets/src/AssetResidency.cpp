@@ -0,0 +1,93 @@
+#include "assets/AssetResidency.h"
+#include "assets/AssetComponentTypes.h"
+
+#include <algorithm>
+
+namespace RDE {
+    void AssetResidency::add(const std::string &uri, uint64_t cpu_bytes) {
+        auto [it, inserted] = m_entries.try_emplace(uri);
+        Entry &entry = it->second;
+        if (inserted) {
+            ++m_statistics.num_assets;
+        }
+        m_statistics.cpu_bytes = m_statistics.cpu_bytes - entry.cpu_bytes + cpu_bytes;
+        entry.cpu_bytes = cpu_bytes;
+        entry.last_use = ++m_use_counter;
+    }
+
+    void AssetResidency::remove(const std::string &uri) {
+        auto it = m_entries.find(uri);
+        if (it == m_entries.end()) {
+            return;
+        }
+        m_statistics.cpu_bytes -= it->second.cpu_bytes;
+        m_statistics.gpu_bytes -= it->second.gpu_bytes;
+        --m_statistics.num_assets;
+        m_entries.erase(it);
+    }
+
+    void AssetResidency::evicted(const std::string &uri) {
+        auto it = m_entries.find(uri);
+        if (it == m_entries.end()) {
+            return;
+        }
+        ++m_statistics.num_evicted;
+        m_statistics.evicted_bytes += it->second.cpu_bytes + it->second.gpu_bytes;
+        remove(uri);
+    }
+
+    void AssetResidency::touch(const std::string &uri) {
+        if (auto it = m_entries.find(uri); it != m_entries.end()) {
+            it->second.last_use = ++m_use_counter;
+        }
+    }
+
+    void AssetResidency::set_gpu_bytes(const std::string &uri, uint64_t bytes) {
+        if (auto it = m_entries.find(uri); it != m_entries.end()) {
+            m_statistics.gpu_bytes = m_statistics.gpu_bytes - it->second.gpu_bytes + bytes;
+            it->second.gpu_bytes = bytes;
+        }
+    }
+
+    std::vector<std::string> AssetResidency::get_eviction_order() const {
+        std::vector<std::pair<uint64_t, const std::string *> > by_use;
+        by_use.reserve(m_entries.size());
+        for (const auto &[uri, entry]: m_entries) {
+            by_use.emplace_back(entry.last_use, &uri);
+        }
+        std::sort(by_use.begin(), by_use.end());
+
+        std::vector<std::string> order;
+        order.reserve(by_use.size());
+        for (const auto &[last_use, uri]: by_use) {
+            order.push_back(*uri);
+        }
+        return order;
+    }
+
+    uint64_t AssetResidency::MeasureCpuBytes(const AssetDatabase &db, const AssetID &asset_id) {
+        const auto &registry = db.get_registry();
+        if (!asset_id || !registry.valid(asset_id->entity_id)) {
+            return 0;
+        }
+        const entt::entity entity = asset_id->entity_id;
+        uint64_t bytes = 0;
+        if (const auto *geometry = registry.try_get<AssetCpuGeometry>(entity)) {
+            bytes += geometry->vertices.total_size_bytes() + geometry->halfedges.total_size_bytes() +
+                    geometry->edges.total_size_bytes() + geometry->faces.total_size_bytes() +
+                    geometry->tets.total_size_bytes() + geometry->meshlets.total_size_bytes();
+            bytes += geometry->subviews.size() * sizeof(AssetGeometrySubView);
+            bytes += geometry->meshlet_vertices.size() * sizeof(uint32_t);
+        }
+        if (const auto *texture = registry.try_get<AssetGpuTexture>(entity)) {
+            bytes += texture->data.size();
+            for (const auto &mip: texture->mips) {
+                bytes += mip.data.size();
+            }
+        }
+        if (const auto *text = registry.try_get<AssetTextSource>(entity)) {
+            bytes += text->text.size();
+        }
+        return bytes;
+    }
+}
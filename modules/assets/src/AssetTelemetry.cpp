@@ -0,0 +1,211 @@
+#include "assets/AssetTelemetry.h"
+#include "core/Log.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace RDE {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        std::string EscapeJson(const std::string &text) {
+            std::string out;
+            out.reserve(text.size());
+            for (const char c: text) {
+                switch (c) {
+                    case '"': out += "\\\"";
+                        break;
+                    case '\\': out += "\\\\";
+                        break;
+                    case '\n': out += "\\n";
+                        break;
+                    case '\t': out += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            char buffer[8];
+                            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                            out += buffer;
+                        } else {
+                            out += c;
+                        }
+                }
+            }
+            return out;
+        }
+
+        std::string QuoteCsv(const std::string &text) {
+            std::string out = "\"";
+            for (const char c: text) {
+                out += c == '"' ? "\"\"" : std::string(1, c);
+            }
+            return out + '"';
+        }
+
+        const char *GetDerivedDataName(AssetTelemetry::DerivedData derived_data) {
+            switch (derived_data) {
+                case AssetTelemetry::DerivedData::Hit: return "hit";
+                case AssetTelemetry::DerivedData::Miss: return "miss";
+                default: return "none";
+            }
+        }
+
+        void WritePhasesJson(std::ofstream &out, const double (&seconds)[AssetTelemetry::NUM_PHASES]) {
+            for (size_t p = 0; p < AssetTelemetry::NUM_PHASES; ++p) {
+                out << "\"" << AssetTelemetry::GetPhaseName(static_cast<AssetTelemetry::Phase>(p)) << "_ms\": "
+                    << seconds[p] * 1000.0 << ", ";
+            }
+        }
+    }
+
+    double AssetTelemetry::AssetRecord::get_total_seconds() const {
+        double total = 0.0;
+        for (const double phase_seconds: seconds) {
+            total += phase_seconds;
+        }
+        return total;
+    }
+
+    void AssetTelemetry::Context::flush(Clock::time_point now) {
+        record->seconds[static_cast<size_t>(phase)] += std::chrono::duration<double>(now - start).count();
+        start = now;
+    }
+
+    AssetTelemetry::Context *&AssetTelemetry::GetCurrent() {
+        thread_local Context *current = nullptr;
+        return current;
+    }
+
+    AssetTelemetry::Scope::Scope(AssetRecord &record, Phase phase) : m_previous(GetCurrent()) {
+        const auto now = Clock::now();
+        if (m_previous) {
+            m_previous->flush(now);
+        }
+        m_context = Context{&record, phase, now};
+        GetCurrent() = &m_context;
+    }
+
+    AssetTelemetry::Scope::~Scope() {
+        const auto now = Clock::now();
+        m_context.flush(now);
+        GetCurrent() = m_previous;
+        if (m_previous) {
+            m_previous->start = now;
+        }
+    }
+
+    AssetTelemetry::ScopedPhase::ScopedPhase(Phase phase) : m_context(GetCurrent()) {
+        if (m_context) {
+            m_context->flush(Clock::now());
+            m_previous = m_context->phase;
+            m_context->phase = phase;
+        }
+    }
+
+    AssetTelemetry::ScopedPhase::~ScopedPhase() {
+        if (m_context) {
+            m_context->flush(Clock::now());
+            m_context->phase = m_previous;
+        }
+    }
+
+    void AssetTelemetry::AddBytesRead(uint64_t bytes) {
+        if (Context *context = GetCurrent()) {
+            context->record->bytes_read += bytes;
+        }
+    }
+
+    const char *AssetTelemetry::GetPhaseName(Phase phase) {
+        switch (phase) {
+            case Phase::Discovery: return "discovery";
+            case Phase::IO: return "io";
+            case Phase::Parse: return "parse";
+            case Phase::PostProcess: return "post_process";
+            case Phase::Commit: return "commit";
+            default: return "unknown";
+        }
+    }
+
+    void AssetTelemetry::submit(AssetRecord record) {
+        LoaderStatistics &statistics = m_loaders[record.loader];
+        ++statistics.num_assets;
+        statistics.num_failed += record.failed;
+        for (size_t p = 0; p < NUM_PHASES; ++p) {
+            statistics.seconds[p] += record.seconds[p];
+        }
+        statistics.bytes_read += record.bytes_read;
+        statistics.derived_data_hits += record.derived_data == DerivedData::Hit;
+        statistics.derived_data_misses += record.derived_data == DerivedData::Miss;
+        m_records.push_back(std::move(record));
+    }
+
+    void AssetTelemetry::clear() {
+        m_records.clear();
+        m_loaders.clear();
+        m_counters = {};
+    }
+
+    bool AssetTelemetry::write_json(const std::filesystem::path &path) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            RDE_CORE_ERROR("AssetTelemetry: Failed to open '{}'", path.string());
+            return false;
+        }
+        out << "{\n  \"counters\": {"
+            << "\"cache_hits\": " << m_counters.cache_hits
+            << ", \"cache_misses\": " << m_counters.cache_misses
+            << ", \"reloads\": " << m_counters.num_reloads
+            << ", \"max_read_queue_depth\": " << m_counters.max_read_queue_depth
+            << ", \"max_ready_queue_depth\": " << m_counters.max_ready_queue_depth
+            << ", \"max_decode_queue_depth\": " << m_counters.max_decode_queue_depth << "},\n";
+
+        out << "  \"loaders\": {";
+        bool first = true;
+        for (const auto &[loader, statistics]: m_loaders) {
+            out << (first ? "\n" : ",\n") << "    \"" << EscapeJson(loader) << "\": {";
+            WritePhasesJson(out, statistics.seconds);
+            out << "\"assets\": " << statistics.num_assets << ", \"failed\": " << statistics.num_failed
+                << ", \"bytes_read\": " << statistics.bytes_read
+                << ", \"derived_data_hits\": " << statistics.derived_data_hits
+                << ", \"derived_data_misses\": " << statistics.derived_data_misses << "}";
+            first = false;
+        }
+        out << "\n  },\n  \"assets\": [";
+
+        first = true;
+        for (const AssetRecord &record: m_records) {
+            out << (first ? "\n" : ",\n") << "    {\"uri\": \"" << EscapeJson(record.uri) << "\", \"loader\": \""
+                << EscapeJson(record.loader) << "\", ";
+            WritePhasesJson(out, record.seconds);
+            out << "\"total_ms\": " << record.get_total_seconds() * 1000.0
+                << ", \"bytes_read\": " << record.bytes_read
+                << ", \"derived_data\": \"" << GetDerivedDataName(record.derived_data)
+                << "\", \"failed\": " << (record.failed ? "true" : "false") << "}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+    bool AssetTelemetry::write_csv(const std::filesystem::path &path) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            RDE_CORE_ERROR("AssetTelemetry: Failed to open '{}'", path.string());
+            return false;
+        }
+        out << "uri,loader";
+        for (size_t p = 0; p < NUM_PHASES; ++p) {
+            out << ',' << GetPhaseName(static_cast<Phase>(p)) << "_ms";
+        }
+        out << ",total_ms,bytes_read,derived_data,failed\n";
+        for (const AssetRecord &record: m_records) {
+            out << QuoteCsv(record.uri) << ',' << QuoteCsv(record.loader);
+            for (const double phase_seconds: record.seconds) {
+                out << ',' << phase_seconds * 1000.0;
+            }
+            out << ',' << record.get_total_seconds() * 1000.0 << ',' << record.bytes_read << ','
+                << GetDerivedDataName(record.derived_data) << ',' << (record.failed ? 1 : 0) << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+}
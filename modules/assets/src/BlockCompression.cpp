@@ -0,0 +1,748 @@
+#include "assets/BlockCompression.h"
+#include "core/FileIOUtils.h"
+#include "core/ParallelFor.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define RDE_BCN_SSE2 1
+#endif
+
+namespace RDE::BlockCompression {
+    namespace {
+        // 16 pixels in row-major order, one array per channel (R, G, B, A) in the 0..255 range.
+        struct Block {
+            alignas(16) float channel[4][16];
+        };
+
+        using Palette = float[16][4];
+
+        constexpr int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        int GetRefinements(Quality quality) {
+            switch (quality) {
+                case Quality::Fast: return 0;
+                case Quality::Normal: return 1;
+                default: return 3;
+            }
+        }
+
+        // Color formats see gray images as RGB, BC4 and BC5 read the raw channels.
+        void LoadBlock(const unsigned char *pixels, int width, int height, int channels, bool expand_gray, int bx,
+                       int by, Block &block) {
+            for (int i = 0; i < 16; ++i) {
+                const int x = std::min(bx * 4 + (i & 3), width - 1);
+                const int y = std::min(by * 4 + (i >> 2), height - 1);
+                const unsigned char *p = pixels + (size_t(y) * size_t(width) + size_t(x)) * size_t(channels);
+                if (expand_gray && channels <= 2) {
+                    block.channel[0][i] = block.channel[1][i] = block.channel[2][i] = p[0];
+                    block.channel[3][i] = channels == 2 ? p[1] : 255.0f;
+                    continue;
+                }
+                for (int c = 0; c < 4; ++c) {
+                    block.channel[c][i] = c < channels ? float(p[c]) : (c == 3 ? 255.0f : 0.0f);
+                }
+            }
+        }
+
+        // Nearest palette entry per pixel over the first `channels` channels. Returns the summed squared error.
+        float FindIndices(const Block &block, int channels, const Palette &palette, int count, uint8_t *indices) {
+            float total = 0.0f;
+#ifdef RDE_BCN_SSE2
+            for (int group = 0; group < 16; group += 4) {
+                __m128 pixel[4];
+                for (int c = 0; c < channels; ++c) {
+                    pixel[c] = _mm_load_ps(&block.channel[c][group]);
+                }
+                __m128 best = _mm_set1_ps(FLT_MAX);
+                __m128i best_index = _mm_setzero_si128();
+                for (int i = 0; i < count; ++i) {
+                    __m128 distance = _mm_setzero_ps();
+                    for (int c = 0; c < channels; ++c) {
+                        const __m128 diff = _mm_sub_ps(pixel[c], _mm_set1_ps(palette[i][c]));
+                        distance = _mm_add_ps(distance, _mm_mul_ps(diff, diff));
+                    }
+                    const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+                    best = _mm_min_ps(distance, best);
+                    best_index = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(i)),
+                                              _mm_andnot_si128(closer, best_index));
+                }
+                alignas(16) int32_t index[4];
+                alignas(16) float error[4];
+                _mm_store_si128(reinterpret_cast<__m128i *>(index), best_index);
+                _mm_store_ps(error, best);
+                for (int k = 0; k < 4; ++k) {
+                    indices[group + k] = static_cast<uint8_t>(index[k]);
+                    total += error[k];
+                }
+            }
+#else
+            for (int p = 0; p < 16; ++p) {
+                float best = FLT_MAX;
+                for (int i = 0; i < count; ++i) {
+                    float distance = 0.0f;
+                    for (int c = 0; c < channels; ++c) {
+                        const float diff = block.channel[c][p] - palette[i][c];
+                        distance += diff * diff;
+                    }
+                    if (distance < best) {
+                        best = distance;
+                        indices[p] = static_cast<uint8_t>(i);
+                    }
+                }
+                total += best;
+            }
+#endif
+            return total;
+        }
+
+        // Line through the block's colors, clipped to the pixels' extent along it: the bounding box diagonal, or the
+        // principal axis found by power iteration on the covariance.
+        void FitLine(const Block &block, int channels, bool principal_axis, float e0[4], float e1[4]) {
+            float lo[4], hi[4];
+            for (int c = 0; c < channels; ++c) {
+                lo[c] = *std::min_element(block.channel[c], block.channel[c] + 16);
+                hi[c] = *std::max_element(block.channel[c], block.channel[c] + 16);
+                e0[c] = lo[c];
+                e1[c] = hi[c];
+            }
+            if (!principal_axis) {
+                return;
+            }
+
+            float mean[4] = {};
+            for (int c = 0; c < channels; ++c) {
+                for (int i = 0; i < 16; ++i) {
+                    mean[c] += block.channel[c][i];
+                }
+                mean[c] /= 16.0f;
+            }
+            float covariance[4][4] = {};
+            for (int i = 0; i < 16; ++i) {
+                for (int a = 0; a < channels; ++a) {
+                    for (int b = a; b < channels; ++b) {
+                        covariance[a][b] += (block.channel[a][i] - mean[a]) * (block.channel[b][i] - mean[b]);
+                    }
+                }
+            }
+            for (int a = 0; a < channels; ++a) {
+                for (int b = 0; b < a; ++b) {
+                    covariance[a][b] = covariance[b][a];
+                }
+            }
+
+            float axis[4];
+            for (int c = 0; c < channels; ++c) {
+                axis[c] = hi[c] - lo[c];
+            }
+            for (int iteration = 0; iteration < 8; ++iteration) {
+                float next[4] = {};
+                float largest = 0.0f;
+                for (int a = 0; a < channels; ++a) {
+                    for (int b = 0; b < channels; ++b) {
+                        next[a] += covariance[a][b] * axis[b];
+                    }
+                    largest = std::max(largest, std::abs(next[a]));
+                }
+                if (largest < 1e-6f) {
+                    break;
+                }
+                for (int c = 0; c < channels; ++c) {
+                    axis[c] = next[c] / largest;
+                }
+            }
+            float length = 0.0f;
+            for (int c = 0; c < channels; ++c) {
+                length += axis[c] * axis[c];
+            }
+            if (length < 1e-12f) {
+                return; // Uniform block, the bounding box is a point
+            }
+
+            float t_min = FLT_MAX, t_max = -FLT_MAX;
+            for (int i = 0; i < 16; ++i) {
+                float t = 0.0f;
+                for (int c = 0; c < channels; ++c) {
+                    t += (block.channel[c][i] - mean[c]) * axis[c];
+                }
+                t_min = std::min(t_min, t);
+                t_max = std::max(t_max, t);
+            }
+            for (int c = 0; c < channels; ++c) {
+                e0[c] = std::clamp(mean[c] + axis[c] * t_min / length, 0.0f, 255.0f);
+                e1[c] = std::clamp(mean[c] + axis[c] * t_max / length, 0.0f, 255.0f);
+            }
+        }
+
+        // Endpoints with the least squared error for fixed interpolation weights (0 at e0, 1 at e1).
+        // Returns false if all pixels use the same weight.
+        bool SolveEndpoints(const Block &block, int channels, const float *weights, float e0[4], float e1[4]) {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float xa[4] = {}, xb[4] = {};
+            for (int i = 0; i < 16; ++i) {
+                const float b = weights[i];
+                const float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < channels; ++c) {
+                    xa[c] += a * block.channel[c][i];
+                    xb[c] += b * block.channel[c][i];
+                }
+            }
+            const float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f) {
+                return false;
+            }
+            for (int c = 0; c < channels; ++c) {
+                e0[c] = std::clamp((bb * xa[c] - ab * xb[c]) / determinant, 0.0f, 255.0f);
+                e1[c] = std::clamp((aa * xb[c] - ab * xa[c]) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        // --- BC4: two 8 bit endpoints, 3 bit indices ---
+        void MakeBc4Palette(int r0, int r1, int palette[8]) {
+            palette[0] = r0;
+            palette[1] = r1;
+            if (r0 > r1) {
+                for (int i = 2; i < 8; ++i) {
+                    palette[i] = ((8 - i) * r0 + (i - 1) * r1 + 3) / 7;
+                }
+            } else {
+                for (int i = 2; i < 6; ++i) {
+                    palette[i] = ((6 - i) * r0 + (i - 1) * r1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        float GetBc4Weight(int index) {
+            return index == 0 ? 0.0f : index == 1 ? 1.0f : float(index - 1) / 7.0f;
+        }
+
+        float EncodeBc4Endpoints(const Block &block, float e0, float e1, int &r0, int &r1, uint8_t *indices) {
+            r0 = std::clamp(int(std::lround(e0)), 0, 255);
+            r1 = std::clamp(int(std::lround(e1)), 0, 255);
+            if (r0 < r1) {
+                std::swap(r0, r1);
+            }
+            int values[8];
+            MakeBc4Palette(r0, r1, values);
+            Palette palette{};
+            const int count = r0 == r1 ? 1 : 8;
+            for (int i = 0; i < count; ++i) {
+                palette[i][0] = float(values[i]);
+            }
+            return FindIndices(block, 1, palette, count, indices);
+        }
+
+        void EncodeBc4(const float *values, Quality quality, unsigned char *out) {
+            Block block;
+            std::memcpy(block.channel[0], values, sizeof(block.channel[0]));
+            const float lo = *std::min_element(values, values + 16);
+            const float hi = *std::max_element(values, values + 16);
+
+            int r0, r1;
+            uint8_t indices[16];
+            float error = EncodeBc4Endpoints(block, hi, lo, r0, r1, indices);
+            for (int iteration = 0; iteration < GetRefinements(quality) && error > 0.0f; ++iteration) {
+                float weights[16];
+                for (int i = 0; i < 16; ++i) {
+                    weights[i] = GetBc4Weight(indices[i]);
+                }
+                float e0[4], e1[4];
+                if (!SolveEndpoints(block, 1, weights, e0, e1)) {
+                    break;
+                }
+                int n0, n1;
+                uint8_t candidate[16];
+                const float candidate_error = EncodeBc4Endpoints(block, e0[0], e1[0], n0, n1, candidate);
+                if (candidate_error >= error) {
+                    break;
+                }
+                error = candidate_error;
+                r0 = n0;
+                r1 = n1;
+                std::memcpy(indices, candidate, sizeof(indices));
+            }
+
+            out[0] = static_cast<unsigned char>(r0);
+            out[1] = static_cast<unsigned char>(r1);
+            uint64_t bits = 0;
+            for (int i = 0; i < 16; ++i) {
+                bits |= uint64_t(indices[i]) << (3 * i);
+            }
+            for (int i = 0; i < 6; ++i) {
+                out[2 + i] = static_cast<unsigned char>(bits >> (8 * i));
+            }
+        }
+
+        // --- BC1: two RGB565 endpoints, 2 bit indices ---
+        uint16_t Pack565(const float color[3]) {
+            const int r = std::clamp(int(std::lround(color[0] * 31.0f / 255.0f)), 0, 31);
+            const int g = std::clamp(int(std::lround(color[1] * 63.0f / 255.0f)), 0, 63);
+            const int b = std::clamp(int(std::lround(color[2] * 31.0f / 255.0f)), 0, 31);
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void Unpack565(uint16_t packed, int color[3]) {
+            const int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+        }
+
+        // Index 0 and 1 are the endpoints, 2 and 3 the interpolated colors (BC3 always decodes four colors).
+        void MakeBc1Palette(uint16_t c0, uint16_t c1, bool four_colors, int palette[4][4]) {
+            Unpack565(c0, palette[0]);
+            Unpack565(c1, palette[1]);
+            for (int c = 0; c < 3; ++c) {
+                if (four_colors) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+                } else {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+            palette[0][3] = palette[1][3] = palette[2][3] = 255;
+            palette[3][3] = four_colors ? 255 : 0;
+        }
+
+        float GetBc1Weight(int index) {
+            constexpr float WEIGHTS[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+            return WEIGHTS[index];
+        }
+
+        float EncodeBc1Endpoints(const Block &block, const float e0[4], const float e1[4], uint16_t &c0, uint16_t &c1,
+                                 uint8_t *indices) {
+            c0 = Pack565(e0);
+            c1 = Pack565(e1);
+            // Four color mode needs c0 > c1, equal endpoints decode index 0 in both modes.
+            if (c0 < c1) {
+                std::swap(c0, c1);
+            }
+            int values[4][4];
+            MakeBc1Palette(c0, c1, true, values);
+            Palette palette{};
+            const int count = c0 == c1 ? 1 : 4;
+            for (int i = 0; i < count; ++i) {
+                for (int c = 0; c < 3; ++c) {
+                    palette[i][c] = float(values[i][c]);
+                }
+            }
+            return FindIndices(block, 3, palette, count, indices);
+        }
+
+        void EncodeBc1(const Block &block, Quality quality, unsigned char *out) {
+            float e0[4], e1[4];
+            FitLine(block, 3, quality != Quality::Fast, e0, e1);
+            if (quality == Quality::Fast) {
+                // Pull the box corners in a little, the extremes are usually outliers.
+                for (int c = 0; c < 3; ++c) {
+                    const float inset = (e1[c] - e0[c]) / 16.0f;
+                    e0[c] += inset;
+                    e1[c] -= inset;
+                }
+            }
+
+            uint16_t c0, c1;
+            uint8_t indices[16];
+            float error = EncodeBc1Endpoints(block, e0, e1, c0, c1, indices);
+            for (int iteration = 0; iteration < GetRefinements(quality) && error > 0.0f; ++iteration) {
+                float weights[16];
+                for (int i = 0; i < 16; ++i) {
+                    weights[i] = GetBc1Weight(indices[i]);
+                }
+                // The weights are relative to the swapped endpoints.
+                if (!SolveEndpoints(block, 3, weights, e0, e1)) {
+                    break;
+                }
+                uint16_t n0, n1;
+                uint8_t candidate[16];
+                const float candidate_error = EncodeBc1Endpoints(block, e0, e1, n0, n1, candidate);
+                if (candidate_error >= error) {
+                    break;
+                }
+                error = candidate_error;
+                c0 = n0;
+                c1 = n1;
+                std::memcpy(indices, candidate, sizeof(indices));
+            }
+
+            out[0] = static_cast<unsigned char>(c0);
+            out[1] = static_cast<unsigned char>(c0 >> 8);
+            out[2] = static_cast<unsigned char>(c1);
+            out[3] = static_cast<unsigned char>(c1 >> 8);
+            uint32_t bits = 0;
+            for (int i = 0; i < 16; ++i) {
+                bits |= uint32_t(indices[i]) << (2 * i);
+            }
+            for (int i = 0; i < 4; ++i) {
+                out[4 + i] = static_cast<unsigned char>(bits >> (8 * i));
+            }
+        }
+
+        // --- BC7 mode 6: RGBA endpoints of 7 bits plus a p-bit each, 4 bit indices ---
+        struct Bc7Endpoints {
+            int quantized[2][4];
+            int p_bit[2];
+        };
+
+        int GetBc7Value(const Bc7Endpoints &endpoints, int endpoint, int channel) {
+            return (endpoints.quantized[endpoint][channel] << 1) | endpoints.p_bit[endpoint];
+        }
+
+        void QuantizeBc7Endpoint(const float value[4], int p_bit, int quantized[4]) {
+            for (int c = 0; c < 4; ++c) {
+                quantized[c] = std::clamp(int(std::lround((value[c] - float(p_bit)) / 2.0f)), 0, 127);
+            }
+        }
+
+        float GetBc7QuantizationError(const float value[4], int p_bit) {
+            int quantized[4];
+            QuantizeBc7Endpoint(value, p_bit, quantized);
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                const float diff = float((quantized[c] << 1) | p_bit) - value[c];
+                error += diff * diff;
+            }
+            return error;
+        }
+
+        float EncodeBc7Candidate(const Block &block, const float e0[4], const float e1[4], int p0, int p1,
+                                 Bc7Endpoints &endpoints, uint8_t *indices) {
+            endpoints.p_bit[0] = p0;
+            endpoints.p_bit[1] = p1;
+            QuantizeBc7Endpoint(e0, p0, endpoints.quantized[0]);
+            QuantizeBc7Endpoint(e1, p1, endpoints.quantized[1]);
+            Palette palette;
+            for (int i = 0; i < 16; ++i) {
+                for (int c = 0; c < 4; ++c) {
+                    const int a = GetBc7Value(endpoints, 0, c), b = GetBc7Value(endpoints, 1, c);
+                    palette[i][c] = float(((64 - BC7_WEIGHTS[i]) * a + BC7_WEIGHTS[i] * b + 32) >> 6);
+                }
+            }
+            return FindIndices(block, 4, palette, 16, indices);
+        }
+
+        enum class PBits {
+            Nearest, // Per endpoint, whichever quantizes it better
+            Search, // All four combinations, by block error
+            Opaque // Both set, so alpha 255 stays exact
+        };
+
+        float EncodeBc7Endpoints(const Block &block, const float e0[4], const float e1[4], PBits p_bits,
+                                 Bc7Endpoints &endpoints, uint8_t *indices) {
+            if (p_bits == PBits::Opaque) {
+                return EncodeBc7Candidate(block, e0, e1, 1, 1, endpoints, indices);
+            }
+            if (p_bits == PBits::Nearest) {
+                const int p0 = GetBc7QuantizationError(e0, 1) < GetBc7QuantizationError(e0, 0) ? 1 : 0;
+                const int p1 = GetBc7QuantizationError(e1, 1) < GetBc7QuantizationError(e1, 0) ? 1 : 0;
+                return EncodeBc7Candidate(block, e0, e1, p0, p1, endpoints, indices);
+            }
+            float best = FLT_MAX;
+            for (int p = 0; p < 4; ++p) {
+                Bc7Endpoints candidate;
+                uint8_t candidate_indices[16];
+                const float error = EncodeBc7Candidate(block, e0, e1, p & 1, p >> 1, candidate, candidate_indices);
+                if (error < best) {
+                    best = error;
+                    endpoints = candidate;
+                    std::memcpy(indices, candidate_indices, 16);
+                }
+            }
+            return best;
+        }
+
+        class BitWriter {
+        public:
+            explicit BitWriter(unsigned char *out) : m_out(out) {
+                std::memset(m_out, 0, 16);
+            }
+
+            void write(uint32_t value, int bits) {
+                for (int i = 0; i < bits; ++i, ++m_position) {
+                    if (value & (1u << i)) {
+                        m_out[m_position >> 3] |= static_cast<unsigned char>(1u << (m_position & 7));
+                    }
+                }
+            }
+
+        private:
+            unsigned char *m_out;
+            int m_position = 0;
+        };
+
+        class BitReader {
+        public:
+            explicit BitReader(const unsigned char *in) : m_in(in) {
+            }
+
+            uint32_t read(int bits) {
+                uint32_t value = 0;
+                for (int i = 0; i < bits; ++i, ++m_position) {
+                    value |= uint32_t((m_in[m_position >> 3] >> (m_position & 7)) & 1) << i;
+                }
+                return value;
+            }
+
+        private:
+            const unsigned char *m_in;
+            int m_position = 0;
+        };
+
+        void EncodeBc7(const Block &block, Quality quality, unsigned char *out) {
+            const bool opaque = std::all_of(block.channel[3], block.channel[3] + 16,
+                                            [](float alpha) { return alpha == 255.0f; });
+            const PBits p_bits = opaque ? PBits::Opaque : quality == Quality::High ? PBits::Search : PBits::Nearest;
+            float e0[4], e1[4];
+            FitLine(block, 4, quality != Quality::Fast, e0, e1);
+
+            Bc7Endpoints endpoints;
+            uint8_t indices[16];
+            float error = EncodeBc7Endpoints(block, e0, e1, p_bits, endpoints, indices);
+            for (int iteration = 0; iteration < GetRefinements(quality) && error > 0.0f; ++iteration) {
+                float weights[16];
+                for (int i = 0; i < 16; ++i) {
+                    weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+                }
+                if (!SolveEndpoints(block, 4, weights, e0, e1)) {
+                    break;
+                }
+                Bc7Endpoints candidate;
+                uint8_t candidate_indices[16];
+                const float candidate_error = EncodeBc7Endpoints(block, e0, e1, p_bits, candidate, candidate_indices);
+                if (candidate_error >= error) {
+                    break;
+                }
+                error = candidate_error;
+                endpoints = candidate;
+                std::memcpy(indices, candidate_indices, sizeof(indices));
+            }
+
+            // The first index is stored without its top bit, which must be 0.
+            if (indices[0] & 8) {
+                std::swap(endpoints.quantized[0], endpoints.quantized[1]);
+                std::swap(endpoints.p_bit[0], endpoints.p_bit[1]);
+                for (auto &index: indices) {
+                    index = static_cast<uint8_t>(15 - index);
+                }
+            }
+
+            BitWriter writer(out);
+            writer.write(1u << 6, 7);
+            for (int c = 0; c < 4; ++c) {
+                writer.write(endpoints.quantized[0][c], 7);
+                writer.write(endpoints.quantized[1][c], 7);
+            }
+            writer.write(endpoints.p_bit[0], 1);
+            writer.write(endpoints.p_bit[1], 1);
+            writer.write(indices[0], 3);
+            for (int i = 1; i < 16; ++i) {
+                writer.write(indices[i], 4);
+            }
+        }
+
+        // --- Decoding, to RGBA8 pixels of one block ---
+        void DecodeBc1(const unsigned char *in, bool always_four_colors, unsigned char rgba[16][4]) {
+            const uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+            const uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+            int palette[4][4];
+            MakeBc1Palette(c0, c1, always_four_colors || c0 > c1, palette);
+            const uint32_t bits = uint32_t(in[4]) | (uint32_t(in[5]) << 8) | (uint32_t(in[6]) << 16) |
+                                  (uint32_t(in[7]) << 24);
+            for (int i = 0; i < 16; ++i) {
+                const int index = (bits >> (2 * i)) & 3;
+                for (int c = 0; c < 4; ++c) {
+                    rgba[i][c] = static_cast<unsigned char>(palette[index][c]);
+                }
+            }
+        }
+
+        void DecodeBc4(const unsigned char *in, int channel, unsigned char rgba[16][4]) {
+            int palette[8];
+            MakeBc4Palette(in[0], in[1], palette);
+            uint64_t bits = 0;
+            for (int i = 0; i < 6; ++i) {
+                bits |= uint64_t(in[2 + i]) << (8 * i);
+            }
+            for (int i = 0; i < 16; ++i) {
+                rgba[i][channel] = static_cast<unsigned char>(palette[(bits >> (3 * i)) & 7]);
+            }
+        }
+
+        void DecodeBc7(const unsigned char *in, unsigned char rgba[16][4]) {
+            if ((in[0] & 0x7f) != (1u << 6)) {
+                for (int i = 0; i < 16; ++i) {
+                    rgba[i][0] = 255;
+                    rgba[i][1] = 0;
+                    rgba[i][2] = 255;
+                    rgba[i][3] = 255;
+                }
+                return;
+            }
+            BitReader reader(in);
+            reader.read(7);
+            Bc7Endpoints endpoints;
+            for (int c = 0; c < 4; ++c) {
+                endpoints.quantized[0][c] = int(reader.read(7));
+                endpoints.quantized[1][c] = int(reader.read(7));
+            }
+            endpoints.p_bit[0] = int(reader.read(1));
+            endpoints.p_bit[1] = int(reader.read(1));
+            for (int i = 0; i < 16; ++i) {
+                const int weight = BC7_WEIGHTS[reader.read(i == 0 ? 3 : 4)];
+                for (int c = 0; c < 4; ++c) {
+                    const int a = GetBc7Value(endpoints, 0, c), b = GetBc7Value(endpoints, 1, c);
+                    rgba[i][c] = static_cast<unsigned char>(((64 - weight) * a + weight * b + 32) >> 6);
+                }
+            }
+        }
+    }
+
+    size_t GetCompressedSize(RAL::Format format, int width, int height) {
+        return size_t((width + 3) / 4) * size_t((height + 3) / 4) * RAL::get_block_size_of_format(format);
+    }
+
+    RAL::Format ChooseFormat(int channels, bool srgb, bool normal_map, bool has_alpha, Quality quality) {
+        if (normal_map) {
+            return RAL::Format::BC5_UNORM;
+        }
+        if (channels == 1 && !srgb) {
+            return RAL::Format::BC4_UNORM;
+        }
+        if (quality == Quality::Fast) {
+            if (has_alpha) {
+                return srgb ? RAL::Format::BC3_SRGB : RAL::Format::BC3_UNORM;
+            }
+            return srgb ? RAL::Format::BC1_RGB_SRGB : RAL::Format::BC1_RGB_UNORM;
+        }
+        return srgb ? RAL::Format::BC7_SRGB : RAL::Format::BC7_UNORM;
+    }
+
+    bool Compress(const unsigned char *pixels, int width, int height, int channels, RAL::Format format,
+                  Quality quality, unsigned char *out) {
+        const uint32_t block_size = RAL::get_block_size_of_format(format);
+        if (block_size == 0 || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+            return false;
+        }
+        const bool raw_channels = format == RAL::Format::BC4_UNORM || format == RAL::Format::BC5_UNORM;
+        const int blocks_x = (width + 3) / 4;
+        const int blocks_y = (height + 3) / 4;
+        const size_t grain = std::max<size_t>(1, 64 / size_t(blocks_x));
+
+        Parallel::For(size_t(blocks_y), grain, [&](size_t by) {
+            Block block;
+            for (int bx = 0; bx < blocks_x; ++bx) {
+                LoadBlock(pixels, width, height, channels, !raw_channels, bx, int(by), block);
+                unsigned char *dst = out + (by * size_t(blocks_x) + size_t(bx)) * block_size;
+                switch (format) {
+                    case RAL::Format::BC1_RGB_UNORM:
+                    case RAL::Format::BC1_RGB_SRGB:
+                        EncodeBc1(block, quality, dst);
+                        break;
+                    case RAL::Format::BC3_UNORM:
+                    case RAL::Format::BC3_SRGB:
+                        EncodeBc4(block.channel[3], quality, dst);
+                        EncodeBc1(block, quality, dst + 8);
+                        break;
+                    case RAL::Format::BC4_UNORM:
+                        EncodeBc4(block.channel[0], quality, dst);
+                        break;
+                    case RAL::Format::BC5_UNORM:
+                        EncodeBc4(block.channel[0], quality, dst);
+                        EncodeBc4(block.channel[1], quality, dst + 8);
+                        break;
+                    default:
+                        EncodeBc7(block, quality, dst);
+                        break;
+                }
+            }
+        });
+        return true;
+    }
+
+    bool Decompress(const unsigned char *blocks, int width, int height, RAL::Format format, unsigned char *rgba) {
+        const uint32_t block_size = RAL::get_block_size_of_format(format);
+        if (block_size == 0 || width <= 0 || height <= 0) {
+            return false;
+        }
+        const int blocks_x = (width + 3) / 4;
+        const int blocks_y = (height + 3) / 4;
+        for (int by = 0; by < blocks_y; ++by) {
+            for (int bx = 0; bx < blocks_x; ++bx) {
+                const unsigned char *in = blocks + (size_t(by) * size_t(blocks_x) + size_t(bx)) * block_size;
+                unsigned char pixels[16][4] = {};
+                for (auto &pixel: pixels) {
+                    pixel[3] = 255;
+                }
+                switch (format) {
+                    case RAL::Format::BC1_RGB_UNORM:
+                    case RAL::Format::BC1_RGB_SRGB:
+                        DecodeBc1(in, false, pixels);
+                        break;
+                    case RAL::Format::BC3_UNORM:
+                    case RAL::Format::BC3_SRGB:
+                        DecodeBc1(in + 8, true, pixels);
+                        DecodeBc4(in, 3, pixels);
+                        break;
+                    case RAL::Format::BC4_UNORM:
+                        DecodeBc4(in, 0, pixels);
+                        break;
+                    case RAL::Format::BC5_UNORM:
+                        DecodeBc4(in, 0, pixels);
+                        DecodeBc4(in + 8, 1, pixels);
+                        break;
+                    default:
+                        DecodeBc7(in, pixels);
+                        break;
+                }
+                for (int i = 0; i < 16; ++i) {
+                    const int x = bx * 4 + (i & 3), y = by * 4 + (i >> 2);
+                    if (x < width && y < height) {
+                        std::memcpy(rgba + (size_t(y) * size_t(width) + size_t(x)) * 4, pixels[i], 4);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool Compress(AssetGpuTexture &texture, RAL::Format format, Quality quality) {
+        if (texture.format != RAL::Format::UNKNOWN || texture.data.empty()) {
+            return false;
+        }
+        auto compress_level = [&](ByteBuffer &pixels, int width, int height) {
+            ByteBuffer blocks(GetCompressedSize(format, width, height));
+            if (!Compress(reinterpret_cast<const unsigned char *>(pixels.data()), width, height, texture.channels,
+                          format, quality, reinterpret_cast<unsigned char *>(blocks.data()))) {
+                return false;
+            }
+            pixels = std::move(blocks);
+            return true;
+        };
+        if (!compress_level(texture.data, texture.width, texture.height)) {
+            return false;
+        }
+        for (auto &mip: texture.mips) {
+            compress_level(mip.data, mip.width, mip.height);
+        }
+        texture.format = format;
+        return true;
+    }
+
+    bool IsNormalMap(std::string_view path) {
+        static constexpr std::string_view NORMAL_WORDS[] = {"normal", "normals", "normalmap", "nrm", "n"};
+        return FileIO::HasNameWord(path, NORMAL_WORDS);
+    }
+}
@@ -0,0 +1,66 @@
+#include "assets/DependencyCache.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+
+#include <cstring>
+
+namespace RDE {
+    std::vector<std::string> DependencyCache::get(const std::string &uri, const ILoader &loader) {
+        FileStat stat;
+        if (!VFS::Stat(uri, stat)) {
+            // Missing files are not cached, the loader reports them.
+            return loader.get_dependencies(uri);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(uri);
+            if (it != m_entries.end() && it->second.size == stat.size && it->second.mtime == stat.mtime) {
+                ++m_hits;
+                return it->second.dependencies;
+            }
+            ++m_misses;
+        }
+
+        // Scan outside of the lock, two threads racing for the same file just scan twice.
+        std::vector<std::string> dependencies = loader.get_dependencies(uri);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[uri] = Entry{stat.size, stat.mtime, dependencies};
+        return dependencies;
+    }
+
+    void DependencyCache::invalidate(const std::string &uri) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.erase(uri);
+    }
+
+    void DependencyCache::clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    std::string ExtractYamlBlock(std::string_view text, std::string_view key) {
+        const char *p = text.data();
+        const char *end = text.data() + text.size();
+        const char *block_begin = nullptr;
+        while (p < end) {
+            const char *line_end = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+            if (!line_end) {
+                line_end = end;
+            }
+            // Top level lines start in the first column, comments and blank lines don't end a block.
+            const bool top_level = p < line_end && *p != ' ' && *p != '\t' && *p != '#' && *p != '\r';
+            if (block_begin && top_level) {
+                return {block_begin, p};
+            }
+            if (!block_begin && top_level && size_t(line_end - p) > key.size() &&
+                std::string_view(p, key.size()) == key && p[key.size()] == ':') {
+                block_begin = p;
+            }
+            p = line_end + (line_end < end ? 1 : 0);
+        }
+        return block_begin ? std::string(block_begin, end) : std::string();
+    }
+}
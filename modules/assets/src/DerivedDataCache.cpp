@@ -0,0 +1,228 @@
+#include "assets/DerivedDataCache.h"
+#include "core/FileIOUtils.h"
+#include "core/Hash.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace RDE {
+    namespace {
+        constexpr const char *ENTRY_EXTENSION = ".ddc";
+
+        // Unique per store, so concurrent stores of one key, from this or another process sharing the cache, never
+        // write the same temporary. The last rename wins and every rename moves a complete file.
+        std::filesystem::path MakeTempPath(const std::filesystem::path &path) {
+            static const uint64_t process_nonce = (uint64_t(std::random_device{}()) << 32) | std::random_device{}();
+            static std::atomic<uint64_t> counter{0};
+            const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+            std::filesystem::path temp_path = path;
+            temp_path += "." + std::to_string(process_nonce) + "." + std::to_string(thread_hash) + "." +
+                    std::to_string(counter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+            return temp_path;
+        }
+    }
+
+    bool DerivedDataCache::open(const std::filesystem::path &root, uint64_t budget_bytes) {
+        std::error_code ec;
+        std::filesystem::create_directories(root, ec);
+        if (ec) {
+            RDE_CORE_ERROR("DerivedDataCache: Failed to create '{}': {}", root.string(), ec.message());
+            return false;
+        }
+
+        // Index the existing entries, their modification time is the last use of a previous run.
+        std::vector<std::pair<std::filesystem::file_time_type, std::pair<std::string, uint64_t> > > found;
+        for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec) || it->path().extension() != ENTRY_EXTENSION) {
+                continue;
+            }
+            const uint64_t size = it->file_size(ec);
+            const auto mtime = it->last_write_time(ec);
+            if (!ec) {
+                found.push_back({mtime, {it->path().stem().string(), size}});
+            }
+        }
+        std::sort(found.begin(), found.end());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_root = root;
+        m_budget = budget_bytes;
+        m_size = 0;
+        m_use_counter = 0;
+        m_entries.clear();
+        for (const auto &[mtime, entry]: found) {
+            m_entries[entry.first] = Entry{entry.second, ++m_use_counter};
+            m_size += entry.second;
+        }
+        RDE_CORE_INFO("DerivedDataCache: {} entries, {:.1f} MiB in '{}'", m_entries.size(),
+                      double(m_size) / (1024.0 * 1024.0), root.string());
+        evict();
+        return true;
+    }
+
+    void DerivedDataCache::close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_root.clear();
+        m_entries.clear();
+        m_source_hashes.clear();
+        m_size = 0;
+    }
+
+    std::string DerivedDataCache::make_key(const std::string &uri, const ILoader &loader) {
+        FileStat stat;
+        if (!VFS::Stat(uri, stat)) {
+            return {};
+        }
+
+        // Pack entries carry their content hash, loose files are hashed once per size and modification time.
+        uint64_t content_hash = stat.content_hash;
+        bool known = content_hash != 0;
+        if (!known) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_source_hashes.find(uri);
+            if (it != m_source_hashes.end() && it->second.size == stat.size && it->second.mtime == stat.mtime) {
+                content_hash = it->second.hash;
+                known = true;
+            }
+        }
+        if (!known) {
+            FileView file = VFS::Open(uri);
+            if (!file.is_open()) {
+                return {};
+            }
+            content_hash = Hash::Compute(file.data(), file.size());
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_source_hashes[uri] = SourceHash{stat.size, stat.mtime, content_hash};
+        }
+        return make_key(content_hash, uri, loader);
+    }
+
+    std::string DerivedDataCache::make_key(uint64_t content_hash, const std::string &uri, const ILoader &loader) {
+        uint64_t key = content_hash;
+        key = Hash::Combine(key, Hash::Compute(FileIO::GetExtension(uri)));
+        key = Hash::Combine(key, Hash::Compute(loader.get_expected_version()));
+        key = Hash::Combine(key, Hash::Compute(loader.get_import_settings()));
+        // Loaders without path settings keep their keys.
+        if (const std::string path_settings = loader.get_path_settings(uri); !path_settings.empty()) {
+            key = Hash::Combine(key, Hash::Compute(path_settings));
+        }
+        return Hash::ToHex(key);
+    }
+
+    std::filesystem::path DerivedDataCache::entry_path(const std::string &key) const {
+        // Two character fan out keeps directories small.
+        return m_root / key.substr(0, 2) / (key + ENTRY_EXTENSION);
+    }
+
+    bool DerivedDataCache::load(const std::string &key, MappedFile &out) {
+        std::filesystem::path path;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_root.empty() ? m_entries.end() : m_entries.find(key);
+            if (it == m_entries.end()) {
+                ++m_misses;
+                return false;
+            }
+            it->second.last_use = ++m_use_counter;
+            path = entry_path(key);
+        }
+
+        if (!out.open(path)) {
+            // Deleted behind our back, forget it.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (auto it = m_entries.find(key); it != m_entries.end()) {
+                m_size -= it->second.size;
+                m_entries.erase(it);
+            }
+            ++m_misses;
+            return false;
+        }
+        // Persist the use for the ordering of the next run.
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_hits;
+        return true;
+    }
+
+    bool DerivedDataCache::store(const std::string &key, const std::vector<char> &data) {
+        std::filesystem::path path;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_root.empty() || key.size() < 2) {
+                return false;
+            }
+            path = entry_path(key);
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        const std::filesystem::path temp_path = MakeTempPath(path);
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!out) {
+                RDE_CORE_WARN("DerivedDataCache: Failed to write '{}'", temp_path.string());
+                out.close();
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+        }
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec) {
+            RDE_CORE_WARN("DerivedDataCache: Failed to move '{}' into place: {}", path.string(), ec.message());
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry &entry = m_entries[key];
+        m_size = m_size - entry.size + data.size();
+        entry.size = data.size();
+        entry.last_use = ++m_use_counter;
+        evict();
+        return true;
+    }
+
+    void DerivedDataCache::set_budget(uint64_t budget_bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budget = budget_bytes;
+        evict();
+    }
+
+    void DerivedDataCache::evict() {
+        if (m_size <= m_budget) {
+            return;
+        }
+        std::vector<std::pair<uint64_t, std::string> > by_use;
+        by_use.reserve(m_entries.size());
+        for (const auto &[key, entry]: m_entries) {
+            by_use.emplace_back(entry.last_use, key);
+        }
+        std::sort(by_use.begin(), by_use.end());
+
+        // Leave some headroom so the next few stores don't evict again.
+        const uint64_t target = m_budget - m_budget / 10;
+        size_t evicted = 0;
+        for (const auto &[last_use, key]: by_use) {
+            if (m_size <= target) {
+                break;
+            }
+            std::error_code ec;
+            std::filesystem::remove(entry_path(key), ec);
+            m_size -= m_entries[key].size;
+            m_entries.erase(key);
+            ++evicted;
+        }
+        RDE_CORE_TRACE("DerivedDataCache: Evicted {} entries, {:.1f} MiB left", evicted,
+                       double(m_size) / (1024.0 * 1024.0));
+    }
+}
@@ -68,7 +68,7 @@ namespace RDE {
                 }
                 break;
             }
-            //TODO above, i still get two notifications... fix this somehow...
+            // A single save can still arrive as several notifications, the HotReloader coalesces them.
         }
 
     private:
@@ -0,0 +1,109 @@
+#include "assets/HotReloader.h"
+#include "core/Log.h"
+
+#include <algorithm>
+
+namespace RDE {
+    HotReloader::HotReloader(AssetManager &asset_manager, std::chrono::milliseconds debounce)
+        : m_asset_manager(asset_manager), m_debounce(debounce) {
+    }
+
+    HotReloader::~HotReloader() {
+        if (m_job.valid()) {
+            m_job.wait();
+        }
+    }
+
+    void HotReloader::on_file_changed(const std::string &path) {
+        m_pending[path] = std::chrono::steady_clock::now();
+    }
+
+    void HotReloader::update() {
+        const auto now = std::chrono::steady_clock::now();
+        for (auto it = m_pending.begin(); it != m_pending.end();) {
+            if (now - it->second >= m_debounce) {
+                if (std::find(m_settled.begin(), m_settled.end(), it->first) == m_settled.end()) {
+                    m_settled.push_back(it->first);
+                }
+                it = m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (m_job.valid()) {
+            if (m_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return;
+            }
+            std::unique_ptr<Job> job = m_job.get();
+            commit(*job);
+        }
+
+        if (m_settled.empty()) {
+            return;
+        }
+        const std::vector<std::string> uris = m_asset_manager.collect_reload_set(m_settled);
+        m_settled.clear();
+        if (uris.empty()) {
+            return;
+        }
+
+        auto job = std::make_unique<Job>();
+        for (const auto &uri: uris) {
+            if (auto loader = m_asset_manager.find_loader(uri)) {
+                job->assets.push_back({uri, std::move(loader), {}});
+            }
+        }
+        RDE_CORE_INFO("HotReloader: Reloading {} assets.", job->assets.size());
+        m_job = std::async(std::launch::async, [job = std::move(job), &asset_manager = m_asset_manager]() mutable {
+            Prepare(*job, asset_manager);
+            return std::move(job);
+        });
+    }
+
+    void HotReloader::Prepare(Job &job, AssetManager &asset_manager) {
+        // Only loaders with derived data can run here: they don't touch the AssetManager and their result can be
+        // carried to the main thread as bytes. The others are cheap manifests and load at commit time.
+        DerivedDataCache &derived_data_cache = asset_manager.get_derived_data_cache();
+        for (auto &asset: job.assets) {
+            if (!asset.loader->supports_derived_data()) {
+                continue;
+            }
+            // Keyed before the import: a save landing during it must not file the older import under the newer
+            // content. The watcher reloads that save again.
+            const std::string key = derived_data_cache.is_open()
+                                        ? derived_data_cache.make_key(asset.uri, *asset.loader)
+                                        : std::string();
+            try {
+                AssetDatabase staging;
+                AssetID id = asset.loader->load_asset(asset.uri, staging, asset_manager);
+                if (!id || !asset.loader->write_derived_data(id, staging, asset.derived_data)) {
+                    asset.derived_data.clear();
+                    continue;
+                }
+            } catch (const std::exception &e) {
+                RDE_CORE_ERROR("HotReloader: Failed to import '{}': {}", asset.uri, e.what());
+                asset.derived_data.clear();
+                continue;
+            }
+            // The next start picks the new import up as well.
+            if (!key.empty()) {
+                derived_data_cache.store(key, asset.derived_data);
+            }
+        }
+    }
+
+    void HotReloader::commit(Job &job) {
+        size_t num_failed = 0;
+        for (auto &asset: job.assets) {
+            const bool prepared = !asset.derived_data.empty();
+            if (!m_asset_manager.reload_asset(asset.uri, prepared ? &asset.derived_data : nullptr)) {
+                ++num_failed;
+            }
+        }
+        if (num_failed > 0) {
+            RDE_CORE_WARN("HotReloader: {} of {} assets failed to reload and kept their previous version.", num_failed,
+                          job.assets.size());
+        }
+    }
+}
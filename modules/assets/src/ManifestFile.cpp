@@ -0,0 +1,362 @@
+#include "assets/ManifestFile.h"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace RDE::ManifestFile {
+    namespace {
+        constexpr char MAGIC[8] = {'R', 'D', 'E', 'M', 'A', 'N', 'I', 'F'};
+
+        enum class Kind : uint32_t {
+            Material = 1,
+            ShaderDef = 2
+        };
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            Kind kind;
+            uint64_t source_hash;
+            uint64_t file_size;
+        };
+
+        static_assert(sizeof(Header) == 32);
+
+        class Writer {
+        public:
+            Writer(std::vector<char> &out, Kind kind, uint64_t source_hash) : m_out(out) {
+                Header header{};
+                std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+                header.version = VERSION;
+                header.kind = kind;
+                header.source_hash = source_hash;
+                m_out.clear();
+                put(header);
+            }
+
+            // Patches the final size into the header.
+            void finish() {
+                const uint64_t file_size = m_out.size();
+                std::memcpy(m_out.data() + offsetof(Header, file_size), &file_size, sizeof(file_size));
+            }
+
+            template<typename T>
+            void put(const T &value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const auto *bytes = reinterpret_cast<const char *>(&value);
+                m_out.insert(m_out.end(), bytes, bytes + sizeof(T));
+            }
+
+            template<typename E>
+            void put_enum(E value) {
+                put(static_cast<uint32_t>(value));
+            }
+
+            void put(const std::string &text) {
+                put(static_cast<uint32_t>(text.size()));
+                m_out.insert(m_out.end(), text.begin(), text.end());
+            }
+
+            void put(const std::optional<std::string> &text) {
+                put(static_cast<uint8_t>(text.has_value()));
+                if (text) {
+                    put(*text);
+                }
+            }
+
+            void put(const std::vector<std::string> &texts) {
+                put(static_cast<uint32_t>(texts.size()));
+                for (const auto &text: texts) {
+                    put(text);
+                }
+            }
+
+        private:
+            std::vector<char> &m_out;
+        };
+
+        // Bounds checked cursor over the records, every get fails once one read past the end.
+        class Reader {
+        public:
+            Reader(const char *data, size_t size) : m_cursor(data), m_end(data + size) {
+            }
+
+            template<typename T>
+            bool get(T &value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                if (size_t(m_end - m_cursor) < sizeof(T)) {
+                    return m_valid = false;
+                }
+                std::memcpy(&value, m_cursor, sizeof(T));
+                m_cursor += sizeof(T);
+                return true;
+            }
+
+            template<typename E>
+            bool get_enum(E &value) {
+                uint32_t raw = 0;
+                if (!get(raw)) {
+                    return false;
+                }
+                value = static_cast<E>(raw);
+                return true;
+            }
+
+            bool get(std::string &text) {
+                uint32_t length = 0;
+                if (!get(length)) {
+                    return false;
+                }
+                if (size_t(m_end - m_cursor) < length) {
+                    return m_valid = false;
+                }
+                text.assign(m_cursor, length);
+                m_cursor += length;
+                return true;
+            }
+
+            bool get(std::optional<std::string> &text) {
+                uint8_t present = 0;
+                if (!get(present)) {
+                    return false;
+                }
+                text.reset();
+                return !present || get(text.emplace());
+            }
+
+            bool get(std::vector<std::string> &texts) {
+                uint32_t count = 0;
+                if (!get_count(count)) {
+                    return false;
+                }
+                texts.resize(count);
+                for (auto &text: texts) {
+                    get(text);
+                }
+                return m_valid;
+            }
+
+            // Counts are checked against the remaining bytes, so a corrupt count cannot allocate huge vectors.
+            bool get_count(uint32_t &count) {
+                if (!get(count)) {
+                    return false;
+                }
+                if (count > size_t(m_end - m_cursor)) {
+                    return m_valid = false;
+                }
+                return true;
+            }
+
+            [[nodiscard]] bool valid() const { return m_valid; }
+
+            [[nodiscard]] bool at_end() const { return m_cursor == m_end; }
+
+        private:
+            const char *m_cursor;
+            const char *m_end;
+            bool m_valid = true;
+        };
+
+        // Returns a reader positioned behind the header, or fails with the reason.
+        bool ReadHeader(const char *data, size_t size, Kind kind, uint64_t source_hash, std::string *error,
+                        Reader &reader) {
+            auto fail = [&](std::string reason) {
+                if (error) {
+                    *error = std::move(reason);
+                }
+                return false;
+            };
+            Header header;
+            if (size < sizeof(Header)) {
+                return fail("too small to be a compiled manifest");
+            }
+            std::memcpy(&header, data, sizeof(Header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.kind != kind) {
+                return fail("not a compiled manifest of this kind");
+            }
+            if (header.version != VERSION) {
+                return fail("version " + std::to_string(header.version) + ", expected " + std::to_string(VERSION));
+            }
+            if (header.source_hash != source_hash) {
+                return fail("compiled from a different source");
+            }
+            if (header.file_size != size) {
+                return fail("truncated");
+            }
+            reader = Reader(data + sizeof(Header), size - sizeof(Header));
+            return true;
+        }
+    }
+
+    void Serialize(const Material &material, uint64_t source_hash, std::vector<char> &out) {
+        Writer writer(out, Kind::Material, source_hash);
+        writer.put(material.name);
+        writer.put(material.shader);
+        writer.put_enum(material.pipeline.cullMode);
+        writer.put_enum(material.pipeline.polygonMode);
+        writer.put(static_cast<uint8_t>(material.pipeline.depthTest));
+        writer.put(static_cast<uint8_t>(material.pipeline.depthWrite));
+
+        writer.put(static_cast<uint32_t>(material.parameters.size()));
+        for (const auto &parameter: material.parameters) {
+            writer.put(parameter.name);
+            writer.put(parameter.components);
+            writer.put(parameter.value);
+        }
+        writer.put(static_cast<uint32_t>(material.textures.size()));
+        for (const auto &texture: material.textures) {
+            writer.put(texture.name);
+            writer.put(texture.path);
+        }
+        writer.finish();
+    }
+
+    void Serialize(const AssetShaderDef &shader_def, uint64_t source_hash, std::vector<char> &out) {
+        Writer writer(out, Kind::ShaderDef, source_hash);
+        writer.put(shader_def.name);
+        writer.put(shader_def.dependencies.spirv_dependencies);
+        writer.put(shader_def.dependencies.source_dependencies);
+        writer.put(shader_def.dependencies.include_dependencies);
+        writer.put(shader_def.features);
+
+        writer.put(static_cast<uint32_t>(shader_def.vertexAttributes.size()));
+        for (const auto &attribute: shader_def.vertexAttributes) {
+            writer.put(attribute.location);
+            writer.put(attribute.binding);
+            writer.put_enum(attribute.format);
+            writer.put(attribute.offset);
+            writer.put(attribute.name);
+            writer.put(attribute.required_feature);
+        }
+        writer.put(static_cast<uint32_t>(shader_def.descriptorSetLayouts.size()));
+        for (const auto &layout: shader_def.descriptorSetLayouts) {
+            writer.put(layout.set);
+            writer.put(static_cast<uint32_t>(layout.bindings.size()));
+            for (const auto &binding: layout.bindings) {
+                writer.put(binding.binding);
+                writer.put_enum(binding.type);
+                writer.put_enum(binding.stages);
+                writer.put(binding.name);
+                writer.put(binding.required_feature);
+            }
+        }
+        writer.put(static_cast<uint32_t>(shader_def.pushConstantRanges.size()));
+        for (const auto &range: shader_def.pushConstantRanges) {
+            writer.put_enum(range.stages);
+            writer.put(range.offset);
+            writer.put(range.size);
+            writer.put(range.name);
+        }
+        writer.finish();
+    }
+
+    bool Deserialize(const char *data, size_t size, uint64_t source_hash, Material &material, std::string *error) {
+        Reader reader(nullptr, 0);
+        if (!ReadHeader(data, size, Kind::Material, source_hash, error, reader)) {
+            return false;
+        }
+
+        Material result;
+        uint8_t depth_test = 0;
+        uint8_t depth_write = 0;
+        reader.get(result.name);
+        reader.get(result.shader);
+        reader.get_enum(result.pipeline.cullMode);
+        reader.get_enum(result.pipeline.polygonMode);
+        reader.get(depth_test);
+        reader.get(depth_write);
+        result.pipeline.depthTest = depth_test != 0;
+        result.pipeline.depthWrite = depth_write != 0;
+
+        uint32_t count = 0;
+        if (reader.get_count(count)) {
+            result.parameters.resize(count);
+            for (auto &parameter: result.parameters) {
+                reader.get(parameter.name);
+                reader.get(parameter.components);
+                reader.get(parameter.value);
+            }
+        }
+        if (reader.get_count(count)) {
+            result.textures.resize(count);
+            for (auto &texture: result.textures) {
+                reader.get(texture.name);
+                reader.get(texture.path);
+            }
+        }
+
+        if (!reader.valid() || !reader.at_end()) {
+            if (error) {
+                *error = "invalid records";
+            }
+            return false;
+        }
+        material = std::move(result);
+        return true;
+    }
+
+    bool Deserialize(const char *data, size_t size, uint64_t source_hash, AssetShaderDef &shader_def,
+                     std::string *error) {
+        Reader reader(nullptr, 0);
+        if (!ReadHeader(data, size, Kind::ShaderDef, source_hash, error, reader)) {
+            return false;
+        }
+
+        AssetShaderDef result;
+        reader.get(result.name);
+        reader.get(result.dependencies.spirv_dependencies);
+        reader.get(result.dependencies.source_dependencies);
+        reader.get(result.dependencies.include_dependencies);
+        reader.get(result.features);
+
+        uint32_t count = 0;
+        if (reader.get_count(count)) {
+            result.vertexAttributes.resize(count);
+            for (auto &attribute: result.vertexAttributes) {
+                reader.get(attribute.location);
+                reader.get(attribute.binding);
+                reader.get_enum(attribute.format);
+                reader.get(attribute.offset);
+                reader.get(attribute.name);
+                reader.get(attribute.required_feature);
+            }
+        }
+        if (reader.get_count(count)) {
+            result.descriptorSetLayouts.resize(count);
+            for (auto &layout: result.descriptorSetLayouts) {
+                uint32_t binding_count = 0;
+                reader.get(layout.set);
+                if (!reader.get_count(binding_count)) {
+                    break;
+                }
+                layout.bindings.resize(binding_count);
+                for (auto &binding: layout.bindings) {
+                    reader.get(binding.binding);
+                    reader.get_enum(binding.type);
+                    reader.get_enum(binding.stages);
+                    reader.get(binding.name);
+                    reader.get(binding.required_feature);
+                }
+            }
+        }
+        if (reader.get_count(count)) {
+            result.pushConstantRanges.resize(count);
+            for (auto &range: result.pushConstantRanges) {
+                reader.get_enum(range.stages);
+                reader.get(range.offset);
+                reader.get(range.size);
+                reader.get(range.name);
+            }
+        }
+
+        if (!reader.valid() || !reader.at_end()) {
+            if (error) {
+                *error = "invalid records";
+            }
+            return false;
+        }
+        shader_def = std::move(result);
+        return true;
+    }
+}
@@ -1,114 +1,174 @@
 #include "assets/MaterialManifestLoader.h"
 #include "assets/AssetComponentTypes.h"
 #include "assets/AssetManager.h"
+#include "assets/AssetTelemetry.h"
+#include "assets/DependencyCache.h"
+#include "assets/ManifestFile.h"
 #include "material/MaterialDescription.h"
 #include "ral/EnumUtils.h"
+#include "core/VirtualFileSystem.h"
 
 #include <yaml-cpp/yaml.h>
+#include <algorithm>
 
 namespace RDE {
+    namespace {
+        // Parses the authoring form into the compiled one, references stay as written.
+        bool CompileMaterial(const std::string &uri, const char *data, size_t size, const ILoader &loader,
+                             ManifestFile::Material &material) {
+            YAML::Node doc;
+            try {
+                doc = YAML::Load(std::string(data, size));
+            } catch (const YAML::Exception &e) {
+                RDE_CORE_ERROR("Failed to load/parse material manifest '{}': {}", uri, e.what());
+                return false;
+            }
+
+            // --- Version & Name Parsing ---
+            if (doc["version"] && !loader.check_version(doc["version"].as<std::string>())) {
+                RDE_CORE_WARN("Material '{}' has unsupported version. Expected {}", uri, loader.get_expected_version());
+                // Decide if this should be a fatal error
+            }
+
+            if (doc["name"]) {
+                material.name = doc["name"].as<std::string>();
+            } else {
+                material.name = std::filesystem::path(uri).stem().string();
+            }
+
+            // --- Dependency Linking ---
+            if (doc["dependencies"] && doc["dependencies"]["shaders"]) {
+                // A material should only depend on ONE shader definition
+                material.shader = doc["dependencies"]["shaders"][0].as<std::string>();
+            } else {
+                RDE_CORE_ERROR("Material '{}' is missing shader dependency.", uri);
+                return false;
+            }
+
+            // --- Pipeline State Parsing ---
+            if (const auto &pipelineNode = doc["pipeline"]) {
+                if (pipelineNode["cullMode"]) {
+                    material.pipeline.cullMode = string_to_cull_mode(pipelineNode["cullMode"].as<std::string>());
+                }
+                if (pipelineNode["polygonMode"]) {
+                    material.pipeline.polygonMode =
+                            string_to_polygon_mode(pipelineNode["polygonMode"].as<std::string>());
+                }
+                if (pipelineNode["depthTest"]) {
+                    material.pipeline.depthTest = pipelineNode["depthTest"].as<bool>();
+                }
+                if (pipelineNode["depthWrite"]) {
+                    material.pipeline.depthWrite = pipelineNode["depthWrite"].as<bool>();
+                }
+            }
+
+            // --- Parameter Parsing ---
+            if (const auto &paramsNode = doc["parameters"]) {
+                for (const auto &paramNode: paramsNode) {
+                    ManifestFile::Material::Parameter parameter;
+                    parameter.name = paramNode["name"].as<std::string>();
+                    const auto param_type = paramNode["type"].as<std::string>();
+                    const auto &valueNode = paramNode["value"];
+
+                    if (param_type == "float") {
+                        parameter.components = 1;
+                        parameter.value[0] = valueNode.as<float>();
+                    } else if (param_type == "vec2" || param_type == "vec3" || param_type == "vec4") {
+                        parameter.components = static_cast<uint32_t>(param_type.back() - '0');
+                        auto v = valueNode.as<std::vector<float> >();
+                        if (v.size() < parameter.components) {
+                            RDE_CORE_WARN("Parameter '{}' in '{}' has {} values, expected {}", parameter.name, uri,
+                                          v.size(), parameter.components);
+                            continue;
+                        }
+                        std::copy_n(v.begin(), parameter.components, parameter.value);
+                    } else {
+                        RDE_CORE_WARN("Unsupported parameter type '{}' in '{}'", param_type, uri);
+                        continue;
+                    }
+                    material.parameters.push_back(std::move(parameter));
+                }
+            }
+
+            // --- Texture Linking ---
+            if (doc["dependencies"]["textures"] && doc["textures"]) {
+                const auto &texture_deps = doc["dependencies"]["textures"];
+                for (const auto &textureNode: doc["textures"]) {
+                    const auto texture_name = textureNode["name"].as<std::string>();
+                    size_t idx = textureNode["index"].as<int>();
+
+                    if (idx < texture_deps.size()) {
+                        material.textures.push_back({texture_name, texture_deps[idx].as<std::string>()});
+                    } else {
+                        RDE_CORE_WARN("Texture index {} out of bounds for '{}' in '{}'", idx, texture_name, uri);
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
     std::vector<std::string> MaterialManifestLoader::get_supported_extensions() const {
         return {".mat"}; // Supported extensions for material manifests
     }
 
+    std::string MaterialManifestLoader::get_import_settings() const {
+        return "manifest=" + std::to_string(ManifestFile::VERSION);
+    }
+
     // This loader is responsible for reading the final .mat manifest
     AssetID MaterialManifestLoader::load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const {
-        YAML::Node doc;
-        try {
-            doc = YAML::LoadFile(uri);
-        } catch (const YAML::Exception &e) {
-            RDE_CORE_ERROR("Failed to load/parse material manifest '{}': {}", uri, e.what());
-            return nullptr;
-        }
-
-        // --- Data objects we will populate ---
-        MaterialDescription material;
-        AssetPipelineDescription pipelineDesc;
-        std::string assetName;
-
-        // --- Version & Name Parsing ---
-        if (doc["version"] && !check_version(doc["version"].as<std::string>())) {
-            RDE_CORE_WARN("Material '{}' has unsupported version. Expected {}", uri, get_expected_version());
-            // Decide if this should be a fatal error
+        FileView file;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            file = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(file.size());
         }
-
-        if (doc["name"]) {
-            assetName = doc["name"].as<std::string>();
-        } else {
-            assetName = std::filesystem::path(uri).stem().string();
-        }
-        material.name = assetName;
-
-        // --- Dependency Linking ---
-        if (doc["dependencies"] && doc["dependencies"]["shaders"]) {
-            // A material should only depend on ONE shader definition
-            auto asset_path = get_asset_path();
-            const auto shader_def_path = asset_path.value() / doc["dependencies"]["shaders"][0].as<std::string>();
-            material.pipeline = manager.get_loaded_asset(shader_def_path);
-        } else {
-            RDE_CORE_ERROR("Material '{}' is missing shader dependency.", uri);
+        if (!file.is_open()) {
+            RDE_CORE_ERROR("Failed to open material manifest '{}'", uri);
             return nullptr;
         }
+        return load_asset_from_memory(uri, file.data(), file.size(), db, manager);
+    }
 
-        // --- NEW: Pipeline State Parsing ---
-        if (const auto &pipelineNode = doc["pipeline"]) {
-            if (pipelineNode["cullMode"]) {
-                // Here you would have a function to convert string to your RAL enum
-                pipelineDesc.cullMode = string_to_cull_mode(pipelineNode["cullMode"].as<std::string>());
-            }
-            if (pipelineNode["polygonMode"]) {
-                pipelineDesc.polygonMode = string_to_polygon_mode(pipelineNode["polygonMode"].as<std::string>());
-            }
-            if (pipelineNode["depthTest"]) {
-                pipelineDesc.depthTest = pipelineNode["depthTest"].as<bool>();
-            }
-            if (pipelineNode["depthWrite"]) {
-                pipelineDesc.depthWrite = pipelineNode["depthWrite"].as<bool>();
-            }
+    AssetID MaterialManifestLoader::load_asset_from_memory(const std::string &uri, const char *data, size_t size,
+                                                           AssetDatabase &db, AssetManager &manager) const {
+        // The YAML is only parsed the first time this exact source is seen.
+        ManifestFile::Material manifest;
+        const bool loaded = ManifestFile::LoadOrCompile(manager.get_derived_data_cache(), uri, data, size, *this,
+                                                        manifest, [&](ManifestFile::Material &out) {
+                                                            return CompileMaterial(uri, data, size, *this, out);
+                                                        });
+        if (!loaded) {
+            return nullptr;
         }
 
-        // --- Corrected Parameter Parsing ---
-        if (const auto &paramsNode = doc["parameters"]) {
-            for (const auto &paramNode: paramsNode) {
-                const auto param_name = paramNode["name"].as<std::string>();
-                const auto param_type = paramNode["type"].as<std::string>();
-                const auto &valueNode = paramNode["value"];
-
-                if (param_type == "float") {
-                    material.parameters.add<float>("p:" + param_name, valueNode.as<float>());
-                } else if (param_type == "vec2") {
-                    auto v = valueNode.as<std::vector<float> >();
-                    material.parameters.add<glm::vec2>("p:" + param_name, {v[0], v[1]});
-                } else if (param_type == "vec3") {
-                    auto v = valueNode.as<std::vector<float> >();
-                    material.parameters.add<glm::vec3>("p:" + param_name, {v[0], v[1], v[2]});
-                } else if (param_type == "vec4") {
-                    auto v = valueNode.as<std::vector<float> >();
-                    material.parameters.add<glm::vec4>("p:" + param_name, {v[0], v[1], v[2], v[3]});
-                } else {
-                    RDE_CORE_WARN("Unsupported parameter type '{}' in '{}'", param_type, uri);
-                }
+        // --- Resolve the references against the loaded assets ---
+        // Quick fix, the asset base path is missing here because we load the relative path from the manifest.
+        // Just prepend the base path to the dependency URI.
+        // TODO: Find a better way to handle absolute and relative paths in manifests.
+        const auto asset_path = get_asset_path();
+        MaterialDescription material;
+        material.name = manifest.name;
+        material.pipeline = manager.get_loaded_asset(asset_path.value() / manifest.shader);
+        for (const auto &parameter: manifest.parameters) {
+            const std::string name = "p:" + parameter.name;
+            const float *v = parameter.value;
+            switch (parameter.components) {
+                case 1: material.parameters.add<float>(name, v[0]);
+                    break;
+                case 2: material.parameters.add<glm::vec2>(name, {v[0], v[1]});
+                    break;
+                case 3: material.parameters.add<glm::vec3>(name, {v[0], v[1], v[2]});
+                    break;
+                case 4: material.parameters.add<glm::vec4>(name, {v[0], v[1], v[2], v[3]});
+                    break;
+                default: RDE_CORE_WARN("Parameter '{}' in '{}' has {} components", parameter.name, uri,
+                                       parameter.components);
             }
         }
-
-        // --- Corrected Texture Linking ---
-        if (doc["dependencies"]["textures"] && doc["textures"]) {
-            const auto &texture_deps = doc["dependencies"]["textures"];
-            for (const auto &textureNode: doc["textures"]) {
-                const auto texture_name = textureNode["name"].as<std::string>();
-                size_t idx = textureNode["index"].as<int>();
-
-                if (idx < texture_deps.size()) {
-                    // Quick fix, the asset base path is missing here because we load the relative path from the manifest.
-                    // Just prepend the base path to the texture URI.
-                    // TODO: Find a better way to handle absolute and relative paths in manifests.
-                    auto asset_path = get_asset_path();
-                    const auto texture_uri = asset_path.value() / texture_deps[idx].as<std::string>();
-                    material.textures["t_" + texture_name] = manager.get_loaded_asset(texture_uri);
-                } else {
-                    RDE_CORE_WARN("Texture index {} out of bounds for '{}' in '{}'", idx, texture_name, uri);
-                }
-            }
+        for (const auto &texture: manifest.textures) {
+            material.textures["t_" + texture.name] = manager.get_loaded_asset(asset_path.value() / texture.path);
         }
 
         // --- Final Asset Creation ---
@@ -116,8 +176,8 @@ namespace RDE {
         entt::entity entity_id = registry.create();
 
         registry.emplace<MaterialDescription>(entity_id, std::move(material));
-        registry.emplace<AssetPipelineDescription>(entity_id, pipelineDesc); // Emplace the new component
-        registry.emplace<AssetName>(entity_id, assetName);
+        registry.emplace<AssetPipelineDescription>(entity_id, manifest.pipeline);
+        registry.emplace<AssetName>(entity_id, manifest.name);
         registry.emplace<AssetFilepath>(entity_id, uri);
 
         RDE_CORE_INFO("Loaded material manifest '{}'", uri);
@@ -125,9 +185,19 @@ namespace RDE {
     }
 
     std::vector<std::string> MaterialManifestLoader::get_dependencies(const std::string &uri) const {
-        // A fast dependency scan of the YAML file
+        // A fast dependency scan: only the top level dependencies block is handed to the YAML parser.
         std::vector<std::string> deps;
-        YAML::Node doc = YAML::LoadFile(uri);
+        FileView file = VFS::Open(uri);
+        if (!file.is_open()) {
+            return deps;
+        }
+        YAML::Node doc;
+        try {
+            doc = YAML::Load(ExtractYamlBlock({file.data(), file.size()}, "dependencies"));
+        } catch (const YAML::Exception &e) {
+            RDE_CORE_WARN("Failed to scan dependencies of '{}': {}", uri, e.what());
+            return deps;
+        }
 
         for (const auto &node: doc["dependencies"]["shaders"]) {
             deps.push_back(node.as<std::string>());
@@ -0,0 +1,64 @@
+#include "assets/MeshBinaryLoader.h"
+#include "assets/AssetComponentTypes.h"
+#include "assets/AssetTelemetry.h"
+#include "assets/MeshFile.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+
+#include <filesystem>
+#include <memory>
+
+namespace RDE {
+    std::vector<std::string> MeshBinaryLoader::get_dependencies(const std::string &uri) const {
+        std::vector<std::string> dependencies;
+        FileView file = VFS::Open(uri);
+        std::vector<std::string> libraries;
+        std::string error = "could not open the file";
+        if (!file.is_open() || !MeshFile::DeserializeMaterialLibraries(file.data(), file.size(), libraries, &error)) {
+            RDE_CORE_WARN("get_dependencies could not read baked mesh '{}': {}", uri, error);
+            return dependencies;
+        }
+
+        // Relative to the mesh file, as in the OBJ it was baked from.
+        std::filesystem::path base_path = std::filesystem::path(uri).parent_path();
+        for (const std::string &library: libraries) {
+            dependencies.push_back((base_path / library).lexically_normal().string());
+        }
+        return dependencies;
+    }
+
+    AssetID MeshBinaryLoader::load_asset(const std::string &uri, AssetDatabase &db,
+                                         [[maybe_unused]] AssetManager &manager) const {
+        FileView file;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            file = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(file.size());
+        }
+        AssetCpuGeometry geometry;
+        std::string error = "could not open the file";
+        if (!file.is_open() || !MeshFile::Deserialize(file.data(), file.size(), geometry, &error)) {
+            RDE_CORE_ERROR("Failed to load baked mesh '{}': {}", uri, error);
+            return nullptr;
+        }
+
+        if (geometry.getVertexCount() == 0 || geometry.faces.empty()) {
+            RDE_CORE_WARN("Loaded empty or invalid mesh from '{}'", uri);
+            return nullptr;
+        }
+
+        auto &asset_registry = db.get_registry();
+        entt::entity entity_id = asset_registry.create();
+
+        asset_registry.emplace<AssetFilepath>(entity_id, uri);
+        asset_registry.emplace<AssetName>(entity_id, std::filesystem::path(uri).filename().string());
+        asset_registry.emplace<AssetCpuGeometry>(entity_id, std::move(geometry));
+
+        RDE_CORE_TRACE("MeshBinaryLoader: Successfully populated asset for '{}'", uri);
+        return std::make_shared<AssetID_Data>(entity_id, uri);
+    }
+
+    std::vector<std::string> MeshBinaryLoader::get_supported_extensions() const {
+        return {MeshFile::EXTENSION};
+    }
+}
@@ -0,0 +1,442 @@
+#include "assets/MeshFile.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+#include "core/ParallelFor.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace RDE::MeshFile {
+    namespace {
+        constexpr char MAGIC[8] = {'R', 'D', 'E', 'M', 'E', 'S', 'H', '\0'};
+        constexpr uint64_t PAYLOAD_ALIGNMENT = 64;
+
+        // Container ids as stored in the file.
+        constexpr PropertyContainer AssetCpuGeometry::*CONTAINERS[] = {
+            &AssetCpuGeometry::vertices, &AssetCpuGeometry::halfedges, &AssetCpuGeometry::edges,
+            &AssetCpuGeometry::faces, &AssetCpuGeometry::tets, &AssetCpuGeometry::meshlets
+        };
+        constexpr size_t NUM_CONTAINERS = std::size(CONTAINERS);
+
+        // The type tag is the index in this list, so only ever append to it. bool is stored as one byte per element.
+        using ElementTypes = std::tuple<float, double, int32_t, uint32_t, int16_t, uint16_t, int8_t, uint8_t, bool,
+            glm::vec2, glm::vec3, glm::vec4, glm::ivec2, glm::ivec3, glm::ivec4, glm::uvec2, glm::uvec3, glm::uvec4,
+            glm::mat3, glm::mat4>;
+        constexpr uint8_t INVALID_TAG = 0xFF;
+
+        template<typename T>
+        constexpr size_t StoredSize() { return std::is_same_v<T, bool> ? 1 : sizeof(T); }
+
+        template<size_t... I>
+        uint8_t TagOfImpl(const std::type_info &type, std::index_sequence<I...>) {
+            uint8_t tag = INVALID_TAG;
+            static_cast<void>(((typeid(std::tuple_element_t<I, ElementTypes>) == type
+                                    ? (tag = static_cast<uint8_t>(I), true)
+                                    : false) || ...));
+            return tag;
+        }
+
+        uint8_t TagOf(const std::type_info &type) {
+            return TagOfImpl(type, std::make_index_sequence<std::tuple_size_v<ElementTypes> >{});
+        }
+
+        // Calls f(std::type_identity<T>{}) for the type with the given tag, returns false for unknown tags.
+        template<typename F, size_t... I>
+        bool VisitTagImpl(uint8_t tag, F &&f, std::index_sequence<I...>) {
+            return ((tag == I ? (f(std::type_identity<std::tuple_element_t<I, ElementTypes> >{}), true) : false) || ...);
+        }
+
+        template<typename F>
+        bool VisitTag(uint8_t tag, F &&f) {
+            return VisitTagImpl(tag, std::forward<F>(f), std::make_index_sequence<std::tuple_size_v<ElementTypes> >{});
+        }
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t num_arrays;
+            uint64_t container_sizes[NUM_CONTAINERS];
+            uint32_t num_subviews;
+            uint32_t string_size;
+            uint64_t meshlet_vertex_count;
+            uint64_t meshlet_vertex_offset;
+            uint64_t file_size;
+            uint32_t num_libraries;
+            uint32_t reserved;
+        };
+
+        struct ArrayEntry {
+            uint8_t container;
+            uint8_t type;
+            uint16_t element_size;
+            uint32_t name_offset;
+            uint32_t name_size;
+            uint32_t reserved;
+            uint64_t count;
+            uint64_t data_offset;
+        };
+
+        struct SubviewEntry {
+            uint32_t index_offset;
+            uint32_t index_count;
+            int32_t material_index;
+            uint32_t name_offset;
+            uint32_t name_size;
+            uint32_t material_offset;
+            uint32_t material_size;
+            uint32_t reserved;
+        };
+
+        struct LibraryEntry {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        static_assert(sizeof(Header) == 104 && sizeof(ArrayEntry) == 32 && sizeof(SubviewEntry) == 32 &&
+                      sizeof(LibraryEntry) == 8);
+        static_assert(std::is_trivially_copyable_v<glm::mat4> && sizeof(glm::vec3) == 12);
+
+        uint64_t AlignUp(uint64_t value) {
+            return (value + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+        }
+
+        uint32_t AppendString(std::string &blob, const std::string &text) {
+            const auto offset = static_cast<uint32_t>(blob.size());
+            blob += text;
+            return offset;
+        }
+
+        // Offsets of the tables behind the header.
+        struct Layout {
+            uint64_t entries;
+            uint64_t subviews;
+            uint64_t libraries;
+            uint64_t strings;
+        };
+
+        // Checks the header and that the tables and strings lie within the file. Returns the error, empty if valid.
+        std::string ReadHeader(const char *base, uint64_t file_size, Header &header, Layout &layout) {
+            if (file_size < sizeof(Header)) {
+                return "too small to be a mesh file";
+            }
+            std::memcpy(&header, base, sizeof(Header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+                return "not a mesh file";
+            }
+            if (header.version != VERSION) {
+                return "version " + std::to_string(header.version) + ", expected " + std::to_string(VERSION);
+            }
+            if (header.file_size != file_size) {
+                return "truncated";
+            }
+            layout.entries = sizeof(Header);
+            layout.subviews = layout.entries + uint64_t(header.num_arrays) * sizeof(ArrayEntry);
+            layout.libraries = layout.subviews + uint64_t(header.num_subviews) * sizeof(SubviewEntry);
+            layout.strings = layout.libraries + uint64_t(header.num_libraries) * sizeof(LibraryEntry);
+            if (layout.strings + header.string_size > file_size ||
+                header.meshlet_vertex_offset % alignof(uint32_t) != 0 ||
+                header.meshlet_vertex_count > (file_size - std::min(file_size, header.meshlet_vertex_offset)) / 4) {
+                return "invalid layout";
+            }
+            return {};
+        }
+
+        struct PendingArray {
+            const BasePropertyArray *array = nullptr;
+            std::vector<uint8_t> bool_bytes; // Only for bool arrays, whose std::vector storage is bit packed
+        };
+    }
+
+    void Serialize(const AssetCpuGeometry &geometry, std::vector<char> &out) {
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+
+        // -- Collect the arrays and strings --
+        std::string strings;
+        std::vector<ArrayEntry> entries;
+        std::vector<PendingArray> pending;
+        for (size_t c = 0; c < NUM_CONTAINERS; ++c) {
+            const PropertyContainer &container = geometry.*CONTAINERS[c];
+            header.container_sizes[c] = container.size();
+            for (const std::string &name: container.properties()) {
+                const BasePropertyArray *array = container.get_base(name);
+                const uint8_t tag = TagOf(array->type());
+                if (tag == INVALID_TAG) {
+                    RDE_CORE_WARN("MeshFile::Serialize: Skipping property '{}' of unsupported type {}", name,
+                                  array->type().name());
+                    continue;
+                }
+                ArrayEntry entry{};
+                entry.container = static_cast<uint8_t>(c);
+                entry.type = tag;
+                entry.name_offset = AppendString(strings, name);
+                entry.name_size = static_cast<uint32_t>(name.size());
+                entry.count = array->size();
+                VisitTag(tag, [&](auto type) {
+                    using T = typename decltype(type)::type;
+                    entry.element_size = static_cast<uint16_t>(StoredSize<T>());
+                });
+
+                PendingArray &payload = pending.emplace_back();
+                payload.array = array;
+                if (array->type() == typeid(bool)) {
+                    const auto &bits = dynamic_cast<const PropertyArray<bool> *>(array)->vector();
+                    payload.bool_bytes.assign(bits.begin(), bits.end());
+                }
+                entries.push_back(entry);
+            }
+        }
+
+        std::vector<SubviewEntry> subviews;
+        subviews.reserve(geometry.subviews.size());
+        for (const AssetGeometrySubView &subview: geometry.subviews) {
+            SubviewEntry entry{};
+            entry.index_offset = subview.index_offset;
+            entry.index_count = subview.index_count;
+            entry.material_index = subview.material_index;
+            entry.name_offset = AppendString(strings, subview.name);
+            entry.name_size = static_cast<uint32_t>(subview.name.size());
+            entry.material_offset = AppendString(strings, subview.material_name);
+            entry.material_size = static_cast<uint32_t>(subview.material_name.size());
+            subviews.push_back(entry);
+        }
+
+        std::vector<LibraryEntry> libraries;
+        libraries.reserve(geometry.material_libraries.size());
+        for (const std::string &library: geometry.material_libraries) {
+            libraries.push_back({AppendString(strings, library), static_cast<uint32_t>(library.size())});
+        }
+
+        // -- Lay out the payloads behind the tables --
+        header.num_arrays = static_cast<uint32_t>(entries.size());
+        header.num_subviews = static_cast<uint32_t>(subviews.size());
+        header.num_libraries = static_cast<uint32_t>(libraries.size());
+        header.string_size = static_cast<uint32_t>(strings.size());
+        uint64_t offset = sizeof(Header) + entries.size() * sizeof(ArrayEntry) + subviews.size() * sizeof(SubviewEntry) +
+                          libraries.size() * sizeof(LibraryEntry) + strings.size();
+        for (ArrayEntry &entry: entries) {
+            offset = AlignUp(offset);
+            entry.data_offset = offset;
+            offset += entry.count * entry.element_size;
+        }
+        offset = AlignUp(offset);
+        header.meshlet_vertex_count = geometry.meshlet_vertices.size();
+        header.meshlet_vertex_offset = offset;
+        offset += geometry.meshlet_vertices.size() * sizeof(uint32_t);
+        header.file_size = offset;
+
+        // -- Copy everything into place --
+        out.assign(header.file_size, 0);
+        auto put = [&](uint64_t offset, const void *data, uint64_t size) {
+            if (size) {
+                std::memcpy(out.data() + offset, data, size);
+            }
+        };
+        uint64_t cursor = 0;
+        put(cursor, &header, sizeof(Header));
+        put(cursor += sizeof(Header), entries.data(), entries.size() * sizeof(ArrayEntry));
+        put(cursor += entries.size() * sizeof(ArrayEntry), subviews.data(), subviews.size() * sizeof(SubviewEntry));
+        put(cursor += subviews.size() * sizeof(SubviewEntry), libraries.data(), libraries.size() * sizeof(LibraryEntry));
+        put(cursor += libraries.size() * sizeof(LibraryEntry), strings.data(), strings.size());
+        Parallel::For(entries.size(), 1, [&](size_t i) {
+            const PendingArray &payload = pending[i];
+            if (payload.array->type() == typeid(bool)) {
+                put(entries[i].data_offset, payload.bool_bytes.data(), payload.bool_bytes.size());
+            } else {
+                put(entries[i].data_offset, payload.array->data(), payload.array->total_size_bytes());
+            }
+        });
+        put(header.meshlet_vertex_offset, geometry.meshlet_vertices.data(),
+            geometry.meshlet_vertices.size() * sizeof(uint32_t));
+    }
+
+    bool Deserialize(const char *data, size_t size, AssetCpuGeometry &geometry, std::string *error) {
+        const char *base = data;
+        const uint64_t file_size = size;
+        auto fail = [&](std::string reason) {
+            if (error) {
+                *error = std::move(reason);
+            }
+            return false;
+        };
+
+        // -- Validate the header and tables --
+        Header header;
+        Layout layout;
+        if (std::string reason = ReadHeader(base, file_size, header, layout); !reason.empty()) {
+            return fail(std::move(reason));
+        }
+        const std::string_view strings(base + layout.strings, header.string_size);
+        auto string_at = [&](uint32_t offset, uint32_t length, std::string &out) {
+            if (uint64_t(offset) + length > strings.size()) {
+                return false;
+            }
+            out.assign(strings.substr(offset, length));
+            return true;
+        };
+
+        std::vector<ArrayEntry> entries(header.num_arrays);
+        std::memcpy(entries.data(), base + layout.entries, entries.size() * sizeof(ArrayEntry));
+
+        // -- Create the arrays, then fill them in parallel straight from the source --
+        AssetCpuGeometry result;
+        std::vector<std::function<void()> > copies;
+        copies.reserve(entries.size());
+        for (const ArrayEntry &entry: entries) {
+            std::string name;
+            if (entry.container >= NUM_CONTAINERS || !string_at(entry.name_offset, entry.name_size, name)) {
+                return fail("invalid array entry");
+            }
+            if (entry.count != header.container_sizes[entry.container] ||
+                entry.data_offset % PAYLOAD_ALIGNMENT != 0 || entry.data_offset > file_size ||
+                entry.element_size == 0 || entry.count > (file_size - entry.data_offset) / entry.element_size) {
+                return fail("invalid payload for property '" + name + "'");
+            }
+            PropertyContainer &container = result.*CONTAINERS[entry.container];
+            bool valid = false;
+            const bool known = VisitTag(entry.type, [&](auto type) {
+                using T = typename decltype(type)::type;
+                if (entry.element_size != StoredSize<T>()) {
+                    return;
+                }
+                auto property = container.add<T>(name);
+                if (!property) {
+                    return;
+                }
+                valid = true;
+                auto *target = &property.vector();
+                const char *source = base + entry.data_offset;
+                const size_t count = entry.count;
+                copies.emplace_back([target, source, count]() {
+                    if constexpr (std::is_same_v<T, bool>) {
+                        target->resize(count);
+                        for (size_t i = 0; i < count; ++i) {
+                            (*target)[i] = source[i] != 0;
+                        }
+                    } else if (reinterpret_cast<uintptr_t>(source) % alignof(T) == 0) {
+                        // Payloads are 64 byte aligned, in a mapping they can be read as T directly.
+                        const T *first = reinterpret_cast<const T *>(source);
+                        target->assign(first, first + count);
+                    } else {
+                        target->resize(count);
+                        std::memcpy(target->data(), source, count * sizeof(T));
+                    }
+                });
+            });
+            if (!known || !valid) {
+                return fail("unsupported or duplicate property '" + name + "'");
+            }
+        }
+
+        Parallel::For(copies.size(), 1, [&](size_t i) { copies[i](); });
+        for (size_t c = 0; c < NUM_CONTAINERS; ++c) {
+            // All arrays already have this size, this only sets the container's element count.
+            (result.*CONTAINERS[c]).resize(header.container_sizes[c]);
+        }
+
+        result.meshlet_vertices.resize(header.meshlet_vertex_count);
+        if (header.meshlet_vertex_count) {
+            std::memcpy(result.meshlet_vertices.data(), base + header.meshlet_vertex_offset,
+                        header.meshlet_vertex_count * sizeof(uint32_t));
+        }
+
+        // -- Subviews --
+        result.subviews.resize(header.num_subviews);
+        for (size_t i = 0; i < result.subviews.size(); ++i) {
+            SubviewEntry entry;
+            std::memcpy(&entry, base + layout.subviews + i * sizeof(SubviewEntry), sizeof(SubviewEntry));
+            AssetGeometrySubView &subview = result.subviews[i];
+            subview.index_offset = entry.index_offset;
+            subview.index_count = entry.index_count;
+            subview.material_index = entry.material_index;
+            if (!string_at(entry.name_offset, entry.name_size, subview.name) ||
+                !string_at(entry.material_offset, entry.material_size, subview.material_name)) {
+                return fail("invalid subview entry");
+            }
+        }
+        if (!DeserializeMaterialLibraries(data, size, result.material_libraries, error)) {
+            return false;
+        }
+
+        geometry = std::move(result);
+        return true;
+    }
+
+    bool DeserializeMaterialLibraries(const char *data, size_t size, std::vector<std::string> &libraries,
+                                      std::string *error) {
+        auto fail = [&](std::string reason) {
+            if (error) {
+                *error = std::move(reason);
+            }
+            return false;
+        };
+
+        Header header;
+        Layout layout;
+        if (std::string reason = ReadHeader(data, size, header, layout); !reason.empty()) {
+            return fail(std::move(reason));
+        }
+        std::vector<std::string> result(header.num_libraries);
+        for (size_t i = 0; i < result.size(); ++i) {
+            LibraryEntry entry;
+            std::memcpy(&entry, data + layout.libraries + i * sizeof(LibraryEntry), sizeof(LibraryEntry));
+            if (uint64_t(entry.offset) + entry.size > header.string_size) {
+                return fail("invalid material library entry");
+            }
+            result[i].assign(data + layout.strings + entry.offset, entry.size);
+        }
+        libraries = std::move(result);
+        return true;
+    }
+
+    bool Write(const std::filesystem::path &path, const AssetCpuGeometry &geometry) {
+        std::vector<char> data;
+        Serialize(geometry, data);
+
+        // Write to a temporary file and swap it in.
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!out) {
+                RDE_CORE_ERROR("MeshFile::Write: Failed to write '{}'", temp_path.string());
+                out.close();
+                std::error_code ec;
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec) {
+            RDE_CORE_ERROR("MeshFile::Write: Failed to move '{}' to '{}': {}", temp_path.string(), path.string(),
+                           ec.message());
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool Read(const std::filesystem::path &path, AssetCpuGeometry &geometry) {
+        FileView file = VFS::Open(path.string());
+        if (!file.is_open()) {
+            RDE_CORE_ERROR("MeshFile::Read: Failed to open '{}'", path.string());
+            return false;
+        }
+        std::string error;
+        if (!Deserialize(file.data(), file.size(), geometry, &error)) {
+            RDE_CORE_ERROR("MeshFile::Read: '{}': {}", path.string(), error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -1,7 +1,10 @@
 #include "assets/MeshMtlLoader.h"
 #include "assets/AssetComponentTypes.h"
+#include "assets/AssetTelemetry.h"
 #include "material/MaterialDescription.h"
+#include "core/VirtualFileSystem.h"
 
+#include <sstream>
 #include <variant>
 
 namespace RDE {
@@ -24,12 +27,18 @@ namespace RDE {
 
     static std::vector<MtlData> parse_mtl_file(const std::string &uri) {
         std::vector<MtlData> materials;
-        std::ifstream file(uri);
+        FileView view;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            view = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(view.size());
+        }
 
-        if (!file.is_open()) {
+        if (!view.is_open()) {
             RDE_CORE_ERROR("Failed to open MTL file: {}", uri);
             return materials;
         }
+        std::istringstream file{std::string(view.view())};
 
         std::string line;
         MtlData* currentMaterial = nullptr;
@@ -1,80 +1,57 @@
 #include "assets/MeshObjLoader.h"
 #include "assets/AssetComponentTypes.h"
+#include "assets/AssetTelemetry.h"
+#include "assets/MeshFile.h"
+#include "assets/MeshOptimizer.h"
+#include "assets/MeshletBuilder.h"
+#include "assets/ObjParser.h"
+#include "assets/TangentSpace.h"
 #include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+#include "core/ParallelFor.h"
 
-#define TINYOBJLOADER_IMPLEMENTATION
-
-#include <tiny_obj_loader.h>
 #include <glm/glm.hpp>
 #include <filesystem>
 #include <memory>
-#include <unordered_map>
-
-namespace tinyobj {
-    struct index_t_hash {
-        std::size_t operator()(const index_t &i) const {
-            std::size_t h1 = std::hash<int>()(i.vertex_index);
-            std::size_t h2 = std::hash<int>()(i.normal_index);
-            std::size_t h3 = std::hash<int>()(i.texcoord_index);
-            // A common way to combine hashes
-            return h1 ^ (h2 << 1) ^ (h3 << 2);
-        }
-    };
-
-    bool operator==(const index_t &a, const index_t &b) {
-        return a.vertex_index == b.vertex_index &&
-               a.normal_index == b.normal_index &&
-               a.texcoord_index == b.texcoord_index;
-    }
-}
 
 namespace RDE {
     std::vector<std::string> MeshObjLoader::get_dependencies(const std::string &uri) const {
         std::vector<std::string> dependencies;
-        std::ifstream file(uri);
+        FileView file = VFS::Open(uri);
         if (!file.is_open()) {
             RDE_CORE_WARN("get_dependencies could not open file: {}", uri);
             return dependencies;
         }
 
+        // Only the header up to the first face is scanned, load_asset parses the whole file anyway.
         std::filesystem::path base_path = std::filesystem::path(uri).parent_path();
-        std::string line;
-        while (std::getline(file, line)) {
-            // Trim whitespace for robustness
-            line.erase(0, line.find_first_not_of(" \t\r\n"));
-            if (line.rfind("mtllib", 0) == 0) { // Check if the line starts with "mtllib"
-                std::stringstream ss(line);
-                std::string keyword, mtl_path_str;
-                ss >> keyword >> std::ws; // Read keyword, consume whitespace
-                std::getline(ss, mtl_path_str);
-
-                if (!mtl_path_str.empty()) {
-                    // Construct the full path relative to the OBJ file
-                    std::string full_path = (base_path / mtl_path_str).lexically_normal().string();
-                    dependencies.push_back(full_path);
-                }
+        for (const std::string &library: ObjParser::ScanMaterialLibraries(file.data(), file.size())) {
+            if (!library.empty()) {
+                // Construct the full path relative to the OBJ file
+                dependencies.push_back((base_path / library).lexically_normal().string());
             }
         }
         return dependencies;
     }
 
-
     AssetID MeshObjLoader::load_asset(const std::string &uri, AssetDatabase &db,[[maybe_unused]] AssetManager &manager) const {
-        tinyobj::ObjReader reader;
-        tinyobj::ObjReaderConfig reader_config;
-        reader_config.mtl_search_path = std::filesystem::path(uri).parent_path().string();
-        reader_config.triangulate = true; // IMPORTANT: Ensure we always get triangles.
-
-        if (!reader.ParseFromFile(uri, reader_config)) {
-            if (!reader.Error().empty()) {
-                RDE_CORE_ERROR("Failed to load OBJ file '{}': {}", uri, reader.Error());
-            }
+        FileView file;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            file = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(file.size());
+        }
+        ObjParser::ObjData obj;
+        std::string error = "Could not open the file";
+        if (!file.is_open() || !ObjParser::Parse(file.data(), file.size(), obj, &error)) {
+            RDE_CORE_ERROR("Failed to load OBJ file '{}': {}", uri, error);
             return nullptr;
         }
 
-        const auto &attrib = reader.GetAttrib();
-        const auto &shapes = reader.GetShapes();
-        const auto &materials = reader.GetMaterials();
+        // -- Weld (position, texcoord, normal) triples into unique vertices --
+        std::vector<uint32_t> indices;
+        const std::vector<ObjParser::Corner> corners = ObjParser::WeldCorners(obj.corners, indices);
+        obj.corners = {};
 
         // -- This is the object we will populate and eventually emplace into the asset entity --
         AssetCpuGeometry geometry;
@@ -82,85 +59,51 @@ namespace RDE {
         auto positions = geometry.vertices.add<glm::vec3>("v:point");
         auto normals = geometry.vertices.add<glm::vec3>("v:normal", glm::vec3(0.0f, 1.0f, 0.0f)); // Default normal
         auto texCoords = geometry.vertices.add<glm::vec2>("v:texcoord");
+        geometry.vertices.resize(corners.size());
 
-        // This will temporarily hold ALL indices from all shapes before we form faces.
-        std::vector<uint32_t> masterIndexBuffer;
-
-        std::unordered_map<tinyobj::index_t, uint32_t, tinyobj::index_t_hash> uniqueVertices{};
-
-        //can we just copy all values directly? and then only set the subview offsets and indices?
-
-        for (const auto &shape: shapes) {
-            AssetGeometrySubView subGeom{};
-            subGeom.index_offset = static_cast<uint32_t>(masterIndexBuffer.size());
-
-            if (!shape.mesh.material_ids.empty() && shape.mesh.material_ids[0] >= 0) {
-                subGeom.material_name = materials[shape.mesh.material_ids[0]].name;
-            } else {
-                subGeom.material_name = "DefaultMaterial";
+        Parallel::For(corners.size(), 1 << 14, [&](size_t v) {
+            const ObjParser::Corner &corner = corners[v];
+            positions[v] = obj.positions[corner.position];
+            if (corner.normal >= 0) {
+                normals[v] = obj.normals[corner.normal];
             }
-
-            // Iterate over the faces of the shape, creating the unified index buffer
-            for (const auto &index: shape.mesh.indices) {
-                if (uniqueVertices.count(index) == 0) {
-                    // This unique vertex doesn't exist yet, so we add its data
-                    uniqueVertices[index] = static_cast<uint32_t>(positions.vector().size());
-                    geometry.vertices.push_back();
-
-                    positions.vector().back() = glm::vec3(
-                            attrib.vertices[3 * index.vertex_index + 0],
-                            attrib.vertices[3 * index.vertex_index + 1],
-                            attrib.vertices[3 * index.vertex_index + 2]
-                    );
-
-                    if (index.normal_index >= 0) {
-                        normals.vector().back() = glm::vec3(
-                                attrib.normals[3 * index.normal_index + 0],
-                                attrib.normals[3 * index.normal_index + 1],
-                                attrib.normals[3 * index.normal_index + 2]
-                        );
-                    }
-
-                    if (index.texcoord_index >= 0) {
-                        texCoords.vector().back() = glm::vec2(
-                                attrib.texcoords[2 * index.texcoord_index + 0],
-                                1.0f -
-                                attrib.texcoords[2 * index.texcoord_index + 1] // Flip V coordinate for Vulkan/OpenGL
-                        );
-                    }
-                }
-                // Add the unified index to our temporary master list
-                masterIndexBuffer.push_back(uniqueVertices[index]);
+            if (corner.texcoord >= 0) {
+                const glm::vec2 &uv = obj.texcoords[corner.texcoord];
+                texCoords[v] = glm::vec2(uv.x, 1.0f - uv.y); // Flip V coordinate for Vulkan/OpenGL
             }
-
-            subGeom.index_count = static_cast<uint32_t>(masterIndexBuffer.size()) - subGeom.index_offset;
-            if (subGeom.index_count > 0) {
-                geometry.subviews.push_back(subGeom);
+        });
+
+        // Vertices without an OBJ normal get a generated one after the faces are known.
+        std::vector<uint32_t> verticesWithoutNormal;
+        bool hasTexCoords = false;
+        for (size_t v = 0; v < corners.size(); ++v) {
+            if (corners[v].normal < 0) {
+                verticesWithoutNormal.push_back(static_cast<uint32_t>(v));
             }
+            hasTexCoords |= corners[v].texcoord >= 0;
         }
 
-        // -- Post-Process and Finalize --
-
-        // Pad missing attributes to ensure all vertex property arrays have the same size.
-        size_t vertexCount = positions.vector().size();
-        if (normals.vector().size() < vertexCount) {
-            normals.vector().resize(vertexCount, glm::vec3(0.0f, 1.0f, 0.0f));
+        // One subview per o/g/usemtl run.
+        for (const auto &group: obj.groups) {
+            AssetGeometrySubView subGeom{};
+            subGeom.index_offset = 3 * group.first_triangle;
+            subGeom.index_count = 3 * group.triangle_count;
+            subGeom.name = group.name;
+            subGeom.material_name = group.material.empty() ? "DefaultMaterial" : group.material;
+            geometry.subviews.push_back(subGeom);
         }
-        if (texCoords.vector().size() < vertexCount) {
-            texCoords.vector().resize(vertexCount, glm::vec2(0.0f));
+        for (std::string &library: obj.material_libraries) {
+            if (!library.empty()) {
+                geometry.material_libraries.push_back(std::move(library));
+            }
         }
 
-        // Now, correctly convert the master index buffer into faces (triangles)
-        if (!masterIndexBuffer.empty()) {
+        if (!indices.empty()) {
             auto faces = geometry.faces.add<glm::ivec3>("f:tris");
-            geometry.faces.resize(masterIndexBuffer.size() / 3);
-            for (size_t i = 0; i < geometry.faces.size(); ++i) {
-                faces[i] = glm::ivec3(
-                        masterIndexBuffer[3 * i + 0],
-                        masterIndexBuffer[3 * i + 1],
-                        masterIndexBuffer[3 * i + 2]
-                );
-            }
+            geometry.faces.resize(indices.size() / 3);
+            Parallel::For(geometry.faces.size(), 1 << 14, [&](size_t f) {
+                faces[f] = glm::ivec3(indices[3 * f + 0], indices[3 * f + 1], indices[3 * f + 2]);
+            });
         }
 
         if (geometry.getVertexCount() == 0 || geometry.faces.empty()) {
@@ -168,6 +111,29 @@ namespace RDE {
             return nullptr;
         }
 
+        AssetTelemetry::ScopedPhase post_process(AssetTelemetry::Phase::PostProcess);
+        // Fill in missing normals and add tangents for normal mapping (the TANGENT attribute of basic_lit).
+        if (!verticesWithoutNormal.empty()) {
+            std::vector<glm::vec3> generated;
+            TangentSpace::ComputeVertexNormals(positions.vector(), geometry.faces.get<glm::ivec3>("f:tris").vector(),
+                                               generated);
+            for (const uint32_t v: verticesWithoutNormal) {
+                normals[v] = generated[v];
+            }
+        }
+        if (hasTexCoords) {
+            TangentSpace::ComputeTangents(geometry.vertices, geometry.faces);
+        }
+
+        // OBJ face order is arbitrary, reorder triangles and vertices for the post-transform cache and fetch locality.
+        const auto optimization = MeshOptimizer::Optimize(geometry);
+        RDE_CORE_TRACE("MeshObjLoader: ACMR {:.3f} -> {:.3f} for '{}'", optimization.before.acmr,
+                       optimization.after.acmr, uri);
+
+        const auto meshlets = MeshletBuilder::Build(geometry);
+        RDE_CORE_TRACE("MeshObjLoader: {} meshlets ({:.1f} vertices, {:.1f} triangles on average) for '{}'",
+                       meshlets.num_meshlets, meshlets.average_vertices, meshlets.average_triangles, uri);
+
         // -- Create the asset entity and emplace its data --
         auto &asset_registry = db.get_registry();
         entt::entity entity_id = asset_registry.create();
@@ -183,4 +149,38 @@ namespace RDE {
     std::vector<std::string> MeshObjLoader::get_supported_extensions() const {
         return {".obj"};
     }
+
+    std::string MeshObjLoader::get_import_settings() const {
+        // Bump when the import pipeline changes its output.
+        const MeshletBuilder::Settings meshlets;
+        return "pipeline=1;rdemesh=" + std::to_string(MeshFile::VERSION) + ";meshlets=" +
+               std::to_string(meshlets.max_vertices) + "x" + std::to_string(meshlets.max_triangles);
+    }
+
+    bool MeshObjLoader::write_derived_data(const AssetID &asset_id, AssetDatabase &db, std::vector<char> &out) const {
+        const auto *geometry = db.try_get<AssetCpuGeometry>(asset_id);
+        if (!geometry) {
+            return false;
+        }
+        MeshFile::Serialize(*geometry, out);
+        return true;
+    }
+
+    AssetID MeshObjLoader::read_derived_data(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                             [[maybe_unused]] AssetManager &manager) const {
+        AssetCpuGeometry geometry;
+        std::string error;
+        if (!MeshFile::Deserialize(data, size, geometry, &error)) {
+            RDE_CORE_WARN("MeshObjLoader: Derived data for '{}' rejected: {}", uri, error);
+            return nullptr;
+        }
+
+        auto &asset_registry = db.get_registry();
+        entt::entity entity_id = asset_registry.create();
+
+        asset_registry.emplace<AssetFilepath>(entity_id, uri);
+        asset_registry.emplace<AssetName>(entity_id, std::filesystem::path(uri).filename().string());
+        asset_registry.emplace<AssetCpuGeometry>(entity_id, std::move(geometry));
+        return std::make_shared<AssetID_Data>(entity_id, uri);
+    }
 }
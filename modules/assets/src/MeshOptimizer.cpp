@@ -0,0 +1,360 @@
+#include "assets/MeshOptimizer.h"
+#include "core/Log.h"
+#include "core/ParallelFor.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace RDE::MeshOptimizer {
+    namespace {
+        constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> FlattenTriangles(const std::vector<glm::ivec3> &triangles) {
+            std::vector<uint32_t> indices(triangles.size() * 3);
+            Parallel::For(triangles.size(), 1 << 14, [&](size_t f) {
+                indices[3 * f + 0] = static_cast<uint32_t>(triangles[f].x);
+                indices[3 * f + 1] = static_cast<uint32_t>(triangles[f].y);
+                indices[3 * f + 2] = static_cast<uint32_t>(triangles[f].z);
+            });
+            return indices;
+        }
+
+        // Sorts the clusters of one range so that outward facing clusters (relative to the range's center) are drawn
+        // first. Clusters start after Tipsify cache flushes, so moving them around barely changes the ACMR.
+        void SortClustersForOverdraw(std::vector<uint32_t> &order, const std::vector<uint32_t> &cluster_starts,
+                                     const std::vector<uint32_t> &indices, size_t first_index,
+                                     const std::vector<glm::vec3> &positions) {
+            const size_t num_clusters = cluster_starts.size();
+            if (num_clusters < 2) {
+                return;
+            }
+
+            struct Cluster {
+                uint32_t begin = 0;
+                uint32_t end = 0;
+                glm::vec3 centroid{0.0f};
+                glm::vec3 normal{0.0f};
+                float area = 0.0f;
+                float sort_key = 0.0f;
+            };
+
+            std::vector<Cluster> clusters(num_clusters);
+            glm::vec3 range_centroid(0.0f);
+            float range_area = 0.0f;
+            for (size_t c = 0; c < num_clusters; ++c) {
+                Cluster &cluster = clusters[c];
+                cluster.begin = cluster_starts[c];
+                cluster.end = c + 1 < num_clusters ? cluster_starts[c + 1] : static_cast<uint32_t>(order.size());
+                for (uint32_t i = cluster.begin; i < cluster.end; ++i) {
+                    const size_t corner = first_index + 3 * size_t(order[i]);
+                    const glm::vec3 &a = positions[indices[corner + 0]];
+                    const glm::vec3 &b = positions[indices[corner + 1]];
+                    const glm::vec3 &c2 = positions[indices[corner + 2]];
+                    const glm::vec3 n = glm::cross(b - a, c2 - a);
+                    const float area = glm::length(n) * 0.5f;
+                    cluster.normal += n;
+                    cluster.centroid += (a + b + c2) * (area / 3.0f);
+                    cluster.area += area;
+                }
+                range_centroid += cluster.centroid;
+                range_area += cluster.area;
+                if (cluster.area > 0.0f) {
+                    cluster.centroid /= cluster.area;
+                }
+            }
+            if (range_area <= 0.0f) {
+                return;
+            }
+            range_centroid /= range_area;
+
+            for (Cluster &cluster: clusters) {
+                const float normal_length = glm::length(cluster.normal);
+                cluster.sort_key = normal_length > 0.0f
+                                       ? glm::dot(cluster.centroid - range_centroid, cluster.normal / normal_length)
+                                       : -std::numeric_limits<float>::max();
+            }
+            std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &lhs, const Cluster &rhs) {
+                return lhs.sort_key > rhs.sort_key;
+            });
+
+            std::vector<uint32_t> sorted;
+            sorted.reserve(order.size());
+            for (const Cluster &cluster: clusters) {
+                sorted.insert(sorted.end(), order.begin() + cluster.begin, order.begin() + cluster.end);
+            }
+            order = std::move(sorted);
+        }
+    }
+
+    CacheStatistics AnalyzeVertexCache(const std::vector<uint32_t> &indices, size_t vertex_count,
+                                       uint32_t cache_size) {
+        CacheStatistics stats;
+        if (indices.empty() || vertex_count == 0) {
+            return stats;
+        }
+
+        // FIFO: a vertex is cached while fewer than cache_size misses happened since it was inserted.
+        constexpr size_t NOT_CACHED = std::numeric_limits<size_t>::max();
+        std::vector<size_t> inserted_at(vertex_count, NOT_CACHED);
+        size_t misses = 0;
+        size_t referenced = 0;
+        for (const uint32_t index: indices) {
+            if (index >= vertex_count) {
+                continue;
+            }
+            size_t &stamp = inserted_at[index];
+            if (stamp == NOT_CACHED) {
+                ++referenced;
+            }
+            if (stamp == NOT_CACHED || misses - stamp >= cache_size) {
+                stamp = misses++;
+            }
+        }
+
+        stats.vertex_shader_invocations = misses;
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+        stats.atvr = referenced ? static_cast<float>(misses) / static_cast<float>(referenced) : 0.0f;
+        return stats;
+    }
+
+    CacheStatistics AnalyzeVertexCache(const AssetCpuGeometry &geometry, uint32_t cache_size) {
+        const auto *triangles = dynamic_cast<const PropertyArray<glm::ivec3> *>(geometry.faces.get_base("f:tris"));
+        if (!triangles) {
+            return {};
+        }
+        return AnalyzeVertexCache(FlattenTriangles(triangles->vector()), geometry.getVertexCount(), cache_size);
+    }
+
+    std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t> &indices, size_t first_index,
+                                              size_t index_count, uint32_t cache_size,
+                                              std::vector<uint32_t> *cluster_starts) {
+        const auto num_triangles = static_cast<uint32_t>(index_count / 3);
+        std::vector<uint32_t> order;
+        order.reserve(num_triangles);
+        if (num_triangles == 0) {
+            return order;
+        }
+
+        // Work on range-local vertex ids so the cost only depends on the size of the range.
+        std::vector<uint32_t> local(indices.begin() + first_index, indices.begin() + first_index + 3 * num_triangles);
+        std::vector<uint32_t> unique = local;
+        std::sort(unique.begin(), unique.end());
+        unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+        for (uint32_t &index: local) {
+            index = static_cast<uint32_t>(std::lower_bound(unique.begin(), unique.end(), index) - unique.begin());
+        }
+        const auto num_vertices = static_cast<uint32_t>(unique.size());
+
+        // Vertex -> triangle adjacency and live triangle counts.
+        std::vector<uint32_t> live(num_vertices, 0);
+        for (const uint32_t v: local) {
+            ++live[v];
+        }
+        std::vector<uint32_t> adjacency_offset(size_t(num_vertices) + 1, 0);
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            adjacency_offset[v + 1] = adjacency_offset[v] + live[v];
+        }
+        std::vector<uint32_t> adjacency(local.size());
+        {
+            std::vector<uint32_t> cursor(adjacency_offset.begin(), adjacency_offset.end() - 1);
+            for (uint32_t t = 0; t < num_triangles; ++t) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    adjacency[cursor[local[3 * t + k]]++] = t;
+                }
+            }
+        }
+
+        // --- Tipsify (Sander, Nehab, Barczak 2007) ---
+        std::vector<uint32_t> cache_time(num_vertices, 0);
+        std::vector<bool> emitted(num_triangles, false);
+        std::vector<uint32_t> dead_end;
+        std::vector<uint32_t> candidates;
+        uint32_t time_stamp = cache_size + 1;
+        uint32_t cursor = 0;
+
+        auto skip_dead_end = [&]() -> uint32_t {
+            while (!dead_end.empty()) {
+                const uint32_t v = dead_end.back();
+                dead_end.pop_back();
+                if (live[v] > 0) {
+                    return v;
+                }
+            }
+            while (cursor < num_vertices) {
+                if (live[cursor] > 0) {
+                    return cursor;
+                }
+                ++cursor;
+            }
+            return INVALID_INDEX;
+        };
+
+        if (cluster_starts) {
+            cluster_starts->clear();
+            cluster_starts->push_back(0);
+        }
+
+        uint32_t fan_vertex = skip_dead_end();
+        while (fan_vertex != INVALID_INDEX) {
+            candidates.clear();
+            for (uint32_t a = adjacency_offset[fan_vertex]; a < adjacency_offset[fan_vertex + 1]; ++a) {
+                const uint32_t t = adjacency[a];
+                if (emitted[t]) {
+                    continue;
+                }
+                emitted[t] = true;
+                order.push_back(t);
+                for (uint32_t k = 0; k < 3; ++k) {
+                    const uint32_t v = local[3 * t + k];
+                    dead_end.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time_stamp - cache_time[v] > cache_size) {
+                        cache_time[v] = time_stamp++;
+                    }
+                }
+            }
+
+            // Prefer the candidate that is still cached and will stay cached while its remaining fan is emitted.
+            uint32_t best = INVALID_INDEX;
+            int64_t best_priority = -1;
+            for (const uint32_t v: candidates) {
+                if (live[v] == 0) {
+                    continue;
+                }
+                int64_t priority = 0;
+                if (time_stamp - cache_time[v] + 2 * live[v] <= cache_size) {
+                    priority = time_stamp - cache_time[v];
+                }
+                if (priority > best_priority) {
+                    best_priority = priority;
+                    best = v;
+                }
+            }
+
+            if (best == INVALID_INDEX) {
+                best = skip_dead_end();
+                if (cluster_starts && best != INVALID_INDEX && order.size() < num_triangles) {
+                    cluster_starts->push_back(static_cast<uint32_t>(order.size()));
+                }
+            }
+            fan_vertex = best;
+        }
+        return order;
+    }
+
+    bool GetSubviewFaceRanges(const AssetCpuGeometry &geometry, std::vector<FaceRange> &ranges) {
+        ranges.clear();
+        const size_t num_faces = geometry.faces.size();
+        if (geometry.subviews.empty()) {
+            ranges.push_back({0, num_faces, -1});
+            return true;
+        }
+        for (size_t s = 0; s < geometry.subviews.size(); ++s) {
+            const auto &subview = geometry.subviews[s];
+            if (subview.index_offset % 3 != 0 || subview.index_count % 3 != 0 ||
+                size_t(subview.index_offset) + subview.index_count > 3 * num_faces) {
+                RDE_CORE_WARN("MeshOptimizer: Skipping subview '{}' with an invalid index range.", subview.name);
+                continue;
+            }
+            ranges.push_back({subview.index_offset / 3u, subview.index_count / 3u, static_cast<int>(s)});
+        }
+        std::sort(ranges.begin(), ranges.end(), [](const FaceRange &lhs, const FaceRange &rhs) {
+            return lhs.first_face < rhs.first_face;
+        });
+        for (size_t r = 1; r < ranges.size(); ++r) {
+            if (ranges[r - 1].first_face + ranges[r - 1].num_faces > ranges[r].first_face) {
+                ranges.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Result Optimize(AssetCpuGeometry &geometry, const Settings &settings) {
+        Result result;
+        auto triangles = geometry.faces.get<glm::ivec3>("f:tris");
+        if (!triangles) {
+            RDE_CORE_WARN("MeshOptimizer::Optimize: Geometry has no f:tris property.");
+            return result;
+        }
+
+        const size_t num_faces = geometry.faces.size();
+        const size_t num_vertices = geometry.getVertexCount();
+        std::vector<uint32_t> indices = FlattenTriangles(triangles.vector());
+        for (const uint32_t index: indices) {
+            if (index >= num_vertices) {
+                RDE_CORE_WARN("MeshOptimizer::Optimize: Index {} out of range ({} vertices).", index, num_vertices);
+                return result;
+            }
+        }
+        result.before = AnalyzeVertexCache(indices, num_vertices, settings.cache_size);
+
+        // --- Triangle order, one independent range per subview ---
+        if (settings.optimize_vertex_cache) {
+            std::vector<FaceRange> ranges;
+            if (!GetSubviewFaceRanges(geometry, ranges)) {
+                RDE_CORE_WARN("MeshOptimizer::Optimize: Subviews overlap, keeping the triangle order.");
+            }
+
+            auto positions = geometry.vertices.get<glm::vec3>("v:point");
+            const bool sort_overdraw = settings.optimize_overdraw && positions;
+            const std::vector<glm::vec3> *position_data = sort_overdraw ? &positions.vector() : nullptr;
+
+            std::vector<size_t> face_order(num_faces);
+            std::iota(face_order.begin(), face_order.end(), size_t(0));
+            Parallel::For(ranges.size(), 1, [&](size_t r) {
+                const FaceRange &range = ranges[r];
+                std::vector<uint32_t> cluster_starts;
+                std::vector<uint32_t> order = OptimizeVertexCache(indices, 3 * range.first_face, 3 * range.num_faces,
+                                                                  settings.cache_size,
+                                                                  position_data ? &cluster_starts : nullptr);
+                if (position_data) {
+                    SortClustersForOverdraw(order, cluster_starts, indices, 3 * range.first_face, *position_data);
+                }
+                for (size_t i = 0; i < order.size(); ++i) {
+                    face_order[range.first_face + i] = range.first_face + order[i];
+                }
+            });
+
+            geometry.faces.gather(face_order);
+            indices = FlattenTriangles(triangles.vector());
+        }
+
+        // --- Vertex order: first use in the new index buffer ---
+        // Skipped when other topology (halfedges, edges, tets) refers to vertex indices as well.
+        const bool only_triangles = geometry.halfedges.empty() && geometry.edges.empty() && geometry.tets.empty();
+        if (settings.optimize_vertex_fetch && only_triangles) {
+            std::vector<uint32_t> new_index(num_vertices, INVALID_INDEX);
+            std::vector<size_t> vertex_order;
+            vertex_order.reserve(num_vertices);
+            for (const uint32_t index: indices) {
+                if (new_index[index] == INVALID_INDEX) {
+                    new_index[index] = static_cast<uint32_t>(vertex_order.size());
+                    vertex_order.push_back(index);
+                }
+            }
+            // Unreferenced vertices are kept, behind the referenced ones.
+            for (size_t v = 0; v < num_vertices; ++v) {
+                if (new_index[v] == INVALID_INDEX) {
+                    new_index[v] = static_cast<uint32_t>(vertex_order.size());
+                    vertex_order.push_back(v);
+                }
+            }
+
+            geometry.vertices.gather(vertex_order);
+            auto &tris = triangles.vector();
+            Parallel::For(tris.size(), 1 << 14, [&](size_t f) {
+                tris[f] = glm::ivec3(new_index[tris[f].x], new_index[tris[f].y], new_index[tris[f].z]);
+                indices[3 * f + 0] = static_cast<uint32_t>(tris[f].x);
+                indices[3 * f + 1] = static_cast<uint32_t>(tris[f].y);
+                indices[3 * f + 2] = static_cast<uint32_t>(tris[f].z);
+            });
+        }
+
+        result.after = AnalyzeVertexCache(indices, num_vertices, settings.cache_size);
+        return result;
+    }
+}
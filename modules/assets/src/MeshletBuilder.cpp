@@ -0,0 +1,437 @@
+#include "assets/MeshletBuilder.h"
+#include "assets/MeshOptimizer.h"
+#include "core/Log.h"
+#include "core/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace RDE::MeshletBuilder {
+    namespace {
+        constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        struct RangeMeshlets {
+            std::vector<uint32_t> order; // Range-local triangles in meshlet order
+            std::vector<uint32_t> packed_triangles; // Meshlet-local corners of every triangle in order
+            std::vector<uint32_t> vertices; // Global vertex indices, meshlet after meshlet
+            std::vector<uint32_t> triangle_counts;
+            std::vector<uint32_t> vertex_counts;
+        };
+
+        // Greedy clustering of one face range. Starting from the first unused triangle (in the Tipsify order the
+        // importer produced), a meshlet grows by the adjacent triangle that adds the fewest new vertices until one of
+        // the limits is hit. If no adjacent triangle is left, the next unused one in order is taken.
+        RangeMeshlets BuildRange(const std::vector<glm::ivec3> &triangles, size_t first_face, size_t num_faces,
+                                 uint32_t max_vertices, uint32_t max_triangles) {
+            RangeMeshlets result;
+            const auto num_triangles = static_cast<uint32_t>(num_faces);
+            if (num_triangles == 0) {
+                return result;
+            }
+
+            // Range-local vertex ids, same as in MeshOptimizer::OptimizeVertexCache.
+            std::vector<uint32_t> local(3 * size_t(num_triangles));
+            for (uint32_t t = 0; t < num_triangles; ++t) {
+                const glm::ivec3 &tri = triangles[first_face + t];
+                local[3 * t + 0] = static_cast<uint32_t>(tri.x);
+                local[3 * t + 1] = static_cast<uint32_t>(tri.y);
+                local[3 * t + 2] = static_cast<uint32_t>(tri.z);
+            }
+            std::vector<uint32_t> unique = local;
+            std::sort(unique.begin(), unique.end());
+            unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+            for (uint32_t &index: local) {
+                index = static_cast<uint32_t>(std::lower_bound(unique.begin(), unique.end(), index) - unique.begin());
+            }
+            const auto num_vertices = static_cast<uint32_t>(unique.size());
+
+            std::vector<uint32_t> adjacency_offset(size_t(num_vertices) + 1, 0);
+            for (const uint32_t v: local) {
+                ++adjacency_offset[v + 1];
+            }
+            for (uint32_t v = 0; v < num_vertices; ++v) {
+                adjacency_offset[v + 1] += adjacency_offset[v];
+            }
+            std::vector<uint32_t> adjacency(local.size());
+            {
+                std::vector<uint32_t> cursor(adjacency_offset.begin(), adjacency_offset.end() - 1);
+                for (uint32_t t = 0; t < num_triangles; ++t) {
+                    for (uint32_t k = 0; k < 3; ++k) {
+                        adjacency[cursor[local[3 * t + k]]++] = t;
+                    }
+                }
+            }
+
+            std::vector<uint32_t> slot(num_vertices, INVALID_INDEX); // Meshlet-local index of a vertex
+            std::vector<uint32_t> queued(num_triangles, INVALID_INDEX); // Meshlet a triangle was last queued for
+            std::vector<bool> used(num_triangles, false);
+            std::vector<uint32_t> meshlet_vertices;
+            std::vector<uint32_t> candidates;
+
+            result.order.reserve(num_triangles);
+            result.packed_triangles.reserve(num_triangles);
+
+            auto count_new_vertices = [&](uint32_t t) {
+                const uint32_t a = local[3 * t + 0];
+                const uint32_t b = local[3 * t + 1];
+                const uint32_t c = local[3 * t + 2];
+                uint32_t count = slot[a] == INVALID_INDEX;
+                count += b != a && slot[b] == INVALID_INDEX;
+                count += c != a && c != b && slot[c] == INVALID_INDEX;
+                return count;
+            };
+
+            uint32_t cursor = 0;
+            uint32_t meshlet = 0;
+            while (true) {
+                while (cursor < num_triangles && used[cursor]) {
+                    ++cursor;
+                }
+                if (cursor == num_triangles) {
+                    break;
+                }
+
+                meshlet_vertices.clear();
+                candidates.clear();
+                uint32_t triangle_count = 0;
+                uint32_t next = cursor;
+                while (next != INVALID_INDEX) {
+                    used[next] = true;
+                    uint32_t corners[3];
+                    for (uint32_t k = 0; k < 3; ++k) {
+                        const uint32_t v = local[3 * next + k];
+                        if (slot[v] == INVALID_INDEX) {
+                            slot[v] = static_cast<uint32_t>(meshlet_vertices.size());
+                            meshlet_vertices.push_back(v);
+                            for (uint32_t a = adjacency_offset[v]; a < adjacency_offset[v + 1]; ++a) {
+                                const uint32_t t = adjacency[a];
+                                if (!used[t] && queued[t] != meshlet) {
+                                    queued[t] = meshlet;
+                                    candidates.push_back(t);
+                                }
+                            }
+                        }
+                        corners[k] = slot[v];
+                    }
+                    result.order.push_back(next);
+                    result.packed_triangles.push_back(corners[0] | (corners[1] << 8) | (corners[2] << 16));
+                    ++triangle_count;
+
+                    // Adjacent triangle with the fewest new vertices, one that closes a gap is taken right away.
+                    uint32_t best = INVALID_INDEX;
+                    uint32_t best_new = 4;
+                    for (size_t i = 0; i < candidates.size();) {
+                        const uint32_t t = candidates[i];
+                        if (used[t]) {
+                            candidates[i] = candidates.back();
+                            candidates.pop_back();
+                            continue;
+                        }
+                        const uint32_t new_vertices = count_new_vertices(t);
+                        if (new_vertices < best_new || (new_vertices == best_new && t < best)) {
+                            best = t;
+                            best_new = new_vertices;
+                            if (new_vertices == 0) {
+                                break;
+                            }
+                        }
+                        ++i;
+                    }
+                    if (best == INVALID_INDEX) {
+                        while (cursor < num_triangles && used[cursor]) {
+                            ++cursor;
+                        }
+                        if (cursor < num_triangles) {
+                            best = cursor;
+                            best_new = count_new_vertices(cursor);
+                        }
+                    }
+
+                    if (best == INVALID_INDEX || triangle_count == max_triangles ||
+                        meshlet_vertices.size() + best_new > max_vertices) {
+                        break;
+                    }
+                    next = best;
+                }
+
+                for (const uint32_t v: meshlet_vertices) {
+                    result.vertices.push_back(unique[v]);
+                    slot[v] = INVALID_INDEX;
+                }
+                result.triangle_counts.push_back(triangle_count);
+                result.vertex_counts.push_back(static_cast<uint32_t>(meshlet_vertices.size()));
+                ++meshlet;
+            }
+            return result;
+        }
+
+        // Bounding sphere around the AABB center and a normal cone in the form of meshoptimizer's cluster bounds:
+        // the meshlet is back facing for every camera position p with dot(normalize(apex - p), axis) >= cutoff.
+        void ComputeBounds(const std::vector<glm::vec3> &positions, const std::vector<glm::ivec3> &triangles,
+                           const uint32_t *vertices, uint32_t vertex_count, size_t first_face, uint32_t face_count,
+                           glm::vec4 &sphere, glm::vec3 &apex, glm::vec3 &axis, float &cutoff) {
+            glm::vec3 min(std::numeric_limits<float>::max());
+            glm::vec3 max(-std::numeric_limits<float>::max());
+            for (uint32_t i = 0; i < vertex_count; ++i) {
+                min = glm::min(min, positions[vertices[i]]);
+                max = glm::max(max, positions[vertices[i]]);
+            }
+            const glm::vec3 center = (min + max) * 0.5f;
+            float radius_squared = 0.0f;
+            for (uint32_t i = 0; i < vertex_count; ++i) {
+                const glm::vec3 d = positions[vertices[i]] - center;
+                radius_squared = std::max(radius_squared, glm::dot(d, d));
+            }
+            sphere = glm::vec4(center, std::sqrt(radius_squared));
+
+            glm::vec3 normal_sum(0.0f);
+            for (uint32_t f = 0; f < face_count; ++f) {
+                const glm::ivec3 &tri = triangles[first_face + f];
+                const glm::vec3 n = glm::cross(positions[tri.y] - positions[tri.x], positions[tri.z] - positions[tri.x]);
+                const float length = glm::length(n);
+                if (length > 0.0f) {
+                    normal_sum += n / length;
+                }
+            }
+
+            // Degenerate or too wide cones never cull.
+            apex = center;
+            axis = glm::vec3(0.0f);
+            cutoff = 1.0f;
+            const float sum_length = glm::length(normal_sum);
+            if (sum_length <= 0.0f) {
+                return;
+            }
+            const glm::vec3 average = normal_sum / sum_length;
+
+            float min_dot = 1.0f;
+            for (uint32_t f = 0; f < face_count && min_dot > 0.1f; ++f) {
+                const glm::ivec3 &tri = triangles[first_face + f];
+                const glm::vec3 n = glm::cross(positions[tri.y] - positions[tri.x], positions[tri.z] - positions[tri.x]);
+                const float length = glm::length(n);
+                if (length > 0.0f) {
+                    min_dot = std::min(min_dot, glm::dot(average, n / length));
+                }
+            }
+            if (min_dot <= 0.1f) {
+                return;
+            }
+
+            // Move the apex back along the axis until every triangle plane is in front of it.
+            float max_t = 0.0f;
+            for (uint32_t f = 0; f < face_count; ++f) {
+                const glm::ivec3 &tri = triangles[first_face + f];
+                const glm::vec3 n = glm::cross(positions[tri.y] - positions[tri.x], positions[tri.z] - positions[tri.x]);
+                const float length = glm::length(n);
+                if (length > 0.0f) {
+                    const glm::vec3 unit = n / length;
+                    max_t = std::max(max_t, glm::dot(center - positions[tri.x], unit) / glm::dot(average, unit));
+                }
+            }
+
+            apex = center - average * max_t;
+            axis = average;
+            cutoff = std::sqrt(1.0f - min_dot * min_dot);
+        }
+
+        template<typename T>
+        const std::vector<T> *GetVector(const PropertyContainer &container, const char *name) {
+            const auto *array = dynamic_cast<const PropertyArray<T> *>(container.get_base(name));
+            return array ? &array->vector() : nullptr;
+        }
+    }
+
+    Statistics Build(AssetCpuGeometry &geometry, const Settings &settings) {
+        Statistics stats;
+        auto triangles = geometry.faces.get<glm::ivec3>("f:tris");
+        auto positions = geometry.vertices.get<glm::vec3>("v:point");
+        if (!triangles || !positions) {
+            RDE_CORE_WARN("MeshletBuilder::Build: Geometry needs f:tris and v:point.");
+            return stats;
+        }
+        const uint32_t max_vertices = std::clamp(settings.max_vertices, 3u, 256u);
+        const uint32_t max_triangles = std::max(settings.max_triangles, 1u);
+
+        const size_t num_faces = geometry.faces.size();
+        const size_t num_vertices = geometry.getVertexCount();
+        for (const glm::ivec3 &tri: triangles.vector()) {
+            if (tri.x < 0 || tri.y < 0 || tri.z < 0 || size_t(tri.x) >= num_vertices ||
+                size_t(tri.y) >= num_vertices || size_t(tri.z) >= num_vertices) {
+                RDE_CORE_WARN("MeshletBuilder::Build: Index out of range ({} vertices).", num_vertices);
+                return stats;
+            }
+        }
+
+        std::vector<MeshOptimizer::FaceRange> subview_ranges;
+        if (!MeshOptimizer::GetSubviewFaceRanges(geometry, subview_ranges)) {
+            RDE_CORE_WARN("MeshletBuilder::Build: Subviews overlap, meshlets would cross them.");
+            return stats;
+        }
+
+        // Faces outside of every subview are clustered as well, so every face belongs to exactly one meshlet.
+        std::vector<MeshOptimizer::FaceRange> ranges;
+        size_t covered = 0;
+        for (const auto &range: subview_ranges) {
+            if (range.first_face > covered) {
+                ranges.push_back({covered, range.first_face - covered, -1});
+            }
+            ranges.push_back(range);
+            covered = range.first_face + range.num_faces;
+        }
+        if (covered < num_faces) {
+            ranges.push_back({covered, num_faces - covered, -1});
+        }
+
+        std::vector<RangeMeshlets> range_meshlets(ranges.size());
+        Parallel::For(ranges.size(), 1, [&](size_t r) {
+            range_meshlets[r] = BuildRange(triangles.vector(), ranges[r].first_face, ranges[r].num_faces,
+                                           max_vertices, max_triangles);
+        });
+
+        // --- Concatenate the ranges ---
+        size_t num_meshlets = 0;
+        size_t num_meshlet_vertices = 0;
+        for (const RangeMeshlets &range: range_meshlets) {
+            num_meshlets += range.triangle_counts.size();
+            num_meshlet_vertices += range.vertices.size();
+        }
+
+        geometry.meshlets.clear();
+        auto triangle_offsets = geometry.meshlets.add<uint32_t>("m:triangle_offset");
+        auto triangle_counts = geometry.meshlets.add<uint32_t>("m:triangle_count");
+        auto vertex_offsets = geometry.meshlets.add<uint32_t>("m:vertex_offset");
+        auto vertex_counts = geometry.meshlets.add<uint32_t>("m:vertex_count");
+        auto subviews = geometry.meshlets.add<int>("m:subview");
+        auto spheres = geometry.meshlets.add<glm::vec4>("m:bounding_sphere");
+        auto cone_apices = geometry.meshlets.add<glm::vec3>("m:cone_apex");
+        auto cone_axes = geometry.meshlets.add<glm::vec3>("m:cone_axis");
+        auto cone_cutoffs = geometry.meshlets.add<float>("m:cone_cutoff");
+        geometry.meshlets.resize(num_meshlets);
+
+        std::vector<size_t> face_order(num_faces);
+        std::vector<uint32_t> packed_triangles(num_faces);
+        std::vector<uint32_t> face_meshlet(num_faces);
+        geometry.meshlet_vertices.clear();
+        geometry.meshlet_vertices.reserve(num_meshlet_vertices);
+
+        size_t meshlet = 0;
+        for (size_t r = 0; r < ranges.size(); ++r) {
+            const RangeMeshlets &range = range_meshlets[r];
+            const size_t first_face = ranges[r].first_face;
+            for (size_t i = 0; i < range.order.size(); ++i) {
+                face_order[first_face + i] = first_face + range.order[i];
+                packed_triangles[first_face + i] = range.packed_triangles[i];
+            }
+
+            size_t face = first_face;
+            size_t vertex = 0;
+            for (size_t m = 0; m < range.triangle_counts.size(); ++m, ++meshlet) {
+                triangle_offsets[meshlet] = static_cast<uint32_t>(face);
+                triangle_counts[meshlet] = range.triangle_counts[m];
+                vertex_offsets[meshlet] = static_cast<uint32_t>(geometry.meshlet_vertices.size());
+                vertex_counts[meshlet] = range.vertex_counts[m];
+                subviews[meshlet] = ranges[r].subview;
+                std::fill_n(face_meshlet.begin() + face, range.triangle_counts[m], static_cast<uint32_t>(meshlet));
+                geometry.meshlet_vertices.insert(geometry.meshlet_vertices.end(), range.vertices.begin() + vertex,
+                                                 range.vertices.begin() + vertex + range.vertex_counts[m]);
+                face += range.triangle_counts[m];
+                vertex += range.vertex_counts[m];
+            }
+        }
+
+        geometry.faces.gather(face_order);
+        geometry.faces.get_or_add<uint32_t>("f:meshlet").vector() = std::move(face_meshlet);
+        geometry.faces.get_or_add<uint32_t>("f:meshlet_tris").vector() = std::move(packed_triangles);
+
+        // --- Bounds ---
+        const auto &tris = triangles.vector();
+        const auto &points = positions.vector();
+        Parallel::For(num_meshlets, 64, [&](size_t m) {
+            ComputeBounds(points, tris, geometry.meshlet_vertices.data() + vertex_offsets[m], vertex_counts[m],
+                          triangle_offsets[m], triangle_counts[m], spheres[m], cone_apices[m], cone_axes[m],
+                          cone_cutoffs[m]);
+        });
+
+        stats.num_meshlets = num_meshlets;
+        if (num_meshlets > 0) {
+            stats.average_vertices = static_cast<float>(num_meshlet_vertices) / static_cast<float>(num_meshlets);
+            stats.average_triangles = static_cast<float>(num_faces) / static_cast<float>(num_meshlets);
+        }
+        return stats;
+    }
+
+    void CullMeshlets(const AssetCpuGeometry &geometry, const glm::mat4 &model, const glm::vec3 &camera_position,
+                      const Plane *planes, size_t num_planes, std::vector<uint32_t> &visible_meshlets) {
+        visible_meshlets.clear();
+        const auto *spheres = GetVector<glm::vec4>(geometry.meshlets, "m:bounding_sphere");
+        const auto *apices = GetVector<glm::vec3>(geometry.meshlets, "m:cone_apex");
+        const auto *axes = GetVector<glm::vec3>(geometry.meshlets, "m:cone_axis");
+        const auto *cutoffs = GetVector<float>(geometry.meshlets, "m:cone_cutoff");
+        if (!spheres || !apices || !axes || !cutoffs) {
+            return;
+        }
+
+        // Spheres go to world space for the frustum, the camera goes to object space for the cones.
+        const float scale = std::sqrt(std::max({
+            glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+            glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+            glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))
+        }));
+        const glm::vec3 camera_local = glm::vec3(glm::inverse(model) * glm::vec4(camera_position, 1.0f));
+
+        const size_t num_meshlets = spheres->size();
+        constexpr size_t grain = 1024;
+        std::vector<std::vector<uint32_t> > chunk_visible(Parallel::GetChunkCount(num_meshlets, grain));
+        Parallel::ForChunks(num_meshlets, grain, [&](size_t chunk, size_t begin, size_t end) {
+            auto &visible = chunk_visible[chunk];
+            for (size_t m = begin; m < end; ++m) {
+                const glm::vec4 &sphere = (*spheres)[m];
+                const glm::vec3 center = glm::vec3(model * glm::vec4(glm::vec3(sphere), 1.0f));
+                const float radius = sphere.w * scale;
+                bool inside = true;
+                for (size_t p = 0; p < num_planes && inside; ++p) {
+                    inside = glm::dot(planes[p].normal, center) + planes[p].distance >= -radius;
+                }
+                if (!inside) {
+                    continue;
+                }
+
+                const glm::vec3 to_apex = (*apices)[m] - camera_local;
+                const float length = glm::length(to_apex);
+                if (length > 0.0f && glm::dot(to_apex / length, (*axes)[m]) >= (*cutoffs)[m]) {
+                    continue;
+                }
+                visible.push_back(static_cast<uint32_t>(m));
+            }
+        });
+
+        for (const auto &visible: chunk_visible) {
+            visible_meshlets.insert(visible_meshlets.end(), visible.begin(), visible.end());
+        }
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t> > GetIndexRanges(const AssetCpuGeometry &geometry,
+                                                              const std::vector<uint32_t> &visible_meshlets) {
+        std::vector<std::pair<uint32_t, uint32_t> > ranges;
+        const auto *offsets = GetVector<uint32_t>(geometry.meshlets, "m:triangle_offset");
+        const auto *counts = GetVector<uint32_t>(geometry.meshlets, "m:triangle_count");
+        if (!offsets || !counts) {
+            return ranges;
+        }
+
+        for (const uint32_t m: visible_meshlets) {
+            if (m >= offsets->size()) {
+                continue;
+            }
+            const uint32_t index_offset = 3 * (*offsets)[m];
+            const uint32_t index_count = 3 * (*counts)[m];
+            if (!ranges.empty() && ranges.back().first + ranges.back().second == index_offset) {
+                ranges.back().second += index_count;
+            } else {
+                ranges.emplace_back(index_offset, index_count);
+            }
+        }
+        return ranges;
+    }
+}
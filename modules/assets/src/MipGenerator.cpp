@@ -0,0 +1,256 @@
+#include "assets/MipGenerator.h"
+#include "core/FileIOUtils.h"
+#include "core/ParallelFor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define RDE_MIPS_SSE2 1
+#endif
+
+namespace RDE::MipGenerator {
+    namespace {
+        constexpr int MAX_TAPS = 6;
+        constexpr int TO_SRGB_STEPS = 4096;
+
+        // Source texels of output texel i are first + 2 * i .. first + 2 * i + count - 1, clamped to the edge.
+        struct Kernel {
+            int first;
+            int count;
+            std::array<float, MAX_TAPS> weights;
+        };
+
+        double BesselI0(double x) {
+            double sum = 1.0, term = 1.0;
+            for (int k = 1; k < 32; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        }
+
+        Kernel MakeKernel(Filter filter) {
+            if (filter == Filter::Box) {
+                return {0, 2, {0.5f, 0.5f}};
+            }
+            // Taps sit 0.5, 1.5 and 2.5 source texels from the output texel's center, sinc cutoff at the new
+            // Nyquist frequency, Kaiser window over 3 texels.
+            constexpr double PI = 3.14159265358979323846;
+            constexpr double ALPHA = 4.0;
+            constexpr double RADIUS = 3.0;
+            Kernel kernel{-2, MAX_TAPS, {}};
+            double sum = 0.0;
+            std::array<double, MAX_TAPS> weights{};
+            for (int k = 0; k < MAX_TAPS; ++k) {
+                const double d = (k - 2) - 0.5;
+                const double x = PI * d * 0.5;
+                const double sinc = std::sin(x) / x;
+                const double t = d / RADIUS;
+                const double window = BesselI0(ALPHA * std::sqrt(1.0 - t * t)) / BesselI0(ALPHA);
+                weights[k] = sinc * window;
+                sum += weights[k];
+            }
+            for (int k = 0; k < MAX_TAPS; ++k) {
+                kernel.weights[k] = static_cast<float>(weights[k] / sum);
+            }
+            return kernel;
+        }
+
+        const Kernel &GetKernel(Filter filter) {
+            static const Kernel box = MakeKernel(Filter::Box);
+            static const Kernel kaiser = MakeKernel(Filter::Kaiser);
+            return filter == Filter::Box ? box : kaiser;
+        }
+
+        struct ColorTables {
+            std::array<float, 256> to_linear;
+            std::array<unsigned char, TO_SRGB_STEPS + 1> to_srgb;
+        };
+
+        const ColorTables &GetColorTables() {
+            static const ColorTables tables = []() {
+                ColorTables t{};
+                for (int i = 0; i < 256; ++i) {
+                    const double c = i / 255.0;
+                    t.to_linear[i] = static_cast<float>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+                }
+                for (int i = 0; i <= TO_SRGB_STEPS; ++i) {
+                    const double l = double(i) / TO_SRGB_STEPS;
+                    const double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+                    t.to_srgb[i] = static_cast<unsigned char>(std::lround(std::clamp(c, 0.0, 1.0) * 255.0));
+                }
+                return t;
+            }();
+            return tables;
+        }
+
+        // Everything but the alpha channel of 2 and 4 channel images.
+        int GetColorChannels(int channels) {
+            return channels == 2 || channels == 4 ? channels - 1 : channels;
+        }
+
+        struct Level {
+            const unsigned char *src;
+            int src_width;
+            int src_height;
+            int dst_width;
+            int dst_height;
+            int channels;
+            bool srgb;
+            const Kernel *kernel;
+        };
+
+        // Linear source row filtered horizontally to the destination width.
+        void FilterRow(const Level &level, int y, std::vector<float> &linear, float *out) {
+            const ColorTables &tables = GetColorTables();
+            const int channels = level.channels;
+            const int color_channels = level.srgb ? GetColorChannels(channels) : 0;
+            const unsigned char *row = level.src + size_t(y) * size_t(level.src_width) * size_t(channels);
+            for (int x = 0; x < level.src_width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    const unsigned char value = row[size_t(x) * channels + c];
+                    linear[size_t(x) * channels + c] = c < color_channels ? tables.to_linear[value] : value / 255.0f;
+                }
+            }
+
+            const Kernel &kernel = *level.kernel;
+            const int last = level.src_width - 1;
+            for (int x = 0; x < level.dst_width; ++x) {
+                const int first = kernel.first + 2 * x;
+#ifdef RDE_MIPS_SSE2
+                if (channels == 4) {
+                    __m128 sum = _mm_setzero_ps();
+                    for (int k = 0; k < kernel.count; ++k) {
+                        const int sx = std::clamp(first + k, 0, last);
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(kernel.weights[k]),
+                                                         _mm_loadu_ps(&linear[size_t(sx) * 4])));
+                    }
+                    _mm_storeu_ps(out + size_t(x) * 4, sum);
+                    continue;
+                }
+#endif
+                for (int c = 0; c < channels; ++c) {
+                    float sum = 0.0f;
+                    for (int k = 0; k < kernel.count; ++k) {
+                        const int sx = std::clamp(first + k, 0, last);
+                        sum += kernel.weights[k] * linear[size_t(sx) * channels + c];
+                    }
+                    out[size_t(x) * channels + c] = sum;
+                }
+            }
+        }
+
+        void CombineRows(const Kernel &kernel, const float *const *rows, size_t count, float *out) {
+            size_t i = 0;
+#ifdef RDE_MIPS_SSE2
+            for (; i + 4 <= count; i += 4) {
+                __m128 sum = _mm_setzero_ps();
+                for (int k = 0; k < kernel.count; ++k) {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(kernel.weights[k]), _mm_loadu_ps(rows[k] + i)));
+                }
+                _mm_storeu_ps(out + i, sum);
+            }
+#endif
+            for (; i < count; ++i) {
+                float sum = 0.0f;
+                for (int k = 0; k < kernel.count; ++k) {
+                    sum += kernel.weights[k] * rows[k][i];
+                }
+                out[i] = sum;
+            }
+        }
+
+        void EncodeRow(const float *linear, int width, int channels, bool srgb, unsigned char *out) {
+            const ColorTables &tables = GetColorTables();
+            const int color_channels = srgb ? GetColorChannels(channels) : 0;
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    const float value = std::clamp(linear[size_t(x) * channels + c], 0.0f, 1.0f);
+                    out[size_t(x) * channels + c] = c < color_channels
+                                                        ? tables.to_srgb[int(value * TO_SRGB_STEPS + 0.5f)]
+                                                        : static_cast<unsigned char>(value * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+
+    int GetLevelCount(int width, int height) {
+        int levels = 1;
+        for (int size = std::max(width, height); size > 1; size /= 2) {
+            ++levels;
+        }
+        return levels;
+    }
+
+    void Downsample(const unsigned char *src, int width, int height, int channels, bool srgb, Filter filter,
+                    unsigned char *dst) {
+        const Level level{
+            src, width, height, std::max(width / 2, 1), std::max(height / 2, 1), channels, srgb, &GetKernel(filter)
+        };
+        const size_t row_floats = size_t(level.dst_width) * size_t(channels);
+        const size_t grain = std::max<size_t>(1, 16384 / row_floats);
+
+        Parallel::ForChunks(size_t(level.dst_height), grain, [&](size_t, size_t begin, size_t end) {
+            const Kernel &kernel = *level.kernel;
+            // Consecutive output rows share source rows, the filtered ones are kept in a small ring.
+            constexpr int CACHED_ROWS = MAX_TAPS + 2;
+            std::vector<float> linear(size_t(width) * size_t(channels));
+            std::vector<float> cache(CACHED_ROWS * row_floats);
+            std::array<int, CACHED_ROWS> cached_y;
+            cached_y.fill(-1);
+            std::vector<float> combined(row_floats);
+            std::array<const float *, MAX_TAPS> rows{};
+
+            for (size_t y = begin; y < end; ++y) {
+                for (int k = 0; k < kernel.count; ++k) {
+                    const int sy = std::clamp(kernel.first + 2 * int(y) + k, 0, height - 1);
+                    const int slot = sy % CACHED_ROWS;
+                    float *row = cache.data() + size_t(slot) * row_floats;
+                    if (cached_y[slot] != sy) {
+                        FilterRow(level, sy, linear, row);
+                        cached_y[slot] = sy;
+                    }
+                    rows[k] = row;
+                }
+                CombineRows(kernel, rows.data(), row_floats, combined.data());
+                EncodeRow(combined.data(), level.dst_width, channels, srgb, dst + y * row_floats);
+            }
+        });
+    }
+
+    void Generate(AssetGpuTexture &texture, Filter filter) {
+        texture.mips.clear();
+        if (texture.data.empty() || texture.width <= 0 || texture.height <= 0 || texture.channels <= 0) {
+            return;
+        }
+        const int levels = GetLevelCount(texture.width, texture.height);
+        texture.mips.reserve(levels - 1);
+        const unsigned char *src = reinterpret_cast<const unsigned char *>(texture.data.data());
+        int width = texture.width;
+        int height = texture.height;
+        for (int level = 1; level < levels; ++level) {
+            AssetTextureMip mip;
+            mip.width = std::max(width / 2, 1);
+            mip.height = std::max(height / 2, 1);
+            mip.data = ByteBuffer(size_t(mip.width) * size_t(mip.height) * size_t(texture.channels));
+            Downsample(src, width, height, texture.channels, texture.srgb, filter,
+                       reinterpret_cast<unsigned char *>(mip.data.data()));
+            texture.mips.push_back(std::move(mip));
+            src = reinterpret_cast<const unsigned char *>(texture.mips.back().data.data());
+            width = texture.mips.back().width;
+            height = texture.mips.back().height;
+        }
+    }
+
+    bool IsLinearData(std::string_view path) {
+        static constexpr std::string_view DATA_WORDS[] = {
+            "normal", "nrm", "n", "rough", "roughness", "metal", "metallic", "metalness", "ao", "occlusion", "orm",
+            "height", "disp", "displacement", "bump", "mask"
+        };
+        return FileIO::HasNameWord(path, DATA_WORDS);
+    }
+}
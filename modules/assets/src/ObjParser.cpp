@@ -0,0 +1,516 @@
+#include "assets/ObjParser.h"
+#include "core/VirtualFileSystem.h"
+#include "core/ParallelFor.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace RDE::ObjParser {
+    namespace {
+        constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+        constexpr size_t CHUNK_GRAIN = size_t(1) << 20; // Bytes, smaller files are parsed on the calling thread
+
+        struct GroupEvent {
+            uint32_t first_triangle = 0; // Chunk-local
+            bool has_name = false;
+            bool has_material = false;
+            std::string name;
+            std::string material;
+        };
+
+        struct Chunk {
+            std::vector<glm::vec3> positions;
+            std::vector<glm::vec2> texcoords;
+            std::vector<glm::vec3> normals;
+            std::vector<Corner> corners;
+            // Corners with a negative (relative) index, resolved against the chunk's own counts until the merge.
+            std::vector<uint32_t> relative_positions;
+            std::vector<uint32_t> relative_texcoords;
+            std::vector<uint32_t> relative_normals;
+            std::vector<GroupEvent> events;
+            std::vector<std::string> material_libraries;
+            size_t lines = 0;
+            size_t error_line = 0; // Chunk-local, 1-based, 0 if the chunk parsed fine
+            std::string error;
+        };
+
+        struct PolygonCorner {
+            Corner corner;
+            uint8_t relative = 0; // Bit 0: position, bit 1: texcoord, bit 2: normal
+        };
+
+        bool IsSpace(char c) {
+            return c == ' ' || c == '\t';
+        }
+
+        const char *SkipSpaces(const char *p, const char *end) {
+            while (p < end && IsSpace(*p)) {
+                ++p;
+            }
+            return p;
+        }
+
+        bool ParseFloat(const char *&p, const char *end, float &value) {
+            p = SkipSpaces(p, end);
+            if (p < end && *p == '+') {
+                ++p;
+            }
+            const auto [ptr, ec] = std::from_chars(p, end, value);
+            if (ec != std::errc()) {
+                return false;
+            }
+            p = ptr;
+            return true;
+        }
+
+        bool ParseInt(const char *&p, const char *end, int64_t &value) {
+            if (p < end && *p == '+') {
+                ++p;
+            }
+            const auto [ptr, ec] = std::from_chars(p, end, value);
+            if (ec != std::errc()) {
+                return false;
+            }
+            p = ptr;
+            return true;
+        }
+
+        // Keyword at the start of a line, followed by whitespace or the end of the line.
+        bool IsKeyword(const char *p, const char *end, const char *keyword, size_t length) {
+            return size_t(end - p) >= length && std::memcmp(p, keyword, length) == 0 &&
+                   (size_t(end - p) == length || IsSpace(p[length]));
+        }
+
+        std::string RestOfLine(const char *p, const char *end) {
+            p = SkipSpaces(p, end);
+            while (end > p && IsSpace(end[-1])) {
+                --end;
+            }
+            return {p, end};
+        }
+
+        // Converts a 1-based or negative OBJ index. Negative indices are relative to the chunk's current count and
+        // get fixed up when the chunks are merged.
+        bool ResolveIndex(int64_t raw, size_t count, int32_t &index, uint8_t &relative, uint8_t bit) {
+            if (raw > 0 && raw <= std::numeric_limits<int32_t>::max()) {
+                index = static_cast<int32_t>(raw - 1);
+                return true;
+            }
+            if (raw < 0 && -raw <= std::numeric_limits<int32_t>::max()) {
+                index = static_cast<int32_t>(static_cast<int64_t>(count) + raw);
+                relative |= bit;
+                return true;
+            }
+            return false;
+        }
+
+        bool ParseFace(const char *p, const char *end, Chunk &chunk, std::vector<PolygonCorner> &polygon) {
+            polygon.clear();
+            while (true) {
+                p = SkipSpaces(p, end);
+                if (p >= end) {
+                    break;
+                }
+                PolygonCorner pc;
+                int64_t raw = 0;
+                if (!ParseInt(p, end, raw) ||
+                    !ResolveIndex(raw, chunk.positions.size(), pc.corner.position, pc.relative, 1)) {
+                    return false;
+                }
+                if (p < end && *p == '/') {
+                    ++p;
+                    if (p < end && *p != '/') {
+                        if (!ParseInt(p, end, raw) ||
+                            !ResolveIndex(raw, chunk.texcoords.size(), pc.corner.texcoord, pc.relative, 2)) {
+                            return false;
+                        }
+                    }
+                    if (p < end && *p == '/') {
+                        ++p;
+                        if (!ParseInt(p, end, raw) ||
+                            !ResolveIndex(raw, chunk.normals.size(), pc.corner.normal, pc.relative, 4)) {
+                            return false;
+                        }
+                    }
+                }
+                if (p < end && !IsSpace(*p)) {
+                    return false;
+                }
+                polygon.push_back(pc);
+            }
+
+            // Fan triangulation, lines and points are dropped.
+            for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                for (const PolygonCorner &pc: {polygon[0], polygon[i], polygon[i + 1]}) {
+                    const auto corner = static_cast<uint32_t>(chunk.corners.size());
+                    chunk.corners.push_back(pc.corner);
+                    if (pc.relative & 1) {
+                        chunk.relative_positions.push_back(corner);
+                    }
+                    if (pc.relative & 2) {
+                        chunk.relative_texcoords.push_back(corner);
+                    }
+                    if (pc.relative & 4) {
+                        chunk.relative_normals.push_back(corner);
+                    }
+                }
+            }
+            return true;
+        }
+
+        void ParseChunk(const char *begin, const char *end, Chunk &chunk) {
+            std::vector<PolygonCorner> polygon;
+            const char *p = begin;
+            while (p < end) {
+                const char *line_end = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+                if (!line_end) {
+                    line_end = end;
+                }
+                ++chunk.lines;
+                const char *q = SkipSpaces(p, line_end);
+                const char *stop = line_end;
+                if (stop > q && stop[-1] == '\r') {
+                    --stop;
+                }
+                p = line_end + (line_end < end ? 1 : 0);
+                if (q >= stop) {
+                    continue;
+                }
+
+                const char *line = q;
+                bool ok = true;
+                switch (*q) {
+                    case 'v': {
+                        if (IsKeyword(q, stop, "v", 1)) {
+                            q += 1;
+                            glm::vec3 &v = chunk.positions.emplace_back();
+                            ok = ParseFloat(q, stop, v.x) && ParseFloat(q, stop, v.y) && ParseFloat(q, stop, v.z);
+                        } else if (IsKeyword(q, stop, "vt", 2)) {
+                            q += 2;
+                            glm::vec2 &vt = chunk.texcoords.emplace_back(0.0f);
+                            ok = ParseFloat(q, stop, vt.x);
+                            if (ok && SkipSpaces(q, stop) < stop) {
+                                ok = ParseFloat(q, stop, vt.y);
+                            }
+                        } else if (IsKeyword(q, stop, "vn", 2)) {
+                            q += 2;
+                            glm::vec3 &vn = chunk.normals.emplace_back();
+                            ok = ParseFloat(q, stop, vn.x) && ParseFloat(q, stop, vn.y) && ParseFloat(q, stop, vn.z);
+                        }
+                        break;
+                    }
+                    case 'f': {
+                        if (IsKeyword(q, stop, "f", 1)) {
+                            ok = ParseFace(q + 1, stop, chunk, polygon);
+                        }
+                        break;
+                    }
+                    case 'o':
+                    case 'g': {
+                        if (IsKeyword(q, stop, "o", 1) || IsKeyword(q, stop, "g", 1)) {
+                            GroupEvent &event = chunk.events.emplace_back();
+                            event.first_triangle = static_cast<uint32_t>(chunk.corners.size() / 3);
+                            event.has_name = true;
+                            event.name = RestOfLine(q + 1, stop);
+                        }
+                        break;
+                    }
+                    case 'u': {
+                        if (IsKeyword(q, stop, "usemtl", 6)) {
+                            GroupEvent &event = chunk.events.emplace_back();
+                            event.first_triangle = static_cast<uint32_t>(chunk.corners.size() / 3);
+                            event.has_material = true;
+                            event.material = RestOfLine(q + 6, stop);
+                        }
+                        break;
+                    }
+                    case 'm': {
+                        if (IsKeyword(q, stop, "mtllib", 6)) {
+                            chunk.material_libraries.push_back(RestOfLine(q + 6, stop));
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+
+                if (!ok) {
+                    chunk.error_line = chunk.lines;
+                    chunk.error = "Malformed '" + std::string(line, std::min<size_t>(size_t(stop - line), 64)) + "'";
+                    return;
+                }
+            }
+        }
+
+        uint64_t HashCorner(const Corner &corner) {
+            uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(corner.position)) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint64_t>(static_cast<uint32_t>(corner.texcoord)) * 0xC2B2AE3D27D4EB4Full;
+            h ^= static_cast<uint64_t>(static_cast<uint32_t>(corner.normal)) * 0x165667B19E3779F9ull;
+            h ^= h >> 29;
+            h *= 0xBF58476D1CE4E5B9ull;
+            h ^= h >> 32;
+            return h;
+        }
+
+        // One shard per 64K corners up to this many.
+        constexpr size_t MAX_WELD_SHARDS = 64;
+
+        size_t ShardOf(uint64_t hash, size_t num_shards) {
+            return static_cast<size_t>(((hash >> 32) * num_shards) >> 32);
+        }
+
+        // Linear probing table from corner to a shard-local vertex id, grows at 70% load.
+        class CornerTable {
+        public:
+            explicit CornerTable(size_t expected) {
+                size_t capacity = 1024;
+                while (capacity * 7 < expected * 10) {
+                    capacity *= 2;
+                }
+                m_slots.resize(capacity);
+            }
+
+            uint32_t insert(const Corner &key, uint64_t hash, std::vector<Corner> &unique) {
+                if ((unique.size() + 1) * 10 > m_slots.size() * 7) {
+                    grow(unique);
+                }
+                const size_t mask = m_slots.size() - 1;
+                for (size_t i = hash & mask;; i = (i + 1) & mask) {
+                    Slot &slot = m_slots[i];
+                    if (slot.id == INVALID_INDEX) {
+                        slot.key = key;
+                        slot.id = static_cast<uint32_t>(unique.size());
+                        unique.push_back(key);
+                        return slot.id;
+                    }
+                    if (slot.key == key) {
+                        return slot.id;
+                    }
+                }
+            }
+
+        private:
+            struct Slot {
+                Corner key;
+                uint32_t id = INVALID_INDEX;
+            };
+
+            void grow(const std::vector<Corner> &unique) {
+                std::vector<Slot> slots(m_slots.size() * 2);
+                const size_t mask = slots.size() - 1;
+                for (uint32_t id = 0; id < unique.size(); ++id) {
+                    size_t i = HashCorner(unique[id]) & mask;
+                    while (slots[i].id != INVALID_INDEX) {
+                        i = (i + 1) & mask;
+                    }
+                    slots[i].key = unique[id];
+                    slots[i].id = id;
+                }
+                m_slots = std::move(slots);
+            }
+
+            std::vector<Slot> m_slots;
+        };
+    }
+
+    bool Parse(const char *data, size_t size, ObjData &out, std::string *error) {
+        out = ObjData();
+        if (size == 0) {
+            return true;
+        }
+
+        // --- Split at line boundaries ---
+        const size_t num_chunks = Parallel::GetChunkCount(size, CHUNK_GRAIN);
+        std::vector<size_t> bounds(num_chunks + 1, size);
+        bounds[0] = 0;
+        for (size_t c = 1; c < num_chunks; ++c) {
+            size_t begin = std::max(bounds[c - 1], size / num_chunks * c);
+            const void *newline = std::memchr(data + begin, '\n', size - begin);
+            bounds[c] = newline ? static_cast<size_t>(static_cast<const char *>(newline) - data) + 1 : size;
+        }
+
+        std::vector<Chunk> chunks(num_chunks);
+        Parallel::For(num_chunks, 1, [&](size_t c) {
+            ParseChunk(data + bounds[c], data + bounds[c + 1], chunks[c]);
+        });
+
+        size_t line_base = 0;
+        for (const Chunk &chunk: chunks) {
+            if (!chunk.error.empty()) {
+                if (error) {
+                    *error = "Line " + std::to_string(line_base + chunk.error_line) + ": " + chunk.error;
+                }
+                return false;
+            }
+            line_base += chunk.lines;
+        }
+
+        // --- Merge ---
+        struct Bases {
+            size_t positions = 0;
+            size_t texcoords = 0;
+            size_t normals = 0;
+            size_t corners = 0;
+        };
+        std::vector<Bases> bases(num_chunks + 1);
+        for (size_t c = 0; c < num_chunks; ++c) {
+            bases[c + 1].positions = bases[c].positions + chunks[c].positions.size();
+            bases[c + 1].texcoords = bases[c].texcoords + chunks[c].texcoords.size();
+            bases[c + 1].normals = bases[c].normals + chunks[c].normals.size();
+            bases[c + 1].corners = bases[c].corners + chunks[c].corners.size();
+        }
+        const Bases &total = bases.back();
+        if (total.corners / 3 > std::numeric_limits<uint32_t>::max() ||
+            total.positions > size_t(std::numeric_limits<int32_t>::max())) {
+            if (error) {
+                *error = "File exceeds 2^31 vertices or 2^32 triangles";
+            }
+            return false;
+        }
+        out.positions.resize(total.positions);
+        out.texcoords.resize(total.texcoords);
+        out.normals.resize(total.normals);
+        out.corners.resize(total.corners);
+
+        std::vector<uint8_t> chunk_valid(num_chunks, 1);
+        Parallel::For(num_chunks, 1, [&](size_t c) {
+            Chunk &chunk = chunks[c];
+            const Bases &base = bases[c];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), out.positions.begin() + base.positions);
+            std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), out.texcoords.begin() + base.texcoords);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), out.normals.begin() + base.normals);
+            for (const uint32_t corner: chunk.relative_positions) {
+                chunk.corners[corner].position += static_cast<int32_t>(base.positions);
+            }
+            for (const uint32_t corner: chunk.relative_texcoords) {
+                chunk.corners[corner].texcoord += static_cast<int32_t>(base.texcoords);
+            }
+            for (const uint32_t corner: chunk.relative_normals) {
+                chunk.corners[corner].normal += static_cast<int32_t>(base.normals);
+            }
+            for (const Corner &corner: chunk.corners) {
+                if (corner.position < 0 || size_t(corner.position) >= total.positions ||
+                    corner.texcoord >= static_cast<int64_t>(total.texcoords) || corner.texcoord < -1 ||
+                    corner.normal >= static_cast<int64_t>(total.normals) || corner.normal < -1) {
+                    chunk_valid[c] = 0;
+                    break;
+                }
+            }
+            std::copy(chunk.corners.begin(), chunk.corners.end(), out.corners.begin() + base.corners);
+            // Release the chunk's copy early, multi-GB files would otherwise need twice the memory.
+            chunk.positions = {};
+            chunk.texcoords = {};
+            chunk.normals = {};
+            chunk.corners = {};
+        });
+        for (const uint8_t valid: chunk_valid) {
+            if (!valid) {
+                if (error) {
+                    *error = "Face index out of range";
+                }
+                out = ObjData();
+                return false;
+            }
+        }
+
+        // --- Groups: o/g/usemtl state carries over chunk boundaries ---
+        Group current;
+        auto close_group = [&](uint32_t end_triangle) {
+            current.triangle_count = end_triangle - current.first_triangle;
+            if (current.triangle_count > 0) {
+                out.groups.push_back(current);
+            }
+            current.first_triangle = end_triangle;
+        };
+        for (size_t c = 0; c < num_chunks; ++c) {
+            const auto triangle_base = static_cast<uint32_t>(bases[c].corners / 3);
+            for (const GroupEvent &event: chunks[c].events) {
+                close_group(triangle_base + event.first_triangle);
+                if (event.has_name) {
+                    current.name = event.name;
+                }
+                if (event.has_material) {
+                    current.material = event.material;
+                }
+            }
+            out.material_libraries.insert(out.material_libraries.end(), chunks[c].material_libraries.begin(),
+                                          chunks[c].material_libraries.end());
+        }
+        close_group(static_cast<uint32_t>(total.corners / 3));
+        return true;
+    }
+
+    bool ParseFile(const std::filesystem::path &path, ObjData &out, std::string *error) {
+        FileView file = VFS::Open(path.string());
+        if (!file.is_open()) {
+            if (error) {
+                *error = "Could not open the file";
+            }
+            return false;
+        }
+        return Parse(file.data(), file.size(), out, error);
+    }
+
+    std::vector<std::string> ScanMaterialLibraries(const char *data, size_t size) {
+        std::vector<std::string> libraries;
+        const char *p = data;
+        const char *end = data + size;
+        while (p < end) {
+            const char *line_end = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+            if (!line_end) {
+                line_end = end;
+            }
+            const char *q = SkipSpaces(p, line_end);
+            const char *stop = line_end > q && line_end[-1] == '\r' ? line_end - 1 : line_end;
+            if (IsKeyword(q, stop, "f", 1)) {
+                break;
+            }
+            if (IsKeyword(q, stop, "mtllib", 6)) {
+                libraries.push_back(RestOfLine(q + 6, stop));
+            }
+            p = line_end + 1;
+        }
+        return libraries;
+    }
+
+    std::vector<Corner> WeldCorners(const std::vector<Corner> &corners, std::vector<uint32_t> &indices) {
+        indices.resize(corners.size());
+        // The shard count follows the input alone, never the worker count, so the vertex order is reproducible.
+        const size_t num_shards = std::clamp<size_t>(corners.size() >> 16, 1, MAX_WELD_SHARDS);
+
+        std::vector<uint64_t> hashes(corners.size());
+        Parallel::For(corners.size(), size_t(1) << 16, [&](size_t c) {
+            hashes[c] = HashCorner(corners[c]);
+        });
+        // Corners of a shard stay in input order, each shard numbers its vertices in order of first use.
+        std::vector<std::vector<uint32_t> > shard_corners(num_shards);
+        for (size_t c = 0; c < corners.size(); ++c) {
+            shard_corners[ShardOf(hashes[c], num_shards)].push_back(static_cast<uint32_t>(c));
+        }
+
+        // Each corner and each table entry is written by exactly one thread.
+        std::vector<std::vector<Corner> > shard_unique(num_shards);
+        Parallel::For(num_shards, 1, [&](size_t shard) {
+            std::vector<Corner> &unique = shard_unique[shard];
+            CornerTable table(shard_corners[shard].size() / 3);
+            for (const uint32_t c: shard_corners[shard]) {
+                indices[c] = table.insert(corners[c], hashes[c], unique);
+            }
+        });
+
+        std::vector<uint32_t> shard_base(num_shards + 1, 0);
+        for (size_t shard = 0; shard < num_shards; ++shard) {
+            shard_base[shard + 1] = shard_base[shard] + static_cast<uint32_t>(shard_unique[shard].size());
+        }
+        std::vector<Corner> unique(shard_base.back());
+        Parallel::For(num_shards, 1, [&](size_t shard) {
+            for (const uint32_t c: shard_corners[shard]) {
+                indices[c] += shard_base[shard];
+            }
+            std::copy(shard_unique[shard].begin(), shard_unique[shard].end(), unique.begin() + shard_base[shard]);
+        });
+        return unique;
+    }
+}
@@ -0,0 +1,190 @@
+#include "assets/PrefabLoader.h"
+#include "assets/AssetComponentTypes.h"
+#include "assets/AssetManager.h"
+#include "assets/AssetTelemetry.h"
+#include "assets/DependencyCache.h"
+#include "core/VirtualFileSystem.h"
+
+#include <yaml-cpp/yaml.h>
+#include <utility>
+
+namespace RDE {
+    namespace {
+        glm::vec3 ReadVec3(const YAML::Node &node, const glm::vec3 &fallback) {
+            if (!node) {
+                return fallback;
+            }
+            const auto v = node.as<std::vector<float> >();
+            return v.size() >= 3 ? glm::vec3(v[0], v[1], v[2]) : fallback;
+        }
+
+        // Written as [x, y, z, w].
+        glm::quat ReadQuat(const YAML::Node &node) {
+            if (!node) {
+                return {1.0f, 0.0f, 0.0f, 0.0f};
+            }
+            const auto v = node.as<std::vector<float> >();
+            return v.size() >= 4 ? glm::normalize(glm::quat(v[3], v[0], v[1], v[2])) : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        }
+
+        // Children are listed either directly on the node or in its hierarchy block.
+        YAML::Node GetChildren(const YAML::Node &node) {
+            if (node["children"]) {
+                return node["children"];
+            }
+            return node["hierarchy"] ? node["hierarchy"]["children"] : YAML::Node();
+        }
+
+        AssetID ResolveReference(const YAML::Node &index_node, const YAML::Node &paths, const char *kind,
+                                 const std::string &uri, AssetManager &manager) {
+            if (!index_node) {
+                return nullptr;
+            }
+            const int index = index_node.as<int>();
+            if (index < 0 || size_t(index) >= paths.size()) {
+                RDE_CORE_WARN("Prefab '{}' references {} {} out of {}", uri, kind, index, paths.size());
+                return nullptr;
+            }
+            const std::string path = paths[index].as<std::string>();
+            AssetID asset_id = manager.get_loaded_asset(get_asset_path().value() / path);
+            if (!asset_id) {
+                RDE_CORE_WARN("Prefab '{}' references {} '{}' which is not loaded", uri, kind, path);
+            }
+            return asset_id;
+        }
+    }
+
+    std::vector<std::string> PrefabLoader::get_supported_extensions() const {
+        return {".prefab"};
+    }
+
+    AssetID PrefabLoader::load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const {
+        FileView file;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            file = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(file.size());
+        }
+        if (!file.is_open()) {
+            RDE_CORE_ERROR("Failed to open prefab '{}'", uri);
+            return nullptr;
+        }
+        return load_asset_from_memory(uri, file.data(), file.size(), db, manager);
+    }
+
+    AssetID PrefabLoader::load_asset_from_memory(const std::string &uri, const char *data, size_t size,
+                                                 AssetDatabase &db, AssetManager &manager) const {
+        YAML::Node doc;
+        try {
+            doc = YAML::Load(std::string(data, size));
+        } catch (const YAML::Exception &e) {
+            RDE_CORE_ERROR("Failed to load/parse prefab '{}': {}", uri, e.what());
+            return nullptr;
+        }
+
+        if (doc["version"] && !check_version(doc["version"].as<std::string>())) {
+            RDE_CORE_WARN("Prefab '{}' has unsupported version. Expected {}", uri, get_expected_version());
+        }
+        const std::string name = doc["name"]
+                                     ? doc["name"].as<std::string>()
+                                     : std::filesystem::path(uri).stem().string();
+
+        const YAML::Node nodes = doc["nodes"];
+        if (!nodes || !nodes.IsSequence() || nodes.size() == 0) {
+            RDE_CORE_ERROR("Prefab '{}' has no nodes", uri);
+            return nullptr;
+        }
+
+        // --- Flatten the tree depth first, parents before their children ---
+        Prefab prefab;
+        prefab.nodes.reserve(nodes.size());
+        try {
+            const YAML::Node meshes = doc["dependencies"]["meshes"];
+            const YAML::Node materials = doc["dependencies"]["materials"];
+            const YAML::Node scene = doc["scene"];
+            const int root = scene && scene["root"] ? scene["root"].as<int>() : 0;
+            if (root < 0 || size_t(root) >= nodes.size()) {
+                RDE_CORE_ERROR("Prefab '{}' has root {} out of {} nodes", uri, root, nodes.size());
+                return nullptr;
+            }
+
+            std::vector<bool> visited(nodes.size(), false);
+            std::vector<std::pair<int, int32_t> > stack{{root, -1}}; // Source node, index of its parent in prefab
+            while (!stack.empty()) {
+                const auto [source_index, parent] = stack.back();
+                stack.pop_back();
+                if (visited[source_index]) {
+                    RDE_CORE_WARN("Prefab '{}' reaches node {} twice, ignoring the second parent", uri, source_index);
+                    continue;
+                }
+                visited[source_index] = true;
+
+                const YAML::Node source = nodes[source_index];
+                Prefab::Node &node = prefab.nodes.emplace_back();
+                node.name = source["name"] ? source["name"].as<std::string>() : "Node_" + std::to_string(source_index);
+                node.parent = parent;
+                if (const YAML::Node transform = source["transform"]) {
+                    node.translation = ReadVec3(transform["translation"], node.translation);
+                    node.orientation = ReadQuat(transform["orientation"]);
+                    node.scale = ReadVec3(transform["scale"], node.scale);
+                }
+                node.mesh_asset = ResolveReference(source["mesh"], meshes, "mesh", uri, manager);
+                node.material_asset = ResolveReference(source["material"], materials, "material", uri, manager);
+
+                // Pushed in reverse, so siblings keep their order.
+                const YAML::Node children = GetChildren(source);
+                const auto index = static_cast<int32_t>(prefab.nodes.size() - 1);
+                for (size_t c = children.size(); c-- > 0;) {
+                    const int child = children[c].as<int>();
+                    if (child < 0 || size_t(child) >= nodes.size()) {
+                        RDE_CORE_WARN("Prefab '{}' node {} has child {} out of {} nodes", uri, source_index, child,
+                                      nodes.size());
+                        continue;
+                    }
+                    stack.emplace_back(child, index);
+                }
+            }
+        } catch (const YAML::Exception &e) {
+            RDE_CORE_ERROR("Invalid node in prefab '{}': {}", uri, e.what());
+            return nullptr;
+        }
+        if (prefab.nodes.size() != nodes.size()) {
+            RDE_CORE_WARN("Prefab '{}': {} nodes are not reachable from the root and were skipped", uri,
+                          nodes.size() - prefab.nodes.size());
+        }
+
+        // --- Final Asset Creation ---
+        auto &registry = db.get_registry();
+        entt::entity entity_id = registry.create();
+        const size_t num_nodes = prefab.nodes.size();
+        registry.emplace<Prefab>(entity_id, std::move(prefab));
+        registry.emplace<AssetName>(entity_id, name);
+        registry.emplace<AssetFilepath>(entity_id, uri);
+
+        RDE_CORE_INFO("Loaded prefab '{}' with {} nodes", uri, num_nodes);
+        return std::make_shared<AssetID_Data>(entity_id, uri);
+    }
+
+    std::vector<std::string> PrefabLoader::get_dependencies(const std::string &uri) const {
+        std::vector<std::string> deps;
+        FileView file = VFS::Open(uri);
+        if (!file.is_open()) {
+            return deps;
+        }
+        YAML::Node doc;
+        try {
+            doc = YAML::Load(ExtractYamlBlock({file.data(), file.size()}, "dependencies"));
+        } catch (const YAML::Exception &e) {
+            RDE_CORE_WARN("Failed to scan dependencies of '{}': {}", uri, e.what());
+            return deps;
+        }
+
+        for (const auto &node: doc["dependencies"]["meshes"]) {
+            deps.push_back(node.as<std::string>());
+        }
+        for (const auto &node: doc["dependencies"]["materials"]) {
+            deps.push_back(node.as<std::string>());
+        }
+        return deps;
+    }
+}
@@ -2,100 +2,138 @@
 #include "assets/ShaderDefLoader.h"
 #include "assets/AssetComponentTypes.h"
 #include "assets/AssetManager.h"
+#include "assets/AssetTelemetry.h"
+#include "assets/DependencyCache.h"
+#include "assets/ManifestFile.h"
 #include "core/Log.h"
+#include "core/VirtualFileSystem.h"
 #include "ral/EnumUtils.h"
 
 #include <yaml-cpp/yaml.h>
 
 namespace RDE {
-    std::vector<std::string> ShaderDefLoader::get_supported_extensions() const {
-        return {".shaderdef"};
-    }
-
-    // This loader parses the shader contract and stores it in an AssetShaderDef component.
-    AssetID ShaderDefLoader::load_asset(const std::string &uri, AssetDatabase &db,
-                                        [[maybe_unused]] AssetManager &manager) const {
-        YAML::Node doc;
-        try {
-            doc = YAML::LoadFile(uri);
-        } catch (const YAML::Exception &e) {
-            RDE_CORE_ERROR("Failed to load/parse shader manifest '{}': {}", uri, e.what());
-            return nullptr;
-        }
-
-        if (doc["version"] && !check_version(doc["version"].as<std::string>())) {
-            RDE_CORE_WARN("ShaderDef '{}' has unsupported version. Expected {}", uri, get_expected_version());
-            // Decide if this should be a fatal error
-        }
+    namespace {
+        // Parses the authoring form of the shader contract.
+        bool CompileShaderDef(const std::string &uri, const char *data, size_t size, const ILoader &loader,
+                              AssetShaderDef &shaderDefComponent) {
+            YAML::Node doc;
+            try {
+                doc = YAML::Load(std::string(data, size));
+            } catch (const YAML::Exception &e) {
+                RDE_CORE_ERROR("Failed to load/parse shader manifest '{}': {}", uri, e.what());
+                return false;
+            }
 
-        AssetShaderDef shaderDefComponent;
+            if (doc["version"] && !loader.check_version(doc["version"].as<std::string>())) {
+                RDE_CORE_WARN("ShaderDef '{}' has unsupported version. Expected {}", uri,
+                              loader.get_expected_version());
+                // Decide if this should be a fatal error
+            }
 
-        if (doc["name"]) shaderDefComponent.name = doc["name"].as<std::string>();
+            if (doc["name"]) shaderDefComponent.name = doc["name"].as<std::string>();
 
-        // --- Parse Dependencies ---
-        if (const auto &depsNode = doc["dependencies"]) {
-            if(const auto &spirvDepsNode = depsNode["spirv"]) {
-                for (const auto &valNode: spirvDepsNode) {
-                    shaderDefComponent.dependencies.spirv_dependencies.push_back(valNode.as<std::string>());
+            // --- Parse Dependencies ---
+            if (const auto &depsNode = doc["dependencies"]) {
+                if(const auto &spirvDepsNode = depsNode["spirv"]) {
+                    for (const auto &valNode: spirvDepsNode) {
+                        shaderDefComponent.dependencies.spirv_dependencies.push_back(valNode.as<std::string>());
+                    }
                 }
-            }
-            if(const auto &sourceDepsNode = depsNode["source"]) {
-                for (const auto &valNode: sourceDepsNode) {
-                    shaderDefComponent.dependencies.source_dependencies.push_back(valNode.as<std::string>());
+                if(const auto &sourceDepsNode = depsNode["source"]) {
+                    for (const auto &valNode: sourceDepsNode) {
+                        shaderDefComponent.dependencies.source_dependencies.push_back(valNode.as<std::string>());
+                    }
                 }
-            }
-            if(const auto &includeDepsNode = depsNode["include"]) {
-                for (const auto &valNode: includeDepsNode) {
-                    shaderDefComponent.dependencies.include_dependencies.push_back(valNode.as<std::string>());
+                if(const auto &includeDepsNode = depsNode["include"]) {
+                    for (const auto &valNode: includeDepsNode) {
+                        shaderDefComponent.dependencies.include_dependencies.push_back(valNode.as<std::string>());
+                    }
                 }
             }
-        }
 
-        // --- Parse Features ---
-        if (const auto &featuresNode = doc["features"]) {
-            for (const auto &featureNode: featuresNode) {
-                shaderDefComponent.features.push_back(featureNode.as<std::string>());
+            // --- Parse Features ---
+            if (const auto &featuresNode = doc["features"]) {
+                for (const auto &featureNode: featuresNode) {
+                    shaderDefComponent.features.push_back(featureNode.as<std::string>());
+                }
             }
-        }
 
-        // --- Parse Interface (The Contract) ---
-        if (const auto &interfaceNode = doc["interface"]) {
-            // Parse Vertex Attributes
-            if (const auto &attrsNode = interfaceNode["vertex_attributes"]) {
-                for (const auto &attrNode: attrsNode) {
-                    ConditionalVertexAttribute attr;
-                    attr.location = attrNode["location"].as<uint32_t>();
-                    attr.format = string_to_ral_format(attrNode["format"].as<std::string>());
-                    attr.name = attrNode["semantic"].as<std::string>();
-                    shaderDefComponent.vertexAttributes.emplace_back(attr);
+            // --- Parse Interface (The Contract) ---
+            if (const auto &interfaceNode = doc["interface"]) {
+                // Parse Vertex Attributes
+                if (const auto &attrsNode = interfaceNode["vertex_attributes"]) {
+                    for (const auto &attrNode: attrsNode) {
+                        ConditionalVertexAttribute attr{};
+                        attr.location = attrNode["location"].as<uint32_t>();
+                        attr.format = string_to_ral_format(attrNode["format"].as<std::string>());
+                        attr.name = attrNode["semantic"].as<std::string>();
+                        shaderDefComponent.vertexAttributes.emplace_back(attr);
+                    }
                 }
-            }
-            // Parse Descriptor Sets
-            if (const auto &setsNode = interfaceNode["sets"]) {
-                for (const auto &setNode: setsNode) {
-                    ConditionalDescriptorSetLayout setLayoutDesc;
-                    setLayoutDesc.set = setNode["set"].as<uint32_t>();
-                    for (const auto &bindingNode: setNode["bindings"]) {
-                        ConditionalDescriptorBinding binding;
-                        binding.stages = string_to_shader_stages_mask(bindingNode["stage"].as<std::string>());
-                        binding.binding = bindingNode["binding"].as<uint32_t>();
-                        binding.type = string_to_descriptor_type(bindingNode["type"].as<std::string>());
-                        binding.name = bindingNode["name"].as<std::string>();
-                        setLayoutDesc.bindings.emplace_back(binding);
+                // Parse Descriptor Sets
+                if (const auto &setsNode = interfaceNode["sets"]) {
+                    for (const auto &setNode: setsNode) {
+                        ConditionalDescriptorSetLayout setLayoutDesc{};
+                        setLayoutDesc.set = setNode["set"].as<uint32_t>();
+                        for (const auto &bindingNode: setNode["bindings"]) {
+                            ConditionalDescriptorBinding binding{};
+                            binding.stages = string_to_shader_stages_mask(bindingNode["stage"].as<std::string>());
+                            binding.binding = bindingNode["binding"].as<uint32_t>();
+                            binding.type = string_to_descriptor_type(bindingNode["type"].as<std::string>());
+                            binding.name = bindingNode["name"].as<std::string>();
+                            setLayoutDesc.bindings.emplace_back(binding);
+                        }
+                        shaderDefComponent.descriptorSetLayouts.push_back(setLayoutDesc);
                     }
-                    shaderDefComponent.descriptorSetLayouts.push_back(setLayoutDesc);
                 }
-            }
-            // Parse Push Constants
-            if (const auto &pushConstantsNode = interfaceNode["push_constants"]) {
-                for (const auto &pcNode: pushConstantsNode) {
-                    RAL::PushConstantRange pcRange;
-                    pcRange.size = pcNode["size"].as<uint32_t>();
-                    pcRange.stages = string_to_shader_stage(pcNode["stage"].as<std::string>());
-                    pcRange.name = pcNode["name"].as<std::string>();
-                    shaderDefComponent.pushConstantRanges.emplace_back(pcRange);
+                // Parse Push Constants
+                if (const auto &pushConstantsNode = interfaceNode["push_constants"]) {
+                    for (const auto &pcNode: pushConstantsNode) {
+                        RAL::PushConstantRange pcRange{};
+                        pcRange.size = pcNode["size"].as<uint32_t>();
+                        pcRange.stages = string_to_shader_stage(pcNode["stage"].as<std::string>());
+                        pcRange.name = pcNode["name"].as<std::string>();
+                        shaderDefComponent.pushConstantRanges.emplace_back(pcRange);
+                    }
                 }
             }
+            return true;
+        }
+    }
+
+    std::vector<std::string> ShaderDefLoader::get_supported_extensions() const {
+        return {".shaderdef"};
+    }
+
+    std::string ShaderDefLoader::get_import_settings() const {
+        return "manifest=" + std::to_string(ManifestFile::VERSION);
+    }
+
+    // This loader parses the shader contract and stores it in an AssetShaderDef component.
+    AssetID ShaderDefLoader::load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const {
+        FileView file;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            file = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(file.size());
+        }
+        if (!file.is_open()) {
+            RDE_CORE_ERROR("Failed to open shader manifest '{}'", uri);
+            return nullptr;
+        }
+        return load_asset_from_memory(uri, file.data(), file.size(), db, manager);
+    }
+
+    AssetID ShaderDefLoader::load_asset_from_memory(const std::string &uri, const char *data, size_t size,
+                                                    AssetDatabase &db, AssetManager &manager) const {
+        // The YAML is only parsed the first time this exact source is seen.
+        AssetShaderDef shaderDefComponent;
+        const bool loaded = ManifestFile::LoadOrCompile(manager.get_derived_data_cache(), uri, data, size, *this,
+                                                        shaderDefComponent, [&](AssetShaderDef &out) {
+                                                            return CompileShaderDef(uri, data, size, *this, out);
+                                                        });
+        if (!loaded) {
+            return nullptr;
         }
 
         // --- Create the asset entity ---
@@ -110,12 +148,16 @@ namespace RDE {
         return std::make_shared<AssetID_Data>(entity_id, uri);
     }
 
-    // Fast dependency scan of the YAML file.
+    // Fast dependency scan: only the top level dependencies block is handed to the YAML parser.
     std::vector<std::string> ShaderDefLoader::get_dependencies(const std::string &uri) const {
         std::vector<std::string> deps;
+        FileView file = VFS::Open(uri);
+        if (!file.is_open()) {
+            return deps;
+        }
         YAML::Node doc;
         try {
-            doc = YAML::LoadFile(uri);
+            doc = YAML::Load(ExtractYamlBlock({file.data(), file.size()}, "dependencies"));
         } catch (const YAML::Exception &e) { return deps; }
 
         if (const auto &depsNode = doc["dependencies"]) {
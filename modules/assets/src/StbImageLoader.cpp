@@ -1,12 +1,89 @@
 #include "assets/StbImageLoader.h"
 #include "assets/AssetComponentTypes.h"
+#include "assets/BlockCompression.h"
+#include "assets/AssetTelemetry.h"
+#include "assets/MipGenerator.h"
 #include "core/Log.h"
+#include "core/VirtualFileSystem.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 namespace RDE {
+    namespace {
+        // Derived data layout: this header followed by the pixels of every level, level 0 first.
+        struct DecodedImageHeader {
+            char magic[4];
+            int32_t width;
+            int32_t height;
+            int32_t channels;
+            int32_t level_count;
+            int32_t srgb;
+            int32_t normal_map;
+            int32_t format; // RAL::Format of the levels, UNKNOWN for 8 bit pixels
+        };
+
+        constexpr char DECODED_IMAGE_MAGIC[4] = {'R', 'D', 'E', 'I'};
+
+        struct DecodedImage final : DecodedAsset {
+            AssetGpuTexture texture;
+        };
+
+        // Bottom row first, as the renderer expects. stbi_set_flip_vertically_on_load is global state, so the rows are
+        // swapped here instead, in place.
+        void FlipRows(char *pixels, size_t row_size, int height) {
+            for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom) {
+                std::swap_ranges(pixels + size_t(top) * row_size, pixels + size_t(top + 1) * row_size,
+                                 pixels + size_t(bottom) * row_size);
+            }
+        }
+
+        AssetID CreateTextureAsset(const std::string &uri, AssetGpuTexture texture, AssetDatabase &db) {
+            auto &registry = db.get_registry();
+            auto entity_id = registry.create();
+
+            registry.emplace<AssetGpuTexture>(entity_id, std::move(texture));
+            registry.emplace<AssetFilepath>(entity_id, uri);
+            registry.emplace<AssetName>(entity_id, std::filesystem::path(uri).filename().string());
+            return std::make_shared<AssetID_Data>(entity_id, uri);
+        }
+
+        bool HasTranslucentPixels(const AssetGpuTexture &texture) {
+            if (texture.channels != 2 && texture.channels != 4) {
+                return false;
+            }
+            const auto *pixels = reinterpret_cast<const unsigned char *>(texture.data.data());
+            const size_t count = size_t(texture.width) * size_t(texture.height);
+            for (size_t i = 0; i < count; ++i) {
+                if (pixels[i * texture.channels + texture.channels - 1] != 255) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const char *GetQualityName(BlockCompression::Quality quality) {
+            switch (quality) {
+                case BlockCompression::Quality::Fast: return "fast";
+                case BlockCompression::Quality::Normal: return "normal";
+                default: return "high";
+            }
+        }
+
+        size_t GetLevelSize(const DecodedImageHeader &header, int level) {
+            const int width = std::max(header.width >> level, 1);
+            const int height = std::max(header.height >> level, 1);
+            const auto format = static_cast<RAL::Format>(header.format);
+            if (format != RAL::Format::UNKNOWN) {
+                return BlockCompression::GetCompressedSize(format, width, height);
+            }
+            return size_t(width) * size_t(height) * size_t(header.channels);
+        }
+    }
+
     std::vector<std::string> StbImageLoader::get_dependencies(const std::string &uri) const {
         // Unused parameter `uri`
         (void) uri;
@@ -14,43 +91,170 @@ namespace RDE {
     }
 
     AssetID StbImageLoader::load_asset(const std::string &uri, AssetDatabase &db, AssetManager &manager) const {
-        (void) manager;
+        FileView file;
+        {
+            AssetTelemetry::ScopedPhase io(AssetTelemetry::Phase::IO);
+            file = VFS::Open(uri);
+            AssetTelemetry::AddBytesRead(file.size());
+        }
+        if (!file.is_open()) {
+            RDE_CORE_ERROR("StbImageLoader: Failed to open texture '{}'", uri);
+            return nullptr;
+        }
+        return load_asset_from_memory(uri, file.data(), file.size(), db, manager);
+    }
 
+    AssetID StbImageLoader::load_asset_from_memory(const std::string &uri, const char *file_data, size_t file_size,
+                                                   AssetDatabase &db, AssetManager &manager) const {
+        return create_asset(uri, decode(uri, file_data, file_size), db, manager);
+    }
+
+    std::unique_ptr<DecodedAsset> StbImageLoader::decode(const std::string &uri, const char *file_data,
+                                                         size_t file_size) const {
         RDE_CORE_INFO("StbImageLoader: Loading texture from '{}'...", uri);
 
+        // Reentrant: no global flip flag, and the failure reason is thread local.
         int width, height, channels;
-        stbi_set_flip_vertically_on_load(true);
-        stbi_uc *data = stbi_load(uri.c_str(), &width, &height, &channels, 0);
+        stbi_uc *data = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(file_data),
+                                              static_cast<int>(file_size), &width, &height, &channels, 0);
 
         if (!data) {
             RDE_CORE_ERROR("StbImageLoader: Failed to load texture '{}'. Reason: {}", uri, stbi_failure_reason());
             return nullptr;
         }
 
-        // Create the CPU-side resource component.
-        AssetGpuTexture texture;
+        // The component adopts stb_image's buffer, a large image is never held twice.
+        auto decoded = std::make_unique<DecodedImage>();
+        AssetGpuTexture &texture = decoded->texture;
         texture.width = width;
         texture.height = height;
         texture.channels = channels;
-        size_t image_size = width * height * channels;
-        texture.data.assign(data, data + image_size);
-
-        // Free the temporary buffer allocated by stb_image.
-        stbi_image_free(data);
+        const size_t row_size = size_t(width) * size_t(channels);
+        texture.data = ByteBuffer::Adopt(data, row_size * size_t(height), stbi_image_free);
+        FlipRows(texture.data.data(), row_size, height);
 
-        // Populate the AssetDatabase with the new entity and its components.
-        auto &registry = db.get_registry();
-        auto entity_id = registry.create();
+        AssetTelemetry::ScopedPhase post_process(AssetTelemetry::Phase::PostProcess);
+        texture.srgb = !MipGenerator::IsLinearData(uri);
+        MipGenerator::Generate(texture, MipGenerator::Filter::Kaiser);
 
-        registry.emplace<AssetGpuTexture>(entity_id, std::move(texture));
-        registry.emplace<AssetFilepath>(entity_id, uri);
-        registry.emplace<AssetName>(entity_id, std::filesystem::path(uri).filename().string());
+        if (m_settings.compress) {
+            const RAL::Format format = BlockCompression::ChooseFormat(
+                channels, texture.srgb, BlockCompression::IsNormalMap(uri), HasTranslucentPixels(texture),
+                m_settings.quality);
+            if (!BlockCompression::Compress(texture, format, m_settings.quality)) {
+                RDE_CORE_WARN("StbImageLoader: Failed to compress texture '{}', keeping it uncompressed", uri);
+            }
+        }
+        return decoded;
+    }
 
+    AssetID StbImageLoader::create_asset(const std::string &uri, std::unique_ptr<DecodedAsset> decoded,
+                                         AssetDatabase &db, [[maybe_unused]] AssetManager &manager) const {
+        if (!decoded) {
+            return nullptr;
+        }
+        auto &image = static_cast<DecodedImage &>(*decoded);
+        AssetID id = CreateTextureAsset(uri, std::move(image.texture), db);
         RDE_CORE_TRACE("StbImageLoader: Successfully populated asset for '{}'", uri);
-        return std::make_shared<AssetID_Data>(entity_id, uri);
+        return id;
     }
 
     std::vector<std::string> StbImageLoader::get_supported_extensions() const {
         return {".png", ".jpg", ".jpeg", ".bmp", ".tga", ".hdr"};
     }
+
+    std::string StbImageLoader::get_import_settings() const {
+        std::string settings = "flip_vertically=1;mips=kaiser;compress=";
+        settings += m_settings.compress ? GetQualityName(m_settings.quality) : "off";
+        return settings;
+    }
+
+    std::string StbImageLoader::get_path_settings(const std::string &uri) const {
+        std::string settings = "srgb=";
+        settings += MipGenerator::IsLinearData(uri) ? "0" : "1";
+        settings += ";normal_map=";
+        settings += BlockCompression::IsNormalMap(uri) ? "1" : "0";
+        return settings;
+    }
+
+    bool StbImageLoader::write_derived_data(const AssetID &asset_id, AssetDatabase &db, std::vector<char> &out) const {
+        const auto *texture = db.try_get<AssetGpuTexture>(asset_id);
+        if (!texture) {
+            return false;
+        }
+        DecodedImageHeader header{};
+        std::memcpy(header.magic, DECODED_IMAGE_MAGIC, sizeof(header.magic));
+        header.width = texture->width;
+        header.height = texture->height;
+        header.channels = texture->channels;
+        header.level_count = static_cast<int32_t>(texture->mips.size() + 1);
+        header.srgb = texture->srgb ? 1 : 0;
+        header.normal_map = BlockCompression::IsNormalMap(asset_id->uri) ? 1 : 0;
+        header.format = static_cast<int32_t>(texture->format);
+        size_t size = sizeof(header) + texture->data.size();
+        for (const auto &mip: texture->mips) {
+            size += mip.data.size();
+        }
+        out.resize(size);
+        std::memcpy(out.data(), &header, sizeof(header));
+        char *cursor = out.data() + sizeof(header);
+        std::memcpy(cursor, texture->data.data(), texture->data.size());
+        cursor += texture->data.size();
+        for (const auto &mip: texture->mips) {
+            std::memcpy(cursor, mip.data.data(), mip.data.size());
+            cursor += mip.data.size();
+        }
+        return true;
+    }
+
+    AssetID StbImageLoader::read_derived_data(const std::string &uri, const char *data, size_t size, AssetDatabase &db,
+                                              [[maybe_unused]] AssetManager &manager) const {
+        DecodedImageHeader header{};
+        if (size < sizeof(header)) {
+            return nullptr;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, DECODED_IMAGE_MAGIC, sizeof(header.magic)) != 0 || header.width <= 0 ||
+            header.height <= 0 || header.channels <= 0 || header.level_count < 1 ||
+            header.level_count > MipGenerator::GetLevelCount(header.width, header.height)) {
+            return nullptr;
+        }
+        const auto format = static_cast<RAL::Format>(header.format);
+        if (format != RAL::Format::UNKNOWN && !RAL::is_block_compressed(format)) {
+            return nullptr;
+        }
+        // The key covers the classification by file name as well, this catches entries written under another key.
+        if ((header.srgb != 0) == MipGenerator::IsLinearData(uri) ||
+            (header.normal_map != 0) != BlockCompression::IsNormalMap(uri)) {
+            return nullptr;
+        }
+        size_t expected = 0;
+        for (int level = 0; level < header.level_count; ++level) {
+            expected += GetLevelSize(header, level);
+        }
+        if (size - sizeof(header) != expected) {
+            return nullptr;
+        }
+
+        AssetGpuTexture texture;
+        texture.width = header.width;
+        texture.height = header.height;
+        texture.channels = header.channels;
+        texture.srgb = header.srgb != 0;
+        texture.format = format;
+        const char *cursor = data + sizeof(header);
+        const size_t level_size = GetLevelSize(header, 0);
+        texture.data = ByteBuffer(cursor, cursor + level_size);
+        cursor += level_size;
+        for (int level = 1; level < header.level_count; ++level) {
+            AssetTextureMip mip;
+            mip.width = std::max(header.width >> level, 1);
+            mip.height = std::max(header.height >> level, 1);
+            const size_t mip_size = GetLevelSize(header, level);
+            mip.data = ByteBuffer(cursor, cursor + mip_size);
+            cursor += mip_size;
+            texture.mips.push_back(std::move(mip));
+        }
+        return CreateTextureAsset(uri, std::move(texture), db);
+    }
 }
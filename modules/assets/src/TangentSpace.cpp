@@ -0,0 +1,229 @@
+#include "assets/TangentSpace.h"
+#include "core/Log.h"
+#include "core/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace RDE::TangentSpace {
+    namespace {
+        constexpr size_t FACE_GRAIN = 1 << 13;
+        constexpr size_t VERTEX_GRAIN = 1 << 13;
+
+        bool IsValid(const glm::ivec3 &tri, size_t num_vertices) {
+            return tri.x >= 0 && tri.y >= 0 && tri.z >= 0 && size_t(tri.x) < num_vertices &&
+                   size_t(tri.y) < num_vertices && size_t(tri.z) < num_vertices;
+        }
+
+        // Vertex -> corner table (corner = 3 * face + k) in CSR layout. Triangles with invalid indices are left out.
+        struct CornerTable {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> corners;
+        };
+
+        CornerTable BuildCornerTable(const std::vector<glm::ivec3> &triangles, size_t num_vertices) {
+            CornerTable table;
+            table.offsets.assign(num_vertices + 1, 0);
+            for (const glm::ivec3 &tri: triangles) {
+                if (IsValid(tri, num_vertices)) {
+                    ++table.offsets[tri.x + 1];
+                    ++table.offsets[tri.y + 1];
+                    ++table.offsets[tri.z + 1];
+                }
+            }
+            for (size_t v = 0; v < num_vertices; ++v) {
+                table.offsets[v + 1] += table.offsets[v];
+            }
+            table.corners.resize(table.offsets.back());
+            std::vector<uint32_t> cursor(table.offsets.begin(), table.offsets.end() - 1);
+            for (size_t f = 0; f < triangles.size(); ++f) {
+                const glm::ivec3 &tri = triangles[f];
+                if (IsValid(tri, num_vertices)) {
+                    for (int k = 0; k < 3; ++k) {
+                        table.corners[cursor[tri[k]]++] = static_cast<uint32_t>(3 * f + k);
+                    }
+                }
+            }
+            return table;
+        }
+
+        // acos with an absolute error below 7e-5 (Abramowitz & Stegun 4.4.45), plenty for weights and several times
+        // cheaper than std::acos.
+        float FastAcos(float x) {
+            const float ax = std::min(std::abs(x), 1.0f);
+            const float r = std::sqrt(1.0f - ax) * (1.5707288f + ax * (-0.2121144f + ax * (0.0742610f - 0.0187293f * ax)));
+            return x >= 0.0f ? r : 3.14159265f - r;
+        }
+
+        // Interior angles of a triangle at its three corners.
+        glm::vec3 CornerAngles(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c) {
+            const glm::vec3 ab = b - a;
+            const glm::vec3 bc = c - b;
+            const glm::vec3 ca = a - c;
+            const float l_ab = glm::length(ab);
+            const float l_bc = glm::length(bc);
+            const float l_ca = glm::length(ca);
+            if (l_ab <= 0.0f || l_bc <= 0.0f || l_ca <= 0.0f) {
+                return glm::vec3(0.0f);
+            }
+            return {
+                FastAcos(-glm::dot(ab, ca) / (l_ab * l_ca)),
+                FastAcos(-glm::dot(bc, ab) / (l_bc * l_ab)),
+                FastAcos(-glm::dot(ca, bc) / (l_ca * l_bc))
+            };
+        }
+
+        glm::vec3 AnyPerpendicular(const glm::vec3 &n) {
+            const glm::vec3 axis = std::abs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+            return glm::normalize(glm::cross(n, axis));
+        }
+
+        template<typename T>
+        const std::vector<T> *GetVector(const PropertyContainer &container, const char *name) {
+            const auto *array = dynamic_cast<const PropertyArray<T> *>(container.get_base(name));
+            return array ? &array->vector() : nullptr;
+        }
+    }
+
+    void ComputeVertexNormals(const std::vector<glm::vec3> &positions, const std::vector<glm::ivec3> &triangles,
+                              std::vector<glm::vec3> &normals, NormalWeighting weighting) {
+        const size_t num_vertices = positions.size();
+        const size_t num_faces = triangles.size();
+        normals.resize(num_vertices);
+
+        // --- Per face: unnormalized normal (twice the area) and corner weights ---
+        std::vector<glm::vec3> face_normals(num_faces);
+        std::vector<glm::vec3> corner_weights(weighting == NormalWeighting::Angle ? num_faces : 0);
+        Parallel::For(num_faces, FACE_GRAIN, [&](size_t f) {
+            const glm::ivec3 &tri = triangles[f];
+            if (!IsValid(tri, num_vertices)) {
+                face_normals[f] = glm::vec3(0.0f);
+                return;
+            }
+            const glm::vec3 &a = positions[tri.x];
+            const glm::vec3 &b = positions[tri.y];
+            const glm::vec3 &c = positions[tri.z];
+            const glm::vec3 n = glm::cross(b - a, c - a);
+            if (weighting == NormalWeighting::Angle) {
+                const float length = glm::length(n);
+                face_normals[f] = length > 0.0f ? n / length : glm::vec3(0.0f);
+                corner_weights[f] = CornerAngles(a, b, c);
+            } else {
+                face_normals[f] = n;
+            }
+        });
+
+        // --- Per vertex: gather the incident corners ---
+        const CornerTable table = BuildCornerTable(triangles, num_vertices);
+        Parallel::For(num_vertices, VERTEX_GRAIN, [&](size_t v) {
+            glm::vec3 sum(0.0f);
+            for (uint32_t i = table.offsets[v]; i < table.offsets[v + 1]; ++i) {
+                const uint32_t corner = table.corners[i];
+                const uint32_t f = corner / 3;
+                sum += weighting == NormalWeighting::Angle
+                           ? face_normals[f] * corner_weights[f][corner % 3]
+                           : face_normals[f];
+            }
+            const float length = glm::length(sum);
+            normals[v] = length > 0.0f ? sum / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        });
+    }
+
+    void ComputeVertexTangents(const std::vector<glm::vec3> &positions, const std::vector<glm::vec2> &texcoords,
+                               const std::vector<glm::vec3> &normals, const std::vector<glm::ivec3> &triangles,
+                               std::vector<glm::vec4> &tangents) {
+        const size_t num_vertices = std::min({positions.size(), texcoords.size(), normals.size()});
+        const size_t num_faces = triangles.size();
+        tangents.resize(positions.size());
+
+        // --- Per face: normalized dP/du, orientation and corner angles ---
+        struct FaceFrame {
+            glm::vec3 s{0.0f}; // dP/du
+            glm::vec3 angles{0.0f};
+            float orientation = 0.0f; // +1 or -1 if the UV mapping is usable, 0 for degenerate faces
+        };
+        std::vector<FaceFrame> frames(num_faces);
+        Parallel::For(num_faces, FACE_GRAIN, [&](size_t f) {
+            const glm::ivec3 &tri = triangles[f];
+            FaceFrame &frame = frames[f];
+            if (!IsValid(tri, num_vertices)) {
+                return;
+            }
+            const glm::vec3 e1 = positions[tri.y] - positions[tri.x];
+            const glm::vec3 e2 = positions[tri.z] - positions[tri.x];
+            const glm::vec2 d1 = texcoords[tri.y] - texcoords[tri.x];
+            const glm::vec2 d2 = texcoords[tri.z] - texcoords[tri.x];
+            const float area = d1.x * d2.y - d2.x * d1.y;
+            if (std::abs(area) <= 1e-20f) {
+                return;
+            }
+            // dP/du up to the positive factor 1 / |area|, the bitangent only contributes its handedness (MikkTSpace's
+            // orientation flag), which is the sign of the UV area.
+            const glm::vec3 s = (e1 * d2.y - e2 * d1.y) * (area > 0.0f ? 1.0f : -1.0f);
+            const float s_length = glm::length(s);
+            if (s_length <= 0.0f) {
+                return;
+            }
+            frame.s = s / s_length;
+            frame.angles = CornerAngles(positions[tri.x], positions[tri.y], positions[tri.z]);
+            frame.orientation = area > 0.0f ? 1.0f : -1.0f;
+        });
+
+        // --- Per vertex: project into the normal's plane, accumulate, orthonormalize ---
+        const CornerTable table = BuildCornerTable(triangles, num_vertices);
+        Parallel::For(positions.size(), VERTEX_GRAIN, [&](size_t v) {
+            if (v >= num_vertices) {
+                tangents[v] = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+                return;
+            }
+            const glm::vec3 &n = normals[v];
+            glm::vec3 tangent(0.0f);
+            float orientation = 0.0f;
+            for (uint32_t i = table.offsets[v]; i < table.offsets[v + 1]; ++i) {
+                const uint32_t corner = table.corners[i];
+                const FaceFrame &frame = frames[corner / 3];
+                if (frame.orientation == 0.0f) {
+                    continue;
+                }
+                const glm::vec3 s = frame.s - n * glm::dot(n, frame.s);
+                const float length = glm::length(s);
+                if (length > 0.0f) {
+                    const float weight = frame.angles[corner % 3];
+                    tangent += s * (weight / length);
+                    orientation += frame.orientation * weight;
+                }
+            }
+
+            tangent -= n * glm::dot(n, tangent);
+            const float length = glm::length(tangent);
+            tangent = length > 1e-12f ? tangent / length : AnyPerpendicular(n);
+            tangents[v] = glm::vec4(tangent, orientation < 0.0f ? -1.0f : 1.0f);
+        });
+    }
+
+    bool ComputeNormals(PropertyContainer &vertices, const PropertyContainer &faces, NormalWeighting weighting) {
+        const auto *positions = GetVector<glm::vec3>(vertices, "v:point");
+        const auto *triangles = GetVector<glm::ivec3>(faces, "f:tris");
+        if (!positions || !triangles) {
+            RDE_CORE_WARN("TangentSpace::ComputeNormals: Needs v:point and f:tris.");
+            return false;
+        }
+        auto normals = vertices.get_or_add<glm::vec3>("v:normal", glm::vec3(0.0f, 1.0f, 0.0f));
+        ComputeVertexNormals(*positions, *triangles, normals.vector(), weighting);
+        return true;
+    }
+
+    bool ComputeTangents(PropertyContainer &vertices, const PropertyContainer &faces) {
+        const auto *positions = GetVector<glm::vec3>(vertices, "v:point");
+        const auto *normals = GetVector<glm::vec3>(vertices, "v:normal");
+        const auto *texcoords = GetVector<glm::vec2>(vertices, "v:texcoord");
+        const auto *triangles = GetVector<glm::ivec3>(faces, "f:tris");
+        if (!positions || !normals || !texcoords || !triangles) {
+            RDE_CORE_WARN("TangentSpace::ComputeTangents: Needs v:point, v:normal, v:texcoord and f:tris.");
+            return false;
+        }
+        auto tangents = vertices.get_or_add<glm::vec4>("v:tangent", glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        ComputeVertexTangents(*positions, *texcoords, *normals, *triangles, tangents.vector());
+        return true;
+    }
+}
@@ -0,0 +1,137 @@
+#include "assets/BlockCompression.h"
+#include "core/Log.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace RDE;
+
+// Every encoder round-trips through Decompress with a minimum PSNR over the channels its format stores. Gradients must
+// come out close, white noise is the worst case for the 4x4 palettes. Sizes that are not a multiple of 4 end in partial
+// blocks on the right and bottom edges, which must decode as well as the rest of the image.
+namespace {
+    int g_failures = 0;
+
+    void Check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++g_failures;
+        }
+    }
+
+    struct Case {
+        RAL::Format format;
+        const char *name;
+        int channels; // Channels the format stores, counted from red
+        double gradient_psnr;
+        double noise_psnr;
+    };
+
+    std::vector<unsigned char> MakeGradient(int width, int height) {
+        std::vector<unsigned char> pixels(size_t(width) * size_t(height) * 4);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                unsigned char *p = pixels.data() + (size_t(y) * size_t(width) + size_t(x)) * 4;
+                p[0] = static_cast<unsigned char>(x * 255 / std::max(width - 1, 1));
+                p[1] = static_cast<unsigned char>(y * 255 / std::max(height - 1, 1));
+                p[2] = static_cast<unsigned char>((x + y) * 255 / std::max(width + height - 2, 1));
+                p[3] = static_cast<unsigned char>(255 - y * 255 / std::max(height - 1, 1));
+            }
+        }
+        return pixels;
+    }
+
+    std::vector<unsigned char> MakeNoise(int width, int height) {
+        std::vector<unsigned char> pixels(size_t(width) * size_t(height) * 4);
+        uint32_t state = 12345;
+        for (auto &value: pixels) {
+            state = state * 1664525u + 1013904223u;
+            value = static_cast<unsigned char>(state >> 24);
+        }
+        return pixels;
+    }
+
+    // Over the pixels at x >= first_x or y >= first_y.
+    double GetPsnr(const std::vector<unsigned char> &a, const std::vector<unsigned char> &b, int width, int height,
+                   int channels, int first_x, int first_y) {
+        double squared_error = 0.0;
+        size_t count = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (x < first_x && y < first_y) {
+                    continue;
+                }
+                const size_t i = (size_t(y) * size_t(width) + size_t(x)) * 4;
+                for (int c = 0; c < channels; ++c) {
+                    const double d = double(a[i + c]) - double(b[i + c]);
+                    squared_error += d * d;
+                    ++count;
+                }
+            }
+        }
+        const double mse = squared_error / double(count);
+        return mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    struct Result {
+        double psnr = 0.0;
+        double edge_psnr = 0.0; // Of the partial blocks only, equal to psnr without any
+    };
+
+    Result RoundTrip(const Case &test, const std::vector<unsigned char> &pixels, int width, int height) {
+        std::vector<unsigned char> blocks(BlockCompression::GetCompressedSize(test.format, width, height));
+        std::vector<unsigned char> decoded(pixels.size());
+        if (!BlockCompression::Compress(pixels.data(), width, height, 4, test.format,
+                                        BlockCompression::Quality::Normal, blocks.data()) ||
+            !BlockCompression::Decompress(blocks.data(), width, height, test.format, decoded.data())) {
+            return {};
+        }
+        Result result;
+        result.psnr = GetPsnr(pixels, decoded, width, height, test.channels, 0, 0);
+        const int first_x = width % 4 ? width / 4 * 4 : width;
+        const int first_y = height % 4 ? height / 4 * 4 : height;
+        result.edge_psnr = first_x == width && first_y == height
+                               ? result.psnr
+                               : GetPsnr(pixels, decoded, width, height, test.channels, first_x, first_y);
+        return result;
+    }
+}
+
+int main() {
+    Log::Initialize();
+    const Case cases[] = {
+        {RAL::Format::BC1_RGB_UNORM, "BC1", 3, 30.0, 12.0},
+        {RAL::Format::BC3_UNORM, "BC3", 4, 30.0, 12.0},
+        {RAL::Format::BC4_UNORM, "BC4", 1, 40.0, 25.0},
+        {RAL::Format::BC5_UNORM, "BC5", 2, 40.0, 25.0},
+        {RAL::Format::BC7_UNORM, "BC7", 4, 30.0, 12.0},
+    };
+    const int sizes[][2] = {{64, 64}, {30, 18}, {61, 35}};
+    for (const Case &test: cases) {
+        for (const auto &size: sizes) {
+            const Result gradient = RoundTrip(test, MakeGradient(size[0], size[1]), size[0], size[1]);
+            const Result noise = RoundTrip(test, MakeNoise(size[0], size[1]), size[0], size[1]);
+            if (gradient.psnr < test.gradient_psnr || gradient.edge_psnr < test.gradient_psnr) {
+                std::fprintf(stderr, "FAILED: %s %dx%d gradient below %.0f dB\n", test.name, size[0], size[1],
+                             test.gradient_psnr);
+                ++g_failures;
+            }
+            if (noise.psnr < test.noise_psnr || noise.edge_psnr < test.noise_psnr) {
+                std::fprintf(stderr, "FAILED: %s %dx%d noise below %.0f dB\n", test.name, size[0], size[1],
+                             test.noise_psnr);
+                ++g_failures;
+            }
+        }
+    }
+
+    unsigned char pixel[4] = {1, 2, 3, 4};
+    unsigned char block[16];
+    Check(!BlockCompression::Compress(pixel, 1, 1, 4, RAL::Format::R8G8B8A8_UNORM, BlockCompression::Quality::Normal,
+                                      block), "an uncompressed format is rejected");
+    if (g_failures == 0) {
+        std::printf("BlockCompressionTests passed\n");
+    }
+    return g_failures == 0 ? 0 : 1;
+}
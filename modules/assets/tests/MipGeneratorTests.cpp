@@ -0,0 +1,127 @@
+#include "assets/MipGenerator.h"
+#include "core/Log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace RDE;
+
+// Chain sizes of odd, non-square textures, gamma-correct averaging of sRGB texels, and the normalization of both
+// filters: a constant image must stay constant at every level.
+namespace {
+    int g_failures = 0;
+
+    void Check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++g_failures;
+        }
+    }
+
+    bool Near(int value, int expected, int tolerance) {
+        return std::abs(value - expected) <= tolerance;
+    }
+
+    AssetGpuTexture MakeTexture(int width, int height, int channels, bool srgb) {
+        AssetGpuTexture texture;
+        texture.width = width;
+        texture.height = height;
+        texture.channels = channels;
+        texture.srgb = srgb;
+        texture.data = ByteBuffer(size_t(width) * size_t(height) * size_t(channels));
+        return texture;
+    }
+
+    const unsigned char *Pixels(const ByteBuffer &data) {
+        return reinterpret_cast<const unsigned char *>(data.data());
+    }
+
+    void TestLevelSizes() {
+        Check(MipGenerator::GetLevelCount(1, 1) == 1, "1x1 has one level");
+        Check(MipGenerator::GetLevelCount(2, 1) == 2, "2x1 has two levels");
+        Check(MipGenerator::GetLevelCount(5, 3) == 3, "5x3 has three levels");
+        Check(MipGenerator::GetLevelCount(640, 480) == 10, "640x480 has ten levels");
+        Check(MipGenerator::GetLevelCount(1, 1000) == 10, "1x1000 has ten levels");
+
+        AssetGpuTexture texture = MakeTexture(13, 6, 4, true);
+        std::memset(texture.data.data(), 0, texture.data.size());
+        MipGenerator::Generate(texture, MipGenerator::Filter::Kaiser);
+        const int expected[][2] = {{6, 3}, {3, 1}, {1, 1}};
+        Check(texture.mips.size() == 3, "13x6 has three levels below level 0");
+        for (size_t i = 0; i < texture.mips.size() && i < 3; ++i) {
+            const AssetTextureMip &mip = texture.mips[i];
+            Check(mip.width == expected[i][0] && mip.height == expected[i][1], "a level halves the previous one");
+            Check(mip.data.size() == size_t(mip.width) * size_t(mip.height) * 4, "a level holds width x height texels");
+        }
+    }
+
+    // Black and white sRGB texels average to 50% linear intensity, which is 188 in sRGB rather than 128. Alpha is
+    // linear and averages to 128.
+    void TestSrgbCheckerboard() {
+        constexpr int SIZE = 16;
+        for (bool srgb: {true, false}) {
+            AssetGpuTexture texture = MakeTexture(SIZE, SIZE, 4, srgb);
+            auto *pixels = reinterpret_cast<unsigned char *>(texture.data.data());
+            for (int y = 0; y < SIZE; ++y) {
+                for (int x = 0; x < SIZE; ++x) {
+                    std::memset(pixels + (size_t(y) * SIZE + x) * 4, (x + y) % 2 ? 255 : 0, 4);
+                }
+            }
+            MipGenerator::Generate(texture, MipGenerator::Filter::Box);
+            const int expected_color = srgb ? 188 : 128;
+            bool color_ok = true, alpha_ok = true;
+            const AssetTextureMip &mip = texture.mips[0];
+            for (int i = 0; i < mip.width * mip.height; ++i) {
+                const unsigned char *texel = Pixels(mip.data) + size_t(i) * 4;
+                for (int c = 0; c < 3; ++c) {
+                    color_ok &= Near(texel[c], expected_color, 1);
+                }
+                alpha_ok &= Near(texel[3], 128, 1);
+            }
+            Check(color_ok, srgb ? "sRGB checkerboard averages in linear space"
+                                 : "linear checkerboard averages to gray");
+            Check(alpha_ok, "alpha averages linearly");
+        }
+    }
+
+    void TestConstantImage() {
+        constexpr unsigned char COLOR[4] = {37, 200, 113, 90};
+        for (bool srgb: {true, false}) {
+            AssetGpuTexture box = MakeTexture(37, 21, 4, srgb);
+            auto *pixels = reinterpret_cast<unsigned char *>(box.data.data());
+            for (size_t i = 0; i < box.data.size(); ++i) {
+                pixels[i] = COLOR[i % 4];
+            }
+            AssetGpuTexture kaiser = MakeTexture(37, 21, 4, srgb);
+            std::memcpy(kaiser.data.data(), box.data.data(), box.data.size());
+            MipGenerator::Generate(box, MipGenerator::Filter::Box);
+            MipGenerator::Generate(kaiser, MipGenerator::Filter::Kaiser);
+
+            bool same_levels = box.mips.size() == kaiser.mips.size();
+            bool constant = true;
+            for (size_t level = 0; same_levels && level < box.mips.size(); ++level) {
+                const ByteBuffer &a = box.mips[level].data;
+                const ByteBuffer &b = kaiser.mips[level].data;
+                same_levels &= a.size() == b.size();
+                for (size_t i = 0; same_levels && i < a.size(); ++i) {
+                    constant &= Near(Pixels(a)[i], COLOR[i % 4], 1) && Near(Pixels(b)[i], COLOR[i % 4], 1);
+                }
+            }
+            Check(same_levels, "box and Kaiser produce the same chain");
+            Check(constant, "box and Kaiser keep a constant image constant");
+        }
+    }
+}
+
+int main() {
+    Log::Initialize();
+    TestLevelSizes();
+    TestSrgbCheckerboard();
+    TestConstantImage();
+    if (g_failures == 0) {
+        std::printf("MipGeneratorTests passed\n");
+    }
+    return g_failures == 0 ? 0 : 1;
+}
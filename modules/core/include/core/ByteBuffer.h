@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace RDE {
+    // Owned block of bytes that can adopt a buffer allocated elsewhere (a decoder's output) instead of copying it, and
+    // frees it with the matching deleter. Move-only.
+    class ByteBuffer {
+    public:
+        using Deleter = void (*)(void *);
+
+        ByteBuffer() = default;
+
+        // Uninitialized bytes.
+        explicit ByteBuffer(size_t size) : m_data(Allocate(size)), m_size(size) {
+        }
+
+        ByteBuffer(const char *first, const char *last) : ByteBuffer(static_cast<size_t>(last - first)) {
+            if (m_size > 0) {
+                std::memcpy(m_data.get(), first, m_size);
+            }
+        }
+
+        // Frees memory from std::malloc.
+        static void Free(void *data) { std::free(data); }
+
+        // Takes ownership of data, which deleter frees.
+        static ByteBuffer Adopt(void *data, size_t size, Deleter deleter = Free) {
+            ByteBuffer buffer;
+            buffer.m_data = Storage(static_cast<char *>(data), deleter);
+            buffer.m_size = data ? size : 0;
+            return buffer;
+        }
+
+        ByteBuffer(ByteBuffer &&other) noexcept : m_data(std::move(other.m_data)), m_size(other.m_size) {
+            other.m_size = 0;
+        }
+
+        ByteBuffer &operator=(ByteBuffer &&other) noexcept {
+            m_data = std::move(other.m_data);
+            m_size = other.m_size;
+            other.m_size = 0;
+            return *this;
+        }
+
+        [[nodiscard]] char *data() { return m_data.get(); }
+
+        [[nodiscard]] const char *data() const { return m_data.get(); }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    private:
+        using Storage = std::unique_ptr<char, Deleter>;
+
+        static Storage Allocate(size_t size) {
+            if (size == 0) {
+                return Storage(nullptr, Free);
+            }
+            auto *data = static_cast<char *>(std::malloc(size));
+            if (!data) {
+                throw std::bad_alloc();
+            }
+            return Storage(data, Free);
+        }
+
+        Storage m_data{nullptr, Free};
+        size_t m_size = 0;
+    };
+}
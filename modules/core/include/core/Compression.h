@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Small LZ77 block codec (LZ4 style sequences: literal run, 16-bit back reference, match length) used by the asset
+// packs. Fast to decode, no external dependency. Blocks are independent, so callers split large data into blocks and
+// (de)compress them in parallel.
+namespace RDE::Compression {
+    // Worst case compressed size of size input bytes.
+    size_t CompressBound(size_t size);
+
+    // Returns the compressed size, or 0 if dst is too small.
+    size_t CompressBlock(const void *src, size_t size, void *dst, size_t capacity);
+
+    // Decodes exactly raw_size bytes. Returns false on corrupt or truncated input, never reads or writes out of bounds.
+    bool DecompressBlock(const void *src, size_t size, void *dst, size_t raw_size);
+}
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace RDE::FileIO {
@@ -8,7 +13,41 @@ namespace RDE::FileIO {
 
     std::filesystem::path GetFileName(const std::filesystem::path &path);
 
+    // Extension including the dot, or empty. String only, cheaper than going through std::filesystem::path.
+    std::string_view GetExtension(std::string_view path);
+
+    // True if one of words is a word of the file name without its extension, compared lower case. Words are separated
+    // by '_', '-', '.' or spaces, so "brick_nrm.png" contains "nrm" but "barn.png" does not contain "n".
+    bool HasNameWord(std::string_view path, std::span<const std::string_view> words);
+
+    // Reads through the VFS, so files inside mounted packs are found as well.
+
     std::vector<char> ReadFile(const std::filesystem::path &path);
 
     bool WriteFile(const std::filesystem::path &path, const std::string &content);
+
+    // --- Asynchronous reads ---
+    // Backed by io_uring on Linux when the kernel allows it, by a small pool of blocking readers otherwise. Files
+    // inside mounted packs are always served by the pool.
+
+    struct ReadResult {
+        std::string path;
+        std::vector<char> data;
+        bool success = false;
+    };
+
+    // Runs on an I/O thread once per file, in completion order. Keep it short or hand the data off, it holds up the
+    // completion of other reads.
+    using ReadCallback = std::function<void(ReadResult &result)>;
+
+    // Submits all reads at once so they overlap. The future is ready once every callback returned.
+    std::future<void> ReadAsync(std::vector<std::string> paths, ReadCallback callback);
+
+    std::future<ReadResult> ReadAsync(std::string path);
+
+    // Blocks until all files are read, results are in the order of paths.
+    std::vector<ReadResult> ReadBatch(std::vector<std::string> paths);
+
+    // "io_uring" or "thread pool".
+    const char *GetAsyncBackendName();
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Non-cryptographic 64-bit hashing (the XXH64 algorithm) for content keys and path ids. Output is stable across
+// platforms and runs, so it may be persisted.
+namespace RDE::Hash {
+    uint64_t Compute(const void *data, size_t size, uint64_t seed = 0);
+
+    inline uint64_t Compute(std::string_view text, uint64_t seed = 0) {
+        return Compute(text.data(), text.size(), seed);
+    }
+
+    // Order dependent combination of two hashes.
+    inline uint64_t Combine(uint64_t a, uint64_t b) {
+        return a ^ (b + 0x9E3779B97F4A7C15ull + (a << 6) + (a >> 2));
+    }
+
+    // 16 lowercase hex digits.
+    std::string ToHex(uint64_t hash);
+}
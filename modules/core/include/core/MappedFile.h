@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace RDE {
+    // Read-only memory mapping of a whole file. Move-only, unmaps on destruction.
+    // Empty files open successfully with size() == 0 and data() == nullptr.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        explicit MappedFile(const std::filesystem::path &path) { open(path); }
+
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        bool open(const std::filesystem::path &path);
+
+        void close();
+
+        [[nodiscard]] bool is_open() const { return m_is_open; }
+
+        [[nodiscard]] const char *data() const { return m_data; }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+
+    private:
+        const char *m_data = nullptr;
+        size_t m_size = 0;
+        bool m_is_open = false;
+#ifdef _WIN32
+        void *m_file = nullptr;
+        void *m_mapping = nullptr;
+#endif
+    };
+}
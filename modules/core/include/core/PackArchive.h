@@ -0,0 +1,94 @@
+#pragma once
+
+#include "core/MappedFile.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RDE {
+    struct FileStat {
+        uint64_t size = 0;
+        std::filesystem::file_time_type mtime;
+        uint64_t content_hash = 0; // Hash::Compute of the content if known without reading it, else 0
+    };
+
+    // Read-only, memory mapped asset pack (.rdepack). One file holds many assets keyed by their '/' separated path
+    // relative to the packed directory. Layout: header | 4K aligned entry data | table of contents sorted by path hash |
+    // path strings | block table. Entries are either stored as is or split into independent BLOCK_SIZE blocks
+    // compressed with Compression::CompressBlock, which are decoded in parallel on read.
+    class PackArchive {
+    public:
+        static constexpr uint32_t VERSION = 1;
+        static constexpr uint64_t ALIGNMENT = 4096;
+        static constexpr uint32_t BLOCK_SIZE = 64 * 1024;
+        static constexpr const char *EXTENSION = ".rdepack";
+
+        PackArchive() = default;
+
+        bool open(const std::filesystem::path &path);
+
+        void close();
+
+        [[nodiscard]] bool is_open() const { return m_file.is_open(); }
+
+        [[nodiscard]] const std::filesystem::path &get_path() const { return m_path; }
+
+        [[nodiscard]] size_t get_entry_count() const { return m_entries.size(); }
+
+        [[nodiscard]] bool contains(std::string_view path) const { return find(path) != nullptr; }
+
+        bool stat(std::string_view path, FileStat &out) const;
+
+        // Stored entries point straight into the mapping, compressed ones are decoded into buffer.
+        // Returns false if the entry is missing or corrupt.
+        bool read(std::string_view path, const char *&data, size_t &size, std::vector<char> &buffer) const;
+
+        // Paths of all entries, in table order.
+        [[nodiscard]] std::vector<std::string> list() const;
+
+        // On-disk table of contents entry.
+        struct Entry {
+            uint64_t path_hash;
+            uint64_t content_hash;
+            uint64_t data_offset;
+            uint64_t stored_size;
+            uint64_t raw_size;
+            uint32_t name_offset;
+            uint32_t name_size;
+            uint32_t first_block; // Index into the block table, compressed entries only
+            uint32_t codec; // 0 = stored, 1 = block compressed
+        };
+
+    private:
+        [[nodiscard]] const Entry *find(std::string_view path) const;
+
+        MappedFile m_file;
+        std::filesystem::path m_path;
+        std::filesystem::file_time_type m_mtime;
+        std::vector<Entry> m_entries;
+        std::string_view m_strings;
+        std::vector<uint32_t> m_block_sizes; // Compressed size per block, high bit set for blocks stored raw
+        std::vector<uint64_t> m_block_offsets; // Offset of every block relative to its entry's data
+    };
+
+    namespace PackBuilder {
+        struct Settings {
+            bool compress = true;
+            float min_savings = 0.1f; // Entries that shrink by less than this fraction are stored uncompressed
+        };
+
+        struct Statistics {
+            size_t num_files = 0;
+            size_t num_compressed = 0;
+            uint64_t raw_bytes = 0;
+            uint64_t stored_bytes = 0;
+        };
+
+        // Packs every regular file below root except output itself. Writes to a temporary and renames.
+        bool Build(const std::filesystem::path &root, const std::filesystem::path &output, const Settings &settings = {},
+                   Statistics *statistics = nullptr);
+    }
+}
@@ -0,0 +1,88 @@
+//core/ParallelFor.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace RDE::Parallel {
+    // Number of worker threads used by the helpers below (including the calling thread).
+    inline size_t GetWorkerCount() {
+        const unsigned int hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : static_cast<size_t>(hw);
+    }
+
+    // Number of chunks a range of `count` elements is split into when every chunk holds at least `grain` elements.
+    inline size_t GetChunkCount(size_t count, size_t grain) {
+        if (count == 0) {
+            return 0;
+        }
+        grain = std::max<size_t>(grain, 1);
+        const size_t max_chunks = (count + grain - 1) / grain;
+        return std::min(max_chunks, GetWorkerCount());
+    }
+
+    /**
+     * @brief Splits [0, count) into contiguous chunks and calls func(chunk_index, begin, end) for each of them.
+     * The calling thread processes the last chunk itself, so small ranges never spawn a thread.
+     * Chunk boundaries only depend on count and grain, which lets callers keep per-chunk scratch data
+     * (see GetChunkCount) and merge it deterministically afterwards.
+     * The first exception thrown by a chunk is rethrown on the calling thread after all chunks joined.
+     */
+    template<typename Func>
+    void ForChunks(size_t count, size_t grain, Func &&func) {
+        const size_t num_chunks = GetChunkCount(count, grain);
+        if (num_chunks == 0) {
+            return;
+        }
+        if (num_chunks == 1) {
+            func(size_t(0), size_t(0), count);
+            return;
+        }
+
+        const size_t chunk_size = (count + num_chunks - 1) / num_chunks;
+        std::vector<std::thread> threads;
+        threads.reserve(num_chunks - 1);
+        std::vector<std::exception_ptr> errors(num_chunks);
+
+        for (size_t chunk = 0; chunk + 1 < num_chunks; ++chunk) {
+            const size_t begin = std::min(count, chunk * chunk_size);
+            const size_t end = std::min(count, begin + chunk_size);
+            threads.emplace_back([&func, &errors, chunk, begin, end]() {
+                try {
+                    func(chunk, begin, end);
+                } catch (...) {
+                    errors[chunk] = std::current_exception();
+                }
+            });
+        }
+
+        const size_t last = num_chunks - 1;
+        try {
+            func(last, std::min(count, last * chunk_size), count);
+        } catch (...) {
+            errors[last] = std::current_exception();
+        }
+
+        for (auto &thread: threads) {
+            thread.join();
+        }
+        for (const auto &error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    // Calls func(i) for every i in [0, count), distributed over the worker threads.
+    template<typename Func>
+    void For(size_t count, size_t grain, Func &&func) {
+        ForChunks(count, grain, [&func](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                func(i);
+            }
+        });
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace RDE {
+    // 64-bit id of a path: Hash::Compute of its VFS::NormalizePath form, so different spellings of the same path share
+    // an id. Stable across runs. 0 is never returned for a non-empty path and means "no path".
+    using PathId = uint64_t;
+
+    // Hashes a PathId as itself, it is already uniformly distributed.
+    struct PathIdHash {
+        size_t operator()(PathId id) const { return static_cast<size_t>(id); }
+    };
+
+    // Interned paths: each path is normalized and hashed once, the normalized string is kept to map ids back to paths.
+    // Strings are never removed, so the returned views stay valid for the table's lifetime. Thread-safe.
+    class PathTable {
+    public:
+        // Normalizes and hashes without interning.
+        static PathId MakeId(std::string_view path);
+
+        PathId intern(std::string_view path);
+
+        // The normalized path, empty if id was never interned.
+        [[nodiscard]] std::string_view get_path(PathId id) const;
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<PathId, std::string, PathIdHash> m_paths;
+    };
+}
@@ -68,4 +68,21 @@ namespace RDE {
         RDE_CORE_WARN("SPIR-V path does not exist: {}", spirv_path.string());
         return std::nullopt; // SPIR-V path does not exist
     }
+
+    // Local, disposable cache of processed assets next to the executable. Created on demand.
+    inline std::optional<std::filesystem::path> get_derived_data_path() {
+        auto exe_path = Platform::get_executable_path();
+        if (!exe_path.has_value()) {
+            RDE_CORE_WARN("No executable path found, cannot determine derived data path");
+            return std::nullopt;
+        }
+        auto derived_data_path = exe_path->parent_path() / "DerivedDataCache";
+        std::error_code ec;
+        std::filesystem::create_directories(derived_data_path, ec);
+        if (ec) {
+            RDE_CORE_WARN("Could not create derived data path {}: {}", derived_data_path.string(), ec.message());
+            return std::nullopt;
+        }
+        return derived_data_path;
+    }
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include <memory>
 #include <typeindex>
 #include <unordered_map>
+#include <type_traits>
+
+#include "core/ParallelFor.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 
@@ -30,6 +33,9 @@ namespace RDE {
 
         virtual void swap(size_t i0, size_t i1) = 0;
 
+        // Rebuilds the array as element i = old element source_indices[i].
+        virtual void gather(const std::vector<size_t> &source_indices) = 0;
+
         [[nodiscard]] virtual std::unique_ptr<BasePropertyArray> clone() const = 0;
 
         [[nodiscard]] virtual const std::string &name() const = 0;
@@ -132,6 +138,21 @@ namespace RDE {
             std::iter_swap(m_data.begin() + i0, m_data.begin() + i1);
         }
 
+        void gather(const std::vector<size_t> &source_indices) override {
+            VectorType gathered(source_indices.size(), m_value);
+            if constexpr (std::is_same_v<T, bool>) {
+                // std::vector<bool> packs bits, so concurrent writes would race.
+                for (size_t i = 0; i < source_indices.size(); ++i) {
+                    gathered[i] = m_data[source_indices[i]];
+                }
+            } else {
+                Parallel::For(source_indices.size(), 1 << 14, [&](size_t i) {
+                    gathered[i] = m_data[source_indices[i]];
+                });
+            }
+            m_data = std::move(gathered);
+        }
+
         [[nodiscard]] std::unique_ptr<BasePropertyArray> clone() const override {
             auto p = std::make_unique<PropertyArray>(m_name, m_value);
             p->m_data = m_data;
@@ -279,6 +300,19 @@ namespace RDE {
             return *this;
         }
 
+        // Moves hand over the arrays, Property handles into rhs stay valid and now refer to this container's arrays.
+        PropertyContainer(PropertyContainer &&rhs) noexcept { operator=(std::move(rhs)); }
+
+        PropertyContainer &operator=(PropertyContainer &&rhs) noexcept {
+            if (this != &rhs) {
+                m_parrays = std::move(rhs.m_parrays);
+                m_property_map = std::move(rhs.m_property_map);
+                m_size = rhs.m_size;
+                rhs.clear();
+            }
+            return *this;
+        }
+
         void copy_ptrs(const PropertyContainer &rhs) {
             clear();
             m_parrays.resize(rhs.n_properties());
@@ -305,6 +339,15 @@ namespace RDE {
 
         [[nodiscard]] size_t n_properties() const { return m_parrays.size(); }
 
+        // Bytes held by all property arrays.
+        [[nodiscard]] size_t total_size_bytes() const {
+            size_t bytes = 0;
+            for (const auto &parray: m_parrays) {
+                bytes += parray->total_size_bytes();
+            }
+            return bytes;
+        }
+
         [[nodiscard]] std::vector<std::string> properties(const std::initializer_list<size_t> filter_dims = {}) const {
             std::vector<std::string> names;
             names.reserve(m_parrays.size());
@@ -441,6 +484,14 @@ namespace RDE {
             }
         }
 
+        // Keeps only the elements listed in source_indices, in that order, moving every property array once.
+        void gather(const std::vector<size_t> &source_indices) {
+            for (const auto &parray: m_parrays) {
+                parray->gather(source_indices);
+            }
+            m_size = source_indices.size();
+        }
+
     private:
         std::vector<std::shared_ptr<BasePropertyArray> > m_parrays;
         std::unordered_map<std::string, size_t> m_property_map;
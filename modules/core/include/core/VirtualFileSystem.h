@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/MappedFile.h"
+#include "core/PackArchive.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RDE {
+    // Read-only contents of a file opened through the VFS: a loose file mapping, a stored pack entry (pointing into the
+    // pack's mapping, which the view keeps alive) or a decompressed pack entry. Move-only.
+    class FileView {
+    public:
+        FileView() = default;
+
+        explicit FileView(MappedFile file) : m_file(std::move(file)), m_data(m_file.data()), m_size(m_file.size()),
+                                             m_is_open(m_file.is_open()) {
+        }
+
+        FileView(std::shared_ptr<const PackArchive> pack, const char *data, size_t size) : m_pack(std::move(pack)),
+            m_data(data), m_size(size), m_is_open(true) {
+        }
+
+        explicit FileView(std::vector<char> buffer) : m_buffer(std::move(buffer)), m_size(m_buffer.size()),
+                                                      m_is_open(true), m_owns_buffer(true) {
+        }
+
+        [[nodiscard]] bool is_open() const { return m_is_open; }
+
+        [[nodiscard]] const char *data() const { return m_owns_buffer ? m_buffer.data() : m_data; }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+
+        [[nodiscard]] std::string_view view() const { return {data(), m_size}; }
+
+    private:
+        MappedFile m_file;
+        std::shared_ptr<const PackArchive> m_pack;
+        std::vector<char> m_buffer;
+        const char *m_data = nullptr;
+        size_t m_size = 0;
+        bool m_is_open = false;
+        bool m_owns_buffer = false;
+    };
+
+    // Virtual file system: files below a mount point are served from the mounted pack, everything else (and anything
+    // the pack does not contain) from the loose file system. Later mounts shadow earlier ones. Relative paths are
+    // resolved against the working directory as of the last Mount. Thread-safe.
+    namespace VFS {
+        bool Mount(const std::filesystem::path &pack_path, const std::filesystem::path &mount_point);
+
+        void Unmount(const std::filesystem::path &pack_path);
+
+        void UnmountAll();
+
+        // Returns a view that is not open if the file exists nowhere.
+        FileView Open(std::string_view path);
+
+        bool Exists(std::string_view path);
+
+        // True if the file is served from a mounted pack rather than the loose file system.
+        bool IsPacked(std::string_view path);
+
+        bool Stat(std::string_view path, FileStat &out);
+
+        // '/' separators, no "." segments and ".." resolved where possible. Pure string work, no file system access.
+        std::string NormalizePath(std::string_view path);
+    }
+}
@@ -0,0 +1,660 @@
+#include "core/FileIOUtils.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define RDE_HAS_IO_URING 1
+#endif
+
+namespace RDE::FileIO {
+    namespace {
+        // Shared by all reads of one submission.
+        struct Batch {
+            std::function<void(size_t index, ReadResult &result)> callback;
+            std::atomic<size_t> remaining{0};
+            std::promise<void> done;
+        };
+
+        struct ReadOp {
+            std::shared_ptr<Batch> batch;
+            size_t index = 0;
+            ReadResult result;
+        };
+
+        void Complete(ReadOp &op) {
+            try {
+                op.batch->callback(op.index, op.result);
+            } catch (const std::exception &e) {
+                RDE_CORE_ERROR("FileIO: Read callback for '{}' threw: {}", op.result.path, e.what());
+            }
+            if (op.batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                op.batch->done.set_value();
+            }
+        }
+
+        // Blocking read of a whole file, used by the worker pool.
+        bool ReadBlocking(const std::string &path, std::vector<char> &out) {
+            if (VFS::IsPacked(path)) {
+                FileView file = VFS::Open(path);
+                if (!file.is_open()) {
+                    return false;
+                }
+                out.assign(file.data(), file.data() + file.size());
+                return true;
+            }
+#ifdef _WIN32
+            std::ifstream file(std::filesystem::path(path), std::ios::binary | std::ios::ate);
+            if (!file.is_open()) {
+                return false;
+            }
+            out.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(out.data(), static_cast<std::streamsize>(out.size()));
+            return static_cast<bool>(file);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return false;
+            }
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return false;
+            }
+            out.resize(static_cast<size_t>(st.st_size));
+            size_t done = 0;
+            while (done < out.size()) {
+                const ssize_t n = ::pread(fd, out.data() + done, out.size() - done, static_cast<off_t>(done));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    break;
+                }
+                done += static_cast<size_t>(n);
+            }
+            ::close(fd);
+            return done == out.size();
+#endif
+        }
+
+        // --- Worker pool: fallback backend and packed files ---
+        class WorkerPool {
+        public:
+            explicit WorkerPool(size_t num_threads) {
+                for (size_t i = 0; i < num_threads; ++i) {
+                    m_threads.emplace_back([this]() { run(); });
+                }
+            }
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_running = false;
+                }
+                m_condition.notify_all();
+                for (auto &thread: m_threads) {
+                    thread.join();
+                }
+            }
+
+            void push(std::unique_ptr<ReadOp> op) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_queue.push_back(std::move(op));
+                }
+                m_condition.notify_one();
+            }
+
+        private:
+            void run() {
+                while (true) {
+                    std::unique_ptr<ReadOp> op;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_condition.wait(lock, [this]() { return !m_running || !m_queue.empty(); });
+                        if (m_queue.empty()) {
+                            return;
+                        }
+                        op = std::move(m_queue.front());
+                        m_queue.pop_front();
+                    }
+                    op->result.success = ReadBlocking(op->result.path, op->result.data);
+                    if (!op->result.success) {
+                        op->result.data.clear();
+                    }
+                    Complete(*op);
+                }
+            }
+
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::deque<std::unique_ptr<ReadOp> > m_queue;
+            std::vector<std::thread> m_threads;
+            bool m_running = true;
+        };
+
+#ifdef RDE_HAS_IO_URING
+        WorkerPool &GetWorkerPool();
+
+        // --- io_uring backend ---
+        // A single thread owns the ring: it opens the files, splits them into chunks, keeps up to QUEUE_DEPTH reads in
+        // flight and completes the files as their last chunk arrives. Small files are read into buffers registered
+        // with the kernel once, which saves pinning the destination pages on every read.
+        class IoUringReader {
+        public:
+            static constexpr unsigned QUEUE_DEPTH = 64;
+            static constexpr unsigned MAX_OPEN_FILES = 32;
+            static constexpr uint32_t CHUNK_SIZE = 1024 * 1024;
+            static constexpr uint32_t SLOT_SIZE = 256 * 1024;
+            static constexpr unsigned NUM_SLOTS = 16;
+
+            IoUringReader() = default;
+
+            ~IoUringReader() {
+                if (m_thread.joinable()) {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_running = false;
+                    }
+                    m_condition.notify_all();
+                    m_thread.join();
+                }
+                if (m_sqes) {
+                    munmap(m_sqes, m_sqes_size);
+                }
+                if (m_cq_ring && m_cq_ring != m_sq_ring) {
+                    munmap(m_cq_ring, m_cq_ring_size);
+                }
+                if (m_sq_ring) {
+                    munmap(m_sq_ring, m_sq_ring_size);
+                }
+                if (m_ring_fd >= 0) {
+                    ::close(m_ring_fd);
+                }
+            }
+
+            bool init() {
+                io_uring_params params{};
+                m_ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params));
+                if (m_ring_fd < 0) {
+                    RDE_CORE_TRACE("FileIO: io_uring unavailable ({}), using the thread pool.", std::strerror(errno));
+                    return false;
+                }
+
+                m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                if (single_mmap) {
+                    m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+                }
+                m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 m_ring_fd, IORING_OFF_SQ_RING);
+                if (m_sq_ring == MAP_FAILED) {
+                    m_sq_ring = nullptr;
+                    return false;
+                }
+                m_cq_ring = single_mmap
+                                ? m_sq_ring
+                                : mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                       m_ring_fd, IORING_OFF_CQ_RING);
+                if (m_cq_ring == MAP_FAILED) {
+                    m_cq_ring = nullptr;
+                    return false;
+                }
+                m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+                void *sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd,
+                                  IORING_OFF_SQES);
+                if (sqes == MAP_FAILED) {
+                    return false;
+                }
+                m_sqes = static_cast<io_uring_sqe *>(sqes);
+
+                auto *sq = static_cast<char *>(m_sq_ring);
+                m_sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+                m_sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+                m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+                m_sq_entries = params.sq_entries;
+                auto *cq = static_cast<char *>(m_cq_ring);
+                m_cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+                m_cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+                m_cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+                // Registration counts against RLIMIT_MEMLOCK, without it every read goes to the destination directly.
+                m_slot_memory.resize(size_t(NUM_SLOTS) * SLOT_SIZE);
+                std::vector<iovec> iovecs(NUM_SLOTS);
+                for (unsigned i = 0; i < NUM_SLOTS; ++i) {
+                    iovecs[i].iov_base = m_slot_memory.data() + size_t(i) * SLOT_SIZE;
+                    iovecs[i].iov_len = SLOT_SIZE;
+                }
+                if (syscall(__NR_io_uring_register, m_ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(), NUM_SLOTS) == 0) {
+                    for (unsigned i = 0; i < NUM_SLOTS; ++i) {
+                        m_free_slots.push_back(static_cast<int>(i));
+                    }
+                } else {
+                    RDE_CORE_TRACE("FileIO: Could not register io_uring buffers: {}", std::strerror(errno));
+                    m_slot_memory.clear();
+                    m_slot_memory.shrink_to_fit();
+                }
+
+                m_thread = std::thread([this]() { run(); });
+                return true;
+            }
+
+            void push(std::unique_ptr<ReadOp> op) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_failed) {
+                        m_queue.push_back(std::move(op));
+                    }
+                }
+                if (op) {
+                    GetWorkerPool().push(std::move(op));
+                    return;
+                }
+                m_condition.notify_one();
+            }
+
+        private:
+            struct OpenFile {
+                std::unique_ptr<ReadOp> op;
+                int fd = -1;
+                uint64_t size = 0;
+                uint64_t next_offset = 0; // Start of the first chunk not yet queued
+                uint32_t pending = 0; // Chunks in flight
+                int slot = -1;
+                bool failed = false;
+            };
+
+            struct Chunk {
+                OpenFile *file;
+                uint64_t offset;
+                uint32_t length;
+            };
+
+            void run() {
+                std::vector<std::unique_ptr<OpenFile> > files;
+                unsigned to_submit = 0;
+                while (true) {
+                    std::deque<std::unique_ptr<ReadOp> > incoming;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        if (files.empty()) {
+                            m_condition.wait(lock, [this]() { return !m_running || !m_queue.empty(); });
+                            if (m_queue.empty()) {
+                                return;
+                            }
+                        }
+                        while (!m_queue.empty() && files.size() + incoming.size() < MAX_OPEN_FILES) {
+                            incoming.push_back(std::move(m_queue.front()));
+                            m_queue.pop_front();
+                        }
+                    }
+
+                    for (auto &op: incoming) {
+                        auto file = open_file(std::move(op));
+                        if (file) {
+                            files.push_back(std::move(file));
+                        }
+                    }
+
+                    // Queue as many chunks as the ring takes, oldest files first.
+                    for (auto &file: files) {
+                        while (!file->failed && file->next_offset < file->size && m_in_flight < m_sq_entries) {
+                            const uint64_t remaining = file->size - file->next_offset;
+                            const auto length = static_cast<uint32_t>(std::min<uint64_t>(remaining, CHUNK_SIZE));
+                            queue_read(new Chunk{file.get(), file->next_offset, length});
+                            file->next_offset += length;
+                            ++to_submit;
+                        }
+                    }
+
+                    if (m_in_flight > 0) {
+                        const int submitted = static_cast<int>(syscall(__NR_io_uring_enter, m_ring_fd, to_submit, 1,
+                                                                       IORING_ENTER_GETEVENTS, nullptr, 0));
+                        if (submitted < 0) {
+                            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                                RDE_CORE_ERROR("FileIO: io_uring_enter failed: {}, using the thread pool.",
+                                               std::strerror(errno));
+                                fall_back(files, to_submit);
+                                return;
+                            }
+                        } else {
+                            to_submit -= std::min<unsigned>(to_submit, static_cast<unsigned>(submitted));
+                        }
+                        to_submit += reap();
+                    }
+                    files.erase(std::remove_if(files.begin(), files.end(), [this](std::unique_ptr<OpenFile> &file) {
+                        if (file->pending > 0 || (!file->failed && file->next_offset < file->size)) {
+                            return false;
+                        }
+                        finish(*file);
+                        return true;
+                    }), files.end());
+                }
+            }
+
+            // After a hard ring error the open files, the queued ones and every later one are read by the thread pool.
+            void fall_back(std::vector<std::unique_ptr<OpenFile> > &files, unsigned unsubmitted) {
+                std::deque<std::unique_ptr<ReadOp> > queued;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_failed = true;
+                    queued.swap(m_queue);
+                }
+
+                // Entries the kernel never took are dropped. They are the last unsubmitted ones before the tail.
+                const unsigned tail = *m_sq_tail;
+                for (unsigned i = 1; i <= unsubmitted; ++i) {
+                    auto *chunk = reinterpret_cast<Chunk *>(m_sqes[(tail - i) & m_sq_mask].user_data);
+                    --chunk->file->pending;
+                    --m_in_flight;
+                    delete chunk;
+                }
+                std::atomic_ref<unsigned>(*m_sq_tail).store(tail - unsubmitted, std::memory_order_release);
+
+                // Reads the kernel took still write into the buffers, so wait for their completions before the files
+                // are handed on. The completion queue is shared memory and fills without io_uring_enter.
+                for (auto &file: files) {
+                    file->failed = true;
+                }
+                while (m_in_flight > 0) {
+                    reap();
+                    if (m_in_flight > 0) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+
+                for (auto &file: files) {
+                    if (file->fd >= 0) {
+                        ::close(file->fd);
+                    }
+                    if (file->slot >= 0) {
+                        m_free_slots.push_back(file->slot);
+                    }
+                    file->op->result.data.clear();
+                    GetWorkerPool().push(std::move(file->op));
+                }
+                files.clear();
+                for (auto &op: queued) {
+                    GetWorkerPool().push(std::move(op));
+                }
+            }
+
+            std::unique_ptr<OpenFile> open_file(std::unique_ptr<ReadOp> op) {
+                if (VFS::IsPacked(op->result.path)) {
+                    // Pack entries are served from the mapping, decompression must not stall the ring.
+                    GetWorkerPool().push(std::move(op));
+                    return nullptr;
+                }
+                auto file = std::make_unique<OpenFile>();
+                file->op = std::move(op);
+                file->fd = ::open(file->op->result.path.c_str(), O_RDONLY | O_CLOEXEC);
+                struct stat st{};
+                if (file->fd < 0 || ::fstat(file->fd, &st) != 0) {
+                    file->failed = true;
+                    finish(*file);
+                    return nullptr;
+                }
+                file->size = static_cast<uint64_t>(st.st_size);
+                file->op->result.data.resize(file->size);
+                if (file->size == 0) {
+                    finish(*file);
+                    return nullptr;
+                }
+                if (file->size <= SLOT_SIZE && !m_free_slots.empty()) {
+                    file->slot = m_free_slots.back();
+                    m_free_slots.pop_back();
+                }
+                return file;
+            }
+
+            void queue_read(Chunk *chunk) {
+                const unsigned tail = *m_sq_tail;
+                const unsigned index = tail & m_sq_mask;
+                io_uring_sqe &sqe = m_sqes[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                OpenFile &file = *chunk->file;
+                if (file.slot >= 0) {
+                    sqe.opcode = IORING_OP_READ_FIXED;
+                    sqe.addr = reinterpret_cast<uint64_t>(m_slot_memory.data() + size_t(file.slot) * SLOT_SIZE +
+                                                          chunk->offset);
+                    sqe.buf_index = static_cast<uint16_t>(file.slot);
+                } else {
+                    sqe.opcode = IORING_OP_READ;
+                    sqe.addr = reinterpret_cast<uint64_t>(file.op->result.data.data() + chunk->offset);
+                }
+                sqe.fd = file.fd;
+                sqe.off = chunk->offset;
+                sqe.len = chunk->length;
+                sqe.user_data = reinterpret_cast<uint64_t>(chunk);
+                m_sq_array[index] = index;
+                std::atomic_ref<unsigned>(*m_sq_tail).store(tail + 1, std::memory_order_release);
+                ++file.pending;
+                ++m_in_flight;
+            }
+
+            // Returns the number of reads queued again.
+            unsigned reap() {
+                unsigned head = *m_cq_head;
+                const unsigned tail = std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+                std::vector<Chunk *> retry;
+                for (; head != tail; ++head) {
+                    const io_uring_cqe &cqe = m_cqes[head & m_cq_mask];
+                    auto *chunk = reinterpret_cast<Chunk *>(cqe.user_data);
+                    OpenFile &file = *chunk->file;
+                    --file.pending;
+                    --m_in_flight;
+                    if (cqe.res == -EAGAIN || cqe.res == -EINTR) {
+                        retry.push_back(chunk);
+                        continue;
+                    }
+                    if (cqe.res <= 0) {
+                        // An error or the file shrank since fstat.
+                        file.failed = true;
+                        delete chunk;
+                        continue;
+                    }
+                    const auto read = static_cast<uint32_t>(cqe.res);
+                    if (read < chunk->length) {
+                        // Short read, ask for the rest.
+                        chunk->offset += read;
+                        chunk->length -= read;
+                        retry.push_back(chunk);
+                        continue;
+                    }
+                    delete chunk;
+                }
+                std::atomic_ref<unsigned>(*m_cq_head).store(head, std::memory_order_release);
+
+                unsigned queued = 0;
+                for (Chunk *chunk: retry) {
+                    if (chunk->file->failed) {
+                        delete chunk;
+                        continue;
+                    }
+                    queue_read(chunk);
+                    ++queued;
+                }
+                return queued;
+            }
+
+            void finish(OpenFile &file) {
+                if (file.fd >= 0) {
+                    ::close(file.fd);
+                    file.fd = -1;
+                }
+                if (file.slot >= 0) {
+                    if (!file.failed) {
+                        std::memcpy(file.op->result.data.data(), m_slot_memory.data() + size_t(file.slot) * SLOT_SIZE,
+                                    file.size);
+                    }
+                    m_free_slots.push_back(file.slot);
+                    file.slot = -1;
+                }
+                file.op->result.success = !file.failed;
+                if (file.failed) {
+                    file.op->result.data.clear();
+                }
+                Complete(*file.op);
+            }
+
+            int m_ring_fd = -1;
+            void *m_sq_ring = nullptr;
+            void *m_cq_ring = nullptr;
+            size_t m_sq_ring_size = 0;
+            size_t m_cq_ring_size = 0;
+            size_t m_sqes_size = 0;
+            io_uring_sqe *m_sqes = nullptr;
+            unsigned *m_sq_tail = nullptr;
+            unsigned *m_sq_array = nullptr;
+            unsigned m_sq_mask = 0;
+            unsigned m_sq_entries = 0;
+            unsigned *m_cq_head = nullptr;
+            unsigned *m_cq_tail = nullptr;
+            unsigned m_cq_mask = 0;
+            io_uring_cqe *m_cqes = nullptr;
+            unsigned m_in_flight = 0;
+
+            std::vector<char> m_slot_memory;
+            std::vector<int> m_free_slots;
+
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::deque<std::unique_ptr<ReadOp> > m_queue;
+            std::thread m_thread;
+            bool m_running = true;
+            bool m_failed = false; // Hard ring error, reads go to the thread pool
+        };
+#endif
+
+        class AsyncReader {
+        public:
+            AsyncReader() : m_pool(std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 4)) {
+#ifdef RDE_HAS_IO_URING
+                m_ring = std::make_unique<IoUringReader>();
+                if (!m_ring->init()) {
+                    m_ring.reset();
+                }
+#endif
+            }
+
+            static AsyncReader &Get() {
+                static AsyncReader reader;
+                return reader;
+            }
+
+            void submit(std::unique_ptr<ReadOp> op) {
+#ifdef RDE_HAS_IO_URING
+                if (m_ring) {
+                    m_ring->push(std::move(op));
+                    return;
+                }
+#endif
+                m_pool.push(std::move(op));
+            }
+
+            WorkerPool &get_pool() { return m_pool; }
+
+            [[nodiscard]] bool uses_io_uring() const {
+#ifdef RDE_HAS_IO_URING
+                return m_ring != nullptr;
+#else
+                return false;
+#endif
+            }
+
+        private:
+            // Declared first so the ring, which forwards packed files to it, is destroyed before it.
+            WorkerPool m_pool;
+#ifdef RDE_HAS_IO_URING
+            std::unique_ptr<IoUringReader> m_ring;
+#endif
+        };
+
+#ifdef RDE_HAS_IO_URING
+        WorkerPool &GetWorkerPool() {
+            return AsyncReader::Get().get_pool();
+        }
+#endif
+
+        std::future<void> Submit(std::vector<std::string> paths,
+                                 std::function<void(size_t index, ReadResult &result)> callback) {
+            auto batch = std::make_shared<Batch>();
+            batch->callback = std::move(callback);
+            batch->remaining = paths.size();
+            std::future<void> future = batch->done.get_future();
+            if (paths.empty()) {
+                batch->done.set_value();
+                return future;
+            }
+            AsyncReader &reader = AsyncReader::Get();
+            for (size_t i = 0; i < paths.size(); ++i) {
+                auto op = std::make_unique<ReadOp>();
+                op->batch = batch;
+                op->index = i;
+                op->result.path = std::move(paths[i]);
+                reader.submit(std::move(op));
+            }
+            return future;
+        }
+    }
+
+    std::future<void> ReadAsync(std::vector<std::string> paths, ReadCallback callback) {
+        return Submit(std::move(paths), [callback = std::move(callback)](size_t, ReadResult &result) {
+            callback(result);
+        });
+    }
+
+    std::future<ReadResult> ReadAsync(std::string path) {
+        auto promise = std::make_shared<std::promise<ReadResult> >();
+        std::future<ReadResult> future = promise->get_future();
+        std::vector<std::string> paths;
+        paths.push_back(std::move(path));
+        Submit(std::move(paths), [promise](size_t, ReadResult &result) {
+            promise->set_value(std::move(result));
+        });
+        return future;
+    }
+
+    std::vector<ReadResult> ReadBatch(std::vector<std::string> paths) {
+        std::vector<ReadResult> results(paths.size());
+        Submit(std::move(paths), [&results](size_t index, ReadResult &result) {
+            results[index] = std::move(result);
+        }).wait();
+        for (const auto &result: results) {
+            if (!result.success) {
+                RDE_CORE_ERROR("Failed to read file: {}", result.path);
+            }
+        }
+        return results;
+    }
+
+    const char *GetAsyncBackendName() {
+        return AsyncReader::Get().uses_io_uring() ? "io_uring" : "thread pool";
+    }
+}
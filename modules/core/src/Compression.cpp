@@ -0,0 +1,172 @@
+#include "core/Compression.h"
+
+#include <cstring>
+
+namespace RDE::Compression {
+    namespace {
+        constexpr size_t MIN_MATCH = 4;
+        constexpr size_t MAX_OFFSET = 65535;
+        constexpr int HASH_BITS = 14;
+        // Matches must not start in the last bytes of a block, they are always emitted as literals.
+        constexpr size_t END_LITERALS = 12;
+
+        uint32_t Read32(const uint8_t *p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint32_t HashOf(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+        // Length continuation bytes: 255 means another byte follows.
+        uint8_t *WriteLength(uint8_t *op, size_t length) {
+            while (length >= 255) {
+                *op++ = 255;
+                length -= 255;
+            }
+            *op++ = static_cast<uint8_t>(length);
+            return op;
+        }
+
+        bool ReadLength(const uint8_t *&ip, const uint8_t *end, size_t &length) {
+            uint8_t byte;
+            do {
+                if (ip >= end) {
+                    return false;
+                }
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        uint8_t *WriteSequence(uint8_t *op, const uint8_t *literals, size_t literal_count, size_t offset,
+                               size_t match_length) {
+            uint8_t *token = op++;
+            const size_t match_code = match_length ? match_length - MIN_MATCH : 0;
+            *token = static_cast<uint8_t>((literal_count >= 15 ? 15 : literal_count) << 4 |
+                                          (match_code >= 15 ? 15 : match_code));
+            if (literal_count >= 15) {
+                op = WriteLength(op, literal_count - 15);
+            }
+            if (literal_count) {
+                std::memcpy(op, literals, literal_count);
+                op += literal_count;
+            }
+            if (match_length) {
+                *op++ = static_cast<uint8_t>(offset);
+                *op++ = static_cast<uint8_t>(offset >> 8);
+                if (match_code >= 15) {
+                    op = WriteLength(op, match_code - 15);
+                }
+            }
+            return op;
+        }
+    }
+
+    size_t CompressBound(size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    size_t CompressBlock(const void *src, size_t size, void *dst, size_t capacity) {
+        if (capacity < CompressBound(size)) {
+            return 0;
+        }
+        const auto *const base = static_cast<const uint8_t *>(src);
+        const uint8_t *const end = base + size;
+        auto *op = static_cast<uint8_t *>(dst);
+
+        const uint8_t *anchor = base;
+        if (size > END_LITERALS + MIN_MATCH) {
+            uint32_t table[1u << HASH_BITS] = {};
+            const uint8_t *const match_limit = end - END_LITERALS;
+            const uint8_t *ip = base + 1;
+            uint32_t misses = 0;
+            while (ip < match_limit) {
+                const uint32_t sequence = Read32(ip);
+                const uint32_t h = HashOf(sequence);
+                const uint8_t *candidate = base + table[h];
+                table[h] = static_cast<uint32_t>(ip - base);
+                if (candidate >= ip || size_t(ip - candidate) > MAX_OFFSET || Read32(candidate) != sequence) {
+                    // Skip faster through data that does not compress.
+                    ip += 1 + (misses++ >> 6);
+                    continue;
+                }
+                misses = 0;
+
+                // Extend backwards over pending literals, then forwards.
+                while (ip > anchor && candidate > base && ip[-1] == candidate[-1]) {
+                    --ip;
+                    --candidate;
+                }
+                size_t length = MIN_MATCH;
+                while (ip + length < match_limit && ip[length] == candidate[length]) {
+                    ++length;
+                }
+
+                op = WriteSequence(op, anchor, size_t(ip - anchor), size_t(ip - candidate), length);
+                ip += length;
+                anchor = ip;
+                if (ip < match_limit) {
+                    table[HashOf(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - base);
+                }
+            }
+        }
+        op = WriteSequence(op, anchor, size_t(end - anchor), 0, 0);
+        return size_t(op - static_cast<uint8_t *>(dst));
+    }
+
+    bool DecompressBlock(const void *src, size_t size, void *dst, size_t raw_size) {
+        const auto *ip = static_cast<const uint8_t *>(src);
+        const uint8_t *const end = ip + size;
+        auto *const out = static_cast<uint8_t *>(dst);
+        uint8_t *op = out;
+        uint8_t *const out_end = out + raw_size;
+
+        while (ip < end) {
+            const uint8_t token = *ip++;
+            size_t literal_count = token >> 4;
+            if (literal_count == 15 && !ReadLength(ip, end, literal_count)) {
+                return false;
+            }
+            if (literal_count > size_t(end - ip) || literal_count > size_t(out_end - op)) {
+                return false;
+            }
+            if (literal_count) {
+                std::memcpy(op, ip, literal_count);
+                ip += literal_count;
+                op += literal_count;
+            }
+            if (ip == end) {
+                break; // The last sequence has no match
+            }
+
+            if (end - ip < 2) {
+                return false;
+            }
+            const size_t offset = size_t(ip[0]) | size_t(ip[1]) << 8;
+            ip += 2;
+            size_t length = token & 15;
+            if (length == 15 && !ReadLength(ip, end, length)) {
+                return false;
+            }
+            length += MIN_MATCH;
+            if (offset == 0 || offset > size_t(op - out) || length > size_t(out_end - op)) {
+                return false;
+            }
+            const uint8_t *match = op - offset;
+            if (offset >= length) {
+                std::memcpy(op, match, length);
+                op += length;
+            } else {
+                // Overlapping copy repeats the last offset bytes.
+                for (size_t i = 0; i < length; ++i) {
+                    *op++ = *match++;
+                }
+            }
+        }
+        return op == out_end;
+    }
+}
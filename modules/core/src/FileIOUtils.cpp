@@ -1,6 +1,9 @@
 #include "core/FileIOUtils.h"
 #include "core/Log.h"
+#include "core/VirtualFileSystem.h"
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <filesystem>
 
@@ -21,20 +24,45 @@ namespace RDE::FileIO {
         return {};
     }
 
+    std::string_view GetExtension(std::string_view path) {
+        const size_t separator = path.find_last_of("/\\");
+        const size_t dot = path.find_last_of('.');
+        if (dot == std::string_view::npos || (separator != std::string_view::npos && dot < separator) ||
+            dot == (separator == std::string_view::npos ? 0 : separator + 1)) {
+            return {};
+        }
+        return path.substr(dot);
+    }
+
+    bool HasNameWord(std::string_view path, std::span<const std::string_view> words) {
+        std::string name(path.substr(path.find_last_of("/\\") + 1));
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        name = name.substr(0, name.rfind('.'));
+
+        size_t begin = 0;
+        while (begin <= name.size()) {
+            size_t end = name.find_first_of("_-. ", begin);
+            if (end == std::string::npos) {
+                end = name.size();
+            }
+            const std::string_view word = std::string_view(name).substr(begin, end - begin);
+            if (std::find(words.begin(), words.end(), word) != words.end()) {
+                return true;
+            }
+            begin = end + 1;
+        }
+        return false;
+    }
+
     std::vector<char> ReadFile(const std::filesystem::path& path) {
-        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        FileView file = VFS::Open(path.string());
 
         if (!file.is_open()) {
             RDE_CORE_ERROR("Failed to open file: {}", path.string());
             return {};
         }
 
-        size_t fileSize = (size_t)file.tellg();
-        std::vector<char> buffer(fileSize);
-
-        file.seekg(0);
-        file.read(buffer.data(), fileSize);
-        file.close();
+        std::vector<char> buffer(file.data(), file.data() + file.size());
 
         if (buffer.empty()) {
             RDE_CORE_WARN("File is empty: {}", path.string());
@@ -0,0 +1,101 @@
+#include "core/Hash.h"
+
+#include <cstring>
+
+namespace RDE::Hash {
+    namespace {
+        constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+        uint64_t RotateLeft(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        uint64_t Read64(const unsigned char *p) {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint32_t Read32(const unsigned char *p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint64_t Round(uint64_t acc, uint64_t input) {
+            acc += input * PRIME2;
+            acc = RotateLeft(acc, 31);
+            return acc * PRIME1;
+        }
+
+        uint64_t MergeRound(uint64_t acc, uint64_t value) {
+            acc ^= Round(0, value);
+            return acc * PRIME1 + PRIME4;
+        }
+    }
+
+    uint64_t Compute(const void *data, size_t size, uint64_t seed) {
+        const auto *p = static_cast<const unsigned char *>(data);
+        const unsigned char *const end = p + size;
+        uint64_t h;
+
+        if (size >= 32) {
+            // Four independent lanes, 32 bytes per iteration.
+            uint64_t v1 = seed + PRIME1 + PRIME2;
+            uint64_t v2 = seed + PRIME2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - PRIME1;
+            const unsigned char *const limit = end - 32;
+            do {
+                v1 = Round(v1, Read64(p));
+                v2 = Round(v2, Read64(p + 8));
+                v3 = Round(v3, Read64(p + 16));
+                v4 = Round(v4, Read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+            h = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            h = MergeRound(h, v1);
+            h = MergeRound(h, v2);
+            h = MergeRound(h, v3);
+            h = MergeRound(h, v4);
+        } else {
+            h = seed + PRIME5;
+        }
+        h += static_cast<uint64_t>(size);
+
+        // --- Tail ---
+        for (; p + 8 <= end; p += 8) {
+            h ^= Round(0, Read64(p));
+            h = RotateLeft(h, 27) * PRIME1 + PRIME4;
+        }
+        if (p + 4 <= end) {
+            h ^= static_cast<uint64_t>(Read32(p)) * PRIME1;
+            h = RotateLeft(h, 23) * PRIME2 + PRIME3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            h ^= static_cast<uint64_t>(*p) * PRIME5;
+            h = RotateLeft(h, 11) * PRIME1;
+        }
+
+        // --- Avalanche ---
+        h ^= h >> 33;
+        h *= PRIME2;
+        h ^= h >> 29;
+        h *= PRIME3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    std::string ToHex(uint64_t hash) {
+        static constexpr char DIGITS[] = "0123456789abcdef";
+        std::string hex(16, '0');
+        for (int i = 15; i >= 0; --i) {
+            hex[i] = DIGITS[hash & 0xF];
+            hash >>= 4;
+        }
+        return hex;
+    }
+}
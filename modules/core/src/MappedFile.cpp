@@ -0,0 +1,120 @@
+#include "core/MappedFile.h"
+#include "core/Log.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#undef WIN32_LEAN_AND_MEAN
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RDE {
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_is_open = std::exchange(other.m_is_open, false);
+#ifdef _WIN32
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::filesystem::path &path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            RDE_CORE_ERROR("MappedFile: Failed to open file: {}", path.string());
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size)) {
+            CloseHandle(file);
+            RDE_CORE_ERROR("MappedFile: Failed to query the size of: {}", path.string());
+            return false;
+        }
+        m_file = file;
+        m_size = static_cast<size_t>(file_size.QuadPart);
+        m_is_open = true;
+        if (m_size == 0) {
+            return true;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping) {
+                CloseHandle(mapping);
+            }
+            RDE_CORE_ERROR("MappedFile: Failed to map file: {}", path.string());
+            close();
+            return false;
+        }
+        m_mapping = mapping;
+        m_data = static_cast<const char *>(view);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            RDE_CORE_ERROR("MappedFile: Failed to open file: {}", path.string());
+            return false;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            RDE_CORE_ERROR("MappedFile: Failed to query the size of: {}", path.string());
+            return false;
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        m_is_open = true;
+        if (m_size > 0) {
+            void *view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED) {
+                ::close(fd);
+                m_size = 0;
+                m_is_open = false;
+                RDE_CORE_ERROR("MappedFile: Failed to map file: {}", path.string());
+                return false;
+            }
+            // Parsers stream through the mapping once, let the kernel read ahead aggressively.
+            madvise(view, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char *>(view);
+        }
+        // The mapping keeps its own reference to the file.
+        ::close(fd);
+#endif
+        return true;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+        }
+        if (m_file) {
+            CloseHandle(static_cast<HANDLE>(m_file));
+        }
+        m_file = nullptr;
+        m_mapping = nullptr;
+#else
+        if (m_data) {
+            munmap(const_cast<char *>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_is_open = false;
+    }
+}
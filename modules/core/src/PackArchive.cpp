@@ -0,0 +1,345 @@
+#include "core/PackArchive.h"
+#include "core/Compression.h"
+#include "core/Hash.h"
+#include "core/Log.h"
+#include "core/ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+namespace RDE {
+    namespace {
+        constexpr char MAGIC[8] = {'R', 'D', 'E', 'P', 'A', 'C', 'K', '\0'};
+        constexpr uint32_t CODEC_STORED = 0;
+        constexpr uint32_t CODEC_BLOCKS = 1;
+        constexpr uint32_t RAW_BLOCK_FLAG = 0x80000000u;
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t entry_count;
+            uint64_t toc_offset;
+            uint64_t strings_offset;
+            uint64_t strings_size;
+            uint64_t block_table_offset;
+            uint64_t block_count;
+            uint64_t file_size;
+        };
+
+        static_assert(sizeof(Header) == 64 && sizeof(PackArchive::Entry) == 56);
+
+        uint64_t BlockCount(uint64_t raw_size) {
+            return (raw_size + PackArchive::BLOCK_SIZE - 1) / PackArchive::BLOCK_SIZE;
+        }
+    }
+
+    bool PackArchive::open(const std::filesystem::path &path) {
+        close();
+        if (!m_file.open(path)) {
+            return false;
+        }
+        const char *base = m_file.data();
+        const uint64_t file_size = m_file.size();
+        auto fail = [&](const char *reason) {
+            RDE_CORE_ERROR("PackArchive: '{}' {}", path.string(), reason);
+            close();
+            return false;
+        };
+
+        Header header{};
+        if (file_size < sizeof(Header)) {
+            return fail("is too small to be a pack");
+        }
+        std::memcpy(&header, base, sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+            return fail("is not a pack of a supported version");
+        }
+        if (header.file_size != file_size ||
+            header.toc_offset > file_size || header.entry_count > (file_size - header.toc_offset) / sizeof(Entry) ||
+            header.strings_offset > file_size || header.strings_size > file_size - header.strings_offset ||
+            header.block_table_offset > file_size ||
+            header.block_count > (file_size - header.block_table_offset) / sizeof(uint32_t)) {
+            return fail("has an invalid layout");
+        }
+
+        m_entries.resize(header.entry_count);
+        std::memcpy(m_entries.data(), base + header.toc_offset, m_entries.size() * sizeof(Entry));
+        m_strings = std::string_view(base + header.strings_offset, header.strings_size);
+        m_block_sizes.resize(header.block_count);
+        std::memcpy(m_block_sizes.data(), base + header.block_table_offset, m_block_sizes.size() * sizeof(uint32_t));
+
+        // Validate every entry once, reads can then trust the tables.
+        m_block_offsets.assign(m_block_sizes.size(), 0);
+        for (const Entry &entry: m_entries) {
+            if (uint64_t(entry.name_offset) + entry.name_size > m_strings.size() ||
+                entry.data_offset > file_size || entry.stored_size > file_size - entry.data_offset) {
+                return fail("has an invalid entry");
+            }
+            if (entry.codec == CODEC_STORED) {
+                if (entry.stored_size != entry.raw_size) {
+                    return fail("has an invalid entry");
+                }
+                continue;
+            }
+            const uint64_t blocks = BlockCount(entry.raw_size);
+            if (entry.codec != CODEC_BLOCKS || entry.first_block > m_block_sizes.size() ||
+                blocks > m_block_sizes.size() - entry.first_block) {
+                return fail("has an invalid entry");
+            }
+            uint64_t offset = 0;
+            for (uint64_t b = 0; b < blocks; ++b) {
+                m_block_offsets[entry.first_block + b] = offset;
+                offset += m_block_sizes[entry.first_block + b] & ~RAW_BLOCK_FLAG;
+            }
+            if (offset != entry.stored_size) {
+                return fail("has an invalid block table");
+            }
+        }
+
+        std::error_code ec;
+        m_mtime = std::filesystem::last_write_time(path, ec);
+        m_path = path;
+        return true;
+    }
+
+    void PackArchive::close() {
+        m_file.close();
+        m_path.clear();
+        m_entries.clear();
+        m_strings = {};
+        m_block_sizes.clear();
+        m_block_offsets.clear();
+    }
+
+    const PackArchive::Entry *PackArchive::find(std::string_view path) const {
+        const uint64_t hash = Hash::Compute(path);
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash,
+                                   [](const Entry &entry, uint64_t value) { return entry.path_hash < value; });
+        // Colliding hashes sit next to each other, the name decides.
+        for (; it != m_entries.end() && it->path_hash == hash; ++it) {
+            if (m_strings.substr(it->name_offset, it->name_size) == path) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    bool PackArchive::stat(std::string_view path, FileStat &out) const {
+        const Entry *entry = find(path);
+        if (!entry) {
+            return false;
+        }
+        out.size = entry->raw_size;
+        out.mtime = m_mtime;
+        out.content_hash = entry->content_hash;
+        return true;
+    }
+
+    bool PackArchive::read(std::string_view path, const char *&data, size_t &size, std::vector<char> &buffer) const {
+        const Entry *entry = find(path);
+        if (!entry) {
+            return false;
+        }
+        const char *source = m_file.data() + entry->data_offset;
+        if (entry->codec == CODEC_STORED) {
+            data = source;
+            size = entry->raw_size;
+            return true;
+        }
+
+        buffer.resize(entry->raw_size);
+        std::atomic<bool> valid = true;
+        Parallel::For(BlockCount(entry->raw_size), 1, [&](size_t b) {
+            const uint32_t stored = m_block_sizes[entry->first_block + b];
+            const char *block = source + m_block_offsets[entry->first_block + b];
+            const size_t raw_size = std::min<uint64_t>(BLOCK_SIZE, entry->raw_size - b * BLOCK_SIZE);
+            char *target = buffer.data() + b * BLOCK_SIZE;
+            if (stored & RAW_BLOCK_FLAG) {
+                if ((stored & ~RAW_BLOCK_FLAG) != raw_size) {
+                    valid = false;
+                    return;
+                }
+                std::memcpy(target, block, raw_size);
+            } else if (!Compression::DecompressBlock(block, stored, target, raw_size)) {
+                valid = false;
+            }
+        });
+        if (!valid) {
+            RDE_CORE_ERROR("PackArchive: Entry '{}' of '{}' is corrupt", path, m_path.string());
+            return false;
+        }
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+    }
+
+    std::vector<std::string> PackArchive::list() const {
+        std::vector<std::string> paths;
+        paths.reserve(m_entries.size());
+        for (const Entry &entry: m_entries) {
+            paths.emplace_back(m_strings.substr(entry.name_offset, entry.name_size));
+        }
+        return paths;
+    }
+
+    namespace PackBuilder {
+        bool Build(const std::filesystem::path &root, const std::filesystem::path &output, const Settings &settings,
+                   Statistics *statistics) {
+            std::filesystem::path temp_path = output;
+            temp_path += ".tmp";
+
+            // -- Collect the files, sorted for reproducible packs --
+            std::error_code ec;
+            const std::filesystem::path output_path = std::filesystem::absolute(output, ec).lexically_normal();
+            const std::filesystem::path output_temp_path = std::filesystem::absolute(temp_path, ec).lexically_normal();
+            std::vector<std::filesystem::path> files;
+            for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+                 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                std::error_code file_ec;
+                const auto path = std::filesystem::absolute(it->path(), file_ec).lexically_normal();
+                if (it->is_regular_file(file_ec) && path != output_path && path != output_temp_path) {
+                    files.push_back(it->path());
+                }
+            }
+            if (ec) {
+                RDE_CORE_ERROR("PackBuilder: Failed to list '{}': {}", root.string(), ec.message());
+                return false;
+            }
+            std::sort(files.begin(), files.end());
+
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                RDE_CORE_ERROR("PackBuilder: Failed to open '{}' for writing", temp_path.string());
+                return false;
+            }
+            uint64_t written = 0;
+            auto write = [&](const void *data, uint64_t size) {
+                out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+                written += size;
+            };
+            auto pad_to = [&](uint64_t alignment) {
+                static const std::vector<char> zeros(PackArchive::ALIGNMENT, 0);
+                write(zeros.data(), (alignment - written % alignment) % alignment);
+            };
+
+            Header header{};
+            write(&header, sizeof(Header));
+
+            // -- Entry data --
+            Statistics stats;
+            std::vector<PackArchive::Entry> entries;
+            std::string strings;
+            std::vector<uint32_t> block_sizes;
+            for (const std::filesystem::path &file_path: files) {
+                MappedFile file;
+                if (!file.open(file_path)) {
+                    out.close();
+                    std::filesystem::remove(temp_path, ec);
+                    return false;
+                }
+                const std::string name = std::filesystem::relative(file_path, root).generic_string();
+
+                PackArchive::Entry entry{};
+                entry.path_hash = Hash::Compute(name);
+                entry.content_hash = Hash::Compute(file.data(), file.size());
+                entry.raw_size = file.size();
+                entry.name_offset = static_cast<uint32_t>(strings.size());
+                entry.name_size = static_cast<uint32_t>(name.size());
+                strings += name;
+
+                // Compress all blocks in parallel, then keep the result only if it pays off.
+                const uint64_t num_blocks = BlockCount(file.size());
+                std::vector<std::vector<char> > blocks;
+                uint64_t compressed_size = 0;
+                if (settings.compress && num_blocks > 0) {
+                    blocks.resize(num_blocks);
+                    Parallel::For(num_blocks, 1, [&](size_t b) {
+                        const size_t raw_size = std::min<uint64_t>(PackArchive::BLOCK_SIZE,
+                                                                   file.size() - b * PackArchive::BLOCK_SIZE);
+                        const char *source = file.data() + b * PackArchive::BLOCK_SIZE;
+                        std::vector<char> &block = blocks[b];
+                        block.resize(Compression::CompressBound(raw_size));
+                        const size_t size = Compression::CompressBlock(source, raw_size, block.data(), block.size());
+                        if (size == 0 || size >= raw_size) {
+                            block.assign(source, source + raw_size); // Incompressible block, stored raw
+                        } else {
+                            block.resize(size);
+                        }
+                    });
+                    for (const auto &block: blocks) {
+                        compressed_size += block.size();
+                    }
+                }
+
+                pad_to(PackArchive::ALIGNMENT);
+                entry.data_offset = written;
+                if (!blocks.empty() && double(compressed_size) <= double(file.size()) * (1.0 - settings.min_savings)) {
+                    entry.codec = CODEC_BLOCKS;
+                    entry.first_block = static_cast<uint32_t>(block_sizes.size());
+                    entry.stored_size = compressed_size;
+                    for (size_t b = 0; b < blocks.size(); ++b) {
+                        const size_t raw_size = std::min<uint64_t>(PackArchive::BLOCK_SIZE,
+                                                                   file.size() - b * PackArchive::BLOCK_SIZE);
+                        const bool raw = blocks[b].size() == raw_size;
+                        block_sizes.push_back(static_cast<uint32_t>(blocks[b].size()) | (raw ? RAW_BLOCK_FLAG : 0));
+                        write(blocks[b].data(), blocks[b].size());
+                    }
+                    ++stats.num_compressed;
+                } else {
+                    entry.codec = CODEC_STORED;
+                    entry.stored_size = file.size();
+                    write(file.data(), file.size());
+                }
+                entries.push_back(entry);
+                ++stats.num_files;
+                stats.raw_bytes += entry.raw_size;
+                stats.stored_bytes += entry.stored_size;
+            }
+
+            // -- Tables --
+            std::stable_sort(entries.begin(), entries.end(),
+                             [](const PackArchive::Entry &a, const PackArchive::Entry &b) {
+                                 return a.path_hash < b.path_hash;
+                             });
+            pad_to(sizeof(uint64_t));
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = PackArchive::VERSION;
+            header.entry_count = static_cast<uint32_t>(entries.size());
+            header.toc_offset = written;
+            write(entries.data(), entries.size() * sizeof(PackArchive::Entry));
+            header.strings_offset = written;
+            header.strings_size = strings.size();
+            write(strings.data(), strings.size());
+            pad_to(sizeof(uint32_t));
+            header.block_table_offset = written;
+            header.block_count = block_sizes.size();
+            write(block_sizes.data(), block_sizes.size() * sizeof(uint32_t));
+            header.file_size = written;
+
+            out.seekp(0);
+            out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+            out.close();
+            if (!out) {
+                RDE_CORE_ERROR("PackBuilder: Failed to write '{}'", temp_path.string());
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+            std::filesystem::rename(temp_path, output, ec);
+            if (ec) {
+                RDE_CORE_ERROR("PackBuilder: Failed to move '{}' into place: {}", output.string(), ec.message());
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+
+            RDE_CORE_INFO("PackBuilder: Packed {} files ({} compressed), {:.1f} MiB -> {:.1f} MiB into '{}'",
+                          stats.num_files, stats.num_compressed, double(stats.raw_bytes) / (1024.0 * 1024.0),
+                          double(stats.stored_bytes) / (1024.0 * 1024.0), output.string());
+            if (statistics) {
+                *statistics = stats;
+            }
+            return true;
+        }
+    }
+}
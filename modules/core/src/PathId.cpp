@@ -0,0 +1,53 @@
+#include "core/PathId.h"
+#include "core/Hash.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+
+#include <mutex>
+
+namespace RDE {
+    namespace {
+        PathId HashNormalized(std::string_view normalized) {
+            if (normalized.empty()) {
+                return 0;
+            }
+            const PathId id = Hash::Compute(normalized);
+            return id != 0 ? id : 1;
+        }
+    }
+
+    PathId PathTable::MakeId(std::string_view path) {
+        return HashNormalized(VFS::NormalizePath(path));
+    }
+
+    PathId PathTable::intern(std::string_view path) {
+        std::string normalized = VFS::NormalizePath(path);
+        const PathId id = HashNormalized(normalized);
+        if (id == 0) {
+            return 0;
+        }
+        {
+            std::shared_lock lock(m_mutex);
+            if (auto it = m_paths.find(id); it != m_paths.end()) {
+                if (it->second != normalized) {
+                    RDE_CORE_ERROR("PathTable: '{}' and '{}' have the same id {}.", it->second, normalized, id);
+                }
+                return id;
+            }
+        }
+        std::unique_lock lock(m_mutex);
+        m_paths.try_emplace(id, std::move(normalized));
+        return id;
+    }
+
+    std::string_view PathTable::get_path(PathId id) const {
+        std::shared_lock lock(m_mutex);
+        auto it = m_paths.find(id);
+        return it == m_paths.end() ? std::string_view() : std::string_view(it->second);
+    }
+
+    size_t PathTable::size() const {
+        std::shared_lock lock(m_mutex);
+        return m_paths.size();
+    }
+}
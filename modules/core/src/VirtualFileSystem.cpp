@@ -0,0 +1,248 @@
+#include "core/VirtualFileSystem.h"
+#include "core/Log.h"
+
+#include <algorithm>
+#include <shared_mutex>
+
+namespace RDE::VFS {
+    namespace {
+        struct MountedPack {
+            std::string root; // Normalized, ends with '/'
+            std::shared_ptr<PackArchive> pack;
+        };
+
+        std::shared_mutex &MountMutex() {
+            static std::shared_mutex mutex;
+            return mutex;
+        }
+
+        std::vector<MountedPack> &Mounts() {
+            static std::vector<MountedPack> mounts;
+            return mounts;
+        }
+
+        // Normalized, ends with '/'. Taken at every Mount, so opening a relative path does not query it.
+        std::string &WorkingDirectory() {
+            static std::string directory;
+            return directory;
+        }
+
+        // True if NormalizePath would return path unchanged.
+        bool IsNormalized(std::string_view path) {
+            size_t i = path.size() >= 2 && path[1] == ':' ? 2 : 0;
+            if (i < path.size() && path[i] == '/') {
+                ++i;
+            }
+            while (i < path.size()) {
+                const size_t end = std::min(path.find('/', i), path.size());
+                const std::string_view segment = path.substr(i, end - i);
+                if (segment.empty() || segment == "." || segment == ".." ||
+                    segment.find('\\') != std::string_view::npos) {
+                    return false;
+                }
+                if (end + 1 == path.size()) {
+                    return false; // Trailing '/'
+                }
+                i = end + 1;
+            }
+            return true;
+        }
+
+        // True if prefix + path lies below root, relative is then set to the rest of it.
+        bool IsBelow(std::string_view root, std::string_view prefix, std::string_view path, std::string &relative) {
+            if (prefix.size() + path.size() <= root.size()) {
+                return false;
+            }
+            if (root.size() <= prefix.size()) {
+                if (prefix.substr(0, root.size()) != root) {
+                    return false;
+                }
+                relative.assign(prefix.substr(root.size())).append(path);
+                return true;
+            }
+            const size_t rest = root.size() - prefix.size();
+            if (root.substr(0, prefix.size()) != prefix || path.substr(0, rest) != root.substr(prefix.size())) {
+                return false;
+            }
+            relative.assign(path.substr(rest));
+            return true;
+        }
+
+        // Finds the innermost pack containing path and returns its path relative to the pack root. Mount roots are
+        // absolute, a relative path is matched as the working directory followed by the path. Paths that are
+        // normalized already, the common case, are matched as they are.
+        std::shared_ptr<PackArchive> FindPack(std::string_view path, std::string &relative) {
+            std::shared_lock lock(MountMutex());
+            if (Mounts().empty()) {
+                return nullptr;
+            }
+            std::string normalized;
+            std::string_view key = path;
+            if (!IsNormalized(key)) {
+                normalized = NormalizePath(key);
+                key = normalized;
+            }
+            std::string_view prefix;
+            const bool has_drive = key.size() >= 2 && key[1] == ':';
+            const bool is_absolute = has_drive ? key.size() >= 3 && key[2] == '/' : !key.empty() && key[0] == '/';
+            if (!is_absolute) {
+                // Leading ".." segments and drive-relative paths are resolved before matching.
+                if (has_drive) {
+                    std::error_code ec;
+                    const std::filesystem::path absolute = std::filesystem::absolute(std::filesystem::path(key), ec);
+                    normalized = NormalizePath(absolute.generic_string());
+                    key = normalized;
+                } else if (key == ".." || key.starts_with("../")) {
+                    normalized = NormalizePath(WorkingDirectory() + std::string(key));
+                    key = normalized;
+                } else {
+                    prefix = WorkingDirectory();
+                }
+            }
+            for (auto it = Mounts().rbegin(); it != Mounts().rend(); ++it) {
+                if (IsBelow(it->root, prefix, key, relative) && it->pack->contains(relative)) {
+                    return it->pack;
+                }
+            }
+            relative.clear();
+            return nullptr;
+        }
+    }
+
+    bool Mount(const std::filesystem::path &pack_path, const std::filesystem::path &mount_point) {
+        auto pack = std::make_shared<PackArchive>();
+        if (!pack->open(pack_path)) {
+            return false;
+        }
+        std::error_code ec;
+        std::string root = NormalizePath(std::filesystem::absolute(mount_point, ec).generic_string());
+        if (root.empty() || root.back() != '/') {
+            root += '/';
+        }
+        RDE_CORE_INFO("VFS: Mounted '{}' ({} entries) at '{}'", pack_path.string(), pack->get_entry_count(), root);
+
+        std::string working_directory = NormalizePath(std::filesystem::current_path(ec).generic_string());
+        if (working_directory.empty() || working_directory.back() != '/') {
+            working_directory += '/';
+        }
+
+        std::unique_lock lock(MountMutex());
+        WorkingDirectory() = std::move(working_directory);
+        Mounts().push_back({std::move(root), std::move(pack)});
+        return true;
+    }
+
+    void Unmount(const std::filesystem::path &pack_path) {
+        std::unique_lock lock(MountMutex());
+        auto &mounts = Mounts();
+        // Open views keep their pack alive through their shared_ptr.
+        mounts.erase(std::remove_if(mounts.begin(), mounts.end(), [&](const MountedPack &mount) {
+            return mount.pack->get_path() == pack_path;
+        }), mounts.end());
+    }
+
+    void UnmountAll() {
+        std::unique_lock lock(MountMutex());
+        Mounts().clear();
+    }
+
+    FileView Open(std::string_view path) {
+        std::string relative;
+        if (auto pack = FindPack(path, relative)) {
+            const char *data = nullptr;
+            size_t size = 0;
+            std::vector<char> buffer;
+            if (!pack->read(relative, data, size, buffer)) {
+                return {};
+            }
+            if (!buffer.empty()) {
+                return FileView(std::move(buffer));
+            }
+            return FileView(std::move(pack), data, size);
+        }
+
+        MappedFile file;
+        if (!file.open(std::filesystem::path(path))) {
+            return {};
+        }
+        return FileView(std::move(file));
+    }
+
+    bool Exists(std::string_view path) {
+        std::string relative;
+        if (FindPack(path, relative)) {
+            return true;
+        }
+        std::error_code ec;
+        return std::filesystem::is_regular_file(std::filesystem::path(path), ec);
+    }
+
+    bool IsPacked(std::string_view path) {
+        std::string relative;
+        return FindPack(path, relative) != nullptr;
+    }
+
+    bool Stat(std::string_view path, FileStat &out) {
+        std::string relative;
+        if (auto pack = FindPack(path, relative)) {
+            return pack->stat(relative, out);
+        }
+        const std::filesystem::path file_path(path);
+        std::error_code ec;
+        out.size = std::filesystem::file_size(file_path, ec);
+        if (ec) {
+            return false;
+        }
+        out.mtime = std::filesystem::last_write_time(file_path, ec);
+        out.content_hash = 0;
+        return !ec;
+    }
+
+    std::string NormalizePath(std::string_view path) {
+        std::string result;
+        result.reserve(path.size());
+        // Root prefix: "/" or a drive such as "C:/" is kept and can't be left with "..".
+        size_t root_size = 0;
+        size_t i = 0;
+        if (path.size() >= 2 && path[1] == ':') {
+            result.append(path.substr(0, 2));
+            i = 2;
+        }
+        if (i < path.size() && (path[i] == '/' || path[i] == '\\')) {
+            result += '/';
+        }
+        root_size = result.size();
+
+        while (i < path.size()) {
+            while (i < path.size() && (path[i] == '/' || path[i] == '\\')) {
+                ++i;
+            }
+            size_t end = i;
+            while (end < path.size() && path[end] != '/' && path[end] != '\\') {
+                ++end;
+            }
+            const std::string_view segment = path.substr(i, end - i);
+            i = end;
+            if (segment.empty() || segment == ".") {
+                continue;
+            }
+            if (segment == "..") {
+                // Drop the previous segment unless there is none or it is a ".." itself.
+                const size_t last = result.find_last_of('/');
+                const size_t start = last == std::string::npos || last < root_size ? root_size : last + 1;
+                if (result.size() > root_size && std::string_view(result).substr(start) != "..") {
+                    result.resize(start > root_size ? start - 1 : root_size);
+                    continue;
+                }
+                if (root_size > 0 && result[root_size - 1] == '/') {
+                    continue; // "/.." is "/"
+                }
+            }
+            if (result.size() > root_size) {
+                result += '/';
+            }
+            result.append(segment);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,242 @@
+#include "core/PackArchive.h"
+#include "core/Compression.h"
+#include "core/Hash.h"
+#include "core/Log.h"
+#include "core/VirtualFileSystem.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace RDE;
+
+// Packs built by PackBuilder must read back byte for byte, through PackArchive and through a VFS mount. Corrupt packs
+// and blocks must be rejected by PackArchive::open or read, never read out of bounds. Offsets follow the layout in
+// PackArchive.cpp: a 64 byte header {magic, version, entry_count, toc_offset, strings_offset, strings_size,
+// block_table_offset, block_count, file_size} and 56 byte PackArchive::Entry records.
+namespace {
+    constexpr size_t TOC_OFFSET = 16;
+    constexpr size_t STRINGS_OFFSET = 24;
+    constexpr size_t BLOCK_TABLE_OFFSET = 40;
+    constexpr size_t FILE_SIZE_OFFSET = 56;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++g_failures;
+        }
+    }
+
+    struct TestFile {
+        const char *name;
+        std::string content;
+    };
+
+    std::vector<TestFile> MakeFiles() {
+        std::string repeated;
+        for (int i = 0; i < 50000; ++i) {
+            repeated += "abcd"; // Several blocks, each starting with four literals and a match at offset 4
+        }
+        std::string noise(100000, '\0');
+        uint32_t state = 12345;
+        for (char &c: noise) {
+            state = state * 1664525u + 1013904223u;
+            c = static_cast<char>(state >> 24);
+        }
+        return {{"repeated.txt", repeated}, {"noise.bin", noise}, {"empty.txt", ""}, {"sub/small.txt", "hello pack"}};
+    }
+
+    bool WriteFile(const std::filesystem::path &path, const std::string &content) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return static_cast<bool>(out);
+    }
+
+    std::string ReadFile(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    uint64_t Read64(const std::string &data, size_t offset) {
+        uint64_t value;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        return value;
+    }
+
+    void Write64(std::string &data, size_t offset, uint64_t value) {
+        std::memcpy(data.data() + offset, &value, sizeof(value));
+    }
+
+    // Byte offset of the table of contents entry of name.
+    size_t FindEntry(const std::string &pack, std::string_view name) {
+        const uint64_t toc = Read64(pack, TOC_OFFSET);
+        const uint64_t strings = Read64(pack, STRINGS_OFFSET);
+        for (size_t entry = toc; entry + sizeof(PackArchive::Entry) <= strings; entry += sizeof(PackArchive::Entry)) {
+            PackArchive::Entry record;
+            std::memcpy(&record, pack.data() + entry, sizeof(record));
+            if (std::string_view(pack).substr(strings + record.name_offset, record.name_size) == name) {
+                return entry;
+            }
+        }
+        return 0;
+    }
+
+    PackArchive::Entry GetEntry(const std::string &pack, size_t offset) {
+        PackArchive::Entry entry;
+        std::memcpy(&entry, pack.data() + offset, sizeof(entry));
+        return entry;
+    }
+
+    void SetEntry(std::string &pack, size_t offset, const PackArchive::Entry &entry) {
+        std::memcpy(pack.data() + offset, &entry, sizeof(entry));
+    }
+
+    void TestRoundTrip(const std::filesystem::path &dir, const std::vector<TestFile> &files,
+                       const std::filesystem::path &pack_path) {
+        PackArchive pack;
+        Check(pack.open(pack_path), "the built pack opens");
+        Check(pack.get_entry_count() == files.size(), "the pack has an entry per file");
+        bool contents_match = true, stats_match = true;
+        for (const TestFile &file: files) {
+            const char *data = nullptr;
+            size_t size = 0;
+            std::vector<char> buffer;
+            contents_match &= pack.read(file.name, data, size, buffer) && std::string_view(data, size) == file.content;
+            FileStat stat;
+            stats_match &= pack.stat(file.name, stat) && stat.size == file.content.size() &&
+                           stat.content_hash == Hash::Compute(file.content);
+        }
+        Check(contents_match, "every entry reads back unchanged");
+        Check(stats_match, "every entry has its size and content hash");
+        Check(!pack.contains("missing.txt"), "a file that was not packed is missing");
+
+        // Relative paths resolve against the working directory of the Mount call.
+        const std::filesystem::path mount_point = dir / "mounted";
+        const std::filesystem::path working_directory = std::filesystem::current_path();
+        std::filesystem::current_path(dir);
+        Check(VFS::Mount(pack_path, mount_point), "the pack mounts");
+        bool vfs_match = true;
+        for (const TestFile &file: files) {
+            const std::string path = (mount_point / file.name).generic_string();
+            const FileView view = VFS::Open(path);
+            vfs_match &= VFS::IsPacked(path) && view.is_open() && view.view() == file.content;
+        }
+        Check(vfs_match, "every entry reads back through the VFS");
+        Check(!VFS::IsPacked((mount_point / "missing.txt").generic_string()), "a file outside the pack is not packed");
+        const char *relative_paths[] = {
+            "mounted/sub/small.txt", "./mounted/sub/../sub/small.txt", "mounted\\sub\\small.txt",
+            "../rde_pack_archive_tests/mounted/sub/small.txt"
+        };
+        for (const char *path: relative_paths) {
+            Check(VFS::IsPacked(path) && VFS::Open(path).view() == "hello pack", "a relative path reads from the pack");
+        }
+        VFS::UnmountAll();
+
+        // A working directory below the mount point.
+        std::filesystem::create_directories(mount_point / "sub");
+        std::filesystem::current_path(mount_point / "sub");
+        Check(VFS::Mount(pack_path, mount_point), "the pack mounts again");
+        Check(VFS::Open("small.txt").view() == "hello pack", "a path below a mounted working directory reads");
+        Check(!VFS::IsPacked("missing.txt"), "a missing file below a mounted working directory is not packed");
+        VFS::UnmountAll();
+        std::filesystem::current_path(working_directory);
+    }
+
+    void TestCorruptPacks(const std::filesystem::path &dir, const std::string &valid) {
+        const std::filesystem::path corrupt_path = dir / "corrupt.rdepack";
+        auto open = [&](const std::string &data) {
+            PackArchive pack;
+            return WriteFile(corrupt_path, data) && pack.open(corrupt_path);
+        };
+        Check(open(valid), "an unmodified copy opens");
+
+        {
+            // Cut inside the table of contents, with a header that agrees on the size.
+            std::string data = valid.substr(0, Read64(valid, TOC_OFFSET) + sizeof(PackArchive::Entry) / 2);
+            Write64(data, FILE_SIZE_OFFSET, data.size());
+            Check(!open(data), "a truncated table of contents is rejected");
+        }
+        {
+            std::string data = valid;
+            const size_t offset = FindEntry(data, "noise.bin");
+            PackArchive::Entry entry = GetEntry(data, offset);
+            entry.data_offset = data.size() - entry.stored_size / 2;
+            SetEntry(data, offset, entry);
+            Check(offset != 0 && !open(data), "entry data past the end of the file is rejected");
+        }
+        {
+            // The block offsets are the running sum of the block sizes, a too large block ends past the entry.
+            std::string data = valid;
+            const PackArchive::Entry entry = GetEntry(data, FindEntry(data, "repeated.txt"));
+            Check(entry.codec == 1, "the repeated file is block compressed");
+            const size_t block_size = Read64(data, BLOCK_TABLE_OFFSET) + size_t(entry.first_block) * sizeof(uint32_t);
+            const uint32_t huge_block = 0x7fffffffu;
+            std::memcpy(data.data() + block_size, &huge_block, sizeof(huge_block));
+            Check(!open(data), "a block past the end of its entry is rejected");
+        }
+        {
+            // The first sequence of a block is a token, 4 literals and a 16-bit match offset. Point the match before
+            // the start of the block.
+            std::string data = valid;
+            const PackArchive::Entry entry = GetEntry(data, FindEntry(data, "repeated.txt"));
+            Check(static_cast<uint8_t>(data[entry.data_offset]) >> 4 == 4, "the first sequence has 4 literals");
+            data[entry.data_offset + 5] = static_cast<char>(0xff);
+            data[entry.data_offset + 6] = static_cast<char>(0xff);
+            PackArchive pack;
+            Check(WriteFile(corrupt_path, data) && pack.open(corrupt_path), "a pack with a corrupt block opens");
+            const char *read_data = nullptr;
+            size_t size = 0;
+            std::vector<char> buffer;
+            Check(!pack.read("repeated.txt", read_data, size, buffer), "a bad match offset fails the read");
+            Check(pack.read("sub/small.txt", read_data, size, buffer) &&
+                  std::string_view(read_data, size) == "hello pack", "the other entries still read");
+        }
+    }
+
+    void TestBlocks() {
+        const std::string text = MakeFiles()[0].content.substr(0, PackArchive::BLOCK_SIZE);
+        std::vector<char> compressed(Compression::CompressBound(text.size()));
+        const size_t size = Compression::CompressBlock(text.data(), text.size(), compressed.data(), compressed.size());
+        Check(size > 0 && size < text.size(), "repeated text compresses");
+        std::string decoded(text.size(), '\0');
+        Check(Compression::DecompressBlock(compressed.data(), size, decoded.data(), decoded.size()) && decoded == text,
+              "a block round-trips");
+        Check(!Compression::DecompressBlock(compressed.data(), size / 2, decoded.data(), decoded.size()),
+              "a truncated block is rejected");
+        Check(!Compression::DecompressBlock(compressed.data(), size, decoded.data(), decoded.size() - 1),
+              "a block larger than its raw size is rejected");
+        const unsigned char bad_offset[] = {0x10, 'a', 0x02, 0x00, 0x00};
+        Check(!Compression::DecompressBlock(bad_offset, sizeof(bad_offset), decoded.data(), 5),
+              "a match before the start of the block is rejected");
+    }
+}
+
+int main() {
+    Log::Initialize();
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "rde_pack_archive_tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "content" / "sub");
+    const std::vector<TestFile> files = MakeFiles();
+    for (const TestFile &file: files) {
+        Check(WriteFile(dir / "content" / file.name, file.content), "the test files are written");
+    }
+
+    const std::filesystem::path pack_path = dir / "test.rdepack";
+    PackBuilder::Statistics statistics;
+    Check(PackBuilder::Build(dir / "content", pack_path, {}, &statistics), "the pack builds");
+    Check(statistics.num_files == files.size() && statistics.num_compressed >= 1, "the repeated file is compressed");
+
+    TestRoundTrip(dir, files, pack_path);
+    TestCorruptPacks(dir, ReadFile(pack_path));
+    TestBlocks();
+
+    std::filesystem::remove_all(dir);
+    if (g_failures == 0) {
+        std::printf("PackArchiveTests passed\n");
+    }
+    return g_failures == 0 ? 0 : 1;
+}
@@ -35,6 +35,24 @@ namespace RDE {
             return diag.x * diag.y * diag.z;
         }
 
+        float surface_area() const {
+            if (!is_valid()) {
+                return 0.0f;
+            }
+            const glm::vec3 diag = diagonal();
+            return 2.0f * (diag.x * diag.y + diag.y * diag.z + diag.z * diag.x);
+        }
+
+        void grow(const glm::vec3 &point) {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        void grow(const AABB &other) {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+
         void clear() {
             min = glm::vec3(std::numeric_limits<float>::max());
             max = glm::vec3(std::numeric_limits<float>::lowest());
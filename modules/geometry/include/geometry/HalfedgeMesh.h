@@ -2,9 +2,15 @@
 
 #include "core/Properties.h"
 #include "core/Log.h"
+#include "core/ParallelFor.h"
 #include "HalfedgeMeshHandles.h"
 #include "HalfedgeMeshCirculators.h"
 
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
 namespace RDE {
     struct VertexConnectivity {
         HalfedgeHandle halfedge = HalfedgeHandle::INVALID(); // Halfedge that starts at this vertex
@@ -21,9 +27,23 @@ namespace RDE {
         HalfedgeHandle halfedge = HalfedgeHandle::INVALID(); // Halfedge that starts the face
     };
 
+    inline std::ostream &operator<<(std::ostream &os, const VertexConnectivity &c) {
+        return os << "{" << c.halfedge << "}";
+    }
+
+    inline std::ostream &operator<<(std::ostream &os, const HalfedgeConnectivity &c) {
+        return os << "{" << c.next << ", " << c.prev << ", " << c.face << ", " << c.vertex << "}";
+    }
+
+    inline std::ostream &operator<<(std::ostream &os, const FaceConnectivity &c) {
+        return os << "{" << c.halfedge << "}";
+    }
+
     class HalfedgeMesh {
     public:
-        HalfedgeMesh() = default;
+        HalfedgeMesh() {
+            init_properties();
+        }
 
         HalfedgeMesh(const PropertyContainer &vertices,
                      const PropertyContainer &halfedges = PropertyContainer(),
@@ -74,119 +94,59 @@ namespace RDE {
             if (!m_has_garbage)
                 return;
 
-            auto nV = vertices.size();
-            auto nE = edges.size();
-            auto nH = halfedges.size();
-            auto nF = faces.size();
-
-            // setup handle mapping
-            auto vmap = vertices.add<VertexHandle>("v:garbage-collection");
-            auto hmap = halfedges.add<HalfedgeHandle>("h:garbage-collection");
-            auto fmap = faces.add<FaceHandle>("f:garbage-collection");
-
-            for (size_t i = 0; i < nV; ++i) { vmap[VertexHandle(i)] = VertexHandle(i); }
-            for (size_t i = 0; i < nH; ++i) { hmap[HalfedgeHandle(i)] = HalfedgeHandle(i); }
-            for (size_t i = 0; i < nF; ++i) { fmap[FaceHandle(i)] = FaceHandle(i); }
-
-            // remove deleted vertices
-            if (nV > 0) {
-                size_t i0 = 0;
-                size_t i1 = nV - 1;
-
-                while (true) {
-                    // find first deleted and last un-deleted
-                    while (!deleted_vertices[VertexHandle(i0)] && i0 < i1) { ++i0; }
-                    while (deleted_vertices[VertexHandle(i1)] && i0 < i1) { --i1; }
-                    if (i0 >= i1) { break; }
-
-                    // swap
-                    vertices.swap(i0, i1);
-                }
-
-                // remember new size
-                nV = deleted_vertices[VertexHandle(i0)] ? i0 : i0 + 1;
-            }
-
-            // remove deleted edges
-            if (nE > 0) {
-                size_t i0 = 0;
-                size_t i1 = nE - 1;
-
-                while (true) {
-                    // find first deleted and last un-deleted
-                    while (!deleted_edges[EdgeHandle(i0)] && i0 < i1) { ++i0; }
-                    while (deleted_edges[EdgeHandle(i1)] && i0 < i1) { --i1; }
-                    if (i0 >= i1) { break; }
-
-                    // swap
-                    edges.swap(i0, i1);
-                    halfedges.swap(2 * i0, 2 * i1);
-                    halfedges.swap(2 * i0 + 1, 2 * i1 + 1);
-                }
-
-                // remember new size
-                nE = deleted_edges[EdgeHandle(i0)] ? i0 : i0 + 1;
-                nH = 2 * nE;
-            }
-
-            // remove deleted faces
-            if (nF > 0) {
-                size_t i0 = 0;
-                size_t i1 = nF - 1;
-
-                while (true) {
-                    // find 1st deleted and last un-deleted
-                    while (!deleted_faces[FaceHandle(i0)] && i0 < i1) { ++i0; }
-                    while (deleted_faces[FaceHandle(i1)] && i0 < i1) { --i1; }
-                    if (i0 >= i1) { break; }
-
-                    // swap
-                    faces.swap(i0, i1);
-                }
-
-                // remember new size
-                nF = deleted_faces[FaceHandle(i0)] ? i0 : i0 + 1;
-            }
-
-            // update vertex connectivity
-            for (size_t i = 0; i < nV; ++i) {
-                auto v = VertexHandle(i);
-                if (!is_isolated(v)) { set_halfedge(v, hmap[get_halfedge(v)]); }
-            }
-
-            // update halfedge connectivity
-            for (size_t i = 0; i < nH; ++i) {
-                auto h = HalfedgeHandle(i);
-                set_vertex(h, vmap[get_vertex(h)]);
-                set_next(h, hmap[get_next(h)]);
-                if (!is_boundary(h)) { set_face(h, fmap[get_face(h)]); }
-            }
-
-            // update handles of faces
-            for (size_t i = 0; i < nF; ++i) {
-                auto f = FaceHandle(i);
-                set_halfedge(f, hmap[get_halfedge(f)]);
-            }
-
-            // remove handle maps
-            vertices.remove(vmap);
-            halfedges.remove(hmap);
-            faces.remove(fmap);
+            // build old -> new and new -> old handle maps with a parallel prefix sum over the deleted flags
+            std::vector<size_t> vmap, vkeep;
+            std::vector<size_t> emap, ekeep;
+            std::vector<size_t> fmap, fkeep;
+            BuildCompaction(deleted_vertices.vector(), vmap, vkeep);
+            BuildCompaction(deleted_edges.vector(), emap, ekeep);
+            BuildCompaction(deleted_faces.vector(), fmap, fkeep);
+
+            // halfedges follow their edge
+            std::vector<size_t> hkeep(2 * ekeep.size());
+            Parallel::For(ekeep.size(), 1 << 14, [&](size_t i) {
+                hkeep[2 * i] = 2 * ekeep[i];
+                hkeep[2 * i + 1] = 2 * ekeep[i] + 1;
+            });
+
+            // move every property array once
+            vertices.gather(vkeep);
+            edges.gather(ekeep);
+            halfedges.gather(hkeep);
+            faces.gather(fkeep);
+
+            // remap connectivity
+            auto remap_halfedge = [&emap](const HalfedgeHandle &h) {
+                return h.is_valid() ? HalfedgeHandle{2 * emap[h.index >> 1] + (h.index & 1)} : h;
+            };
+            auto &vconn = vconnectivity.vector();
+            auto &hconn = hconnectivity.vector();
+            auto &fconn = fconnectivity.vector();
+            Parallel::For(vconn.size(), 1 << 14, [&](size_t i) {
+                vconn[i].halfedge = remap_halfedge(vconn[i].halfedge);
+            });
+            Parallel::For(hconn.size(), 1 << 14, [&](size_t i) {
+                HalfedgeConnectivity &conn = hconn[i];
+                conn.next = remap_halfedge(conn.next);
+                conn.prev = remap_halfedge(conn.prev);
+                if (conn.vertex.is_valid()) { conn.vertex = VertexHandle{vmap[conn.vertex.index]}; }
+                if (conn.face.is_valid()) { conn.face = FaceHandle{fmap[conn.face.index]}; }
+            });
+            Parallel::For(fconn.size(), 1 << 14, [&](size_t i) {
+                fconn[i].halfedge = remap_halfedge(fconn[i].halfedge);
+            });
 
-            // finally resize arrays
-            vertices.resize(nV);
             vertices.free_memory();
-            halfedges.resize(nH);
             halfedges.free_memory();
-            edges.resize(nE);
             edges.free_memory();
-            faces.resize(nF);
             faces.free_memory();
 
             m_num_deleted_vertices = m_num_deleted_edges = m_num_deleted_faces = 0;
             m_has_garbage = false;
         }
 
+        bool has_garbage() const { return m_has_garbage; }
+
         VertexHandle new_vertex() {
             vertices.push_back();
             return static_cast<VertexHandle>(vertices.size() - 1);
@@ -205,6 +165,291 @@ namespace RDE {
             return add_face({v0, v1, v2, v3});
         }
 
+        // --- Bulk construction ---
+
+        // Builds the connectivity of an empty mesh from a flat triangle index buffer (3 indices per face).
+        // Instead of running find_halfedge per corner like add_face, opposite halfedges are paired by bucketing the
+        // directed edges by their smaller vertex and sorting each bucket, then all arrays are filled in parallel passes.
+        // Existing vertex properties (e.g. v:point) are kept. The vertex count is num_vertices, or the current vertex
+        // count, or max index + 1, whichever is given first.
+        // Degenerate triangles are skipped. Faces on a non-manifold edge (more than two faces, or two faces with the
+        // same orientation) are left out of the bulk pass and offered to add_face afterwards, which rejects the ones
+        // it cannot represent. Bulk faces keep their relative input order, re-added faces are appended.
+        bool build_from_triangles(const int *indices, size_t num_triangles, size_t num_vertices = 0) {
+            if (!faces.empty() || !halfedges.empty()) {
+                RDE_CORE_ERROR("HalfedgeMesh::build_from_triangles: Mesh already has faces.");
+                return false;
+            }
+            if (num_triangles == 0) {
+                return true;
+            }
+            const size_t num_corners = num_triangles * 3;
+            if (num_corners >= std::numeric_limits<uint32_t>::max() / 2) {
+                RDE_CORE_ERROR("HalfedgeMesh::build_from_triangles: Too many triangles ({}).", num_triangles);
+                return false;
+            }
+
+            // --- Validate indices ---
+            constexpr size_t GRAIN = 1 << 15;
+            std::vector<int> chunk_max(Parallel::GetChunkCount(num_corners, GRAIN), -1);
+            std::atomic<bool> negative_index{false};
+            Parallel::ForChunks(num_corners, GRAIN, [&](size_t chunk, size_t begin, size_t end) {
+                int max_index = -1;
+                for (size_t c = begin; c < end; ++c) {
+                    max_index = std::max(max_index, indices[c]);
+                    if (indices[c] < 0) {
+                        negative_index = true;
+                    }
+                }
+                chunk_max[chunk] = max_index;
+            });
+            const size_t required_vertices = static_cast<size_t>(
+                *std::max_element(chunk_max.begin(), chunk_max.end()) + 1);
+            const size_t bound = num_vertices ? num_vertices : (vertices.size() ? vertices.size() : required_vertices);
+            if (negative_index || required_vertices > bound) {
+                RDE_CORE_ERROR("HalfedgeMesh::build_from_triangles: Index out of range (vertex count {}).", bound);
+                return false;
+            }
+            if (bound >= std::numeric_limits<uint32_t>::max()) {
+                RDE_CORE_ERROR("HalfedgeMesh::build_from_triangles: Too many vertices ({}).", bound);
+                return false;
+            }
+            const auto nV = static_cast<uint32_t>(bound);
+            const auto nT = static_cast<uint32_t>(num_triangles);
+            const auto nC = static_cast<uint32_t>(num_corners);
+
+            // A corner c is the directed edge from indices[c] to the next index of its triangle.
+            auto corner_from = [indices](uint32_t c) { return static_cast<uint32_t>(indices[c]); };
+            auto corner_to = [indices](uint32_t c) {
+                return static_cast<uint32_t>(indices[c % 3 == 2 ? c - 2 : c + 1]);
+            };
+
+            enum FaceState : uint8_t { Kept = 0, Degenerate = 1, NonManifold = 2 };
+            std::vector<std::atomic<uint8_t>> face_state(nT);
+            Parallel::For(nT, GRAIN, [&](size_t f) {
+                const int *tri = indices + 3 * f;
+                const bool degenerate = tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0];
+                face_state[f].store(degenerate ? Degenerate : Kept, std::memory_order_relaxed);
+            });
+            auto is_skipped = [&](uint32_t c) {
+                return face_state[c / 3].load(std::memory_order_relaxed) != Kept;
+            };
+
+            // --- Bucket the directed edges by their smaller vertex (counting sort) ---
+            std::vector<std::atomic<uint32_t>> bucket_cursor(nV);
+            Parallel::For(nC, GRAIN, [&](size_t c) {
+                if (!is_skipped(static_cast<uint32_t>(c))) {
+                    const uint32_t a = std::min(corner_from(c), corner_to(c));
+                    bucket_cursor[a].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+            std::vector<uint32_t> bucket_offset(size_t(nV) + 1, 0);
+            for (uint32_t v = 0; v < nV; ++v) {
+                const uint32_t count = bucket_cursor[v].load(std::memory_order_relaxed);
+                bucket_offset[v + 1] = bucket_offset[v] + count;
+                bucket_cursor[v].store(bucket_offset[v], std::memory_order_relaxed);
+            }
+            std::vector<uint32_t> bucket_corners(bucket_offset[nV]);
+            Parallel::For(nC, GRAIN, [&](size_t c) {
+                if (!is_skipped(static_cast<uint32_t>(c))) {
+                    const uint32_t a = std::min(corner_from(c), corner_to(c));
+                    bucket_corners[bucket_cursor[a].fetch_add(1, std::memory_order_relaxed)] = c;
+                }
+            });
+
+            // --- Sort each bucket by (other vertex, corner) and reject faces on non-manifold edges ---
+            // Within a run of equal edges the first corner of each direction wins, every other face is rejected.
+            auto other_vertex = [&](uint32_t bucket, uint32_t c) {
+                const uint32_t from = corner_from(c);
+                return from == bucket ? corner_to(c) : from;
+            };
+            Parallel::For(nV, 4096, [&](size_t v) {
+                const auto bucket = static_cast<uint32_t>(v);
+                auto first = bucket_corners.begin() + bucket_offset[v];
+                auto last = bucket_corners.begin() + bucket_offset[v + 1];
+                std::sort(first, last, [&](uint32_t lhs, uint32_t rhs) {
+                    const uint32_t lo = other_vertex(bucket, lhs);
+                    const uint32_t ro = other_vertex(bucket, rhs);
+                    return lo != ro ? lo < ro : lhs < rhs;
+                });
+                for (auto run = first; run != last;) {
+                    const uint32_t other = other_vertex(bucket, *run);
+                    bool has_forward = false;
+                    bool has_backward = false;
+                    for (; run != last && other_vertex(bucket, *run) == other; ++run) {
+                        bool &taken = corner_from(*run) == bucket ? has_forward : has_backward;
+                        if (taken) {
+                            face_state[*run / 3].store(NonManifold, std::memory_order_relaxed);
+                        }
+                        taken = true;
+                    }
+                }
+            });
+
+            // --- Assign edges: one per run that still has a kept corner, halfedge 2e runs from the smaller vertex ---
+            std::vector<uint32_t> edge_offset(size_t(nV) + 1, 0);
+            Parallel::For(nV, 4096, [&](size_t v) {
+                const auto bucket = static_cast<uint32_t>(v);
+                uint32_t num_edges = 0;
+                uint32_t previous_other = std::numeric_limits<uint32_t>::max();
+                for (uint32_t i = bucket_offset[v]; i < bucket_offset[v + 1]; ++i) {
+                    const uint32_t c = bucket_corners[i];
+                    const uint32_t other = other_vertex(bucket, c);
+                    if (!is_skipped(c) && other != previous_other) {
+                        ++num_edges;
+                        previous_other = other;
+                    }
+                }
+                edge_offset[v + 1] = num_edges;
+            });
+            for (uint32_t v = 0; v < nV; ++v) {
+                edge_offset[v + 1] += edge_offset[v];
+            }
+            const uint32_t nE = edge_offset[nV];
+
+            std::vector<uint32_t> corner_halfedge(nC, std::numeric_limits<uint32_t>::max());
+            Parallel::For(nV, 4096, [&](size_t v) {
+                const auto bucket = static_cast<uint32_t>(v);
+                uint32_t e = edge_offset[v];
+                uint32_t previous_other = std::numeric_limits<uint32_t>::max();
+                for (uint32_t i = bucket_offset[v]; i < bucket_offset[v + 1]; ++i) {
+                    const uint32_t c = bucket_corners[i];
+                    if (is_skipped(c)) {
+                        continue;
+                    }
+                    const uint32_t other = other_vertex(bucket, c);
+                    if (previous_other != std::numeric_limits<uint32_t>::max() && other != previous_other) {
+                        ++e;
+                    }
+                    previous_other = other;
+                    corner_halfedge[c] = 2 * e + (corner_from(c) == bucket ? 0 : 1);
+                }
+            });
+            bucket_corners.clear();
+            bucket_corners.shrink_to_fit();
+
+            // --- Compact the kept faces ---
+            std::vector<uint32_t> face_id(nT);
+            uint32_t nF = 0;
+            for (uint32_t f = 0; f < nT; ++f) {
+                face_id[f] = nF;
+                nF += face_state[f].load(std::memory_order_relaxed) == Kept ? 1 : 0;
+            }
+
+            vertices.resize(std::max<size_t>(vertices.size(), nV));
+            edges.resize(nE);
+            halfedges.resize(2 * size_t(nE));
+            faces.resize(nF);
+            auto &vconn = vconnectivity.vector();
+            auto &hconn = hconnectivity.vector();
+            auto &fconn = fconnectivity.vector();
+
+            // --- Face halfedges ---
+            Parallel::For(nT, GRAIN, [&](size_t f) {
+                if (face_state[f].load(std::memory_order_relaxed) != Kept) {
+                    return;
+                }
+                const auto c = static_cast<uint32_t>(3 * f);
+                const HalfedgeHandle h[3] = {
+                    HalfedgeHandle{corner_halfedge[c]}, HalfedgeHandle{corner_halfedge[c + 1]},
+                    HalfedgeHandle{corner_halfedge[c + 2]}
+                };
+                const FaceHandle face{face_id[f]};
+                for (uint32_t k = 0; k < 3; ++k) {
+                    HalfedgeConnectivity &conn = hconn[h[k]];
+                    conn.next = h[(k + 1) % 3];
+                    conn.prev = h[(k + 2) % 3];
+                    conn.face = face;
+                    conn.vertex = VertexHandle{corner_to(c + k)};
+                }
+                fconn[face] = FaceConnectivity{h[0]};
+            });
+
+            // --- Boundary halfedges: target vertex first, then next/prev around each boundary loop ---
+            const size_t nH = 2 * size_t(nE);
+            Parallel::For(nH, GRAIN, [&](size_t h) {
+                if (!hconn[h].face.is_valid()) {
+                    // The opposite halfedge is in a face and starts where this one ends.
+                    hconn[h].vertex = hconn[hconn[h ^ 1].prev].vertex;
+                }
+            });
+            Parallel::For(nH, GRAIN, [&](size_t h) {
+                if (hconn[h].face.is_valid()) {
+                    return;
+                }
+                // Rotate around the target vertex through its faces until the next boundary halfedge leaves it.
+                HalfedgeHandle current{h ^ 1};
+                for (size_t steps = 0; steps < nH; ++steps) {
+                    const HalfedgeHandle outgoing = get_opposite(hconn[current].prev);
+                    if (!hconn[outgoing].face.is_valid()) {
+                        hconn[h].next = outgoing;
+                        hconn[outgoing].prev = HalfedgeHandle{h};
+                        break;
+                    }
+                    current = outgoing;
+                }
+            });
+
+            // --- Outgoing vertex halfedges, preferring the smallest boundary halfedge ---
+            std::vector<std::atomic<uint64_t>> best_outgoing(nV);
+            Parallel::For(nV, GRAIN, [&](size_t v) {
+                best_outgoing[v].store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            });
+            Parallel::For(nH, GRAIN, [&](size_t h) {
+                const size_t from = hconn[h ^ 1].vertex;
+                const uint64_t key = (uint64_t(hconn[h].face.is_valid()) << 32) | uint64_t(h);
+                uint64_t current = best_outgoing[from].load(std::memory_order_relaxed);
+                while (key < current &&
+                       !best_outgoing[from].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                }
+            });
+            Parallel::For(nV, GRAIN, [&](size_t v) {
+                const uint64_t key = best_outgoing[v].load(std::memory_order_relaxed);
+                vconn[v].halfedge = key == std::numeric_limits<uint64_t>::max()
+                                        ? HalfedgeHandle::INVALID()
+                                        : HalfedgeHandle{static_cast<size_t>(key & 0xFFFFFFFFu)};
+            });
+
+            // --- Fallback for faces on non-manifold edges ---
+            size_t num_degenerate = 0;
+            size_t num_non_manifold = 0;
+            size_t num_failed = 0;
+            for (uint32_t f = 0; f < nT; ++f) {
+                const uint8_t state = face_state[f].load(std::memory_order_relaxed);
+                if (state == Degenerate) {
+                    ++num_degenerate;
+                } else if (state == NonManifold) {
+                    ++num_non_manifold;
+                    const int *tri = indices + 3 * size_t(f);
+                    const FaceHandle face = add_face({
+                        VertexHandle{size_t(tri[0])}, VertexHandle{size_t(tri[1])}, VertexHandle{size_t(tri[2])}
+                    });
+                    num_failed += face.is_valid() ? 0 : 1;
+                }
+            }
+            if (num_degenerate || num_non_manifold) {
+                RDE_CORE_WARN("HalfedgeMesh::build_from_triangles: Skipped {} degenerate faces, {} of {} faces on "
+                              "non-manifold edges could not be added.", num_degenerate, num_failed, num_non_manifold);
+            }
+            return true;
+        }
+
+        bool build_from_triangles(const std::vector<glm::ivec3> &triangles, size_t num_vertices = 0) {
+            static_assert(sizeof(glm::ivec3) == 3 * sizeof(int), "ivec3 must be tightly packed");
+            return build_from_triangles(triangles.empty() ? nullptr : &triangles[0].x, triangles.size(),
+                                        num_vertices);
+        }
+
+        // Builds from the f:tris property of an AssetCpuGeometry / TriMesh face container.
+        bool build_from_triangles(const PropertyContainer &triangle_faces, size_t num_vertices = 0) {
+            const auto *tris = dynamic_cast<const PropertyArray<glm::ivec3> *>(triangle_faces.get_base("f:tris"));
+            if (!tris) {
+                RDE_CORE_ERROR("HalfedgeMesh::build_from_triangles: Missing f:tris (ivec3) property.");
+                return false;
+            }
+            return build_from_triangles(tris->vector(), num_vertices);
+        }
+
         void set_halfedge(const VertexHandle &v, const HalfedgeHandle &h) {
             vconnectivity[v] = VertexConnectivity{h};
         }
@@ -215,6 +460,9 @@ namespace RDE {
 
         void set_next(const HalfedgeHandle &h, const HalfedgeHandle &next) {
             hconnectivity[h].next = next;
+            if (next.is_valid()) {
+                hconnectivity[next].prev = h;
+            }
         }
 
         HalfedgeHandle get_next(const HalfedgeHandle &h) const {
@@ -280,6 +528,8 @@ namespace RDE {
             }
 
             deleted_vertices[v] = true;
+            ++m_num_deleted_vertices;
+            m_has_garbage = true;
             return true;
         }
 
@@ -289,6 +539,7 @@ namespace RDE {
             }
 
             deleted_halfedges[h] = true;
+            m_has_garbage = true;
             return true;
         }
 
@@ -298,6 +549,8 @@ namespace RDE {
             }
 
             deleted_edges[e] = true;
+            ++m_num_deleted_edges;
+            m_has_garbage = true;
             return true;
         }
 
@@ -307,6 +560,8 @@ namespace RDE {
             }
 
             deleted_faces[f] = true;
+            ++m_num_deleted_faces;
+            m_has_garbage = true;
             return true;
         }
 
@@ -518,7 +773,7 @@ namespace RDE {
                 return HalfedgeHandle::INVALID(); // Cannot create a halfedge from a vertex to itself
             }
             HalfedgeHandle h = new_halfedge();
-            set_vertex(h, start);
+            set_vertex(h, end);
             return h;
         }
 
@@ -547,13 +802,7 @@ namespace RDE {
             if (h.is_valid() && is_valid(h)) {
                 return h; // Edge already exists
             }
-            new_edge(start, end);
-            h = new_halfedge();
-            const HalfedgeHandle o = new_halfedge();
-
-            set_vertex(h, end);
-            set_vertex(o, start);
-            return h;
+            return new_edge(start, end);
         }
 
         FaceHandle add_face(const std::vector<VertexHandle> &vertices, bool allow_complex_vertex,
@@ -616,7 +865,6 @@ namespace RDE {
                         // search a free gap
                         // free gap will be between boundaryPrev and boundaryNext
                         HalfedgeHandle outer_prev = get_opposite(inner_next);
-                        HalfedgeHandle outer_next = get_opposite(inner_prev);
                         HalfedgeHandle boundary_prev = outer_prev;
                         do {
                             boundary_prev = get_opposite(get_next(boundary_prev));
@@ -676,29 +924,30 @@ namespace RDE {
 
                     // set outer links
                     switch (id) {
-                        case 1: // prev is new, next is old
+                        case 1: { // prev is new, next is old
                             HalfedgeHandle boundary_prev = get_prev(inner_next);
                             add_face_next_cache.emplace_back(boundary_prev, outer_next);
                             set_halfedge(v, outer_next);
                             break;
-
-                        case 2: // next is new, prev is old
+                        }
+                        case 2: { // next is new, prev is old
                             HalfedgeHandle boundary_next = get_next(inner_prev);
                             add_face_next_cache.emplace_back(outer_prev, boundary_next);
                             set_halfedge(v, boundary_next);
                             break;
-
-                        case 3: // both are new
+                        }
+                        case 3: { // both are new
                             if (!get_halfedge(v).is_valid()) {
                                 set_halfedge(v, outer_next);
                                 add_face_next_cache.emplace_back(outer_prev, outer_next);
                             } else {
-                                boundary_next = get_halfedge(v);
-                                boundary_prev = get_prev(boundary_next);
+                                HalfedgeHandle boundary_next = get_halfedge(v);
+                                HalfedgeHandle boundary_prev = get_prev(boundary_next);
                                 add_face_next_cache.emplace_back(boundary_prev, outer_next);
                                 add_face_next_cache.emplace_back(outer_prev, boundary_next);
                             }
                             break;
+                        }
                         default: ;
                     }
 
@@ -727,6 +976,36 @@ namespace RDE {
             return f;
         }
 
+        // Fills old_to_new (invalid index for deleted elements) and new_to_old for the elements that are kept.
+        static void BuildCompaction(const std::vector<bool> &deleted, std::vector<size_t> &old_to_new,
+                                    std::vector<size_t> &new_to_old) {
+            constexpr size_t GRAIN = 1 << 16;
+            const size_t n = deleted.size();
+            std::vector<size_t> chunk_offset(Parallel::GetChunkCount(n, GRAIN) + 1, 0);
+            Parallel::ForChunks(n, GRAIN, [&](size_t chunk, size_t begin, size_t end) {
+                size_t kept = 0;
+                for (size_t i = begin; i < end; ++i) { kept += deleted[i] ? 0 : 1; }
+                chunk_offset[chunk + 1] = kept;
+            });
+            for (size_t chunk = 1; chunk < chunk_offset.size(); ++chunk) {
+                chunk_offset[chunk] += chunk_offset[chunk - 1];
+            }
+
+            old_to_new.resize(n);
+            new_to_old.resize(chunk_offset.back());
+            Parallel::ForChunks(n, GRAIN, [&](size_t chunk, size_t begin, size_t end) {
+                size_t next = chunk_offset[chunk];
+                for (size_t i = begin; i < end; ++i) {
+                    if (deleted[i]) {
+                        old_to_new[i] = static_cast<IndexType>(-1);
+                    } else {
+                        old_to_new[i] = next;
+                        new_to_old[next++] = i;
+                    }
+                }
+            });
+        }
+
         void copy_ptrs(const PropertyContainer &vertices_,
                        const PropertyContainer &halfedges_,
                        const PropertyContainer &edges_,
@@ -760,4 +1039,34 @@ namespace RDE {
         std::vector<bool> m_add_face_needs_adjust;
         NextCache m_add_face_next_cache;
     };
+
+    // --- Circulator members that need the complete HalfedgeMesh ---
+
+    inline HalfedgeAroundVertexCirculator &HalfedgeAroundVertexCirculator::operator++() {
+        m_current = m_mesh->rotate_ccw(m_current);
+        if (m_current == m_start) {
+            // Looped all the way around, compare equal to end().
+            m_current = HalfedgeHandle::INVALID();
+        }
+        return *this;
+    }
+
+    inline HalfedgeAroundFaceCirculator::HalfedgeAroundFaceCirculator(const FaceHandle &face, const HalfedgeMesh *mesh)
+        : m_mesh(mesh) {
+        if (m_mesh) {
+            m_halfedge = m_mesh->get_halfedge(face);
+            m_is_active = true;
+        }
+    }
+
+    inline HalfedgeAroundFaceCirculator &HalfedgeAroundFaceCirculator::operator++() {
+        m_halfedge = m_mesh->get_next(m_halfedge);
+        m_is_active = true;
+        return *this;
+    }
+
+    inline HalfedgeAroundFaceCirculator &HalfedgeAroundFaceCirculator::operator--() {
+        m_halfedge = m_mesh->get_prev(m_halfedge);
+        return *this;
+    }
 }
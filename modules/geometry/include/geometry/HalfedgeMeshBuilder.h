@@ -1,10 +1,12 @@
 #pragma once
-#include "HalfedgeMeshHandles.h"
+#include "HalfedgeMesh.h"
+#include "core/Log.h"
 #include "core/Properties.h"
 
-namespace RDE {
-    class HalfedgeMesh;
+#include <algorithm>
+#include <vector>
 
+namespace RDE {
     template<typename PointType>
     class HalfedgeMeshBuilder {
     public:
@@ -13,7 +15,7 @@ namespace RDE {
         }
 
         VertexHandle add_vertex(const PointType &point) {
-            auto v = m_mesh.vertices.new_vertex();
+            auto v = m_mesh.new_vertex();
             if (v.is_valid()) {
                 m_positions[v] = point;
             }
@@ -21,7 +23,37 @@ namespace RDE {
         }
 
         HalfedgeHandle insert_vertex(const EdgeHandle &e, const PointType &point) {
-            return insert_vertex(m_mesh.get_halfedge(e, 0), add_vertex(point));
+            return m_mesh.insert_vertex(m_mesh.get_halfedge(e, 0), add_vertex(point));
+        }
+
+        // Bulk path for a mesh without faces: appends all points, then builds the connectivity from the index buffer.
+        // Indices refer to points, vertices added before keep their handles and are offset past.
+        bool add_triangles(const std::vector<PointType> &points, const std::vector<glm::ivec3> &triangles) {
+            if (!m_mesh.faces.empty()) {
+                RDE_CORE_ERROR("HalfedgeMeshBuilder::add_triangles: Mesh already has faces.");
+                return false;
+            }
+            const size_t first = m_mesh.vertices.size();
+            if (first == 0) {
+                m_mesh.vertices.resize(points.size());
+                std::copy(points.begin(), points.end(), m_positions.vector().begin());
+                return m_mesh.build_from_triangles(triangles, points.size());
+            }
+
+            const auto num_points = static_cast<int64_t>(points.size());
+            std::vector<glm::ivec3> offset_triangles(triangles.size());
+            for (size_t i = 0; i < triangles.size(); ++i) {
+                const glm::ivec3 &tri = triangles[i];
+                if (std::min({tri.x, tri.y, tri.z}) < 0 || std::max({tri.x, tri.y, tri.z}) >= num_points) {
+                    RDE_CORE_ERROR("HalfedgeMeshBuilder::add_triangles: Index out of range (point count {}).",
+                                   points.size());
+                    return false;
+                }
+                offset_triangles[i] = tri + glm::ivec3(static_cast<int>(first));
+            }
+            m_mesh.vertices.resize(first + points.size());
+            std::copy(points.begin(), points.end(), m_positions.vector().begin() + first);
+            return m_mesh.build_from_triangles(offset_triangles, m_mesh.vertices.size());
         }
 
     protected:
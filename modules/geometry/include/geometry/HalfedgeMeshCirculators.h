@@ -1,5 +1,11 @@
 #pragma once
 
+#include "HalfedgeMeshHandles.h"
+
+#include <cstddef>
+#include <iterator>
+
+// Member functions that need the complete HalfedgeMesh are defined at the end of HalfedgeMesh.h.
 namespace RDE {
     class HalfedgeMesh;
 
@@ -18,14 +24,12 @@ namespace RDE {
         reference operator*() const { return m_current; }
         pointer operator->() const { return &m_current; }
 
-        HalfedgeAroundVertexCirculator& operator++() {
-            // Use the SAME rotation direction you want consistently. Let's use CCW.
-            m_current = m_mesh->rotate_ccw(m_current);
-            if (m_current == m_start) {
-                // We've looped all the way around. Mark as completed.
-                m_current = HalfedgeHandle::INVALID();
-            }
-            return *this;
+        HalfedgeAroundVertexCirculator& operator++();
+
+        HalfedgeAroundVertexCirculator begin() const { return *this; }
+
+        HalfedgeAroundVertexCirculator end() const {
+            return HalfedgeAroundVertexCirculator(m_mesh, HalfedgeHandle::INVALID());
         }
 
         // For range-based for loops, we only need operator!=
@@ -41,13 +45,7 @@ namespace RDE {
 
     class HalfedgeAroundFaceCirculator {
     public:
-        HalfedgeAroundFaceCirculator(const FaceHandle &face, const HalfedgeMesh *mesh)
-            : m_mesh(mesh) {
-            if (m_mesh) {
-                m_halfedge = m_mesh->get_halfedge(face);
-                m_is_active = true;
-            }
-        }
+        HalfedgeAroundFaceCirculator(const FaceHandle &face, const HalfedgeMesh *mesh);
 
         bool operator==(const HalfedgeAroundFaceCirculator &other) const {
             return m_is_active && m_halfedge == other.m_halfedge && m_mesh == other.m_mesh;
@@ -57,11 +55,7 @@ namespace RDE {
             return !operator==(other);
         }
 
-        HalfedgeAroundFaceCirculator &operator++() {
-            m_halfedge = m_mesh->get_next(m_halfedge);
-            m_is_active = true;
-            return *this;
-        }
+        HalfedgeAroundFaceCirculator &operator++();
 
         HalfedgeAroundFaceCirculator operator++(int) {
             auto temp = *this;
@@ -69,12 +63,9 @@ namespace RDE {
             return temp;
         }
 
-        HalfedgeAroundFaceCirculator &operator--() {
-            m_halfedge = m_mesh->get_prev(m_halfedge);
-            return *this;
-        }
+        HalfedgeAroundFaceCirculator &operator--();
 
-        HalfedgeAroundFaceCirculator &operator--(int) {
+        HalfedgeAroundFaceCirculator operator--(int) {
             auto tmp = *this;
             --(*this);
             return tmp;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef> // For size_t
+#include <ostream>
 
 namespace RDE{
     using IndexType = size_t;
@@ -19,7 +20,7 @@ namespace RDE{
         bool is_valid() const {
             return index != static_cast<IndexType>(-1);
         }
-^
+
         bool operator==(const VertexHandle &other) const {
             return index == other.index;
         }
@@ -178,4 +179,13 @@ namespace RDE{
             return FaceHandle{static_cast<IndexType>(-1)};
         }
     };
-}
\ No newline at end of file
+
+    // Handles convert to both IndexType and bool, so streaming them needs an exact overload.
+    inline std::ostream &operator<<(std::ostream &os, const VertexHandle &v) { return os << 'v' << v.index; }
+
+    inline std::ostream &operator<<(std::ostream &os, const HalfedgeHandle &h) { return os << 'h' << h.index; }
+
+    inline std::ostream &operator<<(std::ostream &os, const EdgeHandle &e) { return os << 'e' << e.index; }
+
+    inline std::ostream &operator<<(std::ostream &os, const FaceHandle &f) { return os << 'f' << f.index; }
+}
@@ -0,0 +1,607 @@
+//geometry/PacketQueries.h
+#pragma once
+
+#include "Ray.h"
+#include "Sphere.h"
+
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Batched (SoA) variants of the scalar tests in Ray.h and Sphere.h: one ray or point against 4/8 primitives per call.
+// x86-64 always has SSE2, so the 4-wide kernels use it directly. The 8-wide kernels use AVX when the CPU supports
+// it (detected once at runtime) and otherwise run as two SSE halves. Other architectures use the scalar tests.
+// The kernels evaluate the same expressions in the same order as the scalar versions, so results match bit for bit.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RDE_GEOMETRY_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define RDE_GEOMETRY_TARGET_AVX
+#else
+#define RDE_GEOMETRY_TARGET_AVX __attribute__((target("avx")))
+#endif
+#else
+#define RDE_GEOMETRY_SIMD 0
+#endif
+
+namespace RDE {
+    enum class SimdLevel {
+        Scalar,
+        SSE,
+        AVX
+    };
+
+    inline SimdLevel DetectSimdLevel() {
+#if RDE_GEOMETRY_SIMD
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        const bool has_avx = (info[2] & (1 << 28)) != 0;
+        return os_saves_ymm && has_avx ? SimdLevel::AVX : SimdLevel::SSE;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") ? SimdLevel::AVX : SimdLevel::SSE;
+#endif
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    // Detected once, the packet tests below dispatch on this.
+    inline SimdLevel GetSimdLevel() {
+        static const SimdLevel level = DetectSimdLevel();
+        return level;
+    }
+
+    // --- Packets ---
+
+    // Lanes that were never set are masked out of every result.
+    template<size_t Width>
+    struct AABBPacket {
+        static_assert(Width == 4 || Width == 8, "AABBPacket supports 4 or 8 lanes");
+        static constexpr size_t WIDTH = Width;
+
+        alignas(32) float min_x[Width] = {};
+        alignas(32) float min_y[Width] = {};
+        alignas(32) float min_z[Width] = {};
+        alignas(32) float max_x[Width] = {};
+        alignas(32) float max_y[Width] = {};
+        alignas(32) float max_z[Width] = {};
+        uint32_t valid_mask = 0;
+
+        void set(size_t lane, const AABB &aabb) {
+            min_x[lane] = aabb.min.x;
+            min_y[lane] = aabb.min.y;
+            min_z[lane] = aabb.min.z;
+            max_x[lane] = aabb.max.x;
+            max_y[lane] = aabb.max.y;
+            max_z[lane] = aabb.max.z;
+            valid_mask |= 1u << lane;
+        }
+
+        AABB get(size_t lane) const {
+            return {{min_x[lane], min_y[lane], min_z[lane]}, {max_x[lane], max_y[lane], max_z[lane]}};
+        }
+
+        void clear() {
+            valid_mask = 0;
+        }
+    };
+
+    using AABBPacket4 = AABBPacket<4>;
+    using AABBPacket8 = AABBPacket<8>;
+
+    // Stores vertex a and the two edges, which is what Moeller-Trumbore consumes.
+    template<size_t Width>
+    struct TrianglePacket {
+        static_assert(Width == 4 || Width == 8, "TrianglePacket supports 4 or 8 lanes");
+        static constexpr size_t WIDTH = Width;
+
+        alignas(32) float a_x[Width] = {};
+        alignas(32) float a_y[Width] = {};
+        alignas(32) float a_z[Width] = {};
+        alignas(32) float e1_x[Width] = {};
+        alignas(32) float e1_y[Width] = {};
+        alignas(32) float e1_z[Width] = {};
+        alignas(32) float e2_x[Width] = {};
+        alignas(32) float e2_y[Width] = {};
+        alignas(32) float e2_z[Width] = {};
+        uint32_t valid_mask = 0;
+
+        void set(size_t lane, const Triangle &triangle) {
+            const glm::vec3 e1 = triangle.b - triangle.a;
+            const glm::vec3 e2 = triangle.c - triangle.a;
+            a_x[lane] = triangle.a.x;
+            a_y[lane] = triangle.a.y;
+            a_z[lane] = triangle.a.z;
+            e1_x[lane] = e1.x;
+            e1_y[lane] = e1.y;
+            e1_z[lane] = e1.z;
+            e2_x[lane] = e2.x;
+            e2_y[lane] = e2.y;
+            e2_z[lane] = e2.z;
+            valid_mask |= 1u << lane;
+        }
+
+        Triangle get(size_t lane) const {
+            const glm::vec3 a(a_x[lane], a_y[lane], a_z[lane]);
+            return {a, a + glm::vec3(e1_x[lane], e1_y[lane], e1_z[lane]),
+                    a + glm::vec3(e2_x[lane], e2_y[lane], e2_z[lane])};
+        }
+
+        void clear() {
+            valid_mask = 0;
+        }
+    };
+
+    using TrianglePacket4 = TrianglePacket<4>;
+    using TrianglePacket8 = TrianglePacket<8>;
+
+    // Per lane results of a packet ray/triangle test. Only lanes set in mask hold a hit.
+    template<size_t Width>
+    struct RayTrianglePacketHit {
+        alignas(32) float t[Width] = {};
+        alignas(32) float u[Width] = {};
+        alignas(32) float v[Width] = {};
+        uint32_t mask = 0;
+
+        // Lane of the nearest hit, or -1 if no lane was hit.
+        int closest_lane() const {
+            int best = -1;
+            for (size_t lane = 0; lane < Width; ++lane) {
+                if ((mask & (1u << lane)) && (best < 0 || t[lane] < t[best])) {
+                    best = static_cast<int>(lane);
+                }
+            }
+            return best;
+        }
+
+        RayTriangleHit get(size_t lane) const {
+            return {t[lane], u[lane], v[lane]};
+        }
+    };
+
+    // Any number of spheres in SoA layout, for point queries against many spheres at once.
+    struct SphereSoA {
+        std::vector<float> center_x;
+        std::vector<float> center_y;
+        std::vector<float> center_z;
+        std::vector<float> radius;
+
+        size_t size() const {
+            return radius.size();
+        }
+
+        bool empty() const {
+            return radius.empty();
+        }
+
+        void reserve(size_t count) {
+            center_x.reserve(count);
+            center_y.reserve(count);
+            center_z.reserve(count);
+            radius.reserve(count);
+        }
+
+        void push_back(const Sphere &sphere) {
+            center_x.push_back(sphere.center.x);
+            center_y.push_back(sphere.center.y);
+            center_z.push_back(sphere.center.z);
+            radius.push_back(sphere.radius);
+        }
+
+        Sphere get(size_t index) const {
+            return {{center_x[index], center_y[index], center_z[index]}, radius[index]};
+        }
+
+        void clear() {
+            center_x.clear();
+            center_y.clear();
+            center_z.clear();
+            radius.clear();
+        }
+    };
+
+    namespace PacketDetail {
+        // --- Scalar lanes ---
+
+        template<size_t Width>
+        inline uint32_t RayAABBScalar(const Ray &ray, const glm::vec3 &inv_direction, const AABBPacket<Width> &packet,
+                                      size_t first_lane, size_t num_lanes, float t_min, float t_max, float *t_entry) {
+            uint32_t mask = 0;
+            for (size_t lane = first_lane; lane < first_lane + num_lanes; ++lane) {
+                if (auto t = intersect(ray, inv_direction, packet.get(lane), t_min, t_max)) {
+                    mask |= 1u << lane;
+                    if (t_entry) {
+                        t_entry[lane] = *t;
+                    }
+                }
+            }
+            return mask;
+        }
+
+        template<size_t Width>
+        inline uint32_t RayTriangleScalar(const Ray &ray, const TrianglePacket<Width> &packet, size_t first_lane,
+                                          size_t num_lanes, float t_min, float t_max,
+                                          RayTrianglePacketHit<Width> &hit) {
+            uint32_t mask = 0;
+            for (size_t lane = first_lane; lane < first_lane + num_lanes; ++lane) {
+                // Rebuilding the triangle from a + e could round differently, so the edges are used as stored.
+                const glm::vec3 e1(packet.e1_x[lane], packet.e1_y[lane], packet.e1_z[lane]);
+                const glm::vec3 e2(packet.e2_x[lane], packet.e2_y[lane], packet.e2_z[lane]);
+                const glm::vec3 p = glm::cross(ray.direction, e2);
+                const float det = glm::dot(e1, p);
+                if (std::abs(det) < 1e-12f) {
+                    continue;
+                }
+                const float inv_det = 1.0f / det;
+                const glm::vec3 s = ray.origin - glm::vec3(packet.a_x[lane], packet.a_y[lane], packet.a_z[lane]);
+                const float u = glm::dot(s, p) * inv_det;
+                if (u < 0.0f || u > 1.0f) {
+                    continue;
+                }
+                const glm::vec3 q = glm::cross(s, e1);
+                const float v = glm::dot(ray.direction, q) * inv_det;
+                if (v < 0.0f || u + v > 1.0f) {
+                    continue;
+                }
+                const float t = glm::dot(e2, q) * inv_det;
+                if (t < t_min || t > t_max) {
+                    continue;
+                }
+                hit.t[lane] = t;
+                hit.u[lane] = u;
+                hit.v[lane] = v;
+                mask |= 1u << lane;
+            }
+            return mask;
+        }
+
+#if RDE_GEOMETRY_SIMD
+        // --- SSE, 4 lanes starting at first_lane ---
+
+        inline __m128 Dot3(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        }
+
+        template<size_t Width>
+        inline uint32_t RayAABBSSE(const Ray &ray, const glm::vec3 &inv_direction, const AABBPacket<Width> &packet,
+                                   size_t first_lane, float t_min, float t_max, float *t_entry) {
+            const __m128 t0_x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.min_x + first_lane), _mm_set1_ps(ray.origin.x)),
+                                           _mm_set1_ps(inv_direction.x));
+            const __m128 t0_y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.min_y + first_lane), _mm_set1_ps(ray.origin.y)),
+                                           _mm_set1_ps(inv_direction.y));
+            const __m128 t0_z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.min_z + first_lane), _mm_set1_ps(ray.origin.z)),
+                                           _mm_set1_ps(inv_direction.z));
+            const __m128 t1_x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.max_x + first_lane), _mm_set1_ps(ray.origin.x)),
+                                           _mm_set1_ps(inv_direction.x));
+            const __m128 t1_y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.max_y + first_lane), _mm_set1_ps(ray.origin.y)),
+                                           _mm_set1_ps(inv_direction.y));
+            const __m128 t1_z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.max_z + first_lane), _mm_set1_ps(ray.origin.z)),
+                                           _mm_set1_ps(inv_direction.z));
+
+            // Operand order mirrors glm::min/max and std::min/max so NaN lanes behave like the scalar test.
+            const __m128 near_x = _mm_min_ps(t1_x, t0_x);
+            const __m128 near_y = _mm_min_ps(t1_y, t0_y);
+            const __m128 near_z = _mm_min_ps(t1_z, t0_z);
+            const __m128 far_x = _mm_max_ps(t1_x, t0_x);
+            const __m128 far_y = _mm_max_ps(t1_y, t0_y);
+            const __m128 far_z = _mm_max_ps(t1_z, t0_z);
+
+            const __m128 t_enter = _mm_max_ps(_mm_max_ps(_mm_set1_ps(t_min), near_z), _mm_max_ps(near_y, near_x));
+            const __m128 t_exit = _mm_min_ps(_mm_min_ps(_mm_set1_ps(t_max), far_z), _mm_min_ps(far_y, far_x));
+            if (t_entry) {
+                _mm_storeu_ps(t_entry + first_lane, t_enter);
+            }
+            const auto mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpngt_ps(t_enter, t_exit)));
+            return mask << first_lane;
+        }
+
+        template<size_t Width>
+        inline uint32_t RayTriangleSSE(const Ray &ray, const TrianglePacket<Width> &packet, size_t first_lane,
+                                       float t_min, float t_max, RayTrianglePacketHit<Width> &hit) {
+            const __m128 d_x = _mm_set1_ps(ray.direction.x);
+            const __m128 d_y = _mm_set1_ps(ray.direction.y);
+            const __m128 d_z = _mm_set1_ps(ray.direction.z);
+            const __m128 e1_x = _mm_load_ps(packet.e1_x + first_lane);
+            const __m128 e1_y = _mm_load_ps(packet.e1_y + first_lane);
+            const __m128 e1_z = _mm_load_ps(packet.e1_z + first_lane);
+            const __m128 e2_x = _mm_load_ps(packet.e2_x + first_lane);
+            const __m128 e2_y = _mm_load_ps(packet.e2_y + first_lane);
+            const __m128 e2_z = _mm_load_ps(packet.e2_z + first_lane);
+
+            // p = cross(direction, e2)
+            const __m128 p_x = _mm_sub_ps(_mm_mul_ps(d_y, e2_z), _mm_mul_ps(d_z, e2_y));
+            const __m128 p_y = _mm_sub_ps(_mm_mul_ps(d_z, e2_x), _mm_mul_ps(d_x, e2_z));
+            const __m128 p_z = _mm_sub_ps(_mm_mul_ps(d_x, e2_y), _mm_mul_ps(d_y, e2_x));
+            const __m128 det = Dot3(e1_x, e1_y, e1_z, p_x, p_y, p_z);
+            const __m128 abs_det = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+            const __m128 inv_det = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+            const __m128 s_x = _mm_sub_ps(_mm_set1_ps(ray.origin.x), _mm_load_ps(packet.a_x + first_lane));
+            const __m128 s_y = _mm_sub_ps(_mm_set1_ps(ray.origin.y), _mm_load_ps(packet.a_y + first_lane));
+            const __m128 s_z = _mm_sub_ps(_mm_set1_ps(ray.origin.z), _mm_load_ps(packet.a_z + first_lane));
+            const __m128 u = _mm_mul_ps(Dot3(s_x, s_y, s_z, p_x, p_y, p_z), inv_det);
+
+            // q = cross(s, e1)
+            const __m128 q_x = _mm_sub_ps(_mm_mul_ps(s_y, e1_z), _mm_mul_ps(s_z, e1_y));
+            const __m128 q_y = _mm_sub_ps(_mm_mul_ps(s_z, e1_x), _mm_mul_ps(s_x, e1_z));
+            const __m128 q_z = _mm_sub_ps(_mm_mul_ps(s_x, e1_y), _mm_mul_ps(s_y, e1_x));
+            const __m128 v = _mm_mul_ps(Dot3(d_x, d_y, d_z, q_x, q_y, q_z), inv_det);
+            const __m128 t = _mm_mul_ps(Dot3(e2_x, e2_y, e2_z, q_x, q_y, q_z), inv_det);
+
+            // Each condition is the negation of the scalar early out.
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            __m128 accept = _mm_cmpnlt_ps(abs_det, _mm_set1_ps(1e-12f));
+            accept = _mm_and_ps(accept, _mm_and_ps(_mm_cmpnlt_ps(u, zero), _mm_cmpngt_ps(u, one)));
+            accept = _mm_and_ps(accept, _mm_and_ps(_mm_cmpnlt_ps(v, zero), _mm_cmpngt_ps(_mm_add_ps(u, v), one)));
+            accept = _mm_and_ps(accept, _mm_and_ps(_mm_cmpnlt_ps(t, _mm_set1_ps(t_min)),
+                                                   _mm_cmpngt_ps(t, _mm_set1_ps(t_max))));
+
+            _mm_store_ps(hit.t + first_lane, t);
+            _mm_store_ps(hit.u + first_lane, u);
+            _mm_store_ps(hit.v + first_lane, v);
+            return static_cast<uint32_t>(_mm_movemask_ps(accept)) << first_lane;
+        }
+
+        // --- AVX, all 8 lanes ---
+
+        RDE_GEOMETRY_TARGET_AVX
+        inline __m256 Dot3(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+            return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+        }
+
+        RDE_GEOMETRY_TARGET_AVX
+        inline uint32_t RayAABBAVX(const Ray &ray, const glm::vec3 &inv_direction, const AABBPacket<8> &packet,
+                                   float t_min, float t_max, float *t_entry) {
+            const __m256 o_x = _mm256_set1_ps(ray.origin.x);
+            const __m256 o_y = _mm256_set1_ps(ray.origin.y);
+            const __m256 o_z = _mm256_set1_ps(ray.origin.z);
+            const __m256 i_x = _mm256_set1_ps(inv_direction.x);
+            const __m256 i_y = _mm256_set1_ps(inv_direction.y);
+            const __m256 i_z = _mm256_set1_ps(inv_direction.z);
+            const __m256 t0_x = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(packet.min_x), o_x), i_x);
+            const __m256 t0_y = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(packet.min_y), o_y), i_y);
+            const __m256 t0_z = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(packet.min_z), o_z), i_z);
+            const __m256 t1_x = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(packet.max_x), o_x), i_x);
+            const __m256 t1_y = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(packet.max_y), o_y), i_y);
+            const __m256 t1_z = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(packet.max_z), o_z), i_z);
+
+            const __m256 near_x = _mm256_min_ps(t1_x, t0_x);
+            const __m256 near_y = _mm256_min_ps(t1_y, t0_y);
+            const __m256 near_z = _mm256_min_ps(t1_z, t0_z);
+            const __m256 far_x = _mm256_max_ps(t1_x, t0_x);
+            const __m256 far_y = _mm256_max_ps(t1_y, t0_y);
+            const __m256 far_z = _mm256_max_ps(t1_z, t0_z);
+
+            const __m256 t_enter = _mm256_max_ps(_mm256_max_ps(_mm256_set1_ps(t_min), near_z),
+                                                 _mm256_max_ps(near_y, near_x));
+            const __m256 t_exit = _mm256_min_ps(_mm256_min_ps(_mm256_set1_ps(t_max), far_z),
+                                                _mm256_min_ps(far_y, far_x));
+            if (t_entry) {
+                _mm256_storeu_ps(t_entry, t_enter);
+            }
+            return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(t_enter, t_exit, _CMP_NGT_UQ)));
+        }
+
+        RDE_GEOMETRY_TARGET_AVX
+        inline uint32_t RayTriangleAVX(const Ray &ray, const TrianglePacket<8> &packet, float t_min, float t_max,
+                                       RayTrianglePacketHit<8> &hit) {
+            const __m256 d_x = _mm256_set1_ps(ray.direction.x);
+            const __m256 d_y = _mm256_set1_ps(ray.direction.y);
+            const __m256 d_z = _mm256_set1_ps(ray.direction.z);
+            const __m256 e1_x = _mm256_load_ps(packet.e1_x);
+            const __m256 e1_y = _mm256_load_ps(packet.e1_y);
+            const __m256 e1_z = _mm256_load_ps(packet.e1_z);
+            const __m256 e2_x = _mm256_load_ps(packet.e2_x);
+            const __m256 e2_y = _mm256_load_ps(packet.e2_y);
+            const __m256 e2_z = _mm256_load_ps(packet.e2_z);
+
+            const __m256 p_x = _mm256_sub_ps(_mm256_mul_ps(d_y, e2_z), _mm256_mul_ps(d_z, e2_y));
+            const __m256 p_y = _mm256_sub_ps(_mm256_mul_ps(d_z, e2_x), _mm256_mul_ps(d_x, e2_z));
+            const __m256 p_z = _mm256_sub_ps(_mm256_mul_ps(d_x, e2_y), _mm256_mul_ps(d_y, e2_x));
+            const __m256 det = Dot3(e1_x, e1_y, e1_z, p_x, p_y, p_z);
+            const __m256 abs_det = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), det);
+            const __m256 inv_det = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+            const __m256 s_x = _mm256_sub_ps(_mm256_set1_ps(ray.origin.x), _mm256_load_ps(packet.a_x));
+            const __m256 s_y = _mm256_sub_ps(_mm256_set1_ps(ray.origin.y), _mm256_load_ps(packet.a_y));
+            const __m256 s_z = _mm256_sub_ps(_mm256_set1_ps(ray.origin.z), _mm256_load_ps(packet.a_z));
+            const __m256 u = _mm256_mul_ps(Dot3(s_x, s_y, s_z, p_x, p_y, p_z), inv_det);
+
+            const __m256 q_x = _mm256_sub_ps(_mm256_mul_ps(s_y, e1_z), _mm256_mul_ps(s_z, e1_y));
+            const __m256 q_y = _mm256_sub_ps(_mm256_mul_ps(s_z, e1_x), _mm256_mul_ps(s_x, e1_z));
+            const __m256 q_z = _mm256_sub_ps(_mm256_mul_ps(s_x, e1_y), _mm256_mul_ps(s_y, e1_x));
+            const __m256 v = _mm256_mul_ps(Dot3(d_x, d_y, d_z, q_x, q_y, q_z), inv_det);
+            const __m256 t = _mm256_mul_ps(Dot3(e2_x, e2_y, e2_z, q_x, q_y, q_z), inv_det);
+
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            __m256 accept = _mm256_cmp_ps(abs_det, _mm256_set1_ps(1e-12f), _CMP_NLT_UQ);
+            accept = _mm256_and_ps(accept, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_NLT_UQ),
+                                                         _mm256_cmp_ps(u, one, _CMP_NGT_UQ)));
+            accept = _mm256_and_ps(accept, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_NLT_UQ),
+                                                         _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_NGT_UQ)));
+            accept = _mm256_and_ps(accept, _mm256_and_ps(_mm256_cmp_ps(t, _mm256_set1_ps(t_min), _CMP_NLT_UQ),
+                                                         _mm256_cmp_ps(t, _mm256_set1_ps(t_max), _CMP_NGT_UQ)));
+
+            _mm256_store_ps(hit.t, t);
+            _mm256_store_ps(hit.u, u);
+            _mm256_store_ps(hit.v, v);
+            return static_cast<uint32_t>(_mm256_movemask_ps(accept));
+        }
+
+        RDE_GEOMETRY_TARGET_AVX
+        inline void SphereSignedDistancesAVX(const SphereSoA &spheres, const glm::vec3 &point, size_t count,
+                                             float *out) {
+            const __m256 p_x = _mm256_set1_ps(point.x);
+            const __m256 p_y = _mm256_set1_ps(point.y);
+            const __m256 p_z = _mm256_set1_ps(point.z);
+            for (size_t i = 0; i < count; i += 8) {
+                const __m256 d_x = _mm256_sub_ps(p_x, _mm256_loadu_ps(spheres.center_x.data() + i));
+                const __m256 d_y = _mm256_sub_ps(p_y, _mm256_loadu_ps(spheres.center_y.data() + i));
+                const __m256 d_z = _mm256_sub_ps(p_z, _mm256_loadu_ps(spheres.center_z.data() + i));
+                const __m256 length = _mm256_sqrt_ps(Dot3(d_x, d_y, d_z, d_x, d_y, d_z));
+                _mm256_storeu_ps(out + i, _mm256_sub_ps(length, _mm256_loadu_ps(spheres.radius.data() + i)));
+            }
+        }
+
+        RDE_GEOMETRY_TARGET_AVX
+        inline void SphereContainsAVX(const SphereSoA &spheres, const glm::vec3 &point, size_t count,
+                                      std::vector<uint32_t> &indices) {
+            const __m256 p_x = _mm256_set1_ps(point.x);
+            const __m256 p_y = _mm256_set1_ps(point.y);
+            const __m256 p_z = _mm256_set1_ps(point.z);
+            for (size_t i = 0; i < count; i += 8) {
+                const __m256 d_x = _mm256_sub_ps(p_x, _mm256_loadu_ps(spheres.center_x.data() + i));
+                const __m256 d_y = _mm256_sub_ps(p_y, _mm256_loadu_ps(spheres.center_y.data() + i));
+                const __m256 d_z = _mm256_sub_ps(p_z, _mm256_loadu_ps(spheres.center_z.data() + i));
+                const __m256 r = _mm256_loadu_ps(spheres.radius.data() + i);
+                const int mask = _mm256_movemask_ps(
+                    _mm256_cmp_ps(Dot3(d_x, d_y, d_z, d_x, d_y, d_z), _mm256_mul_ps(r, r), _CMP_LE_OQ));
+                for (uint32_t lane = 0; mask != 0 && lane < 8; ++lane) {
+                    if (mask & (1 << lane)) {
+                        indices.push_back(static_cast<uint32_t>(i) + lane);
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+    // --- Ray vs AABB packet ---
+
+    // Slab test against every lane. Returns a bitmask of the lanes hit within [t_min, t_max] and, if t_entry is
+    // given, writes the entry distance of every lane (only meaningful for lanes in the mask).
+    template<size_t Width>
+    inline uint32_t intersect(const Ray &ray, const glm::vec3 &inv_direction, const AABBPacket<Width> &packet,
+                              float t_min = 0.0f, float t_max = std::numeric_limits<float>::max(),
+                              float *t_entry = nullptr) {
+        uint32_t mask = 0;
+#if RDE_GEOMETRY_SIMD
+        // Rays parallel to an axis take the scalar test, which guards that axis.
+        if (is_parallel_to_slabs(ray.direction.x) || is_parallel_to_slabs(ray.direction.y) ||
+            is_parallel_to_slabs(ray.direction.z)) {
+            mask = PacketDetail::RayAABBScalar(ray, inv_direction, packet, 0, Width, t_min, t_max, t_entry);
+            return mask & packet.valid_mask;
+        }
+        if constexpr (Width == 8) {
+            if (GetSimdLevel() == SimdLevel::AVX) {
+                mask = PacketDetail::RayAABBAVX(ray, inv_direction, packet, t_min, t_max, t_entry);
+                return mask & packet.valid_mask;
+            }
+        }
+        for (size_t first_lane = 0; first_lane < Width; first_lane += 4) {
+            mask |= PacketDetail::RayAABBSSE(ray, inv_direction, packet, first_lane, t_min, t_max, t_entry);
+        }
+#else
+        mask = PacketDetail::RayAABBScalar(ray, inv_direction, packet, 0, Width, t_min, t_max, t_entry);
+#endif
+        return mask & packet.valid_mask;
+    }
+
+    template<size_t Width>
+    inline uint32_t intersect(const Ray &ray, const AABBPacket<Width> &packet, float t_min = 0.0f,
+                              float t_max = std::numeric_limits<float>::max(), float *t_entry = nullptr) {
+        return intersect(ray, 1.0f / ray.direction, packet, t_min, t_max, t_entry);
+    }
+
+    // --- Ray vs triangle packet ---
+
+    // Moeller-Trumbore against every lane, both faces are hit. Returns hit.mask.
+    template<size_t Width>
+    inline uint32_t intersect(const Ray &ray, const TrianglePacket<Width> &packet, RayTrianglePacketHit<Width> &hit,
+                              float t_min = 0.0f, float t_max = std::numeric_limits<float>::max()) {
+        uint32_t mask = 0;
+#if RDE_GEOMETRY_SIMD
+        if constexpr (Width == 8) {
+            if (GetSimdLevel() == SimdLevel::AVX) {
+                mask = PacketDetail::RayTriangleAVX(ray, packet, t_min, t_max, hit);
+                hit.mask = mask & packet.valid_mask;
+                return hit.mask;
+            }
+        }
+        for (size_t first_lane = 0; first_lane < Width; first_lane += 4) {
+            mask |= PacketDetail::RayTriangleSSE(ray, packet, first_lane, t_min, t_max, hit);
+        }
+#else
+        mask = PacketDetail::RayTriangleScalar(ray, packet, 0, Width, t_min, t_max, hit);
+#endif
+        hit.mask = mask & packet.valid_mask;
+        return hit.mask;
+    }
+
+    // --- Point vs spheres ---
+
+    // Writes |point - center| - radius for every sphere into out (spheres.size() floats): negative inside.
+    inline void SignedDistances(const SphereSoA &spheres, const glm::vec3 &point, float *out) {
+        const size_t count = spheres.size();
+        size_t i = 0;
+#if RDE_GEOMETRY_SIMD
+        if (GetSimdLevel() == SimdLevel::AVX) {
+            const size_t packed = count & ~size_t(7);
+            PacketDetail::SphereSignedDistancesAVX(spheres, point, packed, out);
+            i = packed;
+        } else {
+            const __m128 p_x = _mm_set1_ps(point.x);
+            const __m128 p_y = _mm_set1_ps(point.y);
+            const __m128 p_z = _mm_set1_ps(point.z);
+            for (; i + 4 <= count; i += 4) {
+                const __m128 d_x = _mm_sub_ps(p_x, _mm_loadu_ps(spheres.center_x.data() + i));
+                const __m128 d_y = _mm_sub_ps(p_y, _mm_loadu_ps(spheres.center_y.data() + i));
+                const __m128 d_z = _mm_sub_ps(p_z, _mm_loadu_ps(spheres.center_z.data() + i));
+                const __m128 length = _mm_sqrt_ps(PacketDetail::Dot3(d_x, d_y, d_z, d_x, d_y, d_z));
+                _mm_storeu_ps(out + i, _mm_sub_ps(length, _mm_loadu_ps(spheres.radius.data() + i)));
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            const glm::vec3 diff = point - glm::vec3(spheres.center_x[i], spheres.center_y[i], spheres.center_z[i]);
+            out[i] = std::sqrt(diff.x * diff.x + diff.y * diff.y + diff.z * diff.z) - spheres.radius[i];
+        }
+    }
+
+    // Appends the index of every sphere containing the point (boundary included) to indices, in ascending order.
+    inline void Contains(const SphereSoA &spheres, const glm::vec3 &point, std::vector<uint32_t> &indices) {
+        const size_t count = spheres.size();
+        size_t i = 0;
+#if RDE_GEOMETRY_SIMD
+        if (GetSimdLevel() == SimdLevel::AVX) {
+            const size_t packed = count & ~size_t(7);
+            PacketDetail::SphereContainsAVX(spheres, point, packed, indices);
+            i = packed;
+        } else {
+            const __m128 p_x = _mm_set1_ps(point.x);
+            const __m128 p_y = _mm_set1_ps(point.y);
+            const __m128 p_z = _mm_set1_ps(point.z);
+            for (; i + 4 <= count; i += 4) {
+                const __m128 d_x = _mm_sub_ps(p_x, _mm_loadu_ps(spheres.center_x.data() + i));
+                const __m128 d_y = _mm_sub_ps(p_y, _mm_loadu_ps(spheres.center_y.data() + i));
+                const __m128 d_z = _mm_sub_ps(p_z, _mm_loadu_ps(spheres.center_z.data() + i));
+                const __m128 r = _mm_loadu_ps(spheres.radius.data() + i);
+                const __m128 inside = _mm_cmple_ps(PacketDetail::Dot3(d_x, d_y, d_z, d_x, d_y, d_z), _mm_mul_ps(r, r));
+                const int mask = _mm_movemask_ps(inside);
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    if (mask & (1 << lane)) {
+                        indices.push_back(static_cast<uint32_t>(i) + lane);
+                    }
+                }
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            const glm::vec3 diff = point - glm::vec3(spheres.center_x[i], spheres.center_y[i], spheres.center_z[i]);
+            const float r = spheres.radius[i];
+            if (diff.x * diff.x + diff.y * diff.y + diff.z * diff.z <= r * r) {
+                indices.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+}
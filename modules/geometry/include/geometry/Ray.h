@@ -1,6 +1,12 @@
 #pragma once
 
+#include "AABB.h"
+#include "Triangle.h"
+
 #include <glm/glm.hpp>
+#include <cmath>
+#include <limits>
+#include <optional>
 
 namespace RDE{
     struct Ray{
@@ -31,4 +37,77 @@ namespace RDE{
     inline float distance(const Ray &ray, const glm::vec3 &point) {
         return std::sqrt(squared_distance(ray, point));
     }
+
+    struct RayTriangleHit {
+        float t; // Distance along the ray
+        float u; // Barycentric weight of triangle.b
+        float v; // Barycentric weight of triangle.c
+    };
+
+    // Moeller-Trumbore, both faces are hit. Returns the hit if t lies in [t_min, t_max].
+    inline std::optional<RayTriangleHit> intersect(const Ray &ray, const Triangle &triangle, float t_min = 0.0f,
+                                                   float t_max = std::numeric_limits<float>::max()) {
+        const glm::vec3 e1 = triangle.b - triangle.a;
+        const glm::vec3 e2 = triangle.c - triangle.a;
+        const glm::vec3 p = glm::cross(ray.direction, e2);
+        const float det = glm::dot(e1, p);
+        if (std::abs(det) < 1e-12f) {
+            return std::nullopt; // Ray is parallel to the triangle plane (or the triangle is degenerate)
+        }
+
+        const float inv_det = 1.0f / det;
+        const glm::vec3 s = ray.origin - triangle.a;
+        const float u = glm::dot(s, p) * inv_det;
+        if (u < 0.0f || u > 1.0f) {
+            return std::nullopt;
+        }
+
+        const glm::vec3 q = glm::cross(s, e1);
+        const float v = glm::dot(ray.direction, q) * inv_det;
+        if (v < 0.0f || u + v > 1.0f) {
+            return std::nullopt;
+        }
+
+        const float t = glm::dot(e2, q) * inv_det;
+        if (t < t_min || t > t_max) {
+            return std::nullopt;
+        }
+        return RayTriangleHit{t, u, v};
+    }
+
+    // Rays with a direction component this small run parallel to the slabs of that axis. Their inverse is infinite
+    // and an origin on a slab plane would give 0 * inf = NaN in the slab test.
+    inline bool is_parallel_to_slabs(float direction) {
+        return std::abs(direction) < 1e-12f;
+    }
+
+    // Slab test with a precomputed 1 / ray.direction. Returns the entry distance if the box is hit within [t_min, t_max].
+    inline std::optional<float> intersect(const Ray &ray, const glm::vec3 &inv_direction, const AABB &aabb,
+                                          float t_min = 0.0f, float t_max = std::numeric_limits<float>::max()) {
+        const glm::vec3 t0 = (aabb.min - ray.origin) * inv_direction;
+        const glm::vec3 t1 = (aabb.max - ray.origin) * inv_direction;
+        glm::vec3 t_near = glm::min(t0, t1);
+        glm::vec3 t_far = glm::max(t0, t1);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (is_parallel_to_slabs(ray.direction[axis])) {
+                // Inside the slab for every t or never.
+                if (ray.origin[axis] < aabb.min[axis] || ray.origin[axis] > aabb.max[axis]) {
+                    return std::nullopt;
+                }
+                t_near[axis] = -std::numeric_limits<float>::infinity();
+                t_far[axis] = std::numeric_limits<float>::infinity();
+            }
+        }
+        const float t_enter = std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, t_min));
+        const float t_exit = std::min(std::min(t_far.x, t_far.y), std::min(t_far.z, t_max));
+        if (t_enter > t_exit) {
+            return std::nullopt;
+        }
+        return t_enter;
+    }
+
+    inline std::optional<float> intersect(const Ray &ray, const AABB &aabb, float t_min = 0.0f,
+                                          float t_max = std::numeric_limits<float>::max()) {
+        return intersect(ray, 1.0f / ray.direction, aabb, t_min, t_max);
+    }
 }
\ No newline at end of file
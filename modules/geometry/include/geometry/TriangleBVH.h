@@ -0,0 +1,496 @@
+//geometry/TriangleBVH.h
+#pragma once
+
+#include "AABB.h"
+#include "Ray.h"
+#include "Triangle.h"
+#include "core/Log.h"
+#include "core/ParallelFor.h"
+#include "core/Properties.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace RDE {
+    // Compact 32 byte node, two nodes per cache line.
+    // Inner nodes store the index of their left child (the right child is always left + 1),
+    // leaves store the index of their first triangle and the triangle count.
+    struct BVHNode {
+        glm::vec3 aabb_min;
+        uint32_t left_first = 0;
+        glm::vec3 aabb_max;
+        uint32_t count = 0; // 0 for inner nodes
+
+        bool is_leaf() const {
+            return count > 0;
+        }
+
+        AABB get_aabb() const {
+            return {aabb_min, aabb_max};
+        }
+    };
+
+    static_assert(sizeof(BVHNode) == 32, "BVHNode must stay 32 bytes.");
+
+    struct BVHRayHit {
+        float t = 0.0f; // Distance along the ray
+        float u = 0.0f; // Barycentric weight of the second triangle vertex
+        float v = 0.0f; // Barycentric weight of the third triangle vertex
+        uint32_t face = 0; // Index into the f:tris array the BVH was built from
+    };
+
+    struct BVHClosestPoint {
+        glm::vec3 point{0.0f}; // Closest point on the mesh surface
+        float squared_distance = 0.0f;
+        uint32_t face = 0; // Index into the f:tris array the BVH was built from
+    };
+
+    struct BVHBuildSettings {
+        uint32_t num_bins = 16; // SAH bins per axis, clamped to TriangleBVH::MAX_BINS
+        uint32_t min_leaf_size = 2; // Ranges this small always become leaves
+        uint32_t max_leaf_size = 16; // Ranges larger than this are always split
+        float traversal_cost = 1.0f; // Cost of visiting a node relative to one triangle test
+        // Nodes with more triangles are split on the calling thread, the subtrees below are built in parallel
+        size_t parallel_threshold = 16384;
+    };
+
+    // Bounding volume hierarchy over an indexed triangle mesh (v:point + f:tris), built with binned SAH.
+    // The triangles are copied into leaf order, so the source arrays may change after the build.
+    class TriangleBVH {
+    public:
+        using BuildSettings = BVHBuildSettings;
+
+        static constexpr uint32_t MAX_BINS = 32;
+        static constexpr uint32_t MAX_DEPTH = 60; // Keeps the fixed traversal stacks below bounded
+
+        bool build(const std::vector<glm::vec3> &positions, const std::vector<glm::ivec3> &triangles,
+                   const BuildSettings &settings = {}) {
+            clear();
+            if (triangles.empty()) {
+                return false;
+            }
+
+            const size_t num_triangles = triangles.size();
+            if (num_triangles >= std::numeric_limits<uint32_t>::max() / 2) {
+                RDE_CORE_ERROR("TriangleBVH::build: Too many triangles ({}).", num_triangles);
+                return false;
+            }
+
+            BuildContext ctx;
+            ctx.settings = settings;
+            ctx.settings.num_bins = std::clamp<uint32_t>(settings.num_bins, 2, MAX_BINS);
+            ctx.settings.max_leaf_size = std::max(settings.max_leaf_size, settings.min_leaf_size);
+            ctx.bounds.resize(num_triangles);
+            ctx.centroids.resize(num_triangles);
+            ctx.indices.resize(num_triangles);
+
+            std::atomic<bool> valid_indices{true};
+            const auto num_positions = static_cast<int>(positions.size());
+            Parallel::For(num_triangles, 4096, [&](size_t i) {
+                const glm::ivec3 &tri = triangles[i];
+                if (tri.x < 0 || tri.y < 0 || tri.z < 0 ||
+                    tri.x >= num_positions || tri.y >= num_positions || tri.z >= num_positions) {
+                    valid_indices = false;
+                    return;
+                }
+                AABB box = AABB::Create(positions[tri.x]);
+                box.grow(positions[tri.y]);
+                box.grow(positions[tri.z]);
+                ctx.bounds[i] = box;
+                ctx.centroids[i] = box.center();
+                ctx.indices[i] = static_cast<uint32_t>(i);
+            });
+
+            if (!valid_indices) {
+                RDE_CORE_ERROR("TriangleBVH::build: Triangle references a vertex out of range.");
+                return false;
+            }
+
+            m_nodes.resize(2 * num_triangles - 1);
+            ctx.nodes = m_nodes.data();
+            ctx.node_count = 1;
+            // The top of the tree is split here, Parallel::For then builds the subtrees below the threshold with one
+            // thread per worker. Nothing nests, so the build never runs more threads than workers.
+            std::vector<Subtree> subtrees;
+            build_recursive(ctx, {0, 0, static_cast<uint32_t>(num_triangles), 0}, &subtrees);
+            Parallel::For(subtrees.size(), 1, [&](size_t i) {
+                build_recursive(ctx, subtrees[i], nullptr);
+            });
+            m_nodes.resize(ctx.node_count.load());
+            m_nodes.shrink_to_fit();
+
+            // Copy the triangles into leaf order so leaf tests stream through memory.
+            m_triangles.resize(num_triangles);
+            m_face_indices = std::move(ctx.indices);
+            Parallel::For(num_triangles, 4096, [&](size_t i) {
+                const glm::ivec3 &tri = triangles[m_face_indices[i]];
+                m_triangles[i] = Triangle{positions[tri.x], positions[tri.y], positions[tri.z]};
+            });
+            return true;
+        }
+
+        // Builds from the property containers of an AssetCpuGeometry / TriMesh (v:point + f:tris).
+        bool build(const PropertyContainer &vertices, const PropertyContainer &faces,
+                   const BuildSettings &settings = {}) {
+            const auto *positions = dynamic_cast<const PropertyArray<glm::vec3> *>(vertices.get_base("v:point"));
+            const auto *triangles = dynamic_cast<const PropertyArray<glm::ivec3> *>(faces.get_base("f:tris"));
+            if (!positions || !triangles) {
+                RDE_CORE_WARN("TriangleBVH::build: Missing v:point (vec3) or f:tris (ivec3) property.");
+                clear();
+                return false;
+            }
+            return build(positions->vector(), triangles->vector(), settings);
+        }
+
+        void clear() {
+            m_nodes.clear();
+            m_triangles.clear();
+            m_face_indices.clear();
+        }
+
+        bool empty() const {
+            return m_nodes.empty();
+        }
+
+        AABB get_bounds() const {
+            return m_nodes.empty() ? AABB() : m_nodes.front().get_aabb();
+        }
+
+        const std::vector<BVHNode> &get_nodes() const {
+            return m_nodes;
+        }
+
+        // Triangles in leaf order, get_face_index maps them back to the source f:tris index.
+        const std::vector<Triangle> &get_triangles() const {
+            return m_triangles;
+        }
+
+        uint32_t get_face_index(uint32_t leaf_triangle) const {
+            return m_face_indices[leaf_triangle];
+        }
+
+        // Closest hit along the ray within [t_min, t_max].
+        std::optional<BVHRayHit> intersect(const Ray &ray, float t_min = 0.0f,
+                                           float t_max = std::numeric_limits<float>::max()) const {
+            if (m_nodes.empty()) {
+                return std::nullopt;
+            }
+
+            const glm::vec3 inv_direction = 1.0f / ray.direction;
+            if (!RDE::intersect(ray, inv_direction, m_nodes[0].get_aabb(), t_min, t_max)) {
+                return std::nullopt;
+            }
+
+            std::optional<BVHRayHit> closest_hit;
+            float closest_t = t_max;
+
+            std::array<uint32_t, MAX_DEPTH + 4> stack;
+            size_t stack_size = 0;
+            stack[stack_size++] = 0;
+
+            while (stack_size > 0) {
+                const BVHNode &node = m_nodes[stack[--stack_size]];
+                if (node.is_leaf()) {
+                    for (uint32_t i = node.left_first; i < node.left_first + node.count; ++i) {
+                        if (auto hit = RDE::intersect(ray, m_triangles[i], t_min, closest_t)) {
+                            closest_t = hit->t;
+                            closest_hit = BVHRayHit{hit->t, hit->u, hit->v, m_face_indices[i]};
+                        }
+                    }
+                    continue;
+                }
+
+                const uint32_t left = node.left_first;
+                const uint32_t right = left + 1;
+                auto t_left = RDE::intersect(ray, inv_direction, m_nodes[left].get_aabb(), t_min, closest_t);
+                auto t_right = RDE::intersect(ray, inv_direction, m_nodes[right].get_aabb(), t_min, closest_t);
+
+                // Push the far child first so the near child is popped (and shrinks closest_t) first.
+                if (t_left && t_right) {
+                    const bool left_first = *t_left <= *t_right;
+                    stack[stack_size++] = left_first ? right : left;
+                    stack[stack_size++] = left_first ? left : right;
+                } else if (t_left) {
+                    stack[stack_size++] = left;
+                } else if (t_right) {
+                    stack[stack_size++] = right;
+                }
+            }
+            return closest_hit;
+        }
+
+        // Occlusion query: returns as soon as any triangle is hit within [t_min, t_max].
+        bool intersects_any(const Ray &ray, float t_min = 0.0f,
+                            float t_max = std::numeric_limits<float>::max()) const {
+            if (m_nodes.empty()) {
+                return false;
+            }
+
+            const glm::vec3 inv_direction = 1.0f / ray.direction;
+            std::array<uint32_t, MAX_DEPTH + 4> stack;
+            size_t stack_size = 0;
+            stack[stack_size++] = 0;
+
+            while (stack_size > 0) {
+                const BVHNode &node = m_nodes[stack[--stack_size]];
+                if (!RDE::intersect(ray, inv_direction, node.get_aabb(), t_min, t_max)) {
+                    continue;
+                }
+                if (node.is_leaf()) {
+                    for (uint32_t i = node.left_first; i < node.left_first + node.count; ++i) {
+                        if (RDE::intersect(ray, m_triangles[i], t_min, t_max)) {
+                            return true;
+                        }
+                    }
+                    continue;
+                }
+                stack[stack_size++] = node.left_first + 1;
+                stack[stack_size++] = node.left_first;
+            }
+            return false;
+        }
+
+        // Closest point on the mesh surface, limited to max_distance from the query point.
+        std::optional<BVHClosestPoint> closest_point(const glm::vec3 &point,
+                                                     float max_distance = std::numeric_limits<float>::max()) const {
+            if (m_nodes.empty()) {
+                return std::nullopt;
+            }
+
+            float best_squared_distance = max_distance < std::sqrt(std::numeric_limits<float>::max())
+                                              ? max_distance * max_distance
+                                              : std::numeric_limits<float>::max();
+            if (SquaredDistance(m_nodes[0].get_aabb(), point) > best_squared_distance) {
+                return std::nullopt;
+            }
+
+            std::optional<BVHClosestPoint> result;
+            std::array<uint32_t, MAX_DEPTH + 4> stack;
+            size_t stack_size = 0;
+            stack[stack_size++] = 0;
+
+            while (stack_size > 0) {
+                const BVHNode &node = m_nodes[stack[--stack_size]];
+                // The bound may have shrunk since this node was pushed.
+                if (SquaredDistance(node.get_aabb(), point) > best_squared_distance) {
+                    continue;
+                }
+
+                if (node.is_leaf()) {
+                    for (uint32_t i = node.left_first; i < node.left_first + node.count; ++i) {
+                        const glm::vec3 candidate = ClosestPoint(m_triangles[i], point);
+                        const glm::vec3 diff = candidate - point;
+                        const float squared_distance = glm::dot(diff, diff);
+                        if (squared_distance <= best_squared_distance) {
+                            best_squared_distance = squared_distance;
+                            result = BVHClosestPoint{candidate, squared_distance, m_face_indices[i]};
+                        }
+                    }
+                    continue;
+                }
+
+                const uint32_t left = node.left_first;
+                const uint32_t right = left + 1;
+                const float d_left = SquaredDistance(m_nodes[left].get_aabb(), point);
+                const float d_right = SquaredDistance(m_nodes[right].get_aabb(), point);
+                const bool left_first = d_left <= d_right;
+                const uint32_t near_child = left_first ? left : right;
+                const uint32_t far_child = left_first ? right : left;
+                const float d_near = left_first ? d_left : d_right;
+                const float d_far = left_first ? d_right : d_left;
+
+                if (d_far <= best_squared_distance) {
+                    stack[stack_size++] = far_child;
+                }
+                if (d_near <= best_squared_distance) {
+                    stack[stack_size++] = near_child;
+                }
+            }
+            return result;
+        }
+
+    private:
+        struct BuildContext {
+            BuildSettings settings;
+            std::vector<AABB> bounds; // Per triangle bounds
+            std::vector<glm::vec3> centroids; // Per triangle bounds center
+            std::vector<uint32_t> indices; // Triangle indices, partitioned in place during the build
+            BVHNode *nodes = nullptr; // Pre-sized to the 2N - 1 upper bound
+            std::atomic<uint32_t> node_count{0};
+        };
+
+        struct Bin {
+            AABB bounds;
+            uint32_t count = 0;
+        };
+
+        // A node still to be built and the triangle range it covers.
+        struct Subtree {
+            uint32_t node_index;
+            uint32_t first;
+            uint32_t count;
+            uint32_t depth;
+        };
+
+        static void compute_bounds(const BuildContext &ctx, uint32_t first, uint32_t count,
+                                   AABB &node_bounds, AABB &centroid_bounds) {
+            node_bounds.clear();
+            centroid_bounds.clear();
+
+            if (count <= ctx.settings.parallel_threshold) {
+                for (uint32_t i = first; i < first + count; ++i) {
+                    const uint32_t prim = ctx.indices[i];
+                    node_bounds.grow(ctx.bounds[prim]);
+                    centroid_bounds.grow(ctx.centroids[prim]);
+                }
+                return;
+            }
+
+            const size_t num_chunks = Parallel::GetChunkCount(count, ctx.settings.parallel_threshold / 4);
+            std::vector<AABB> chunk_bounds(num_chunks);
+            std::vector<AABB> chunk_centroid_bounds(num_chunks);
+            Parallel::ForChunks(count, ctx.settings.parallel_threshold / 4, [&](size_t chunk, size_t begin, size_t end) {
+                for (size_t i = first + begin; i < first + end; ++i) {
+                    const uint32_t prim = ctx.indices[i];
+                    chunk_bounds[chunk].grow(ctx.bounds[prim]);
+                    chunk_centroid_bounds[chunk].grow(ctx.centroids[prim]);
+                }
+            });
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+                node_bounds.grow(chunk_bounds[chunk]);
+                centroid_bounds.grow(chunk_centroid_bounds[chunk]);
+            }
+        }
+
+        static void make_leaf(BVHNode &node, uint32_t first, uint32_t count) {
+            node.left_first = first;
+            node.count = count;
+        }
+
+        // Builds the subtree. With deferred set, children at or below the parallel threshold are appended to it
+        // instead of being built.
+        static void build_recursive(BuildContext &ctx, const Subtree &subtree, std::vector<Subtree> *deferred) {
+            const auto [node_index, first, count, depth] = subtree;
+            BVHNode &node = ctx.nodes[node_index];
+            AABB node_bounds, centroid_bounds;
+            compute_bounds(ctx, first, count, node_bounds, centroid_bounds);
+            node.aabb_min = node_bounds.min;
+            node.aabb_max = node_bounds.max;
+
+            if (count <= ctx.settings.min_leaf_size || depth >= MAX_DEPTH) {
+                make_leaf(node, first, count);
+                return;
+            }
+
+            // -- Binned SAH split search --
+            const uint32_t num_bins = ctx.settings.num_bins;
+            const glm::vec3 extent = centroid_bounds.diagonal();
+            float best_cost = std::numeric_limits<float>::max();
+            int best_axis = -1;
+            uint32_t best_split = 0;
+
+            for (int axis = 0; axis < 3; ++axis) {
+                if (extent[axis] <= 1e-12f) {
+                    continue; // All centroids coincide along this axis
+                }
+
+                std::array<Bin, MAX_BINS> bins{};
+                const float scale = static_cast<float>(num_bins) / extent[axis];
+                for (uint32_t i = first; i < first + count; ++i) {
+                    const uint32_t prim = ctx.indices[i];
+                    const auto bin = std::min(num_bins - 1, static_cast<uint32_t>(
+                                                  (ctx.centroids[prim][axis] - centroid_bounds.min[axis]) * scale));
+                    bins[bin].count++;
+                    bins[bin].bounds.grow(ctx.bounds[prim]);
+                }
+
+                // Sweep from both sides to get the cost of every split plane between bins.
+                std::array<float, MAX_BINS> left_cost{};
+                AABB left_bounds;
+                uint32_t left_count = 0;
+                for (uint32_t i = 0; i + 1 < num_bins; ++i) {
+                    left_count += bins[i].count;
+                    left_bounds.grow(bins[i].bounds);
+                    left_cost[i] = static_cast<float>(left_count) * left_bounds.surface_area();
+                }
+
+                AABB right_bounds;
+                uint32_t right_count = 0;
+                for (uint32_t i = num_bins - 1; i > 0; --i) {
+                    right_count += bins[i].count;
+                    right_bounds.grow(bins[i].bounds);
+                    const float cost = left_cost[i - 1] + static_cast<float>(right_count) * right_bounds.surface_area();
+                    if (right_count > 0 && right_count < count && cost < best_cost) {
+                        best_cost = cost;
+                        best_axis = axis;
+                        best_split = i;
+                    }
+                }
+            }
+
+            const float node_area = node_bounds.surface_area();
+            const float leaf_cost = static_cast<float>(count);
+            const float split_cost = node_area > 0.0f
+                                         ? ctx.settings.traversal_cost + best_cost / node_area
+                                         : std::numeric_limits<float>::max();
+
+            if (count <= ctx.settings.max_leaf_size && (best_axis < 0 || split_cost >= leaf_cost)) {
+                make_leaf(node, first, count);
+                return;
+            }
+
+            // -- Partition --
+            auto *begin = ctx.indices.data() + first;
+            auto *end = begin + count;
+            uint32_t left_count = 0;
+            if (best_axis >= 0) {
+                const float scale = static_cast<float>(num_bins) / extent[best_axis];
+                const float min_axis = centroid_bounds.min[best_axis];
+                auto *mid = std::partition(begin, end, [&](uint32_t prim) {
+                    const auto bin = std::min(num_bins - 1, static_cast<uint32_t>(
+                                                  (ctx.centroids[prim][best_axis] - min_axis) * scale));
+                    return bin < best_split;
+                });
+                left_count = static_cast<uint32_t>(mid - begin);
+            }
+
+            if (left_count == 0 || left_count == count) {
+                // No usable SAH split (coincident centroids): fall back to an object median split.
+                int axis = 0;
+                if (extent.y > extent[axis]) axis = 1;
+                if (extent.z > extent[axis]) axis = 2;
+                left_count = count / 2;
+                std::nth_element(begin, begin + left_count, end, [&](uint32_t a, uint32_t b) {
+                    return ctx.centroids[a][axis] < ctx.centroids[b][axis];
+                });
+            }
+
+            const uint32_t left_child = ctx.node_count.fetch_add(2);
+            node.left_first = left_child;
+            node.count = 0;
+
+            const Subtree children[2] = {
+                {left_child, first, left_count, depth + 1},
+                {left_child + 1, first + left_count, count - left_count, depth + 1}
+            };
+            for (const Subtree &child: children) {
+                if (deferred && child.count <= ctx.settings.parallel_threshold) {
+                    deferred->push_back(child);
+                } else {
+                    build_recursive(ctx, child, deferred);
+                }
+            }
+        }
+
+        std::vector<BVHNode> m_nodes;
+        std::vector<Triangle> m_triangles; // Triangle vertices in leaf order
+        std::vector<uint32_t> m_face_indices; // Leaf order -> source face index
+    };
+}
@@ -73,6 +73,16 @@ namespace RDE {
                 return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
             case RAL::Format::BC7_UNORM:
                 return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case RAL::Format::BC1_RGB_SRGB:
+                return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+            case RAL::Format::BC3_SRGB:
+                return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case RAL::Format::BC4_UNORM:
+                return GL_COMPRESSED_RED_RGTC1;
+            case RAL::Format::BC5_UNORM:
+                return GL_COMPRESSED_RG_RGTC2;
+            case RAL::Format::BC7_SRGB:
+                return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
 
             case RAL::Format::UNKNOWN:
             default:
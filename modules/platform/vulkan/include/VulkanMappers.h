@@ -123,6 +123,16 @@ namespace RDE {
                 return VK_FORMAT_BC3_UNORM_BLOCK;
             case RAL::Format::BC7_UNORM:
                 return VK_FORMAT_BC7_UNORM_BLOCK;
+            case RAL::Format::BC1_RGB_SRGB:
+                return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+            case RAL::Format::BC3_SRGB:
+                return VK_FORMAT_BC3_SRGB_BLOCK;
+            case RAL::Format::BC4_UNORM:
+                return VK_FORMAT_BC4_UNORM_BLOCK;
+            case RAL::Format::BC5_UNORM:
+                return VK_FORMAT_BC5_UNORM_BLOCK;
+            case RAL::Format::BC7_SRGB:
+                return VK_FORMAT_BC7_SRGB_BLOCK;
 
             case RAL::Format::UNKNOWN:
             default:
@@ -477,6 +487,11 @@ namespace RDE {
             case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return  RAL::Format::BC1_RGB_UNORM;
             case VK_FORMAT_BC3_UNORM_BLOCK: return  RAL::Format::BC3_UNORM;
             case VK_FORMAT_BC7_UNORM_BLOCK: return  RAL::Format::BC7_UNORM;
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK: return  RAL::Format::BC1_RGB_SRGB;
+            case VK_FORMAT_BC3_SRGB_BLOCK: return  RAL::Format::BC3_SRGB;
+            case VK_FORMAT_BC4_UNORM_BLOCK: return  RAL::Format::BC4_UNORM;
+            case VK_FORMAT_BC5_UNORM_BLOCK: return  RAL::Format::BC5_UNORM;
+            case VK_FORMAT_BC7_SRGB_BLOCK: return  RAL::Format::BC7_SRGB;
 
             case VK_FORMAT_UNDEFINED:
             default:
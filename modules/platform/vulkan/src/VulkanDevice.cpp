@@ -909,7 +909,7 @@ namespace RDE {
         samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
         samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
         samplerInfo.mipLodBias = 0.0f;
-        samplerInfo.minLod = 0.0f;
+        samplerInfo.minLod = desc.minLod;
         samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
 
         VulkanSampler sampler;
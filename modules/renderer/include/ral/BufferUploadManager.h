@@ -3,6 +3,8 @@
 #include "ral/Device.h"
 #include "ral/CommandBuffer.h"
 
+#include <cstdint>
+
 namespace RAL {
     class BufferUploadManager {
     public:
@@ -41,6 +43,30 @@ namespace RAL {
                 RAL::BufferUsage usage
         );
 
+        /**
+         * @brief Queues an upload of one mip level of a texture. The texture is transitioned to TransferDst for the
+         * copy and back to ShaderReadOnly after it, so levels uploaded earlier stay intact. Levels larger than the
+         * staging buffer are split into bands of rows.
+         * @param data Tightly packed pixels, or 4x4 blocks for block-compressed formats.
+         */
+        void update_texture(RAL::TextureHandle handle, uint32_t mip_level, uint32_t width, uint32_t height,
+                            const void* data, size_t size);
+
+        /**
+         * @brief Bytes that may be queued per frame by work that can wait for a later frame, such as texture
+         * streaming. Uploads are never refused, callers check get_frame_budget_remaining(). Unlimited by default.
+         */
+        void set_frame_budget(size_t bytes) { m_frame_budget = bytes; }
+
+        size_t get_frame_budget_remaining() const {
+            return m_frame_bytes < m_frame_budget ? m_frame_budget - m_frame_bytes : 0;
+        }
+
+        /**
+         * @brief Starts a new budget period. Call once per frame, flush() may also run mid-frame when staging is full.
+         */
+        void begin_frame() { m_frame_bytes = 0; }
+
         /**
          * @brief Submits all queued copy commands to the GPU and waits for them to complete.
          */
@@ -52,6 +78,10 @@ namespace RAL {
         // The fundamental, private upload-queuing logic.
         void queue_upload(RAL::BufferHandle destination, const void* data, size_t size, size_t offset);
 
+        // Copies data into the staging buffer, flushing first if it does not fit, and sets staging_offset to where it
+        // went. Fails with an error for data larger than the whole staging buffer, callers split larger uploads.
+        bool stage(const void* data, size_t size, size_t alignment, uint64_t& staging_offset);
+
         struct QueuedUpload {
             RAL::BufferHandle destination_buffer;
             uint64_t source_offset_in_staging;
@@ -59,10 +89,22 @@ namespace RAL {
             uint64_t size;
         };
 
+        struct QueuedTextureUpload {
+            RAL::TextureHandle destination_texture;
+            uint64_t source_offset_in_staging;
+            uint32_t mip_level;
+            uint32_t y; // First row of the band, levels larger than the staging buffer are copied in bands
+            uint32_t width;
+            uint32_t height;
+        };
+
         RAL::Device* m_device;
         RAL::BufferHandle m_staging_buffer;
         void* m_staging_buffer_mapped_ptr;
         uint64_t m_current_staging_offset;
         std::vector<QueuedUpload> m_request_queue;
+        std::vector<QueuedTextureUpload> m_texture_request_queue;
+        size_t m_frame_budget = SIZE_MAX;
+        size_t m_frame_bytes = 0;
     };
 }
\ No newline at end of file
@@ -103,6 +103,11 @@ namespace RAL {
         BC1_RGB_UNORM, // DXT1
         BC3_UNORM, // DXT5
         BC7_UNORM, // High quality compression
+        BC1_RGB_SRGB,
+        BC3_SRGB,
+        BC4_UNORM, // Single channel
+        BC5_UNORM, // Two channels, tangent space normal maps (XY)
+        BC7_SRGB,
     };
 
     inline uint32_t get_size_of_format(RAL::Format format) {
@@ -143,4 +148,25 @@ namespace RAL {
             default: return 0; // Unknown or block-compressed formats
         }
     }
+
+    // Bytes per 4x4 block of a block-compressed format, 0 for the others.
+    inline uint32_t get_block_size_of_format(RAL::Format format) {
+        switch (format) {
+            case RAL::Format::BC1_RGB_UNORM:
+            case RAL::Format::BC1_RGB_SRGB:
+            case RAL::Format::BC4_UNORM: return 8;
+
+            case RAL::Format::BC3_UNORM:
+            case RAL::Format::BC3_SRGB:
+            case RAL::Format::BC5_UNORM:
+            case RAL::Format::BC7_UNORM:
+            case RAL::Format::BC7_SRGB: return 16;
+
+            default: return 0;
+        }
+    }
+
+    inline bool is_block_compressed(RAL::Format format) {
+        return get_block_size_of_format(format) != 0;
+    }
 }
@@ -85,6 +85,14 @@ namespace RDE {
             case RAL::Format::R32G32_SFLOAT: return "R32G32_SFLOAT";
             case RAL::Format::R32_SFLOAT: return "R32_SFLOAT";
             case RAL::Format::R8G8B8A8_UNORM: return "R8G8B8A8_UNORM";
+            case RAL::Format::BC1_RGB_UNORM: return "BC1_RGB_UNORM";
+            case RAL::Format::BC1_RGB_SRGB: return "BC1_RGB_SRGB";
+            case RAL::Format::BC3_UNORM: return "BC3_UNORM";
+            case RAL::Format::BC3_SRGB: return "BC3_SRGB";
+            case RAL::Format::BC4_UNORM: return "BC4_UNORM";
+            case RAL::Format::BC5_UNORM: return "BC5_UNORM";
+            case RAL::Format::BC7_UNORM: return "BC7_UNORM";
+            case RAL::Format::BC7_SRGB: return "BC7_SRGB";
             // Add other formats as needed...
             default: throw std::runtime_error("Unknown RAL format enum value");
         }
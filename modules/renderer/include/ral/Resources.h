@@ -344,6 +344,7 @@ namespace RAL {
         SamplerAddressMode addressModeU = SamplerAddressMode::Repeat;
         SamplerAddressMode addressModeV = SamplerAddressMode::Repeat;
         SamplerAddressMode addressModeW = SamplerAddressMode::Repeat;
+        float minLod = 0.0f; // Finest mip level that is sampled, raised while finer levels are still streaming in
         // ... other options like anisotropy, mipmapping etc. can be added later
     };
 
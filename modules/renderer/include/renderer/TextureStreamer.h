@@ -0,0 +1,63 @@
+// renderer/TextureStreamer.h
+#pragma once
+
+#include "ral/BufferUploadManager.h"
+#include "ral/Device.h"
+#include "assets/AssetDatabase.h"
+#include "assets/AssetComponentTypes.h"
+
+#include <entt/entity/registry.hpp>
+#include <map>
+#include <tuple>
+
+namespace RDE {
+    struct TextureStreamingSettings {
+        // Levels no larger than this on either side are uploaded when the texture is created, so it can be sampled in
+        // the same frame. They are a small fraction of the chain.
+        int tail_extent = 256;
+        // Bytes of finer levels queued per frame, applied through BufferUploadManager::set_frame_budget.
+        size_t frame_budget = 32 * 1024 * 1024;
+    };
+
+    // Creates GPU textures for loaded texture assets and streams their mip chains in. A new texture gets its mip tail
+    // right away, finer levels follow coarsest first within the per-frame upload budget. Textures with the highest
+    // AssetTextureResidency::priority go first, and none streams past its requested_level. GPU textures are released
+    // with their asset. Samplers are shared by all textures with the same description and resident level.
+    class TextureStreamer {
+    public:
+        TextureStreamer(RAL::Device *device, RAL::BufferUploadManager &upload_manager, AssetDatabase &database,
+                        const TextureStreamingSettings &settings = {});
+
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer &) = delete;
+
+        TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+        // Queues this frame's uploads, call before BufferUploadManager::flush.
+        void update();
+
+        // Levels that are requested but not yet on the GPU, over all textures.
+        size_t get_pending_level_count() const;
+
+    private:
+        void create_gpu_texture(entt::entity entity, AssetGpuTexture &texture);
+
+        void upload_level(const AssetGpuTexture &texture, AssetTextureResidency &residency, int level);
+
+        void update_sampler(AssetGpuTexture &texture, const AssetTextureResidency &residency);
+
+        RAL::SamplerHandle get_sampler(const RAL::SamplerDescription &desc);
+
+        void on_texture_destroyed(entt::registry &registry, entt::entity entity);
+
+        RAL::Device *m_device;
+        RAL::BufferUploadManager &m_upload_manager;
+        AssetDatabase &m_database;
+        TextureStreamingSettings m_settings;
+        // Filters, address modes and minLod of the cached samplers.
+        using SamplerKey = std::tuple<RAL::Filter, RAL::Filter, RAL::SamplerAddressMode, RAL::SamplerAddressMode,
+            RAL::SamplerAddressMode, float>;
+        std::map<SamplerKey, RAL::SamplerHandle> m_samplers;
+    };
+}
@@ -2,6 +2,7 @@
 #include "ral/CommandBuffer.h" // Needed for the flush() implementation
 #include "core/Log.h"          // For logging errors/warnings
 #include <cassert>             // For assertions on critical errors
+#include <algorithm>
 
 namespace RAL {
 
@@ -53,33 +54,51 @@ namespace RAL {
         }
     }
 
-    // --- Private Helper ---
-    // This is the single place where data is copied to the staging buffer and a command is enqueued.
-    void
-    BufferUploadManager::queue_upload(RAL::BufferHandle destination, const void *data, size_t size, size_t offset) {
-        assert(destination.is_valid() && "Destination buffer for upload is invalid.");
-
-        size_t aligned_offset = align_up(m_current_staging_offset, 4);
+    // --- Private Helpers ---
+    // This is the single place where data is copied to the staging buffer.
+    bool BufferUploadManager::stage(const void *data, size_t size, size_t alignment, uint64_t &staging_offset) {
+        if (size > STAGING_BUFFER_SIZE) {
+            RDE_CORE_ERROR("UploadManager: Upload of {} bytes exceeds the {} byte staging buffer.", size,
+                           STAGING_BUFFER_SIZE);
+            return false;
+        }
+        size_t aligned_offset = align_up(m_current_staging_offset, alignment);
 
         if (aligned_offset + size > STAGING_BUFFER_SIZE) {
             RDE_CORE_WARN("UploadManager staging buffer full. Flushing mid-frame.");
             flush();
-            aligned_offset = align_up(m_current_staging_offset, 4);
+            aligned_offset = align_up(m_current_staging_offset, alignment);
         }
-        assert(aligned_offset + size <= STAGING_BUFFER_SIZE &&
-               "Single upload request exceeds total staging buffer size!");
 
         uint8_t *destination_in_staging = static_cast<uint8_t *>(m_staging_buffer_mapped_ptr) + aligned_offset;
         memcpy(destination_in_staging, data, size);
 
-        m_request_queue.push_back({
-                                          .destination_buffer = destination,
-                                          .source_offset_in_staging = aligned_offset,
-                                          .destination_offset = offset,
-                                          .size = size
-                                  });
-
         m_current_staging_offset = aligned_offset + size;
+        m_frame_bytes += size;
+        staging_offset = aligned_offset;
+        return true;
+    }
+
+    void
+    BufferUploadManager::queue_upload(RAL::BufferHandle destination, const void *data, size_t size, size_t offset) {
+        assert(destination.is_valid() && "Destination buffer for upload is invalid.");
+
+        // Uploads larger than the staging buffer go in pieces, staging is flushed whenever it fills up.
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        for (size_t done = 0; done < size;) {
+            const size_t chunk_size = std::min(size - done, STAGING_BUFFER_SIZE);
+            uint64_t staging_offset = 0;
+            if (!stage(bytes + done, chunk_size, 4, staging_offset)) {
+                return;
+            }
+            m_request_queue.push_back({
+                                              .destination_buffer = destination,
+                                              .source_offset_in_staging = staging_offset,
+                                              .destination_offset = offset + done,
+                                              .size = chunk_size
+                                      });
+            done += chunk_size;
+        }
     }
 
 
@@ -136,12 +155,53 @@ namespace RAL {
         queue_upload(handle, data, new_size, 0);
     }
 
+    void BufferUploadManager::update_texture(RAL::TextureHandle handle, uint32_t mip_level, uint32_t width,
+                                             uint32_t height, const void *data, size_t size) {
+        assert(handle.is_valid() && "Destination texture for upload is invalid.");
+
+        // Levels larger than the staging buffer are copied in bands of whole rows, of texels or of 4x4 blocks.
+        const auto &description = m_device->get_resources_database().get<RAL::TextureDescription>(handle);
+        const uint32_t row_height = RAL::is_block_compressed(description.format) ? 4 : 1;
+        const uint32_t num_rows = (height + row_height - 1) / row_height;
+        const size_t row_size = num_rows > 0 ? size / num_rows : 0;
+        if (row_size == 0 || row_size > STAGING_BUFFER_SIZE) {
+            RDE_CORE_ERROR("UploadManager: Cannot stage level {} of {}x{} with {} bytes.", mip_level, width, height,
+                           size);
+            return;
+        }
+        const auto rows_per_band = static_cast<uint32_t>(std::min<size_t>(num_rows, STAGING_BUFFER_SIZE / row_size));
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        for (uint32_t row = 0; row < num_rows; row += rows_per_band) {
+            const uint32_t band_rows = std::min(rows_per_band, num_rows - row);
+            // Copies from a buffer must start at a multiple of the texel or block size, 16 covers both.
+            uint64_t staging_offset = 0;
+            if (!stage(bytes + size_t(row) * row_size, size_t(band_rows) * row_size, 16, staging_offset)) {
+                return;
+            }
+            const uint32_t y = row * row_height;
+            m_texture_request_queue.push_back({
+                                                      .destination_texture = handle,
+                                                      .source_offset_in_staging = staging_offset,
+                                                      .mip_level = mip_level,
+                                                      .y = y,
+                                                      .width = width,
+                                                      .height = std::min(band_rows * row_height, height - y)
+                                              });
+        }
+    }
+
     // --- Processes all queued uploads for the frame ---
     void BufferUploadManager::flush() {
-        if (m_request_queue.empty()) {
+        if (m_request_queue.empty() && m_texture_request_queue.empty()) {
             return;
         }
 
+        // Levels of the same texture are copied with one pair of layout transitions.
+        std::stable_sort(m_texture_request_queue.begin(), m_texture_request_queue.end(),
+                         [](const QueuedTextureUpload &a, const QueuedTextureUpload &b) {
+                             return a.destination_texture < b.destination_texture;
+                         });
+
         // Use a dedicated immediate-submit path so we don't consume the frame's primary command buffer.
         m_device->immediate_submit([&](RAL::CommandBuffer *cmd) {
             for (const auto &request: m_request_queue) {
@@ -153,10 +213,49 @@ namespace RAL {
                     request.destination_offset
                 );
             }
+
+            for (size_t begin = 0; begin < m_texture_request_queue.size();) {
+                const RAL::TextureHandle texture = m_texture_request_queue[begin].destination_texture;
+                size_t end = begin;
+                std::vector<RAL::BufferTextureCopy> regions;
+                for (; end < m_texture_request_queue.size() &&
+                       m_texture_request_queue[end].destination_texture == texture; ++end) {
+                    const auto &request = m_texture_request_queue[end];
+                    RAL::BufferTextureCopy region = {};
+                    region.bufferOffset = request.source_offset_in_staging;
+                    region.imageSubresource.mipLevel = request.mip_level;
+                    region.imageOffset = {0, static_cast<int32_t>(request.y), 0};
+                    region.imageExtent = {request.width, request.height, 1};
+                    regions.push_back(region);
+                }
+
+                RAL::ResourceBarrier to_transfer_dst = {};
+                to_transfer_dst.srcStage = RAL::PipelineStageFlags::FragmentShader;
+                to_transfer_dst.srcAccess = RAL::AccessFlags::ShaderRead;
+                to_transfer_dst.dstStage = RAL::PipelineStageFlags::Transfer;
+                to_transfer_dst.dstAccess = RAL::AccessFlags::TransferWrite;
+                to_transfer_dst.textureTransition = {texture, RAL::ImageLayout::ShaderReadOnly,
+                                                     RAL::ImageLayout::TransferDst};
+                cmd->pipeline_barrier(to_transfer_dst);
+
+                cmd->copy_buffer_to_texture(m_staging_buffer, texture, regions);
+
+                RAL::ResourceBarrier to_shader_read = {};
+                to_shader_read.srcStage = RAL::PipelineStageFlags::Transfer;
+                to_shader_read.srcAccess = RAL::AccessFlags::TransferWrite;
+                to_shader_read.dstStage = RAL::PipelineStageFlags::FragmentShader;
+                to_shader_read.dstAccess = RAL::AccessFlags::ShaderRead;
+                to_shader_read.textureTransition = {texture, RAL::ImageLayout::TransferDst,
+                                                    RAL::ImageLayout::ShaderReadOnly};
+                cmd->pipeline_barrier(to_shader_read);
+                begin = end;
+            }
         });
 
-        RDE_CORE_TRACE("UploadManager flushed {} requests.", m_request_queue.size());
+        RDE_CORE_TRACE("UploadManager flushed {} buffer and {} texture requests.", m_request_queue.size(),
+                       m_texture_request_queue.size());
         m_request_queue.clear();
+        m_texture_request_queue.clear();
         m_current_staging_offset = 0;
     }
 }
\ No newline at end of file
@@ -82,18 +82,22 @@ namespace RDE {
         // The dependency list in the shaderDef gives us the base paths.
         // We append the permutation mask to get the correct file.
         const auto &spirvDeps = shaderDef->dependencies.spirv_dependencies;
+        std::vector<std::string> permutationPaths;
         for (const auto &baseSpirvPath: spirvDeps) {
-            std::string permutationPath = baseSpirvPath + "." + std::to_string(mask) + ".spv";
+            permutationPaths.push_back(baseSpirvPath + "." + std::to_string(mask) + ".spv");
+        }
 
-            // Assume the AssetManager can load raw binary blobs, or use FileIO for now.
-            auto bytecode = FileIO::ReadFile(permutationPath);
+        // All stages are read in one batch so their reads overlap.
+        auto bytecodes = FileIO::ReadBatch(std::move(permutationPaths));
+        for (size_t i = 0; i < spirvDeps.size(); ++i) {
+            auto &bytecode = bytecodes[i].data;
             if (bytecode.empty()) {
-                RDE_CORE_ERROR("PipelineCache: Failed to load SPIR-V file: {}", permutationPath);
+                RDE_CORE_ERROR("PipelineCache: Failed to load SPIR-V file: {}", bytecodes[i].path);
                 continue; // Or handle error more gracefully
             }
 
             // Determine the stage from the file extension (e.g., .vert, .frag)
-            RAL::ShaderStage stage = path_to_shader_stage(baseSpirvPath); // You need this helper
+            RAL::ShaderStage stage = path_to_shader_stage(spirvDeps[i]); // You need this helper
             auto handle = m_device.create_shader_module(bytecode, stage);
             new_cached_pipeline.shaderModules.push_back(handle);
         }
@@ -0,0 +1,208 @@
+#include "renderer/TextureStreamer.h"
+#include "core/Log.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace RDE {
+    namespace {
+        struct LevelView {
+            int width;
+            int height;
+            const ByteBuffer *data;
+        };
+
+        int GetLevelCount(const AssetGpuTexture &texture) {
+            return static_cast<int>(texture.mips.size()) + 1;
+        }
+
+        LevelView GetLevel(const AssetGpuTexture &texture, int level) {
+            if (level == 0) {
+                return {texture.width, texture.height, &texture.data};
+            }
+            const AssetTextureMip &mip = texture.mips[level - 1];
+            return {mip.width, mip.height, &mip.data};
+        }
+
+        // There are no 3 channel GPU formats, and gray + alpha is sampled as RGBA like in the block-compressed
+        // formats, so uncompressed 2 and 3 channel levels are expanded on upload.
+        bool NeedsExpansion(const AssetGpuTexture &texture) {
+            return texture.format == RAL::Format::UNKNOWN && (texture.channels == 2 || texture.channels == 3);
+        }
+
+        RAL::Format GetGpuFormat(const AssetGpuTexture &texture) {
+            if (texture.format != RAL::Format::UNKNOWN) {
+                return texture.format;
+            }
+            if (texture.channels == 1) {
+                return texture.srgb ? RAL::Format::R8_SRGB : RAL::Format::R8_UNORM;
+            }
+            return texture.srgb ? RAL::Format::R8G8B8A8_SRGB : RAL::Format::R8G8B8A8_UNORM;
+        }
+
+        size_t GetUploadSize(const AssetGpuTexture &texture, int level) {
+            const LevelView view = GetLevel(texture, level);
+            return NeedsExpansion(texture) ? size_t(view.width) * size_t(view.height) * 4 : view.data->size();
+        }
+
+        void ExpandToRgba(const unsigned char *src, size_t pixel_count, int channels, std::vector<unsigned char> &out) {
+            out.resize(pixel_count * 4);
+            for (size_t i = 0; i < pixel_count; ++i) {
+                const unsigned char *p = src + i * channels;
+                unsigned char *q = out.data() + i * 4;
+                if (channels == 2) {
+                    q[0] = q[1] = q[2] = p[0];
+                    q[3] = p[1];
+                } else {
+                    q[0] = p[0];
+                    q[1] = p[1];
+                    q[2] = p[2];
+                    q[3] = 255;
+                }
+            }
+        }
+    }
+
+    TextureStreamer::TextureStreamer(RAL::Device *device, RAL::BufferUploadManager &upload_manager,
+                                     AssetDatabase &database, const TextureStreamingSettings &settings)
+        : m_device(device), m_upload_manager(upload_manager), m_database(database), m_settings(settings) {
+        m_upload_manager.set_frame_budget(m_settings.frame_budget);
+        m_database.get_registry().on_destroy<AssetGpuTexture>().connect<&TextureStreamer::on_texture_destroyed>(*this);
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        auto &registry = m_database.get_registry();
+        registry.on_destroy<AssetGpuTexture>().disconnect<&TextureStreamer::on_texture_destroyed>(*this);
+        for (auto entity: registry.view<AssetGpuTexture>()) {
+            on_texture_destroyed(registry, entity);
+        }
+        for (const auto &[key, sampler]: m_samplers) {
+            m_device->destroy_sampler(sampler);
+        }
+    }
+
+    void TextureStreamer::update() {
+        auto &registry = m_database.get_registry();
+        auto textures = registry.view<AssetGpuTexture>();
+        for (auto entity: textures) {
+            auto &texture = textures.get<AssetGpuTexture>(entity);
+            if (!texture.texture.is_valid() && !texture.data.empty() && texture.width > 0 && texture.height > 0) {
+                create_gpu_texture(entity, texture);
+            }
+        }
+
+        std::vector<std::pair<float, entt::entity> > candidates;
+        auto streamed = registry.view<AssetGpuTexture, AssetTextureResidency>();
+        for (auto entity: streamed) {
+            const auto &texture = streamed.get<AssetGpuTexture>(entity);
+            const auto &residency = streamed.get<AssetTextureResidency>(entity);
+            if (texture.texture.is_valid() && residency.finest_resident_level > residency.requested_level) {
+                candidates.emplace_back(residency.priority, entity);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+        bool uploaded = false;
+        for (const auto &[priority, entity]: candidates) {
+            auto &texture = registry.get<AssetGpuTexture>(entity);
+            auto &residency = registry.get<AssetTextureResidency>(entity);
+            const int previous_level = residency.finest_resident_level;
+            // One level at a time, the chain on the GPU has no holes. A level larger than the whole budget still
+            // goes through as the first upload of a frame.
+            while (residency.finest_resident_level > std::max(residency.requested_level, 0)) {
+                const int level = residency.finest_resident_level - 1;
+                if (uploaded && GetUploadSize(texture, level) > m_upload_manager.get_frame_budget_remaining()) {
+                    break;
+                }
+                upload_level(texture, residency, level);
+                uploaded = true;
+            }
+            if (residency.finest_resident_level != previous_level) {
+                update_sampler(texture, residency);
+            }
+            if (m_upload_manager.get_frame_budget_remaining() == 0) {
+                break;
+            }
+        }
+    }
+
+    size_t TextureStreamer::get_pending_level_count() const {
+        size_t count = 0;
+        auto view = m_database.get_registry().view<const AssetTextureResidency>();
+        for (auto entity: view) {
+            const auto &residency = view.get<const AssetTextureResidency>(entity);
+            count += size_t(std::max(residency.finest_resident_level - std::max(residency.requested_level, 0), 0));
+        }
+        return count;
+    }
+
+    void TextureStreamer::create_gpu_texture(entt::entity entity, AssetGpuTexture &texture) {
+        const int level_count = GetLevelCount(texture);
+
+        RAL::TextureDescription desc{};
+        desc.width = static_cast<uint32_t>(texture.width);
+        desc.height = static_cast<uint32_t>(texture.height);
+        desc.mipLevels = static_cast<uint32_t>(level_count);
+        desc.format = GetGpuFormat(texture);
+        desc.usage = RAL::TextureUsage::Sampled | RAL::TextureUsage::TransferDst;
+        texture.texture = m_device->create_texture(desc);
+
+        // The scene may have requested levels before the texture existed, keep its request.
+        auto &residency = m_database.get_registry().get_or_emplace<AssetTextureResidency>(entity);
+        residency.resident_levels = 0;
+        residency.finest_resident_level = -1;
+        for (int level = level_count - 1; level >= 0; --level) {
+            const LevelView view = GetLevel(texture, level);
+            if (level != level_count - 1 && std::max(view.width, view.height) > m_settings.tail_extent) {
+                break;
+            }
+            upload_level(texture, residency, level);
+        }
+        // Without a request the texture stays at its coarsest resident level instead of streaming to full size.
+        residency.requested_level = std::min(residency.requested_level, residency.finest_resident_level);
+        update_sampler(texture, residency);
+        RDE_CORE_TRACE("TextureStreamer: Created {}x{} texture with {} of {} levels resident", texture.width,
+                       texture.height, level_count - residency.finest_resident_level, level_count);
+    }
+
+    void TextureStreamer::upload_level(const AssetGpuTexture &texture, AssetTextureResidency &residency, int level) {
+        const LevelView view = GetLevel(texture, level);
+        const auto *pixels = reinterpret_cast<const unsigned char *>(view.data->data());
+        if (NeedsExpansion(texture)) {
+            std::vector<unsigned char> rgba;
+            ExpandToRgba(pixels, size_t(view.width) * size_t(view.height), texture.channels, rgba);
+            m_upload_manager.update_texture(texture.texture, level, view.width, view.height, rgba.data(), rgba.size());
+        } else {
+            m_upload_manager.update_texture(texture.texture, level, view.width, view.height, pixels,
+                                            view.data->size());
+        }
+        residency.resident_levels |= 1u << level;
+        residency.finest_resident_level = level;
+    }
+
+    void TextureStreamer::update_sampler(AssetGpuTexture &texture, const AssetTextureResidency &residency) {
+        RAL::SamplerDescription desc = texture.sampler_description;
+        desc.minLod = static_cast<float>(std::max(residency.finest_resident_level, 0));
+        texture.sampler = get_sampler(desc);
+    }
+
+    RAL::SamplerHandle TextureStreamer::get_sampler(const RAL::SamplerDescription &desc) {
+        const SamplerKey key{desc.magFilter, desc.minFilter, desc.addressModeU, desc.addressModeV, desc.addressModeW,
+                             desc.minLod};
+        auto [it, inserted] = m_samplers.try_emplace(key);
+        if (inserted) {
+            it->second = m_device->create_sampler(desc);
+        }
+        return it->second;
+    }
+
+    void TextureStreamer::on_texture_destroyed(entt::registry &registry, entt::entity entity) {
+        auto &texture = registry.get<AssetGpuTexture>(entity);
+        // The sampler is shared, it stays in the cache.
+        texture.sampler = RAL::SamplerHandle::INVALID();
+        if (texture.texture.is_valid()) {
+            m_device->destroy_texture(texture.texture);
+            texture.texture = RAL::TextureHandle::INVALID();
+        }
+    }
+}
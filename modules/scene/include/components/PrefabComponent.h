@@ -0,0 +1,31 @@
+#pragma once
+
+#include "assets/AssetHandle.h"
+#include "components/TransformComponent.h"
+
+#include <span>
+#include <vector>
+
+namespace RDE {
+    struct Prefab;
+
+    // Marks the root entity of an instantiated prefab.
+    struct PrefabInstance {
+        AssetID prefab_id; // The prefab asset this copy was created from
+    };
+}
+
+#include <entt/fwd.hpp>
+
+namespace RDE::PrefabUtils {
+    // Creates one copy of prefab per transform, which places the copy's root. Each node becomes an entity with a
+    // TransformLocal and a Hierarchy, nodes with a mesh also get a RenderableComponent and a MaterialComponent.
+    // The whole batch is created at once: the pools are reserved up front, every component type is inserted as one
+    // array and the batch is marked TransformDirty in one insert instead of one construction signal per entity.
+    // Returns the root entity of each copy, in the order of transforms.
+    std::vector<entt::entity> Instantiate(entt::registry &registry, const AssetID &prefab_id, const Prefab &prefab,
+                                          std::span<const TransformUtils::TransformParameters> transforms);
+
+    entt::entity Instantiate(entt::registry &registry, const AssetID &prefab_id, const Prefab &prefab,
+                             const TransformUtils::TransformParameters &transform = {});
+}
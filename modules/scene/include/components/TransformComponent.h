@@ -19,6 +19,7 @@ namespace RDE {
 }
 
 #include <entt/fwd.hpp>
+#include <span>
 
 namespace RDE::TransformUtils{
     using TransformParameters = TransformLocal;
@@ -28,4 +29,16 @@ namespace RDE::TransformUtils{
     TransformParameters DecomposeModelMatrix(const glm::mat4 &model_matrix);
 
     void SetTransformDirty(entt::registry &registry, entt::entity entity_id);
+
+    // Marks an entity TransformDirty whenever its TransformLocal is constructed or updated. Connected by the
+    // TransformSystem for its lifetime.
+    void ConnectDirtyListeners(entt::registry &registry);
+
+    void DisconnectDirtyListeners(entt::registry &registry);
+
+    // Adds transforms[i] to entities[i] and marks them TransformDirty, none of which may have either yet. The batch is
+    // tagged with a single insert while the dirty construction listener is disconnected, other construction listeners
+    // still see every entity. For bulk creation, e.g. prefab instances or scene snapshots.
+    void InsertTransforms(entt::registry &registry, std::span<const entt::entity> entities,
+                          const TransformParameters *transforms);
 }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "assets/AssetHandle.h"
+
+#include <entt/fwd.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+// Engine native binary snapshot of a scene registry (.rdescene). Stores every entity that has one of the persistent
+// components, one dense section per component type: the entities' snapshot indices and an array of fixed size records.
+// Entity references (Hierarchy) are snapshot indices, asset references (RenderableComponent, MaterialComponent,
+// PrefabInstance) are path ids into a table of asset paths, relative to the asset directory where possible.
+// Layout: header | section table | path table | string blob | 64 byte aligned section payloads.
+// Loading maps the file and inserts each section into the registry as one array, trivially copyable components
+// straight out of the mapping, so it is bound by the disk instead of parsing. Runtime state (TransformWorld, dirty
+// tags, GPU resources, per instance material parameters) is not stored and rebuilt by the systems. Files are written
+// in native (little endian) byte order.
+namespace RDE::SceneFile {
+    inline constexpr uint32_t VERSION = 1;
+    inline constexpr const char *EXTENSION = ".rdescene";
+
+    void Serialize(const entt::registry &registry, std::vector<char> &out);
+
+    // Only entities, e.g. one cell of a world partition. References to entities outside of it are written as null.
+    void Serialize(const entt::registry &registry, std::span<const entt::entity> entities, std::vector<char> &out);
+
+    // Validated view of a serialized snapshot, the data must outlive it. Cheap to open: only the header and tables are
+    // read, so the asset paths can be loaded before the entities are created.
+    class Snapshot {
+    public:
+        // Validates every table and payload range against size, and that no section type repeats and no entity repeats
+        // within a section. Returns false and fills error on bad data.
+        bool open(const char *data, size_t size, std::string *error = nullptr);
+
+        [[nodiscard]] bool is_open() const { return m_data != nullptr; }
+
+        [[nodiscard]] uint32_t get_entity_count() const { return m_entity_count; }
+
+        // Indexed by path id, as written.
+        [[nodiscard]] const std::vector<std::string> &get_asset_paths() const { return m_asset_paths; }
+
+        struct Section {
+            uint32_t type;
+            uint32_t record_size;
+            uint64_t count;
+            const uint32_t *entities; // Snapshot indices, aligned inside the data
+            const char *records;
+        };
+
+        [[nodiscard]] const std::vector<Section> &get_sections() const { return m_sections; }
+
+    private:
+        const char *m_data = nullptr;
+        uint32_t m_entity_count = 0;
+        std::vector<std::string> m_asset_paths;
+        std::vector<Section> m_sections;
+    };
+
+    // Creates the snapshot's entities in registry, assets[i] is the asset of path id i and may be nullptr.
+    // Returns the created entities by snapshot index.
+    std::vector<entt::entity> Instantiate(const Snapshot &snapshot, entt::registry &registry,
+                                          std::span<const AssetID> assets);
+
+    // Absolute path of a path from Snapshot::get_asset_paths.
+    std::string ResolveAssetPath(const std::string &path);
+
+    // The file is written to a temporary next to path and renamed, so readers never see a partial file.
+    bool Write(const std::filesystem::path &path, const entt::registry &registry);
+
+    bool Write(const std::filesystem::path &path, const entt::registry &registry,
+               std::span<const entt::entity> entities);
+
+    // Writes data the same way, for files that belong with snapshots such as a world index.
+    bool WriteData(const std::filesystem::path &path, std::span<const char> data);
+
+    // Maps the file, loads the referenced assets through asset_manager and instantiates the snapshot into registry.
+    // Returns false and leaves registry untouched on a missing, truncated or incompatible file.
+    bool Read(const std::filesystem::path &path, entt::registry &registry, AssetManager &asset_manager);
+}
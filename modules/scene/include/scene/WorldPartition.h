@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <entt/fwd.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// A level split into square cells on the XZ plane, for levels that don't fit in memory at once. A world is a directory
+// with an index and one SceneFile snapshot per cell. Every top level entity goes to the cell containing its position
+// together with its descendants, so each cell loads and unloads on its own, and the path table of its snapshot lists
+// the assets it depends on. WorldStreamingSystem streams the cells around the primary camera.
+namespace RDE::WorldPartition {
+    inline constexpr uint32_t VERSION = 1;
+    inline constexpr const char *INDEX_FILE = "world.rdeworld";
+
+    struct Cell {
+        int32_t x;
+        int32_t z;
+        uint32_t entity_count;
+    };
+
+    struct Index {
+        float cell_size = 0.0f;
+        std::vector<Cell> cells;
+    };
+
+    std::filesystem::path GetCellPath(const std::filesystem::path &directory, const Cell &cell);
+
+    // Distance on the XZ plane from position to the cell's square, 0 inside of it.
+    float GetDistance(const Index &index, const Cell &cell, const glm::vec3 &position);
+
+    // Splits the registry into cells of cell_size and writes them and the index to directory. Top level entities are
+    // placed by their TransformWorld, or their TransformLocal before the first transform update. The primary camera
+    // and entities without a transform stay out.
+    bool Write(const std::filesystem::path &directory, const entt::registry &registry, float cell_size);
+
+    bool ReadIndex(const std::filesystem::path &directory, Index &index);
+}
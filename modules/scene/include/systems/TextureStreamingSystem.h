@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/ISystem.h"
+#include "assets/AssetDatabase.h"
+
+#include <entt/fwd.hpp>
+
+namespace RDE {
+    // CPU-side feedback for texture streaming. Every frame each mesh's bounding volume is projected with the primary
+    // camera, and every texture of its material gets the finest mip level it can show at that size: the level whose
+    // extent is about the mesh's height in pixels, assuming the texture spans the mesh once. A texture used by several
+    // meshes keeps the finest request, and its priority is the largest on-screen size. The results go to the
+    // AssetTextureResidency of the texture assets, which TextureStreamer reads.
+    class TextureStreamingSystem : public ISystem {
+    public:
+        // lod_bias is added to the requested levels, negative values stream sharper textures.
+        TextureStreamingSystem(entt::registry &registry, AssetDatabase &asset_database, float viewport_height,
+                               float lod_bias = 0.0f);
+
+        void init() override;
+
+        void shutdown() override;
+
+        void update(float delta_time) override;
+
+        void declare_dependencies(SystemDependencyBuilder &builder) override;
+
+        void set_viewport_height(float viewport_height) { m_viewport_height = viewport_height; }
+
+    private:
+        entt::registry &m_registry;
+        AssetDatabase &m_asset_database;
+        float m_viewport_height;
+        float m_lod_bias;
+    };
+}
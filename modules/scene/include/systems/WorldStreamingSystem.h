@@ -0,0 +1,96 @@
+#pragma once
+
+#include "core/ISystem.h"
+#include "core/MappedFile.h"
+#include "assets/AssetHandle.h"
+#include "scene/SceneFile.h"
+#include "scene/WorldPartition.h"
+
+#include <entt/fwd.hpp>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RDE {
+    struct WorldStreamingSettings {
+        // Cells within load_radius of the primary camera are loaded, loaded cells beyond unload_radius are unloaded.
+        // The gap keeps a camera moving along a cell border from loading and unloading it every frame.
+        float load_radius = 150.0f;
+        float unload_radius = 200.0f;
+        // Cells mapped and validated on background threads at once.
+        size_t max_reading_cells = 4;
+        // Assets loaded through the AssetManager per frame, assets it already has don't count.
+        size_t asset_loads_per_frame = 8;
+        // Entities merged into the registry per frame. Cells are merged whole, nearest first, at least one per frame.
+        size_t entities_per_frame = 16384;
+    };
+
+    // Streams the cells of a WorldPartition around the primary camera. A cell coming into the load radius is mapped,
+    // validated and paged in on a background thread. Its assets are then loaded through the AssetManager on the main
+    // thread, a few per frame, and once all of them are there the cell is merged into the registry in one batch.
+    // Cells beyond the unload radius have their entities destroyed, their assets are released to the AssetResidency.
+    class WorldStreamingSystem : public ISystem {
+    public:
+        WorldStreamingSystem(entt::registry &registry, AssetManager &asset_manager, std::filesystem::path directory,
+                             const WorldStreamingSettings &settings = {});
+
+        // Waits for running reads.
+        ~WorldStreamingSystem() override;
+
+        void init() override;
+
+        void shutdown() override;
+
+        void update(float delta_time) override;
+
+        void declare_dependencies(SystemDependencyBuilder &builder) override;
+
+        [[nodiscard]] size_t get_loaded_cell_count() const;
+
+    private:
+        enum class CellState {
+            Unloaded,
+            Reading, // Background read running
+            Prefetching, // Loading the assets
+            Ready, // Waiting for the merge budget
+            Loaded,
+            Failed // Missing or invalid file, not tried again
+        };
+
+        struct CellData {
+            MappedFile file;
+            SceneFile::Snapshot snapshot;
+            std::vector<std::string> asset_paths; // Resolved, by path id
+            std::vector<AssetID> assets; // By path id
+            size_t num_resolved = 0;
+        };
+
+        struct StreamedCell {
+            WorldPartition::Cell cell;
+            CellState state = CellState::Unloaded;
+            float distance = 0.0f;
+            std::future<std::unique_ptr<CellData> > read;
+            std::unique_ptr<CellData> data;
+            std::vector<entt::entity> entities;
+        };
+
+        // Background thread: maps, validates and touches every page of the cell, nullptr on failure.
+        static std::unique_ptr<CellData> ReadCell(const std::filesystem::path &path);
+
+        // Returns true once every asset of the cell is resolved.
+        bool prefetch(CellData &data, size_t &asset_budget);
+
+        void merge(StreamedCell &cell);
+
+        void unload(StreamedCell &cell);
+
+        entt::registry &m_registry;
+        AssetManager &m_asset_manager;
+        std::filesystem::path m_directory;
+        WorldStreamingSettings m_settings;
+        WorldPartition::Index m_index;
+        std::vector<StreamedCell> m_cells;
+    };
+}
@@ -0,0 +1,136 @@
+#include "components/PrefabComponent.h"
+#include "components/HierarchyComponent.h"
+#include "components/MaterialComponent.h"
+#include "components/RenderableComponent.h"
+#include "assets/AssetComponentTypes.h"
+#include "core/Log.h"
+
+#include <entt/entity/registry.hpp>
+
+namespace RDE::PrefabUtils {
+    namespace {
+        // Links of one copy as node indices, -1 for none.
+        struct NodeLinks {
+            int32_t first_child = -1;
+            int32_t last_child = -1;
+            int32_t next_sibling = -1;
+            int32_t prev_sibling = -1;
+            size_t num_children = 0;
+        };
+
+        template<typename T>
+        void Reserve(entt::registry &registry, size_t count) {
+            auto &storage = registry.storage<T>();
+            storage.reserve(storage.size() + count);
+        }
+
+        // Places local, the root node's transform, by transform.
+        TransformLocal Compose(const TransformLocal &transform, const TransformLocal &local) {
+            TransformLocal result;
+            result.translation = transform.translation + transform.orientation * (transform.scale * local.translation);
+            result.orientation = transform.orientation * local.orientation;
+            result.scale = transform.scale * local.scale;
+            return result;
+        }
+    }
+
+    std::vector<entt::entity> Instantiate(entt::registry &registry, const AssetID &prefab_id, const Prefab &prefab,
+                                          std::span<const TransformUtils::TransformParameters> transforms) {
+        std::vector<entt::entity> roots;
+        const size_t num_nodes = prefab.nodes.size();
+        const size_t num_copies = transforms.size();
+        if (num_nodes == 0 || num_copies == 0) {
+            return roots;
+        }
+
+        // --- Link one copy, every other copy has the same shape ---
+        std::vector<NodeLinks> links(num_nodes);
+        std::vector<size_t> renderable_nodes;
+        for (size_t i = 0; i < num_nodes; ++i) {
+            const int32_t parent = prefab.nodes[i].parent;
+            if ((i == 0) != (parent < 0) || (parent >= 0 && size_t(parent) >= i)) {
+                RDE_CORE_ERROR("PrefabUtils: Node {} of '{}' breaks the node order, not instantiated", i,
+                               prefab_id ? prefab_id->uri : std::string());
+                return roots;
+            }
+            if (parent >= 0) {
+                NodeLinks &parent_links = links[parent];
+                if (parent_links.first_child < 0) {
+                    parent_links.first_child = static_cast<int32_t>(i);
+                } else {
+                    links[parent_links.last_child].next_sibling = static_cast<int32_t>(i);
+                    links[i].prev_sibling = parent_links.last_child;
+                }
+                parent_links.last_child = static_cast<int32_t>(i);
+                parent_links.num_children++;
+            }
+            if (prefab.nodes[i].mesh_asset) {
+                renderable_nodes.push_back(i);
+            }
+        }
+
+        // --- Create the entities, node i of copy c is entities[c * num_nodes + i] ---
+        const size_t count = num_nodes * num_copies;
+        Reserve<entt::entity>(registry, count);
+        Reserve<TransformLocal>(registry, count);
+        Reserve<TransformDirty>(registry, count);
+        Reserve<Hierarchy>(registry, count);
+        Reserve<RenderableComponent>(registry, renderable_nodes.size() * num_copies);
+        Reserve<MaterialComponent>(registry, renderable_nodes.size() * num_copies);
+        Reserve<PrefabInstance>(registry, num_copies);
+
+        std::vector<entt::entity> entities(count);
+        registry.create(entities.begin(), entities.end());
+
+        // --- Fill the component arrays ---
+        std::vector<TransformLocal> locals;
+        std::vector<Hierarchy> hierarchies;
+        locals.reserve(count);
+        hierarchies.reserve(count);
+        roots.reserve(num_copies);
+        for (size_t c = 0; c < num_copies; ++c) {
+            const entt::entity *copy = entities.data() + c * num_nodes;
+            auto entity_of = [copy](int32_t node) { return node < 0 ? entt::entity(entt::null) : copy[node]; };
+            for (size_t i = 0; i < num_nodes; ++i) {
+                const Prefab::Node &node = prefab.nodes[i];
+                const NodeLinks &node_links = links[i];
+                const TransformLocal local{node.translation, node.orientation, node.scale};
+                locals.push_back(i == 0 ? Compose(transforms[c], local) : local);
+                hierarchies.push_back({
+                    entity_of(node.parent), entity_of(node_links.first_child), entity_of(node_links.last_child),
+                    entity_of(node_links.next_sibling), entity_of(node_links.prev_sibling), node_links.num_children
+                });
+            }
+            roots.push_back(copy[0]);
+        }
+
+        registry.insert<Hierarchy>(entities.begin(), entities.end(), hierarchies.begin());
+        TransformUtils::InsertTransforms(registry, entities, locals.data());
+        registry.insert<PrefabInstance>(roots.begin(), roots.end(), PrefabInstance{prefab_id});
+
+        // The same mesh and material on every copy of a node.
+        std::vector<entt::entity> node_entities(num_copies);
+        for (const size_t i: renderable_nodes) {
+            const Prefab::Node &node = prefab.nodes[i];
+            for (size_t c = 0; c < num_copies; ++c) {
+                node_entities[c] = entities[c * num_nodes + i];
+            }
+            registry.insert<RenderableComponent>(node_entities.begin(), node_entities.end(),
+                                                 RenderableComponent{node.mesh_asset});
+            if (node.material_asset) {
+                registry.insert<MaterialComponent>(node_entities.begin(), node_entities.end(),
+                                                   MaterialComponent{node.material_asset, {}, {}});
+            }
+        }
+
+        RDE_CORE_TRACE("PrefabUtils: Instantiated {} copies of '{}', {} entities", num_copies,
+                       prefab_id ? prefab_id->uri : std::string(), count);
+        return roots;
+    }
+
+    entt::entity Instantiate(entt::registry &registry, const AssetID &prefab_id, const Prefab &prefab,
+                             const TransformUtils::TransformParameters &transform) {
+        const auto roots = Instantiate(registry, prefab_id, prefab, std::span(&transform, 1));
+        return roots.empty() ? entt::entity(entt::null) : roots.front();
+    }
+}
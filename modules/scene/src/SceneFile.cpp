@@ -0,0 +1,703 @@
+#include "scene/SceneFile.h"
+#include "assets/AssetComponentTypes.h"
+#include "assets/AssetManager.h"
+#include "components/BoundingVolumeComponent.h"
+#include "components/CameraComponent.h"
+#include "components/HierarchyComponent.h"
+#include "components/MaterialComponent.h"
+#include "components/PrefabComponent.h"
+#include "components/RenderableComponent.h"
+#include "components/TransformComponent.h"
+#include "core/Log.h"
+#include "core/MappedFile.h"
+#include "core/Paths.h"
+
+#include <entt/entity/registry.hpp>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+
+namespace RDE::SceneFile {
+    namespace {
+        constexpr char MAGIC[8] = {'R', 'D', 'E', 'S', 'C', 'E', 'N', 'E'};
+        constexpr uint64_t PAYLOAD_ALIGNMENT = 64;
+        constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu; // No entity or no asset
+
+        // Stored as uint32_t, only ever append.
+        enum class SectionType : uint32_t {
+            TransformLocal = 1,
+            Hierarchy,
+            Renderable,
+            Material,
+            CameraProjection,
+            CameraPrimary,
+            BoundsAABB,
+            BoundsSphere,
+            BoundsCapsule,
+            PrefabInstance
+        };
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t num_sections;
+            uint32_t entity_count;
+            uint32_t num_paths;
+            uint32_t string_size;
+            uint32_t reserved;
+            uint64_t file_size;
+        };
+
+        struct SectionEntry {
+            uint32_t type;
+            uint32_t record_size;
+            uint64_t count;
+            uint64_t entities_offset;
+            uint64_t data_offset;
+        };
+
+        struct PathEntry {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        // Entity references are snapshot indices, INVALID_INDEX for entt::null.
+        struct HierarchyRecord {
+            uint32_t parent;
+            uint32_t first_child;
+            uint32_t last_child;
+            uint32_t next_sibling;
+            uint32_t prev_sibling;
+            uint32_t num_children;
+        };
+
+        struct RenderableRecord {
+            uint32_t geometry; // Path id
+            uint32_t visible;
+        };
+
+        // MaterialComponent and PrefabInstance.
+        struct AssetRecord {
+            uint32_t path; // Path id
+        };
+
+        struct CameraRecord {
+            uint32_t orthographic;
+            float values[4]; // fov and aspect ratio, or left, right, bottom and top
+            float near_plane;
+            float far_plane;
+        };
+
+        static_assert(sizeof(Header) == 40 && sizeof(SectionEntry) == 32 && sizeof(PathEntry) == 8);
+
+        // Components stored as they are, read straight out of the mapping. Everything in a snapshot is 4 byte aligned.
+        template<typename T>
+        constexpr bool IsRaw = std::is_same_v<T, TransformLocal> || std::is_same_v<T, BoundingVolumeAABBComponent> ||
+                               std::is_same_v<T, BoundingVolumeSphereComponent> ||
+                               std::is_same_v<T, BoundingVolumeCapsuleComponent>;
+
+        static_assert(std::is_trivially_copyable_v<TransformLocal> && alignof(TransformLocal) <= 4);
+        static_assert(std::is_trivially_copyable_v<BoundingVolumeAABBComponent> &&
+                      alignof(BoundingVolumeAABBComponent) <= 4);
+        static_assert(std::is_trivially_copyable_v<BoundingVolumeSphereComponent> &&
+                      alignof(BoundingVolumeSphereComponent) <= 4);
+        static_assert(std::is_trivially_copyable_v<BoundingVolumeCapsuleComponent> &&
+                      alignof(BoundingVolumeCapsuleComponent) <= 4);
+
+        // Record size of each section type, INVALID_INDEX for unknown types.
+        uint32_t GetRecordSize(uint32_t type) {
+            switch (static_cast<SectionType>(type)) {
+                case SectionType::TransformLocal: return sizeof(TransformLocal);
+                case SectionType::Hierarchy: return sizeof(HierarchyRecord);
+                case SectionType::Renderable: return sizeof(RenderableRecord);
+                case SectionType::Material: return sizeof(AssetRecord);
+                case SectionType::CameraProjection: return sizeof(CameraRecord);
+                case SectionType::CameraPrimary: return 0; // Tag, only the entities
+                case SectionType::BoundsAABB: return sizeof(BoundingVolumeAABBComponent);
+                case SectionType::BoundsSphere: return sizeof(BoundingVolumeSphereComponent);
+                case SectionType::BoundsCapsule: return sizeof(BoundingVolumeCapsuleComponent);
+                case SectionType::PrefabInstance: return sizeof(AssetRecord);
+                default: return INVALID_INDEX;
+            }
+        }
+
+        uint64_t AlignUp(uint64_t value) {
+            return (value + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+        }
+
+        template<typename T>
+        void Reserve(entt::registry &registry, size_t count) {
+            auto &storage = registry.storage<T>();
+            storage.reserve(storage.size() + count);
+        }
+
+        // Converts the records of a section with to_component and inserts them as one array.
+        template<typename T, typename Record, typename ToComponent>
+        void InsertSection(entt::registry &registry, std::span<const entt::entity> entities, const char *data,
+                           ToComponent &&to_component) {
+            const auto *records = reinterpret_cast<const Record *>(data);
+            std::vector<T> components;
+            components.reserve(entities.size());
+            for (size_t i = 0; i < entities.size(); ++i) {
+                components.push_back(to_component(records[i]));
+            }
+            Reserve<T>(registry, entities.size());
+            registry.insert<T>(entities.begin(), entities.end(), components.begin());
+        }
+
+        // Inserts the records straight out of the snapshot data.
+        template<typename T>
+        void InsertRawSection(entt::registry &registry, std::span<const entt::entity> entities, const char *data) {
+            static_assert(IsRaw<T>);
+            Reserve<T>(registry, entities.size());
+            registry.insert<T>(entities.begin(), entities.end(), reinterpret_cast<const T *>(data));
+        }
+
+        CameraRecord ToRecord(const CameraProjectionParameters &projection) {
+            CameraRecord record{};
+            if (const auto *perspective = std::get_if<CameraProjectionParameters::Perspective>(&projection.parameters)) {
+                record.values[0] = perspective->fov_degrees;
+                record.values[1] = perspective->aspect_ratio;
+            } else if (const auto *orthographic =
+                    std::get_if<CameraProjectionParameters::Orthographic>(&projection.parameters)) {
+                record.orthographic = 1;
+                record.values[0] = orthographic->left;
+                record.values[1] = orthographic->right;
+                record.values[2] = orthographic->bottom;
+                record.values[3] = orthographic->top;
+            }
+            record.near_plane = projection.near_plane;
+            record.far_plane = projection.far_plane;
+            return record;
+        }
+
+        CameraProjectionParameters ToProjection(const CameraRecord &record) {
+            CameraProjectionParameters projection;
+            if (record.orthographic) {
+                projection.parameters = CameraProjectionParameters::Orthographic{
+                    record.values[0], record.values[1], record.values[2], record.values[3]
+                };
+            } else {
+                projection.parameters = CameraProjectionParameters::Perspective{record.values[0], record.values[1]};
+            }
+            projection.near_plane = record.near_plane;
+            projection.far_plane = record.far_plane;
+            return projection;
+        }
+
+        struct PendingSection {
+            SectionType type;
+            uint32_t record_size;
+            std::vector<uint32_t> entities;
+            std::vector<char> records;
+        };
+
+        // Assigns snapshot indices and path ids while the sections are collected.
+        class Builder {
+        public:
+            explicit Builder(const entt::registry &registry) : m_registry(registry), m_asset_path(get_asset_path()) {
+            }
+
+            // Restricts the snapshot to entities, references to others are written as null.
+            void include_only(std::span<const entt::entity> entities) {
+                m_filtered = true;
+                for (const entt::entity entity: entities) {
+                    const auto key = static_cast<size_t>(entt::to_entity(entity));
+                    if (key >= m_included.size()) {
+                        m_included.resize(key + 1, false);
+                    }
+                    m_included[key] = true;
+                }
+            }
+
+            [[nodiscard]] bool is_included(entt::entity entity) const {
+                const auto key = static_cast<size_t>(entt::to_entity(entity));
+                return !m_filtered || (key < m_included.size() && m_included[key]);
+            }
+
+            uint32_t index_of(entt::entity entity) {
+                if (entity == entt::null || !is_included(entity)) {
+                    return INVALID_INDEX;
+                }
+                const auto key = static_cast<size_t>(entt::to_entity(entity));
+                if (key >= m_indices.size()) {
+                    m_indices.resize(key + 1, INVALID_INDEX);
+                }
+                if (m_indices[key] == INVALID_INDEX) {
+                    m_indices[key] = m_entity_count++;
+                }
+                return m_indices[key];
+            }
+
+            uint32_t path_id_of(const AssetID &asset_id) {
+                if (!asset_id) {
+                    return INVALID_INDEX;
+                }
+                // Most entities share a few assets, strings are only hashed once per asset.
+                if (auto it = m_asset_ids.find(asset_id.get()); it != m_asset_ids.end()) {
+                    return it->second;
+                }
+                std::string path = asset_id->uri;
+                if (m_asset_path) {
+                    const auto relative = std::filesystem::path(path).lexically_relative(*m_asset_path);
+                    if (!relative.empty() && *relative.begin() != "..") {
+                        path = relative.generic_string();
+                    }
+                }
+                auto [it, inserted] = m_path_ids.try_emplace(path, static_cast<uint32_t>(m_paths.size()));
+                if (inserted) {
+                    m_paths.push_back(std::move(path));
+                }
+                m_asset_ids.emplace(asset_id.get(), it->second);
+                return it->second;
+            }
+
+            // Adds a section with to_record(component) for every entity that has T.
+            template<typename T, typename Record, typename ToRecord>
+            void add(SectionType type, ToRecord &&to_record) {
+                auto view = m_registry.view<const T>();
+                PendingSection section{type, sizeof(Record), {}, {}};
+                for (auto entity: view) {
+                    if (!is_included(entity)) {
+                        continue;
+                    }
+                    section.entities.push_back(index_of(entity));
+                    const Record record = to_record(view.template get<const T>(entity));
+                    const auto *bytes = reinterpret_cast<const char *>(&record);
+                    section.records.insert(section.records.end(), bytes, bytes + sizeof(Record));
+                }
+                if (!section.entities.empty()) {
+                    m_sections.push_back(std::move(section));
+                }
+            }
+
+            template<typename T>
+            void add_raw(SectionType type) {
+                add<T, T>(type, [](const T &component) { return component; });
+            }
+
+            template<typename T>
+            void add_tag(SectionType type) {
+                PendingSection section{type, 0, {}, {}};
+                for (auto entity: m_registry.view<const T>()) {
+                    if (!is_included(entity)) {
+                        continue;
+                    }
+                    section.entities.push_back(index_of(entity));
+                }
+                if (!section.entities.empty()) {
+                    m_sections.push_back(std::move(section));
+                }
+            }
+
+            [[nodiscard]] uint32_t get_entity_count() const { return m_entity_count; }
+
+            [[nodiscard]] const std::vector<std::string> &get_paths() const { return m_paths; }
+
+            [[nodiscard]] const std::vector<PendingSection> &get_sections() const { return m_sections; }
+
+        private:
+            const entt::registry &m_registry;
+            std::optional<std::filesystem::path> m_asset_path;
+            bool m_filtered = false;
+            std::vector<bool> m_included; // By entity index, when filtered
+            std::vector<uint32_t> m_indices; // Snapshot index by entity index
+            uint32_t m_entity_count = 0;
+            std::vector<std::string> m_paths;
+            std::unordered_map<std::string, uint32_t> m_path_ids;
+            std::unordered_map<const AssetID_Data *, uint32_t> m_asset_ids;
+            std::vector<PendingSection> m_sections;
+        };
+    }
+
+    static void Serialize(Builder &builder, std::vector<char> &out) {
+        // -- Collect the sections, TransformLocal first so most entities are numbered in its dense order --
+        builder.add_raw<TransformLocal>(SectionType::TransformLocal);
+        builder.add<Hierarchy, HierarchyRecord>(SectionType::Hierarchy, [&](const Hierarchy &hierarchy) {
+            return HierarchyRecord{
+                builder.index_of(hierarchy.parent), builder.index_of(hierarchy.first_child),
+                builder.index_of(hierarchy.last_child), builder.index_of(hierarchy.next_sibling),
+                builder.index_of(hierarchy.prev_sibling), static_cast<uint32_t>(hierarchy.num_children)
+            };
+        });
+        builder.add<RenderableComponent, RenderableRecord>(SectionType::Renderable, [&](const RenderableComponent &r) {
+            return RenderableRecord{builder.path_id_of(r.geometry_id), r.isVisible ? 1u : 0u};
+        });
+        builder.add<MaterialComponent, AssetRecord>(SectionType::Material, [&](const MaterialComponent &material) {
+            return AssetRecord{builder.path_id_of(material.material_asset_id)};
+        });
+        builder.add<CameraProjectionParameters, CameraRecord>(SectionType::CameraProjection, ToRecord);
+        builder.add_tag<CameraPrimary>(SectionType::CameraPrimary);
+        builder.add_raw<BoundingVolumeAABBComponent>(SectionType::BoundsAABB);
+        builder.add_raw<BoundingVolumeSphereComponent>(SectionType::BoundsSphere);
+        builder.add_raw<BoundingVolumeCapsuleComponent>(SectionType::BoundsCapsule);
+        builder.add<PrefabInstance, AssetRecord>(SectionType::PrefabInstance, [&](const PrefabInstance &instance) {
+            return AssetRecord{builder.path_id_of(instance.prefab_id)};
+        });
+
+        // -- Lay out the tables and payloads --
+        const auto &sections = builder.get_sections();
+        const auto &paths = builder.get_paths();
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.num_sections = static_cast<uint32_t>(sections.size());
+        header.entity_count = builder.get_entity_count();
+        header.num_paths = static_cast<uint32_t>(paths.size());
+
+        std::string strings;
+        std::vector<PathEntry> path_entries;
+        path_entries.reserve(paths.size());
+        for (const std::string &path: paths) {
+            path_entries.push_back({static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(path.size())});
+            strings += path;
+        }
+        header.string_size = static_cast<uint32_t>(strings.size());
+
+        std::vector<SectionEntry> entries;
+        entries.reserve(sections.size());
+        uint64_t offset = sizeof(Header) + sections.size() * sizeof(SectionEntry) +
+                          path_entries.size() * sizeof(PathEntry) + strings.size();
+        for (const PendingSection &section: sections) {
+            SectionEntry entry{};
+            entry.type = static_cast<uint32_t>(section.type);
+            entry.record_size = section.record_size;
+            entry.count = section.entities.size();
+            entry.entities_offset = offset = AlignUp(offset);
+            offset += entry.count * sizeof(uint32_t);
+            entry.data_offset = offset = AlignUp(offset);
+            offset += section.records.size();
+            entries.push_back(entry);
+        }
+        header.file_size = offset;
+
+        // -- Copy everything into place --
+        out.assign(header.file_size, 0);
+        auto put = [&](uint64_t at, const void *data, uint64_t size) {
+            if (size) {
+                std::memcpy(out.data() + at, data, size);
+            }
+        };
+        uint64_t cursor = 0;
+        put(cursor, &header, sizeof(Header));
+        put(cursor += sizeof(Header), entries.data(), entries.size() * sizeof(SectionEntry));
+        put(cursor += entries.size() * sizeof(SectionEntry), path_entries.data(),
+            path_entries.size() * sizeof(PathEntry));
+        put(cursor += path_entries.size() * sizeof(PathEntry), strings.data(), strings.size());
+        for (size_t i = 0; i < sections.size(); ++i) {
+            put(entries[i].entities_offset, sections[i].entities.data(), sections[i].entities.size() * sizeof(uint32_t));
+            put(entries[i].data_offset, sections[i].records.data(), sections[i].records.size());
+        }
+    }
+
+    void Serialize(const entt::registry &registry, std::vector<char> &out) {
+        Builder builder(registry);
+        Serialize(builder, out);
+    }
+
+    void Serialize(const entt::registry &registry, std::span<const entt::entity> entities, std::vector<char> &out) {
+        Builder builder(registry);
+        builder.include_only(entities);
+        Serialize(builder, out);
+    }
+
+    bool Snapshot::open(const char *data, size_t size, std::string *error) {
+        const uint64_t file_size = size;
+        auto fail = [&](std::string reason) {
+            if (error) {
+                *error = std::move(reason);
+            }
+            return false;
+        };
+        m_data = nullptr;
+
+        // -- Validate the header and tables --
+        Header header;
+        if (file_size < sizeof(Header)) {
+            return fail("too small to be a scene file");
+        }
+        std::memcpy(&header, data, sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            return fail("not a scene file");
+        }
+        if (header.version != VERSION) {
+            return fail("version " + std::to_string(header.version) + ", expected " + std::to_string(VERSION));
+        }
+        if (header.file_size != file_size) {
+            return fail("truncated");
+        }
+        if (reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0) {
+            return fail("data is not 4 byte aligned");
+        }
+        const uint64_t sections_offset = sizeof(Header);
+        const uint64_t paths_offset = sections_offset + uint64_t(header.num_sections) * sizeof(SectionEntry);
+        const uint64_t strings_offset = paths_offset + uint64_t(header.num_paths) * sizeof(PathEntry);
+        if (strings_offset + header.string_size > file_size) {
+            return fail("invalid layout");
+        }
+
+        std::vector<std::string> asset_paths(header.num_paths);
+        for (uint32_t i = 0; i < header.num_paths; ++i) {
+            PathEntry entry;
+            std::memcpy(&entry, data + paths_offset + i * sizeof(PathEntry), sizeof(PathEntry));
+            if (uint64_t(entry.offset) + entry.size > header.string_size) {
+                return fail("invalid path entry");
+            }
+            asset_paths[i].assign(data + strings_offset + entry.offset, entry.size);
+        }
+
+        // -- Validate every section, Instantiate relies on all indices being in range and each component being added
+        // to an entity once --
+        // Every entity is in at least one entities array, which bounds the seen set below by the file size.
+        if (header.entity_count > file_size / sizeof(uint32_t)) {
+            return fail("entity count exceeds the file size");
+        }
+        std::vector<bool> seen_entities(header.entity_count, false);
+        std::vector<bool> seen_types;
+        auto check_entity = [&](uint32_t index) { return index < header.entity_count || index == INVALID_INDEX; };
+        auto check_path = [&](uint32_t path) { return path < header.num_paths || path == INVALID_INDEX; };
+        std::vector<Section> sections;
+        sections.reserve(header.num_sections);
+        uint64_t num_records = 0;
+        for (uint32_t i = 0; i < header.num_sections; ++i) {
+            SectionEntry entry;
+            std::memcpy(&entry, data + sections_offset + i * sizeof(SectionEntry), sizeof(SectionEntry));
+            const uint32_t record_size = GetRecordSize(entry.type);
+            if (record_size == INVALID_INDEX || record_size != entry.record_size) {
+                return fail("unknown section " + std::to_string(entry.type));
+            }
+            if (entry.type >= seen_types.size()) {
+                seen_types.resize(entry.type + 1, false);
+            }
+            if (seen_types[entry.type]) {
+                return fail("repeated section " + std::to_string(entry.type));
+            }
+            seen_types[entry.type] = true;
+            if (entry.entities_offset % PAYLOAD_ALIGNMENT != 0 || entry.data_offset % PAYLOAD_ALIGNMENT != 0 ||
+                entry.entities_offset > file_size || entry.data_offset > file_size ||
+                entry.count > (file_size - entry.entities_offset) / sizeof(uint32_t) ||
+                (entry.record_size && entry.count > (file_size - entry.data_offset) / entry.record_size)) {
+                return fail("invalid payload for section " + std::to_string(entry.type));
+            }
+            const Section section{
+                entry.type, entry.record_size, entry.count,
+                reinterpret_cast<const uint32_t *>(data + entry.entities_offset), data + entry.data_offset
+            };
+            for (uint64_t e = 0; e < section.count; ++e) {
+                if (section.entities[e] >= header.entity_count) {
+                    return fail("entity index out of range in section " + std::to_string(entry.type));
+                }
+                if (seen_entities[section.entities[e]]) {
+                    return fail("repeated entity in section " + std::to_string(entry.type));
+                }
+                seen_entities[section.entities[e]] = true;
+            }
+            // Only the marked entries are cleared, so the check costs the section's size rather than the entity count.
+            for (uint64_t e = 0; e < section.count; ++e) {
+                seen_entities[section.entities[e]] = false;
+            }
+
+            bool valid = true;
+            switch (static_cast<SectionType>(entry.type)) {
+                case SectionType::Hierarchy: {
+                    const auto *records = reinterpret_cast<const HierarchyRecord *>(section.records);
+                    for (uint64_t r = 0; r < section.count && valid; ++r) {
+                        valid = check_entity(records[r].parent) && check_entity(records[r].first_child) &&
+                                check_entity(records[r].last_child) && check_entity(records[r].next_sibling) &&
+                                check_entity(records[r].prev_sibling);
+                    }
+                    break;
+                }
+                case SectionType::Renderable: {
+                    const auto *records = reinterpret_cast<const RenderableRecord *>(section.records);
+                    for (uint64_t r = 0; r < section.count && valid; ++r) {
+                        valid = check_path(records[r].geometry);
+                    }
+                    break;
+                }
+                case SectionType::Material:
+                case SectionType::PrefabInstance: {
+                    const auto *records = reinterpret_cast<const AssetRecord *>(section.records);
+                    for (uint64_t r = 0; r < section.count && valid; ++r) {
+                        valid = check_path(records[r].path);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            if (!valid) {
+                return fail("reference out of range in section " + std::to_string(entry.type));
+            }
+            num_records += section.count;
+            sections.push_back(section);
+        }
+        // Every entity is in at least one section, this bounds the allocation in Instantiate by the file size
+        if (header.entity_count > num_records) {
+            return fail("entity count exceeds the records");
+        }
+
+        m_data = data;
+        m_entity_count = header.entity_count;
+        m_asset_paths = std::move(asset_paths);
+        m_sections = std::move(sections);
+        return true;
+    }
+
+    std::vector<entt::entity> Instantiate(const Snapshot &snapshot, entt::registry &registry,
+                                          std::span<const AssetID> assets) {
+        std::vector<entt::entity> entities(snapshot.get_entity_count());
+        Reserve<entt::entity>(registry, entities.size());
+        registry.create(entities.begin(), entities.end());
+
+        auto entity_at = [&](uint32_t index) {
+            return index == INVALID_INDEX ? entt::entity(entt::null) : entities[index];
+        };
+        auto asset_at = [&](uint32_t path) { return path < assets.size() ? assets[path] : AssetID(); };
+        const bool has_primary_camera = !registry.view<CameraPrimary>().empty();
+
+        std::vector<entt::entity> section_entities;
+        for (const Snapshot::Section &section: snapshot.get_sections()) {
+            section_entities.resize(section.count);
+            for (size_t i = 0; i < section.count; ++i) {
+                section_entities[i] = entities[section.entities[i]];
+            }
+            const std::span<const entt::entity> batch = section_entities;
+            const char *records = section.records;
+            switch (static_cast<SectionType>(section.type)) {
+                case SectionType::TransformLocal:
+                    TransformUtils::InsertTransforms(registry, batch, reinterpret_cast<const TransformLocal *>(records));
+                    break;
+                case SectionType::Hierarchy:
+                    InsertSection<Hierarchy, HierarchyRecord>(registry, batch, records, [&](const HierarchyRecord &r) {
+                        return Hierarchy{
+                            entity_at(r.parent), entity_at(r.first_child), entity_at(r.last_child),
+                            entity_at(r.next_sibling), entity_at(r.prev_sibling), r.num_children
+                        };
+                    });
+                    break;
+                case SectionType::Renderable:
+                    InsertSection<RenderableComponent, RenderableRecord>(registry, batch, records,
+                                                                         [&](const RenderableRecord &r) {
+                                                                             return RenderableComponent{
+                                                                                 asset_at(r.geometry), r.visible != 0
+                                                                             };
+                                                                         });
+                    break;
+                case SectionType::Material:
+                    InsertSection<MaterialComponent, AssetRecord>(registry, batch, records, [&](const AssetRecord &r) {
+                        return MaterialComponent{asset_at(r.path), {}, {}};
+                    });
+                    break;
+                case SectionType::CameraProjection:
+                    InsertSection<CameraProjectionParameters, CameraRecord>(registry, batch, records, ToProjection);
+                    break;
+                case SectionType::CameraPrimary:
+                    // There is only one primary camera, the one already in the registry stays.
+                    if (!has_primary_camera && !batch.empty()) {
+                        registry.emplace<CameraPrimary>(batch.front());
+                    }
+                    break;
+                case SectionType::BoundsAABB:
+                    InsertRawSection<BoundingVolumeAABBComponent>(registry, batch, records);
+                    break;
+                case SectionType::BoundsSphere:
+                    InsertRawSection<BoundingVolumeSphereComponent>(registry, batch, records);
+                    break;
+                case SectionType::BoundsCapsule:
+                    InsertRawSection<BoundingVolumeCapsuleComponent>(registry, batch, records);
+                    break;
+                case SectionType::PrefabInstance:
+                    InsertSection<PrefabInstance, AssetRecord>(registry, batch, records, [&](const AssetRecord &r) {
+                        return PrefabInstance{asset_at(r.path)};
+                    });
+                    break;
+            }
+        }
+        return entities;
+    }
+
+    std::string ResolveAssetPath(const std::string &path) {
+        const std::filesystem::path file_path(path);
+        if (file_path.is_relative()) {
+            if (const auto asset_path = get_asset_path()) {
+                return (*asset_path / file_path).string();
+            }
+        }
+        return path;
+    }
+
+    bool WriteData(const std::filesystem::path &path, std::span<const char> data) {
+        // Write to a temporary file and swap it in.
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!out) {
+                RDE_CORE_ERROR("SceneFile::WriteData: Failed to write '{}'", temp_path.string());
+                out.close();
+                std::error_code ec;
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec) {
+            RDE_CORE_ERROR("SceneFile::WriteData: Failed to move '{}' to '{}': {}", temp_path.string(),
+                           path.string(), ec.message());
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool Write(const std::filesystem::path &path, const entt::registry &registry) {
+        std::vector<char> data;
+        Serialize(registry, data);
+        return WriteData(path, data);
+    }
+
+    bool Write(const std::filesystem::path &path, const entt::registry &registry,
+               std::span<const entt::entity> entities) {
+        std::vector<char> data;
+        Serialize(registry, entities, data);
+        return WriteData(path, data);
+    }
+
+    bool Read(const std::filesystem::path &path, entt::registry &registry, AssetManager &asset_manager) {
+        MappedFile file;
+        if (!file.open(path)) {
+            RDE_CORE_ERROR("SceneFile::Read: Failed to map '{}'", path.string());
+            return false;
+        }
+        Snapshot snapshot;
+        std::string error;
+        if (!snapshot.open(file.data(), file.size(), &error)) {
+            RDE_CORE_ERROR("SceneFile::Read: '{}': {}", path.string(), error);
+            return false;
+        }
+
+        // Each referenced asset is loaded once, however many entities use it.
+        std::vector<AssetID> assets;
+        assets.reserve(snapshot.get_asset_paths().size());
+        for (const std::string &asset_path: snapshot.get_asset_paths()) {
+            AssetID asset_id;
+            try {
+                asset_id = asset_manager.load_async(ResolveAssetPath(asset_path)).get();
+            } catch (const std::exception &e) {
+                RDE_CORE_WARN("SceneFile::Read: Failed to load '{}' of '{}': {}", asset_path, path.string(), e.what());
+            }
+            assets.push_back(std::move(asset_id));
+        }
+
+        const auto entities = Instantiate(snapshot, registry, assets);
+        RDE_CORE_INFO("Loaded scene '{}' with {} entities and {} assets", path.string(), entities.size(),
+                      assets.size());
+        return true;
+    }
+}
@@ -0,0 +1,143 @@
+#include "systems/TextureStreamingSystem.h"
+#include "assets/AssetComponentTypes.h"
+#include "components/BoundingVolumeComponent.h"
+#include "components/CameraComponent.h"
+#include "components/MaterialComponent.h"
+#include "components/TransformComponent.h"
+#include "material/MaterialDescription.h"
+#include "scene/SystemDependencyBuilder.h"
+
+#include <entt/entity/registry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace RDE {
+    namespace {
+        struct StreamingRequest {
+            int level;
+            float pixels;
+        };
+
+        bool GetWorldSphere(const entt::registry &registry, entt::entity entity, Sphere &sphere) {
+            if (const auto *bounds = registry.try_get<BoundingVolumeSphereComponent>(entity)) {
+                sphere = bounds->world;
+                return true;
+            }
+            if (const auto *bounds = registry.try_get<BoundingVolumeAABBComponent>(entity)) {
+                sphere.center = (bounds->world.min + bounds->world.max) * 0.5f;
+                sphere.radius = glm::length(bounds->world.max - bounds->world.min) * 0.5f;
+                return true;
+            }
+            return false;
+        }
+
+        // Height in pixels of the sphere's projection. Inside the sphere everything is needed at full detail.
+        float GetProjectedPixels(const Sphere &sphere, const glm::vec3 &camera_position, const glm::mat4 &projection,
+                                 float viewport_height) {
+            const float scale = sphere.radius * projection[1][1] * viewport_height;
+            const bool perspective = projection[3][3] == 0.0f;
+            if (!perspective) {
+                return scale;
+            }
+            const float distance = glm::length(sphere.center - camera_position) - sphere.radius;
+            if (distance <= 0.0f) {
+                return std::numeric_limits<float>::max();
+            }
+            return scale / distance;
+        }
+
+        int GetRequestedLevel(const AssetGpuTexture &texture, float pixels, float lod_bias) {
+            const int coarsest = static_cast<int>(texture.mips.size());
+            if (pixels <= 0.0f) {
+                return coarsest;
+            }
+            const float extent = static_cast<float>(std::max(texture.width, texture.height));
+            const float level = std::floor(std::log2(extent / pixels) + lod_bias);
+            return static_cast<int>(std::clamp(level, 0.0f, static_cast<float>(coarsest)));
+        }
+    }
+
+    TextureStreamingSystem::TextureStreamingSystem(entt::registry &registry, AssetDatabase &asset_database,
+                                                   float viewport_height, float lod_bias)
+        : m_registry(registry), m_asset_database(asset_database), m_viewport_height(viewport_height),
+          m_lod_bias(lod_bias) {
+    }
+
+    void TextureStreamingSystem::init() {
+    }
+
+    void TextureStreamingSystem::shutdown() {
+    }
+
+    void TextureStreamingSystem::update([[maybe_unused]] float delta_time) {
+        const entt::entity camera = CameraUtils::GetCameraEntityPrimary(m_registry);
+        const auto *matrices = camera != entt::null ? m_registry.try_get<CameraMatrices>(camera) : nullptr;
+        if (!matrices) {
+            return;
+        }
+        const glm::vec3 camera_position = glm::vec3(glm::inverse(matrices->view_matrix)[3]);
+
+        auto &asset_registry = m_asset_database.get_registry();
+        std::unordered_map<entt::entity, StreamingRequest> requests;
+        auto request = [&](const AssetID &texture_id, float pixels) {
+            if (!texture_id || !asset_registry.valid(texture_id->entity_id)) {
+                return;
+            }
+            const auto *texture = asset_registry.try_get<AssetGpuTexture>(texture_id->entity_id);
+            if (!texture) {
+                return; // Not loaded yet
+            }
+            const int level = GetRequestedLevel(*texture, pixels, m_lod_bias);
+            auto [it, inserted] = requests.try_emplace(texture_id->entity_id, StreamingRequest{level, pixels});
+            if (!inserted) {
+                it->second.level = std::min(it->second.level, level);
+                it->second.pixels = std::max(it->second.pixels, pixels);
+            }
+        };
+
+        auto view = m_registry.view<TransformWorld, MaterialComponent>();
+        for (auto entity: view) {
+            Sphere sphere;
+            if (!GetWorldSphere(m_registry, entity, sphere)) {
+                continue;
+            }
+            const float pixels = GetProjectedPixels(sphere, camera_position, matrices->projection_matrix,
+                                                    m_viewport_height);
+            const auto &material = view.get<MaterialComponent>(entity);
+            for (const auto &[name, texture_id]: material.texture_bindings) {
+                request(texture_id, pixels);
+            }
+            if (material.is_valid()) {
+                if (const auto *description = asset_registry.try_get<MaterialDescription>(
+                    material.material_asset_id->entity_id)) {
+                    for (const auto &[name, texture_id]: description->textures) {
+                        request(texture_id, pixels);
+                    }
+                }
+            }
+        }
+
+        // Textures no mesh uses this frame keep their last requested level, but at priority 0 they only stream once the
+        // visible ones are done.
+        for (auto texture_entity: asset_registry.view<AssetTextureResidency>()) {
+            asset_registry.get<AssetTextureResidency>(texture_entity).priority = 0.0f;
+        }
+        for (const auto &[texture_entity, texture_request]: requests) {
+            auto &residency = asset_registry.get_or_emplace<AssetTextureResidency>(texture_entity);
+            residency.requested_level = texture_request.level;
+            residency.priority = texture_request.pixels;
+        }
+    }
+
+    void TextureStreamingSystem::declare_dependencies(SystemDependencyBuilder &builder) {
+        builder.reads<TransformWorld>();
+        builder.reads<MaterialComponent>();
+        builder.reads<BoundingVolumeSphereComponent>();
+        builder.reads<BoundingVolumeAABBComponent>();
+        builder.reads<CameraMatrices>();
+        builder.writes<AssetTextureResidency>();
+    }
+}
@@ -7,6 +7,15 @@
 #include <glm/gtx/string_cast.hpp>
 
 namespace RDE::TransformUtils{
+    namespace {
+        // Present in the registry context while the dirty listeners are connected.
+        struct DirtyListenersConnected {};
+
+        void MarkDirty(entt::registry &registry, entt::entity entity_id) {
+            registry.emplace_or_replace<TransformDirty>(entity_id);
+        }
+    }
+
     glm::mat4 GetModelMatrix(const TransformParameters &parameters) {
         glm::mat4 translation = glm::translate(glm::mat4(1.0f), parameters.translation);
         glm::mat4 rotation = glm::mat4_cast(parameters.orientation); // Convert quaternion to rotation matrix
@@ -32,4 +41,31 @@ namespace RDE::TransformUtils{
         }
         registry.emplace_or_replace<TransformDirty>(entity_id);
     }
+
+    void ConnectDirtyListeners(entt::registry &registry) {
+        registry.on_construct<TransformLocal>().connect<&MarkDirty>();
+        registry.on_update<TransformLocal>().connect<&MarkDirty>();
+        registry.ctx().emplace<DirtyListenersConnected>();
+    }
+
+    void DisconnectDirtyListeners(entt::registry &registry) {
+        registry.on_construct<TransformLocal>().disconnect<&MarkDirty>();
+        registry.on_update<TransformLocal>().disconnect<&MarkDirty>();
+        registry.ctx().erase<DirtyListenersConnected>();
+    }
+
+    void InsertTransforms(entt::registry &registry, std::span<const entt::entity> entities,
+                          const TransformParameters *transforms) {
+        // The whole batch is tagged by one insert, so the construction listener would only patch every tag again. It is
+        // disconnected for the batch, the context flag tells whether a TransformSystem had it connected.
+        const bool listening = registry.ctx().contains<DirtyListenersConnected>();
+        if (listening) {
+            registry.on_construct<TransformLocal>().disconnect<&MarkDirty>();
+        }
+        registry.insert<TransformDirty>(entities.begin(), entities.end());
+        registry.insert<TransformLocal>(entities.begin(), entities.end(), transforms);
+        if (listening) {
+            registry.on_construct<TransformLocal>().connect<&MarkDirty>();
+        }
+    }
 }
\ No newline at end of file
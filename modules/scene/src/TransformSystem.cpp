@@ -9,24 +9,18 @@
 #include <stack>
 
 namespace RDE {
-    namespace Detail {
-        inline void set_dirty_on_change(entt::registry &registry, entt::entity entity_id) {
-            registry.emplace_or_replace<TransformDirty>(entity_id);
-        }
-    }
-
     TransformSystem::TransformSystem(entt::registry &registry) : m_registry(registry) {
 
     }
 
     void TransformSystem::init() {
         // Initialize the Transform system by ensuring the necessary components are present
-        m_registry.on_construct<TransformLocal>().connect<&Detail::set_dirty_on_change>();
-        m_registry.on_update<TransformLocal>().connect<&Detail::set_dirty_on_change>();
+        TransformUtils::ConnectDirtyListeners(m_registry);
     }
 
     void TransformSystem::shutdown() {
         // Cleanup if necessary, currently nothing to do
+        TransformUtils::DisconnectDirtyListeners(m_registry);
         m_registry.clear<TransformLocal>();
         m_registry.clear<TransformWorld>();
         m_registry.clear<TransformDirty>();
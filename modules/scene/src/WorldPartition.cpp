@@ -0,0 +1,160 @@
+#include "scene/WorldPartition.h"
+#include "scene/SceneFile.h"
+#include "components/CameraComponent.h"
+#include "components/HierarchyComponent.h"
+#include "components/TransformComponent.h"
+#include "core/Log.h"
+
+#include <entt/entity/registry.hpp>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace RDE::WorldPartition {
+    namespace {
+        constexpr char MAGIC[8] = {'R', 'D', 'E', 'W', 'O', 'R', 'L', 'D'};
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t num_cells;
+            float cell_size;
+            uint32_t reserved;
+        };
+
+        static_assert(sizeof(Header) == 24);
+        static_assert(sizeof(Cell) == 12);
+
+        glm::vec3 GetPosition(const entt::registry &registry, entt::entity entity) {
+            if (const auto *world = registry.try_get<TransformWorld>(entity)) {
+                return glm::vec3(world->matrix[3]);
+            }
+            return registry.get<TransformLocal>(entity).translation;
+        }
+
+        // Appends entity and all of its descendants.
+        void CollectSubtree(const entt::registry &registry, entt::entity root, std::vector<entt::entity> &out) {
+            std::vector<entt::entity> stack{root};
+            while (!stack.empty()) {
+                const entt::entity entity = stack.back();
+                stack.pop_back();
+                out.push_back(entity);
+                if (const auto *hierarchy = registry.try_get<Hierarchy>(entity)) {
+                    for (auto child = hierarchy->first_child; child != entt::null;
+                         child = registry.get<Hierarchy>(child).next_sibling) {
+                        stack.push_back(child);
+                    }
+                }
+            }
+        }
+    }
+
+    std::filesystem::path GetCellPath(const std::filesystem::path &directory, const Cell &cell) {
+        return directory / ("cell_" + std::to_string(cell.x) + "_" + std::to_string(cell.z) + SceneFile::EXTENSION);
+    }
+
+    float GetDistance(const Index &index, const Cell &cell, const glm::vec3 &position) {
+        const glm::vec2 min = glm::vec2(static_cast<float>(cell.x), static_cast<float>(cell.z)) * index.cell_size;
+        const glm::vec2 point(position.x, position.z);
+        const glm::vec2 closest = glm::clamp(point, min, min + glm::vec2(index.cell_size));
+        return glm::length(point - closest);
+    }
+
+    bool Write(const std::filesystem::path &directory, const entt::registry &registry, float cell_size) {
+        if (!(cell_size > 0.0f)) {
+            RDE_CORE_ERROR("WorldPartition::Write: Invalid cell size {}", cell_size);
+            return false;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec) {
+            RDE_CORE_ERROR("WorldPartition::Write: Failed to create '{}': {}", directory.string(), ec.message());
+            return false;
+        }
+
+        // -- Assign every top level entity with its subtree to a cell --
+        std::map<std::pair<int32_t, int32_t>, std::vector<entt::entity> > cells;
+        for (auto entity: registry.view<const TransformLocal>()) {
+            const auto *hierarchy = registry.try_get<Hierarchy>(entity);
+            if ((hierarchy && hierarchy->parent != entt::null) || registry.all_of<CameraPrimary>(entity)) {
+                continue;
+            }
+            const glm::vec3 position = GetPosition(registry, entity);
+            const auto x = static_cast<int32_t>(std::floor(position.x / cell_size));
+            const auto z = static_cast<int32_t>(std::floor(position.z / cell_size));
+            CollectSubtree(registry, entity, cells[{x, z}]);
+        }
+
+        // -- One snapshot per cell, the index last so a failed write leaves the previous world readable --
+        Index index;
+        index.cell_size = cell_size;
+        for (const auto &[key, entities]: cells) {
+            const Cell cell{key.first, key.second, static_cast<uint32_t>(entities.size())};
+            if (!SceneFile::Write(GetCellPath(directory, cell), registry, entities)) {
+                return false;
+            }
+            index.cells.push_back(cell);
+        }
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.num_cells = static_cast<uint32_t>(index.cells.size());
+        header.cell_size = cell_size;
+        std::vector<char> data(sizeof(Header) + index.cells.size() * sizeof(Cell));
+        std::memcpy(data.data(), &header, sizeof(Header));
+        if (!index.cells.empty()) {
+            std::memcpy(data.data() + sizeof(Header), index.cells.data(), index.cells.size() * sizeof(Cell));
+        }
+        if (!SceneFile::WriteData(directory / INDEX_FILE, data)) {
+            return false;
+        }
+        RDE_CORE_INFO("Wrote world '{}' with {} cells of {}", directory.string(), index.cells.size(), cell_size);
+        return true;
+    }
+
+    bool ReadIndex(const std::filesystem::path &directory, Index &index) {
+        const std::filesystem::path index_path = directory / INDEX_FILE;
+        std::ifstream in(index_path, std::ios::binary);
+        if (!in) {
+            RDE_CORE_ERROR("WorldPartition::ReadIndex: Failed to open '{}'", index_path.string());
+            return false;
+        }
+        Header header{};
+        in.read(reinterpret_cast<char *>(&header), sizeof(Header));
+        if (!in || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            RDE_CORE_ERROR("WorldPartition::ReadIndex: '{}' is not a world index", index_path.string());
+            return false;
+        }
+        if (header.version != VERSION) {
+            RDE_CORE_ERROR("WorldPartition::ReadIndex: '{}' has version {}, expected {}", index_path.string(),
+                           header.version, VERSION);
+            return false;
+        }
+        if (!(header.cell_size > 0.0f)) {
+            RDE_CORE_ERROR("WorldPartition::ReadIndex: '{}' has an invalid cell size", index_path.string());
+            return false;
+        }
+
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(index_path, ec);
+        if (ec || file_size != sizeof(Header) + uint64_t(header.num_cells) * sizeof(Cell)) {
+            RDE_CORE_ERROR("WorldPartition::ReadIndex: '{}' is truncated", index_path.string());
+            return false;
+        }
+        Index result;
+        result.cell_size = header.cell_size;
+        result.cells.resize(header.num_cells);
+        in.read(reinterpret_cast<char *>(result.cells.data()),
+                static_cast<std::streamsize>(result.cells.size() * sizeof(Cell)));
+        if (!in) {
+            RDE_CORE_ERROR("WorldPartition::ReadIndex: Failed to read '{}'", index_path.string());
+            return false;
+        }
+        index = std::move(result);
+        return true;
+    }
+}
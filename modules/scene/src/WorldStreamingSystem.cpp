@@ -0,0 +1,221 @@
+#include "systems/WorldStreamingSystem.h"
+#include "assets/AssetManager.h"
+#include "components/BoundingVolumeComponent.h"
+#include "components/CameraComponent.h"
+#include "components/HierarchyComponent.h"
+#include "components/MaterialComponent.h"
+#include "components/PrefabComponent.h"
+#include "components/RenderableComponent.h"
+#include "components/TransformComponent.h"
+#include "core/Log.h"
+#include "scene/SystemDependencyBuilder.h"
+
+#include <entt/entity/registry.hpp>
+
+#include <algorithm>
+
+namespace RDE {
+    namespace {
+        constexpr size_t PAGE_SIZE = 4096;
+    }
+
+    WorldStreamingSystem::WorldStreamingSystem(entt::registry &registry, AssetManager &asset_manager,
+                                               std::filesystem::path directory,
+                                               const WorldStreamingSettings &settings)
+        : m_registry(registry), m_asset_manager(asset_manager), m_directory(std::move(directory)),
+          m_settings(settings) {
+        if (m_settings.unload_radius < m_settings.load_radius) {
+            RDE_CORE_WARN("WorldStreamingSystem: Unload radius {} is less than the load radius {}, using the latter.",
+                          m_settings.unload_radius, m_settings.load_radius);
+            m_settings.unload_radius = m_settings.load_radius;
+        }
+    }
+
+    WorldStreamingSystem::~WorldStreamingSystem() {
+        shutdown();
+    }
+
+    void WorldStreamingSystem::init() {
+        if (!WorldPartition::ReadIndex(m_directory, m_index)) {
+            return;
+        }
+        m_cells.resize(m_index.cells.size());
+        for (size_t i = 0; i < m_cells.size(); ++i) {
+            m_cells[i].cell = m_index.cells[i];
+        }
+        RDE_CORE_INFO("WorldStreamingSystem: Streaming {} cells from '{}'", m_cells.size(), m_directory.string());
+    }
+
+    void WorldStreamingSystem::shutdown() {
+        // The registry is cleared with the scene, only the reads and mappings are dropped here.
+        for (auto &cell: m_cells) {
+            if (cell.read.valid()) {
+                cell.read.wait();
+            }
+        }
+        m_cells.clear();
+    }
+
+    void WorldStreamingSystem::update([[maybe_unused]] float delta_time) {
+        const entt::entity camera = CameraUtils::GetCameraEntityPrimary(m_registry);
+        const auto *transform = camera != entt::null ? m_registry.try_get<TransformWorld>(camera) : nullptr;
+        if (!transform || m_cells.empty()) {
+            return;
+        }
+        const glm::vec3 position(transform->matrix[3]);
+
+        // -- Nearest cells first for every step below --
+        std::vector<StreamedCell *> cells;
+        cells.reserve(m_cells.size());
+        for (auto &cell: m_cells) {
+            cell.distance = WorldPartition::GetDistance(m_index, cell.cell, position);
+            cells.push_back(&cell);
+        }
+        std::sort(cells.begin(), cells.end(), [](const StreamedCell *a, const StreamedCell *b) {
+            return a->distance < b->distance;
+        });
+
+        size_t num_reading = 0;
+        for (StreamedCell *cell: cells) {
+            if (cell->state != CellState::Reading) {
+                continue;
+            }
+            if (cell->read.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++num_reading;
+                continue;
+            }
+            cell->data = cell->read.get();
+            // A broken cell is not read again, it would fail every frame.
+            cell->state = cell->data ? CellState::Prefetching : CellState::Failed;
+        }
+
+        // -- Unload beyond the unload radius, cells still being read are dropped once they finish --
+        for (StreamedCell *cell: cells) {
+            if (cell->distance <= m_settings.unload_radius) {
+                continue;
+            }
+            if (cell->state == CellState::Loaded) {
+                unload(*cell);
+            } else if (cell->state == CellState::Prefetching || cell->state == CellState::Ready) {
+                cell->data.reset();
+                cell->state = CellState::Unloaded;
+            }
+        }
+
+        // -- Start reads within the load radius --
+        for (StreamedCell *cell: cells) {
+            if (cell->distance > m_settings.load_radius || num_reading >= m_settings.max_reading_cells) {
+                break;
+            }
+            if (cell->state == CellState::Unloaded) {
+                cell->read = std::async(std::launch::async, ReadCell,
+                                        WorldPartition::GetCellPath(m_directory, cell->cell));
+                cell->state = CellState::Reading;
+                ++num_reading;
+            }
+        }
+
+        // -- Load the assets of read cells --
+        size_t asset_budget = m_settings.asset_loads_per_frame;
+        for (StreamedCell *cell: cells) {
+            if (cell->state == CellState::Prefetching && prefetch(*cell->data, asset_budget)) {
+                cell->state = CellState::Ready;
+            }
+        }
+
+        // -- Merge within the entity budget --
+        size_t num_merged = 0;
+        for (StreamedCell *cell: cells) {
+            if (cell->state != CellState::Ready) {
+                continue;
+            }
+            const size_t count = cell->data->snapshot.get_entity_count();
+            if (num_merged > 0 && num_merged + count > m_settings.entities_per_frame) {
+                break;
+            }
+            merge(*cell);
+            num_merged += count;
+        }
+    }
+
+    void WorldStreamingSystem::declare_dependencies(SystemDependencyBuilder &builder) {
+        builder.reads<TransformWorld>();
+        builder.reads<CameraPrimary>();
+        builder.writes<TransformLocal>();
+        builder.writes<TransformDirty>();
+        builder.writes<Hierarchy>();
+        builder.writes<RenderableComponent>();
+        builder.writes<MaterialComponent>();
+        builder.writes<BoundingVolumeAABBComponent>();
+        builder.writes<BoundingVolumeSphereComponent>();
+        builder.writes<BoundingVolumeCapsuleComponent>();
+        builder.writes<BoundingVolumeDirty>();
+        builder.writes<CameraProjectionParameters>();
+        builder.writes<CameraPrimary>();
+        builder.writes<PrefabInstance>();
+    }
+
+    size_t WorldStreamingSystem::get_loaded_cell_count() const {
+        return static_cast<size_t>(std::count_if(m_cells.begin(), m_cells.end(), [](const StreamedCell &cell) {
+            return cell.state == CellState::Loaded;
+        }));
+    }
+
+    std::unique_ptr<WorldStreamingSystem::CellData> WorldStreamingSystem::ReadCell(const std::filesystem::path &path) {
+        auto data = std::make_unique<CellData>();
+        if (!data->file.open(path)) {
+            RDE_CORE_ERROR("WorldStreamingSystem: Failed to map '{}'", path.string());
+            return nullptr;
+        }
+        std::string error;
+        if (!data->snapshot.open(data->file.data(), data->file.size(), &error)) {
+            RDE_CORE_ERROR("WorldStreamingSystem: '{}': {}", path.string(), error);
+            return nullptr;
+        }
+        // Fault the whole mapping in here, so the merge on the main thread doesn't wait on the disk.
+        for (size_t offset = 0; offset < data->file.size(); offset += PAGE_SIZE) {
+            static_cast<void>(*static_cast<const volatile char *>(data->file.data() + offset));
+        }
+        for (const std::string &asset_path: data->snapshot.get_asset_paths()) {
+            data->asset_paths.push_back(SceneFile::ResolveAssetPath(asset_path));
+        }
+        data->assets.resize(data->asset_paths.size());
+        return data;
+    }
+
+    bool WorldStreamingSystem::prefetch(CellData &data, size_t &asset_budget) {
+        while (data.num_resolved < data.asset_paths.size()) {
+            const std::string &path = data.asset_paths[data.num_resolved];
+            AssetID asset_id = m_asset_manager.get_loaded_asset(path);
+            if (!asset_id) {
+                if (asset_budget == 0) {
+                    return false;
+                }
+                --asset_budget;
+                try {
+                    asset_id = m_asset_manager.load_async(path).get();
+                } catch (const std::exception &e) {
+                    RDE_CORE_WARN("WorldStreamingSystem: Failed to load '{}': {}", path, e.what());
+                }
+            }
+            data.assets[data.num_resolved++] = std::move(asset_id);
+        }
+        return true;
+    }
+
+    void WorldStreamingSystem::merge(StreamedCell &cell) {
+        cell.entities = SceneFile::Instantiate(cell.data->snapshot, m_registry, cell.data->assets);
+        // The components hold their own references to the assets, the mapping is not needed anymore.
+        cell.data.reset();
+        cell.state = CellState::Loaded;
+    }
+
+    void WorldStreamingSystem::unload(StreamedCell &cell) {
+        // Cells own whole hierarchies, so no links into other cells are left behind. Entities destroyed by someone
+        // else in the meantime are skipped.
+        std::erase_if(cell.entities, [this](entt::entity entity) { return !m_registry.valid(entity); });
+        m_registry.destroy(cell.entities.begin(), cell.entities.end());
+        cell.entities.clear();
+        cell.state = CellState::Unloaded;
+    }
+}
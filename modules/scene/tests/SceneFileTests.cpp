@@ -0,0 +1,259 @@
+#include "scene/SceneFile.h"
+#include "components/BoundingVolumeComponent.h"
+#include "components/CameraComponent.h"
+#include "components/HierarchyComponent.h"
+#include "components/MaterialComponent.h"
+#include "components/PrefabComponent.h"
+#include "components/RenderableComponent.h"
+#include "components/TransformComponent.h"
+#include "core/Log.h"
+
+#include <entt/entity/registry.hpp>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace RDE;
+
+// Snapshot::open must reject corrupt files before Instantiate inserts anything: a component inserted twice into one
+// entity asserts in entt. Offsets follow the layout in SceneFile.cpp: a 40 byte header, then 32 byte section entries
+// {type, record_size, count, entities_offset, data_offset}.
+namespace {
+    constexpr size_t HEADER_SIZE = 40;
+    constexpr size_t SECTION_ENTRY_SIZE = 32;
+    constexpr uint32_t SECTION_TRANSFORM_LOCAL = 1;
+    constexpr uint32_t SECTION_MATERIAL = 4;
+    constexpr uint32_t SECTION_PREFAB_INSTANCE = 10;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++g_failures;
+        }
+    }
+
+    uint32_t ReadU32(const std::vector<char> &data, size_t offset) {
+        uint32_t value;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        return value;
+    }
+
+    // Offset of the section entry of type, or 0 if there is none.
+    size_t FindSection(const std::vector<char> &data, uint32_t type) {
+        const uint32_t num_sections = ReadU32(data, 12);
+        for (uint32_t i = 0; i < num_sections; ++i) {
+            const size_t entry = HEADER_SIZE + i * SECTION_ENTRY_SIZE;
+            if (ReadU32(data, entry) == type) {
+                return entry;
+            }
+        }
+        return 0;
+    }
+
+    std::vector<char> MakeSnapshot() {
+        entt::registry registry;
+        for (int i = 0; i < 3; ++i) {
+            const entt::entity entity = registry.create();
+            registry.emplace<TransformLocal>(entity);
+            registry.emplace<MaterialComponent>(entity);
+            registry.emplace<PrefabInstance>(entity);
+        }
+        std::vector<char> data;
+        SceneFile::Serialize(registry, data);
+        return data;
+    }
+
+    // Copied into uint32_t storage, Snapshot::open needs 4 byte aligned data.
+    bool Open(const std::vector<char> &data, std::string &error) {
+        std::vector<uint32_t> aligned((data.size() + 3) / 4);
+        std::memcpy(aligned.data(), data.data(), data.size());
+        SceneFile::Snapshot snapshot;
+        return snapshot.open(reinterpret_cast<const char *>(aligned.data()), data.size(), &error);
+    }
+
+    template<typename T>
+    size_t Count(const entt::registry &registry) {
+        size_t count = 0;
+        for ([[maybe_unused]] auto entity: registry.view<const T>()) {
+            ++count;
+        }
+        return count;
+    }
+
+    template<typename T>
+    bool SameBytes(const T &a, const T &b) {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    }
+
+    // Same asset path, or both without an asset.
+    bool SamePath(const AssetID &a, const AssetID &b) {
+        return a && b ? a->uri == b->uri : !a && !b;
+    }
+
+    // A scene with every stored component goes through Serialize, Snapshot::open and Instantiate into a fresh registry.
+    // Entities are told apart by their translation, every one has a different x.
+    void TestRoundTrip() {
+        entt::registry registry;
+        const AssetID mesh = std::make_shared<AssetID_Data>(entt::null, "/scene_file_tests/box.obj");
+        const AssetID material = std::make_shared<AssetID_Data>(entt::null, "/scene_file_tests/box.mat");
+        const AssetID prefab = std::make_shared<AssetID_Data>(entt::null, "/scene_file_tests/crate.prefab");
+
+        std::vector<entt::entity> entities(5);
+        registry.create(entities.begin(), entities.end());
+        for (size_t i = 0; i < entities.size(); ++i) {
+            TransformLocal transform;
+            transform.translation = {static_cast<float>(i), 2.0f, 3.0f};
+            transform.scale = {1.0f, 2.0f, static_cast<float>(i + 1)};
+            registry.emplace<TransformLocal>(entities[i], transform);
+        }
+        const entt::entity root = entities[0], left = entities[1], right = entities[2], leaf = entities[3];
+        const entt::entity camera = entities[4];
+        HierarchyUtils::SetParent(registry, left, root);
+        HierarchyUtils::SetParent(registry, right, root);
+        HierarchyUtils::SetParent(registry, leaf, right);
+        registry.emplace<RenderableComponent>(left, RenderableComponent{mesh, true});
+        registry.emplace<RenderableComponent>(leaf, RenderableComponent{mesh, false});
+        registry.emplace<MaterialComponent>(left, MaterialComponent{material, {}, {}});
+        registry.emplace<MaterialComponent>(leaf, MaterialComponent{material, {}, {}});
+        registry.emplace<PrefabInstance>(root, PrefabInstance{prefab});
+        BoundingVolumeAABBComponent aabb;
+        aabb.local = {glm::vec3(-1.0f), glm::vec3(1.0f)};
+        aabb.world = {glm::vec3(-2.0f), glm::vec3(4.0f)};
+        registry.emplace<BoundingVolumeAABBComponent>(left, aabb);
+        BoundingVolumeSphereComponent sphere;
+        sphere.local = {glm::vec3(0.5f), 1.5f};
+        sphere.world = {glm::vec3(1.5f), 3.0f};
+        registry.emplace<BoundingVolumeSphereComponent>(leaf, sphere);
+        CameraProjectionParameters projection;
+        projection.parameters = CameraProjectionParameters::Orthographic{-4.0f, 4.0f, -3.0f, 3.0f};
+        projection.near_plane = 0.5f;
+        projection.far_plane = 50.0f;
+        registry.emplace<CameraProjectionParameters>(camera, projection);
+        registry.emplace<CameraPrimary>(camera);
+
+        std::vector<char> data;
+        SceneFile::Serialize(registry, data);
+        std::vector<uint32_t> aligned((data.size() + 3) / 4);
+        std::memcpy(aligned.data(), data.data(), data.size());
+        SceneFile::Snapshot snapshot;
+        std::string error;
+        Check(snapshot.open(reinterpret_cast<const char *>(aligned.data()), data.size(), &error),
+              "the round-trip snapshot opens");
+        Check(snapshot.get_entity_count() == entities.size(), "every entity is stored");
+        Check(snapshot.get_asset_paths().size() == 3, "each asset path is stored once");
+
+        std::vector<AssetID> assets;
+        for (const std::string &path: snapshot.get_asset_paths()) {
+            assets.push_back(std::make_shared<AssetID_Data>(entt::null, path));
+        }
+        entt::registry loaded;
+        const std::vector<entt::entity> created = SceneFile::Instantiate(snapshot, loaded, assets);
+        Check(created.size() == entities.size(), "every entity is created");
+
+        std::unordered_map<entt::entity, entt::entity> mapping;
+        for (const entt::entity entity: created) {
+            const auto *transform = loaded.try_get<TransformLocal>(entity);
+            if (transform) {
+                mapping[entities[static_cast<size_t>(transform->translation.x)]] = entity;
+            }
+        }
+        Check(mapping.size() == entities.size(), "every entity has its own transform");
+        if (mapping.size() != entities.size()) {
+            return;
+        }
+        auto mapped = [&](entt::entity entity) { return entity == entt::null ? entity : mapping.at(entity); };
+
+        bool transforms = true, hierarchies = true, renderables = true, materials = true;
+        for (const entt::entity entity: entities) {
+            const entt::entity copy = mapping.at(entity);
+            transforms &= SameBytes(registry.get<TransformLocal>(entity), loaded.get<TransformLocal>(copy)) &&
+                    loaded.all_of<TransformDirty>(copy);
+            if (const auto *hierarchy = registry.try_get<Hierarchy>(entity)) {
+                const auto *other = loaded.try_get<Hierarchy>(copy);
+                hierarchies &= other && other->parent == mapped(hierarchy->parent) &&
+                        other->first_child == mapped(hierarchy->first_child) &&
+                        other->last_child == mapped(hierarchy->last_child) &&
+                        other->next_sibling == mapped(hierarchy->next_sibling) &&
+                        other->prev_sibling == mapped(hierarchy->prev_sibling) &&
+                        other->num_children == hierarchy->num_children;
+            }
+            if (const auto *renderable = registry.try_get<RenderableComponent>(entity)) {
+                const auto *other = loaded.try_get<RenderableComponent>(copy);
+                renderables &= other && SamePath(other->geometry_id, renderable->geometry_id) &&
+                        other->isVisible == renderable->isVisible;
+            }
+            if (const auto *component = registry.try_get<MaterialComponent>(entity)) {
+                const auto *other = loaded.try_get<MaterialComponent>(copy);
+                materials &= other && SamePath(other->material_asset_id, component->material_asset_id);
+            }
+        }
+        Check(transforms, "transforms are restored and dirty");
+        Check(hierarchies, "hierarchy links point at the new entities");
+        Check(renderables, "renderables keep their mesh and visibility");
+        Check(materials, "materials keep their asset");
+        Check(Count<Hierarchy>(loaded) == Count<Hierarchy>(registry) &&
+              Count<RenderableComponent>(loaded) == 2 && Count<MaterialComponent>(loaded) == 2,
+              "no components are added");
+        Check(loaded.get<RenderableComponent>(mapping.at(left)).geometry_id ==
+              loaded.get<RenderableComponent>(mapping.at(leaf)).geometry_id, "a shared asset has one path id");
+
+        const auto *loaded_prefab = loaded.try_get<PrefabInstance>(mapping.at(root));
+        Check(loaded_prefab && SamePath(loaded_prefab->prefab_id, prefab), "the prefab instance keeps its prefab");
+        const auto *loaded_aabb = loaded.try_get<BoundingVolumeAABBComponent>(mapping.at(left));
+        Check(loaded_aabb && SameBytes(*loaded_aabb, aabb), "the AABB is restored");
+        const auto *loaded_sphere = loaded.try_get<BoundingVolumeSphereComponent>(mapping.at(leaf));
+        Check(loaded_sphere && SameBytes(*loaded_sphere, sphere), "the bounding sphere is restored");
+
+        const auto *loaded_projection = loaded.try_get<CameraProjectionParameters>(mapping.at(camera));
+        const auto *orthographic = loaded_projection
+                                       ? std::get_if<CameraProjectionParameters::Orthographic>(
+                                           &loaded_projection->parameters)
+                                       : nullptr;
+        Check(orthographic && orthographic->left == -4.0f && orthographic->right == 4.0f &&
+              orthographic->bottom == -3.0f && orthographic->top == 3.0f && loaded_projection->near_plane == 0.5f &&
+              loaded_projection->far_plane == 50.0f, "the camera projection is restored");
+        Check(loaded.all_of<CameraPrimary>(mapping.at(camera)) && Count<CameraPrimary>(loaded) == 1,
+              "the camera is primary");
+    }
+}
+
+int main() {
+    Log::Initialize();
+    const std::vector<char> valid = MakeSnapshot();
+    std::string error;
+    Check(Open(valid, error), "a valid snapshot opens");
+
+    {
+        // The second entity of the transforms is the first one again.
+        std::vector<char> data = valid;
+        const size_t entry = FindSection(data, SECTION_TRANSFORM_LOCAL);
+        Check(entry != 0, "the snapshot has a TransformLocal section");
+        uint64_t entities_offset;
+        std::memcpy(&entities_offset, data.data() + entry + 16, sizeof(entities_offset));
+        std::memcpy(data.data() + entities_offset + sizeof(uint32_t), data.data() + entities_offset,
+                    sizeof(uint32_t));
+        Check(!Open(data, error), "a repeated entity in a section is rejected");
+        Check(error.find("repeated entity") != std::string::npos, "the error names the repeated entity");
+    }
+    {
+        // PrefabInstance has the record size of Material, so only the repeated type is wrong.
+        std::vector<char> data = valid;
+        const size_t entry = FindSection(data, SECTION_PREFAB_INSTANCE);
+        Check(entry != 0 && FindSection(data, SECTION_MATERIAL) != 0, "the snapshot has both asset sections");
+        std::memcpy(data.data() + entry, &SECTION_MATERIAL, sizeof(uint32_t));
+        Check(!Open(data, error), "a repeated section type is rejected");
+        Check(error.find("repeated section") != std::string::npos, "the error names the repeated section");
+    }
+
+    TestRoundTrip();
+
+    if (g_failures == 0) {
+        std::printf("SceneFileTests passed\n");
+    }
+    return g_failures == 0 ? 0 : 1;
+}
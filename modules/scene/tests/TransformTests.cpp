@@ -0,0 +1,89 @@
+#include "components/TransformComponent.h"
+#include "core/Log.h"
+
+#include <entt/entity/registry.hpp>
+#include <cstdio>
+#include <vector>
+
+using namespace RDE;
+
+// InsertTransforms tags a batch with one insert<TransformDirty>. The dirty listener must not patch the tags entity by
+// entity on top of it, while other TransformLocal construction listeners still see every entity.
+namespace {
+    constexpr size_t BATCH_SIZE = 1000;
+
+    int g_failures = 0;
+    size_t g_dirty_constructs = 0;
+    size_t g_dirty_updates = 0;
+    size_t g_local_constructs = 0;
+
+    void Check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++g_failures;
+        }
+    }
+
+    void CountDirtyConstruct(entt::registry &, entt::entity) { ++g_dirty_constructs; }
+
+    void CountDirtyUpdate(entt::registry &, entt::entity) { ++g_dirty_updates; }
+
+    void CountLocalConstruct(entt::registry &, entt::entity) { ++g_local_constructs; }
+
+    void ResetCounts() {
+        g_dirty_constructs = 0;
+        g_dirty_updates = 0;
+        g_local_constructs = 0;
+    }
+}
+
+int main() {
+    Log::Initialize();
+    entt::registry registry;
+    TransformUtils::ConnectDirtyListeners(registry);
+    registry.on_construct<TransformDirty>().connect<&CountDirtyConstruct>();
+    registry.on_update<TransformDirty>().connect<&CountDirtyUpdate>();
+    registry.on_construct<TransformLocal>().connect<&CountLocalConstruct>();
+
+    std::vector<entt::entity> entities(BATCH_SIZE);
+    registry.create(entities.begin(), entities.end());
+    std::vector<TransformLocal> transforms(BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        transforms[i].translation = {static_cast<float>(i), 0.0f, 0.0f};
+    }
+    TransformUtils::InsertTransforms(registry, entities, transforms.data());
+
+    Check(g_dirty_constructs == BATCH_SIZE, "the batch is tagged once per entity");
+    Check(g_dirty_updates == 0, "the dirty listener does not patch the batch");
+    Check(g_local_constructs == BATCH_SIZE, "other construction listeners see every entity");
+    bool all_inserted = true;
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        const auto *local = registry.try_get<TransformLocal>(entities[i]);
+        all_inserted &= local && local->translation.x == static_cast<float>(i) &&
+                        registry.all_of<TransformDirty>(entities[i]);
+    }
+    Check(all_inserted, "every entity has its transform and is dirty");
+
+    // The dirty listener is connected again after the batch.
+    ResetCounts();
+    const entt::entity single = registry.create();
+    registry.emplace<TransformLocal>(single);
+    Check(registry.all_of<TransformDirty>(single), "a single emplace is marked dirty");
+    Check(g_dirty_constructs == 1 && g_local_constructs == 1, "a single emplace fires one construction each");
+
+    // Without the dirty listeners the batch is tagged all the same, and InsertTransforms leaves them disconnected.
+    TransformUtils::DisconnectDirtyListeners(registry);
+    ResetCounts();
+    std::vector<entt::entity> unobserved(BATCH_SIZE);
+    registry.create(unobserved.begin(), unobserved.end());
+    TransformUtils::InsertTransforms(registry, unobserved, transforms.data());
+    Check(g_dirty_constructs == BATCH_SIZE && g_dirty_updates == 0, "the batch is tagged without a listener");
+    const entt::entity untracked = registry.create();
+    registry.emplace<TransformLocal>(untracked);
+    Check(!registry.all_of<TransformDirty>(untracked), "the dirty listener stays disconnected");
+
+    if (g_failures == 0) {
+        std::printf("TransformTests passed\n");
+    }
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include "scene/WorldPartition.h"
+#include "scene/SceneFile.h"
+#include "components/CameraComponent.h"
+#include "components/HierarchyComponent.h"
+#include "components/TransformComponent.h"
+#include "core/Log.h"
+
+#include <entt/entity/registry.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+using namespace RDE;
+
+// WorldPartition::Write puts every top level entity into the cell of its position together with its whole subtree,
+// and the filtered SceneFile::Serialize it writes the cells with drops references to entities outside of the cell.
+// Entities are told apart by their translation's y, every one has a different one.
+namespace {
+    constexpr float CELL_SIZE = 10.0f;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++g_failures;
+        }
+    }
+
+    struct Scene {
+        entt::registry registry;
+        entt::entity near_root, near_left, near_right, near_leaf; // Cell (0, 0), the leaf is far away on its own
+        entt::entity far_root, far_child; // Cell (1, 0), the child is in cell (-1, 0) on its own
+        entt::entity camera;
+    };
+
+    entt::entity CreateEntity(entt::registry &registry, float x, float id) {
+        const entt::entity entity = registry.create();
+        TransformLocal transform;
+        transform.translation = {x, id, 0.0f};
+        registry.emplace<TransformLocal>(entity, transform);
+        return entity;
+    }
+
+    void MakeScene(Scene &scene) {
+        entt::registry &registry = scene.registry;
+        scene.near_root = CreateEntity(registry, 5.0f, 0.0f);
+        scene.near_left = CreateEntity(registry, 1.0f, 1.0f);
+        scene.near_right = CreateEntity(registry, 2.0f, 2.0f);
+        scene.near_leaf = CreateEntity(registry, 25.0f, 3.0f);
+        scene.far_root = CreateEntity(registry, 15.0f, 4.0f);
+        scene.far_child = CreateEntity(registry, -5.0f, 5.0f);
+        scene.camera = CreateEntity(registry, 5.0f, 6.0f);
+        registry.emplace<CameraPrimary>(scene.camera);
+        HierarchyUtils::SetParent(registry, scene.near_left, scene.near_root);
+        HierarchyUtils::SetParent(registry, scene.near_right, scene.near_root);
+        HierarchyUtils::SetParent(registry, scene.near_leaf, scene.near_right);
+        HierarchyUtils::SetParent(registry, scene.far_child, scene.far_root);
+    }
+
+    // Instantiates data into registry and returns the created entities by the id in their translation.
+    std::unordered_map<int, entt::entity> Load(const std::vector<char> &data, entt::registry &registry) {
+        std::vector<uint32_t> aligned((data.size() + 3) / 4);
+        std::memcpy(aligned.data(), data.data(), data.size());
+        SceneFile::Snapshot snapshot;
+        std::unordered_map<int, entt::entity> by_id;
+        if (!snapshot.open(reinterpret_cast<const char *>(aligned.data()), data.size())) {
+            return by_id;
+        }
+        for (const entt::entity entity: SceneFile::Instantiate(snapshot, registry, {})) {
+            if (const auto *transform = registry.try_get<TransformLocal>(entity)) {
+                by_id[static_cast<int>(transform->translation.y)] = entity;
+            }
+        }
+        return by_id;
+    }
+
+    int GetId(const entt::registry &registry, entt::entity entity) {
+        return static_cast<int>(registry.get<TransformLocal>(entity).translation.y);
+    }
+
+    // Every link of every original entity in by_id points at the loaded copy of its target, or is null if the
+    // target was not loaded.
+    bool LinksMatch(const entt::registry &original, const entt::registry &loaded,
+                    const std::unordered_map<int, entt::entity> &by_id) {
+        std::unordered_map<int, entt::entity> originals;
+        for (auto entity: original.view<const TransformLocal>()) {
+            originals[GetId(original, entity)] = entity;
+        }
+        auto expected = [&](entt::entity target) {
+            if (target == entt::null) {
+                return entt::entity(entt::null);
+            }
+            const auto it = by_id.find(GetId(original, target));
+            return it == by_id.end() ? entt::entity(entt::null) : it->second;
+        };
+        bool match = true;
+        for (const auto &[id, copy]: by_id) {
+            const auto *hierarchy = original.try_get<Hierarchy>(originals.at(id));
+            const auto *other = loaded.try_get<Hierarchy>(copy);
+            if (!hierarchy || !other) {
+                match &= !hierarchy && !other;
+                continue;
+            }
+            match &= other->parent == expected(hierarchy->parent) &&
+                    other->first_child == expected(hierarchy->first_child) &&
+                    other->last_child == expected(hierarchy->last_child) &&
+                    other->next_sibling == expected(hierarchy->next_sibling) &&
+                    other->prev_sibling == expected(hierarchy->prev_sibling);
+        }
+        return match;
+    }
+
+    std::vector<char> ReadFile(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    void TestPartition(const Scene &scene) {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "rde_world_partition_tests";
+        std::filesystem::remove_all(directory);
+        Check(WorldPartition::Write(directory, scene.registry, CELL_SIZE), "the world is written");
+        Check(!std::filesystem::exists(directory / (std::string(WorldPartition::INDEX_FILE) + ".tmp")),
+              "no temporary index is left behind");
+        WorldPartition::Index index;
+        Check(WorldPartition::ReadIndex(directory, index), "the index reads back");
+        Check(index.cell_size == CELL_SIZE && index.cells.size() == 2, "the index has both cells");
+
+        const std::vector<int> expected_ids[] = {{0, 1, 2, 3}, {4, 5}};
+        for (const WorldPartition::Cell &cell: index.cells) {
+            const bool near = cell.x == 0 && cell.z == 0;
+            Check(near || (cell.x == 1 && cell.z == 0), "roots are placed by their own position");
+            const std::vector<int> &ids = expected_ids[near ? 0 : 1];
+            entt::registry loaded;
+            const auto by_id = Load(ReadFile(WorldPartition::GetCellPath(directory, cell)), loaded);
+            bool whole = by_id.size() == ids.size() && cell.entity_count == ids.size();
+            for (const int id: ids) {
+                whole &= by_id.contains(id);
+            }
+            Check(whole, "a cell holds its roots with their whole subtrees");
+            Check(LinksMatch(scene.registry, loaded, by_id), "links inside a cell are restored");
+            Check(loaded.view<CameraPrimary>().begin() == loaded.view<CameraPrimary>().end(),
+                  "the primary camera stays out of the cells");
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    // A subset that cuts through a subtree, as a cell never does: the links to the rest are written as null.
+    void TestFilteredSerialize(const Scene &scene) {
+        const entt::entity subset[] = {scene.near_root, scene.near_right, scene.far_child};
+        std::vector<char> data;
+        SceneFile::Serialize(scene.registry, subset, data);
+        entt::registry loaded;
+        const auto by_id = Load(data, loaded);
+        Check(by_id.size() == 3 && by_id.contains(0) && by_id.contains(2) && by_id.contains(5),
+              "only the subset is stored");
+        Check(LinksMatch(scene.registry, loaded, by_id), "links to entities outside the subset are null");
+        if (by_id.size() == 3) {
+            const auto &root = loaded.get<Hierarchy>(by_id.at(0));
+            const auto &right = loaded.get<Hierarchy>(by_id.at(2));
+            Check(root.first_child == entt::null && root.last_child == by_id.at(2), "the excluded child is dropped");
+            Check(right.prev_sibling == entt::null && right.first_child == entt::null && right.parent == by_id.at(0),
+                  "the excluded sibling and child are dropped");
+            Check(loaded.get<Hierarchy>(by_id.at(5)).parent == entt::null, "the excluded parent is dropped");
+        }
+    }
+}
+
+int main() {
+    Log::Initialize();
+    Scene scene;
+    MakeScene(scene);
+    TestPartition(scene);
+    TestFilteredSerialize(scene);
+    if (g_failures == 0) {
+        std::printf("WorldPartitionTests passed\n");
+    }
+    return g_failures == 0 ? 0 : 1;
+}